@@ -10,8 +10,10 @@
 //====================================================================
 //public data
 rclc_action_server_t g_actionServerFollowJointTrajectory;
-control_msgs__action__FollowJointTrajectory_SendGoal_Request g_actionServer_FJT_SendGoal_Request;
+control_msgs__action__FollowJointTrajectory_SendGoal_Request g_actionServer_FJT_SendGoal_Request[MAX_NUMBER_OF_FJT_GOALS];
 UINT32 g_actionServer_FJT_SendGoal_Request__sizeof;
+UINT32 g_actionServer_FJT_MaxNumberOfPoints;
+UINT32 g_actionServer_FJT_NumberOfGoals;
 
 //====================================================================
 //private data
@@ -31,18 +33,53 @@ typedef enum
 {
     GOAL_COMPLETE,
     GOAL_CANCEL,
-    GOAL_ABORT_DUE_TO_ERROR
+    GOAL_ABORT_DUE_TO_ERROR,
+    GOAL_ABORT_DUE_TO_PATH_TOLERANCE
 } GOAL_END_TYPE;
 
+#define MR2_JTA_MAX_NUM_AXES (MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM)
+
 INT64 fjt_trajectory_start_time_ns;
+INT64 fjt_goal_time_offset_ns; //start of the active goal relative to fjt_trajectory_start_time_ns (non-zero for a replacement goal)
 
 rclc_action_goal_handle_t* fjt_active_goal_handle;
-rclc_action_goal_handle_t* fjt_rejected_goal_handle;
 control_msgs__action__FollowJointTrajectory_GetResult_Response fjt_result_response;
 rcl_action_goal_state_t fjt_goal_state;
 
+//goals which don't execute (anymore) are finished independently of the active goal
+rclc_action_goal_handle_t* fjt_rejected_goal_handle;
+control_msgs__action__FollowJointTrajectory_GetResult_Response fjt_rejected_result_response;
+rclc_action_goal_handle_t* fjt_preempted_goal_handle;
+control_msgs__action__FollowJointTrajectory_GetResult_Response fjt_preempted_result_response;
+
 BOOL fjt_result_message_ready;
 
+//path_tolerance of the active goal, in the order of the feedback message. Joints which aren't
+//checked have a limit of PATH_TOLERANCE_NOT_CHECKED, so all joints can be compared in one pass.
+#define PATH_TOLERANCE_NOT_CHECKED (1.0e9)
+double fjt_path_tolerance_limits[MR2_JTA_MAX_NUM_AXES];
+BOOL fjt_path_tolerance_active;
+double fjt_path_tolerance_violators[MR2_JTA_MAX_NUM_AXES];
+
+//desired positions published by the increment-move task, one snapshot per interpolation cycle.
+//Each slot carries a sequence number (odd while it is being written), so the executor can take a
+//consistent copy without blocking the increment-move task (see Q_MEMORY_BARRIER). The feedback
+//position trails the command position by the servo lag, so the path_tolerance is checked against
+//the snapshot of fjt_desired_lag_cycles cycles ago (see path_tolerance_servo_lag) instead of the latest one.
+//The check itself runs in the executor, each time feedback is published, so a violation is
+//detected within one action_feedback_publisher_period (not within an interpolation cycle).
+#define DESIRED_HISTORY_SIZE (64)
+#define DESIRED_READ_ATTEMPTS (3)
+typedef struct
+{
+    volatile UINT32 sequence;
+    double positions[MR2_JTA_MAX_NUM_AXES];
+} DesiredPositionSnapshot;
+DesiredPositionSnapshot fjt_desired_history[DESIRED_HISTORY_SIZE];
+volatile UINT32 fjt_desired_count;  //number of snapshots published (written by the increment-move task only)
+UINT32 fjt_desired_goal_start;      //fjt_desired_count when the active goal was accepted
+UINT32 fjt_desired_lag_cycles;      //servo lag, in interpolation cycles (less than DESIRED_HISTORY_SIZE)
+
 #define RESULT_REPONSE_ERROR_CODE(rosCode, motomanCode) ((rosCode * 100000) - motomanCode)
 
 //====================================================================
@@ -50,6 +87,13 @@ BOOL fjt_result_message_ready;
 void Ros_ActionServer_FJT_ResetProgressTracker();
 void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type);
 void Ros_ActionServer_FJT_DeleteFeedbackMessage();
+void Ros_ActionServer_FJT_PreemptActiveGoal();
+void Ros_ActionServer_FJT_AppendIncQueueStats(rosidl_runtime_c__String* error_string);
+void Ros_ActionServer_FJT_InitPathTolerances(control_msgs__action__FollowJointTrajectory_SendGoal_Request const* ros_goal_request);
+size_t Ros_ActionServer_FJT_GetGoalBufferSize(int numberOfGoals);
+BOOL Ros_ActionServer_FJT_IsReplacementGoal(BOOL bAllowReplacement, BOOL bGoalActive, BOOL bResultReady, INT64 replacementStart_ns);
+INT64 Ros_ActionServer_FJT_GetSpliceTime(INT64 replacementStart_ns, INT64 trajectoryStart_ns, INT64 speedScaleDelay_ns);
+UINT32 Ros_ActionServer_FJT_GetServoLagCycles(int servoLag_ms, int interpolPeriod_ms);
 
 //===================================================================
 void Ros_ActionServer_FJT_Initialize()
@@ -60,6 +104,7 @@ void Ros_ActionServer_FJT_Initialize()
 
     fjt_active_goal_handle = NULL;
     fjt_rejected_goal_handle = NULL;
+    fjt_preempted_goal_handle = NULL;
     fjt_result_message_ready = FALSE;
 
     //===============================================
@@ -79,6 +124,7 @@ void Ros_ActionServer_FJT_Initialize()
     //configure how much memory to allocate for the FJT request message
     static micro_ros_utilities_memory_conf_t goal_svc_req_msg_alloc_cfg = { 0 };
     int maxAxes = MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM;
+    int numAxes = g_Ros_Controller.totalAxesCount;
     goal_svc_req_msg_alloc_cfg.max_string_capacity = MAX_JOINT_NAME_LENGTH;
     goal_svc_req_msg_alloc_cfg.max_ros2_type_sequence_capacity = maxAxes;
     goal_svc_req_msg_alloc_cfg.max_basic_type_sequence_capacity = maxAxes;
@@ -86,11 +132,11 @@ void Ros_ActionServer_FJT_Initialize()
     micro_ros_utilities_memory_rule_t rules[] = {
         {"goal.trajectory.joint_names", maxAxes}, //number of joints
         {"goal.trajectory.joint_names.data", MAX_JOINT_NAME_LENGTH}, //string length for joint name
-        {"goal.trajectory.points", MAX_NUMBER_OF_POINTS_PER_TRAJECTORY}, //number of points in trajectory
-        {"goal.trajectory.points.positions", maxAxes}, //number of positions in a point (max axes)
-        {"goal.trajectory.points.velocities", maxAxes}, //number of velocities in a point (max axes)
-        {"goal.trajectory.points.accelerations", maxAxes}, //number of accelerations in a point (max axes)
-        {"goal.trajectory.points.effort", maxAxes}, //number of effort in a point (max axes)
+        {"goal.trajectory.points", 0}, //number of points in trajectory (determined below)
+        {"goal.trajectory.points.positions", numAxes}, //number of positions in a point (axes on this controller)
+        {"goal.trajectory.points.velocities", numAxes}, //number of velocities in a point (axes on this controller, also used for the timing of waypoint goals)
+        {"goal.trajectory.points.accelerations", numAxes}, //number of accelerations in a point (axes on this controller, also used for the timing of waypoint goals)
+        {"goal.trajectory.points.effort", numAxes}, //number of effort in a point (axes on this controller)
 
         //NOTE: Setting these to zero to 'disable' multi-dof trajectory
         {"goal.multi_dof_trajectory.joint_names", 0}, //each point will have cartesian position for each group
@@ -100,30 +146,60 @@ void Ros_ActionServer_FJT_Initialize()
         {"goal.multi_dof_trajectory.points.velocities", 0}, //each point will have cartesian position for each group
         {"goal.multi_dof_trajectory.points.accelerations", 0}, //each point will have cartesian position for each group
 
-        {"goal.path_tolerance", MAX_NUMBER_OF_POINTS_PER_TRAJECTORY}, //number of points in trajectory
+        {"goal.path_tolerance", maxAxes}, //number of joints
         {"goal.goal_tolerance", maxAxes}, //number of joints
     };
 
     goal_svc_req_msg_alloc_cfg.rules = rules;
     goal_svc_req_msg_alloc_cfg.n_rules = sizeof(rules) / sizeof(rules[0]);
 
+    //----------------
+    //The trajectory is converted into a rolling window while it is executed (see Ros_MotionControl_Init),
+    //so the number of points is only limited by the size of the goal request. Use as many points as will
+    //fit in the static buffer. If a goal can be replaced while it is executing, the buffer has to hold
+    //a second goal as well.
+    g_actionServer_FJT_NumberOfGoals = g_nodeConfigSettings.allow_fjt_goal_replacement ? MAX_NUMBER_OF_FJT_GOALS : 1;
+    size_t sizeOfGoalBuffer = Ros_ActionServer_FJT_GetGoalBufferSize(g_actionServer_FJT_NumberOfGoals);
+
+    micro_ros_utilities_memory_rule_t* pointsRule = &rules[2]; //"goal.trajectory.points"
+    const rosidl_message_type_support_t* goal_req_type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request);
+
+    pointsRule->size = 0;
+    size_t sizeWithoutPoints = micro_ros_utilities_get_static_size(goal_req_type_support, goal_svc_req_msg_alloc_cfg);
+    pointsRule->size = 1;
+    size_t sizePerPoint = micro_ros_utilities_get_static_size(goal_req_type_support, goal_svc_req_msg_alloc_cfg) - sizeWithoutPoints;
+    size_t sizeAvailable = sizeOfGoalBuffer - sizeof(g_actionServer_FJT_SendGoal_Request[0]);
+
+    pointsRule->size = (sizeAvailable - sizeWithoutPoints) / sizePerPoint;
+    if (pointsRule->size > MAX_NUMBER_OF_POINTS_PER_TRAJECTORY)
+        pointsRule->size = MAX_NUMBER_OF_POINTS_PER_TRAJECTORY;
+    while (micro_ros_utilities_get_static_size(goal_req_type_support, goal_svc_req_msg_alloc_cfg) > sizeAvailable) //account for alignment
+        pointsRule->size -= 1;
+    g_actionServer_FJT_MaxNumberOfPoints = pointsRule->size;
+
     //----------------
     //Create goal-request message using STATIC buffer. My heap is very limited, so I'm cheating by using
     //static block of memory that is allocated in MemoryAllocation.c (Ros_StaticAllocationBuffer_FJTgoal)
     Ros_Debug_BroadcastMsg("Allocating FollowJointTrajectory goal request");
-    Ros_Debug_BroadcastMsg("Maximum length of trajectories: %d points", MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+    Ros_Debug_BroadcastMsg("Maximum length of trajectories: %d points", g_actionServer_FJT_MaxNumberOfPoints);
+    Ros_Debug_BroadcastMsg("Number of goals which can be held: %d", g_actionServer_FJT_NumberOfGoals);
 
-    g_actionServer_FJT_SendGoal_Request__sizeof = sizeof(g_actionServer_FJT_SendGoal_Request) +
-        micro_ros_utilities_get_static_size(ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request), goal_svc_req_msg_alloc_cfg);
+    g_actionServer_FJT_SendGoal_Request__sizeof = sizeof(g_actionServer_FJT_SendGoal_Request[0]) +
+        micro_ros_utilities_get_static_size(goal_req_type_support, goal_svc_req_msg_alloc_cfg);
     Ros_Debug_BroadcastMsg("g_actionServer_FJT_SendGoal_Request__sizeof = %d", g_actionServer_FJT_SendGoal_Request__sizeof);
 
     bzero(Ros_StaticAllocationBuffer_FJTgoal, sizeof(Ros_StaticAllocationBuffer_FJTgoal));
-    micro_ros_utilities_create_static_message_memory(
-        ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request),
-        &g_actionServer_FJT_SendGoal_Request,
-        goal_svc_req_msg_alloc_cfg,
-        Ros_StaticAllocationBuffer_FJTgoal,
-        sizeof(Ros_StaticAllocationBuffer_FJTgoal));
+    for (int i = 0; i < g_actionServer_FJT_NumberOfGoals; i += 1)
+    {
+        micro_ros_utilities_create_static_message_memory(
+            ROSIDL_GET_MSG_TYPE_SUPPORT(control_msgs, action, FollowJointTrajectory_SendGoal_Request),
+            &g_actionServer_FJT_SendGoal_Request[i],
+            goal_svc_req_msg_alloc_cfg,
+            &Ros_StaticAllocationBuffer_FJTgoal[i * sizeOfGoalBuffer],
+            sizeOfGoalBuffer);
+    }
+
+    Ros_MotionControl_InitTrajectorySplice();
 
     MOTOROS2_MEM_TRACE_REPORT(fjt_init);
 }
@@ -137,11 +213,17 @@ void Ros_ActionServer_FJT_Cleanup()
 
     //Memory for actionServer_FJT_SendGoal_Request was not allocated off the heap. It was taken from a static buffer.
     //Clear the buffer and any pointers into it.
-    bzero(&g_actionServer_FJT_SendGoal_Request, sizeof(g_actionServer_FJT_SendGoal_Request));
+    bzero(g_actionServer_FJT_SendGoal_Request, sizeof(g_actionServer_FJT_SendGoal_Request));
     bzero(Ros_StaticAllocationBuffer_FJTgoal, sizeof(Ros_StaticAllocationBuffer_FJTgoal));
 
+    Ros_MotionControl_CleanupTrajectorySplice();
+
     if (fjt_result_response.result.error_string.data != NULL)
         micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
+    if (fjt_rejected_result_response.result.error_string.data != NULL)
+        micro_ros_string_utilities_destroy(&fjt_rejected_result_response.result.error_string);
+    if (fjt_preempted_result_response.result.error_string.data != NULL)
+        micro_ros_string_utilities_destroy(&fjt_preempted_result_response.result.error_string);
 
     Ros_ActionServer_FJT_DeleteFeedbackMessage();
 
@@ -163,6 +245,36 @@ void Ros_ActionServer_FJT_DeleteFeedbackMessage()
     }
 }
 
+//-------------------------------------------------------------------
+// Size of the part of the static goal buffer used by each goal. Each part
+// starts on a boundary which is suitable for the doubles of the points.
+//-------------------------------------------------------------------
+size_t Ros_ActionServer_FJT_GetGoalBufferSize(int numberOfGoals)
+{
+    size_t size = SIZEOF_BUFFER_FJT_GOAL / numberOfGoals;
+
+    return size - (size % sizeof(double));
+}
+
+//-------------------------------------------------------------------
+// A goal which specifies when it starts (a non-zero stamp) can replace the
+// goal which is executing, if replacement is enabled
+//-------------------------------------------------------------------
+BOOL Ros_ActionServer_FJT_IsReplacementGoal(BOOL bAllowReplacement, BOOL bGoalActive, BOOL bResultReady, INT64 replacementStart_ns)
+{
+    return bAllowReplacement && bGoalActive && !bResultReady && (replacementStart_ns != 0);
+}
+
+//-------------------------------------------------------------------
+// The time (ms) on the timeline of the active trajectory at which the
+// replacement takes over. The active trajectory runs behind real time by the
+// delay of the speed scaling.
+//-------------------------------------------------------------------
+INT64 Ros_ActionServer_FJT_GetSpliceTime(INT64 replacementStart_ns, INT64 trajectoryStart_ns, INT64 speedScaleDelay_ns)
+{
+    return (replacementStart_ns - trajectoryStart_ns - speedScaleDelay_ns) / 1000000;
+}
+
 rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_handle, void* context)
 {
     (void)context;
@@ -175,9 +287,16 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
 
 
     bool bMotionModeOk = Ros_MotionControl_IsMotionMode_Trajectory();
-    bool bSizeOk = (pending_ros_goal_request->goal.trajectory.points.size <= MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+    bool bSizeOk = (pending_ros_goal_request->goal.trajectory.points.size <= g_actionServer_FJT_MaxNumberOfPoints);
     bool bMotionReady = Ros_Controller_IsMotionReady();
 
+    //A goal which specifies when it starts can replace the goal which is executing. It is spliced into
+    //the active trajectory at that time (see Ros_MotionControl_SpliceTrajectory).
+    INT64 replacementStart_ns = Ros_Time_Msg_To_Nanos(&pending_ros_goal_request->goal.trajectory.header.stamp);
+    bool bReplaceActiveGoal = Ros_ActionServer_FJT_IsReplacementGoal(g_nodeConfigSettings.allow_fjt_goal_replacement,
+        fjt_active_goal_handle != NULL, fjt_result_message_ready, replacementStart_ns);
+    INT64 spliceTime_ms = 0;
+
     if (bMotionModeOk && bSizeOk && !bMotionReady && Ros_Controller_IsEcoMode()) //energy saving function
     {
         Ros_Debug_BroadcastMsg("Energy saving function is active. Re-enabling the robot.");
@@ -202,12 +321,32 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
     bool bInitOk = FALSE;
     if (bSizeOk && bMotionReady && bMotionModeOk)
     {
-        trajStatus = Ros_MotionControl_InitTrajectory(pending_ros_goal_request);
+        if (bReplaceActiveGoal)
+        {
+            //This assumes that the delay of the speed scaling doesn't grow any further before the replacement starts.
+            INT64 speedScaleDelay = (INT64)(Ros_MotionControl_GetSpeedScaleDelay() * 1000000.0);
+            spliceTime_ms = Ros_ActionServer_FJT_GetSpliceTime(replacementStart_ns, fjt_trajectory_start_time_ns, speedScaleDelay);
+
+            trajStatus = Ros_MotionControl_SpliceTrajectory(pending_ros_goal_request, spliceTime_ms);
+        }
+        else
+            trajStatus = Ros_MotionControl_InitTrajectory(pending_ros_goal_request);
         bInitOk = (trajStatus == INIT_TRAJ_OK);
     }
 
     //-----------RESPOND TO REQUEST
-    if (bSizeOk && bMotionReady && bMotionModeOk && bInitOk)
+    if (bSizeOk && bMotionReady && bMotionModeOk && bInitOk && bReplaceActiveGoal)
+    {
+        //The feedback message and the progress tracker carry on with the replacement. Only the
+        //goal that they are reported for changes.
+        Ros_ActionServer_FJT_PreemptActiveGoal();
+
+        fjt_active_goal_handle = goal_handle;
+        fjt_goal_time_offset_ns = spliceTime_ms * 1000000;
+
+        Ros_ActionServer_FJT_InitPathTolerances(pending_ros_goal_request);
+    }
+    else if (bSizeOk && bMotionReady && bMotionModeOk && bInitOk)
     {
         // ---- Build feedback message
         micro_ros_utilities_create_message_memory(
@@ -229,8 +368,10 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
         }
 
         Ros_ActionServer_FJT_ResetProgressTracker();
+        Ros_ActionServer_FJT_InitPathTolerances(pending_ros_goal_request);
 
         fjt_trajectory_start_time_ns = rmw_uros_epoch_nanos();
+        fjt_goal_time_offset_ns = 0;
     }
     else
     {
@@ -239,7 +380,7 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
         //https://github.com/ros2/rclc/issues/271
 
         if (fjt_rejected_goal_handle) //result string already pending
-            micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
+            micro_ros_string_utilities_destroy(&fjt_rejected_result_response.result.error_string);
 
         fjt_rejected_goal_handle = goal_handle;
 
@@ -247,41 +388,73 @@ rcl_ret_t Ros_ActionServer_FJT_Goal_Received(rclc_action_goal_handle_t* goal_han
         if (!bSizeOk)
         {
             motomanErrorCode = INIT_TRAJ_TOO_BIG;
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, 
+            rosidl_runtime_c__String__assign(&fjt_rejected_result_response.result.error_string, 
                 Ros_ErrorHandling_Init_Trajectory_Status_ToString((Init_Trajectory_Status) motomanErrorCode));
         }
         else if (!bMotionReady)
         {
             motomanErrorCode = Ros_Controller_GetNotReadySubcode(false);
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string,
+            rosidl_runtime_c__String__assign(&fjt_rejected_result_response.result.error_string,
                 Ros_ErrorHandling_MotionNotReadyCode_ToString((MotionNotReadyCode)motomanErrorCode));
         }
         else if (!bMotionModeOk)
         {
             motomanErrorCode = INIT_TRAJ_WRONG_MODE;
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, 
+            rosidl_runtime_c__String__assign(&fjt_rejected_result_response.result.error_string, 
                 Ros_ErrorHandling_Init_Trajectory_Status_ToString((Init_Trajectory_Status) motomanErrorCode));
         }
         else if (!bInitOk)
         {
             motomanErrorCode = trajStatus;
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, 
-                Ros_ErrorHandling_Init_Trajectory_Status_ToString(trajStatus));
-        }
 
-        fjt_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__INVALID_GOAL, motomanErrorCode);
-        fjt_result_response.status = GOAL_STATE_ABORTED;
+            //include which point was rejected, if that is known
+            char const* details = Ros_MotionControl_GetInitTrajectoryDetails();
+            if (strlen(details) > 0)
+            {
+                char msgBuffer[256] = { 0 };
+                snprintf(msgBuffer, 256, "%s (%s)", Ros_ErrorHandling_Init_Trajectory_Status_ToString(trajStatus), details);
+                rosidl_runtime_c__String__assign(&fjt_rejected_result_response.result.error_string, msgBuffer);
+            }
+            else
+            {
+                rosidl_runtime_c__String__assign(&fjt_rejected_result_response.result.error_string, 
+                    Ros_ErrorHandling_Init_Trajectory_Status_ToString(trajStatus));
+            }
+        }
 
-        fjt_result_message_ready = TRUE;
+        fjt_rejected_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__INVALID_GOAL, motomanErrorCode);
+        fjt_rejected_result_response.status = GOAL_STATE_ABORTED;
 
         Ros_Debug_BroadcastMsg("FollowJointTrajectory - Goal request rejected");
         Ros_Debug_BroadcastMsg("The trajectory will be accepted and then immediately aborted");
-        Ros_Debug_BroadcastMsg(fjt_result_response.result.error_string.data);
+        Ros_Debug_BroadcastMsg(fjt_rejected_result_response.result.error_string.data);
     }
 
     return RCL_RET_ACTION_GOAL_ACCEPTED;
 }
 
+void Ros_ActionServer_FJT_PreemptActiveGoal()
+{
+    if (fjt_preempted_goal_handle) //result string already pending
+        micro_ros_string_utilities_destroy(&fjt_preempted_result_response.result.error_string);
+
+    fjt_preempted_goal_handle = fjt_active_goal_handle;
+
+    //The result is only sent once all groups have switched over to the replacement (see
+    //Ros_ActionServer_FJT_ProcessResult). Until then, the points of this goal are still in use.
+    //The replacement was requested on purpose, so this isn't reported as a failure (like ros2_control's JTC).
+    //The goal can't be reported as canceled, as no cancel was requested for it.
+    fjt_preempted_result_response.status = GOAL_STATE_SUCCEEDED;
+
+    char msgBuffer[64] = { 0 };
+    snprintf(msgBuffer, sizeof(msgBuffer), "Goal was preempted by a replacement goal (%d).", FAIL_TRAJ_PREEMPTED);
+    rosidl_runtime_c__String__assign(&fjt_preempted_result_response.result.error_string, msgBuffer);
+
+    fjt_preempted_result_response.result.error_code = control_msgs__action__FollowJointTrajectory_Result__SUCCESSFUL;
+
+    Ros_Debug_BroadcastMsg("FollowJointTrajectory - Active goal preempted by a replacement goal");
+}
+
 void Ros_ActionServer_FJT_ResetProgressTracker()
 {
     control_msgs__action__FollowJointTrajectory_Feedback* feedback = &feedback_FollowJointTrajectory.feedback;
@@ -326,6 +499,10 @@ void Ros_ActionServer_FJT_ResetProgressTracker()
 
     feedback->desired.positions.size = g_messages_PositionMonitor.jointStateAllGroups->position.size;
 
+    //snapshots published before this goal don't lag behind its start
+    fjt_desired_goal_start = fjt_desired_count;
+    fjt_desired_lag_cycles = Ros_ActionServer_FJT_GetServoLagCycles(g_nodeConfigSettings.path_tolerance_servo_lag, g_Ros_Controller.interpolPeriod);
+
     //--------------------
     //desired velocity
     bzero(feedback->desired.velocities.data,
@@ -346,22 +523,123 @@ void Ros_ActionServer_FJT_ResetProgressTracker()
     //TODO: do multidof too
 }
 
+//Servo lag (ms) in whole interpolation cycles. The lagged snapshot must still be in the history
+//while the increment-move task publishes a few more.
+UINT32 Ros_ActionServer_FJT_GetServoLagCycles(int servoLag_ms, int interpolPeriod_ms)
+{
+    UINT32 lagCycles;
+
+    if (interpolPeriod_ms <= 0)
+        return 0;
+
+    lagCycles = (UINT32)((servoLag_ms + (interpolPeriod_ms / 2)) / interpolPeriod_ms);
+    if (lagCycles > DESIRED_HISTORY_SIZE / 2)
+        lagCycles = DESIRED_HISTORY_SIZE / 2;
+
+    return lagCycles;
+}
+
+//Called from the increment-move task only (single writer)
+static void Ros_ActionServer_FJT_PublishDesired(double const* positions, size_t numAxes)
+{
+    UINT32 count = fjt_desired_count;
+    DesiredPositionSnapshot* slot = &fjt_desired_history[count % DESIRED_HISTORY_SIZE];
+
+    slot->sequence += 1;
+    Q_MEMORY_BARRIER();
+    memcpy(slot->positions, positions, sizeof(double) * numAxes);
+    Q_MEMORY_BARRIER();
+    slot->sequence += 1;
+    Q_MEMORY_BARRIER();
+    fjt_desired_count = count + 1;
+}
+
+//Copies the desired position of fjt_desired_lag_cycles cycles ago into 'positions'.
+//Returns FALSE (and leaves 'positions' unchanged) if the active goal hasn't run for that many
+//cycles yet, or if the snapshot kept being overwritten while it was copied.
+static BOOL Ros_ActionServer_FJT_ReadLaggedDesired(double* positions, size_t numAxes)
+{
+    double copy[MR2_JTA_MAX_NUM_AXES];
+
+    for (int attempt = 0; attempt < DESIRED_READ_ATTEMPTS; attempt += 1)
+    {
+        UINT32 count = fjt_desired_count;
+        Q_MEMORY_BARRIER();
+
+        if ((count - fjt_desired_goal_start) <= fjt_desired_lag_cycles)
+            return FALSE;
+
+        DesiredPositionSnapshot const* slot = &fjt_desired_history[(count - 1 - fjt_desired_lag_cycles) % DESIRED_HISTORY_SIZE];
+        UINT32 sequence = slot->sequence;
+        Q_MEMORY_BARRIER();
+        if (sequence & 1)
+            continue;
+
+        memcpy(copy, slot->positions, sizeof(double) * numAxes);
+        Q_MEMORY_BARRIER();
+
+        if (slot->sequence == sequence)
+        {
+            memcpy(positions, copy, sizeof(double) * numAxes);
+            return TRUE;
+        }
+    }
+
+    return FALSE;
+}
+
 //Called from TrajectoryMotionControl::Ros_MotionControl_IncMoveLoopStart
-void Ros_ActionServer_FJT_UpdateProgressTracker(MP_EXPOS_DATA* incrementData)
+//The desired position is the command position of the controller, including the increment
+//which was just sent. It is published as a snapshot, which the executor reads in
+//Ros_ActionServer_FJT_ProcessFeedback.
+void Ros_ActionServer_FJT_UpdateProgressTracker(MP_EXPOS_DATA* incrementData, MP_PULSE_POS_RSP_DATA const cmdPulsePos[])
 {
     if (fjt_active_goal_handle == NULL)
         return;
 
+    double desired[MR2_JTA_MAX_NUM_AXES];
     int iteratorAllAxes = 0;
     for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
     {
+        long pulsePos[MP_GRP_AXES_NUM];
         double radRosOrder[MP_GRP_AXES_NUM];
         CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
-        Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, incrementData->grp_pos_info[groupIndex].pos, radRosOrder);
+
+        for (int axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            pulsePos[axis] = cmdPulsePos[groupIndex].lPos[axis] + incrementData->grp_pos_info[groupIndex].pos[axis];
+        Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, pulsePos, radRosOrder);
 
         for (int i = 0; i < ctrlGroup->numAxes; i += 1, iteratorAllAxes += 1)
-            feedback_FollowJointTrajectory.feedback.desired.positions.data[iteratorAllAxes] = feedback_FollowJointTrajectory.feedback.actual.positions.data[iteratorAllAxes] + radRosOrder[i];
+            desired[iteratorAllAxes] = radRosOrder[i];
+    }
+
+    Ros_ActionServer_FJT_PublishDesired(desired, iteratorAllAxes);
+}
+
+//-------------------------------------------------------------------
+// Compare the position error of all joints with their path_tolerance in one
+// pass, without branching on the joints which aren't checked (their limit is
+// PATH_TOLERANCE_NOT_CHECKED). Records the error of each joint which is out of
+// tolerance in 'violators' (0 otherwise).
+//
+// Returns the number of joints which are out of tolerance.
+//-------------------------------------------------------------------
+static int Ros_ActionServer_FJT_Check_PathTolerances(
+    double const* const posErrors /* in */, double const* const limits /* in */,
+    double* violators /* out */, size_t numAxes /* in */)
+{
+    int numViolators = 0;
+
+    for (size_t axis = 0; axis < numAxes; axis += 1)
+    {
+        double diff = fabs(posErrors[axis]);
+        int bViolated = (diff > limits[axis]);
+
+        violators[axis] = bViolated ? diff : 0.0;
+        numViolators += bViolated;
     }
+
+    return numViolators;
 }
 
 //Called from Communication Executor
@@ -376,7 +654,7 @@ void Ros_ActionServer_FJT_ProcessFeedback()
         feedback_FollowJointTrajectory.goal_id = fjt_active_goal_handle->goal_id;
 
         //Use timestamp from when this positional data was captured
-        feedback_FollowJointTrajectory.feedback.header.stamp = g_messages_PositionMonitor.transform->transforms.data[0].header.stamp;
+        feedback_FollowJointTrajectory.feedback.header.stamp = g_messages_PositionMonitor.jointStateAllGroups->header.stamp;
 
         //The PositionMonitor functions are already polling the information we need and
         //storing it in g_messages_PositionMonitor.
@@ -392,9 +670,14 @@ void Ros_ActionServer_FJT_ProcessFeedback()
             g_messages_PositionMonitor.jointStateAllGroups->effort.data,
             sizeof(double) * g_messages_PositionMonitor.jointStateAllGroups->effort.size);
 
+        //.desired is the command position of fjt_desired_lag_cycles ago, published by
+        //ActionServer_FJT_UpdateProgressTracker (called from increment-move loop). It keeps its
+        //previous value if no suitable snapshot is available.
+        Ros_ActionServer_FJT_ReadLaggedDesired(feedback_FollowJointTrajectory.feedback.desired.positions.data,
+            feedback_FollowJointTrajectory.feedback.desired.positions.size);
+
         for (int i = 0; i < (MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM); i += 1)
         {
-            //.desired was set in ActionServer_FJT_UpdateProgressTracker (called from increment-move loop)
             feedback_FollowJointTrajectory.feedback.error.positions.data[i] =
                 feedback_FollowJointTrajectory.feedback.desired.positions.data[i] -
                 feedback_FollowJointTrajectory.feedback.actual.positions.data[i];
@@ -413,6 +696,18 @@ void Ros_ActionServer_FJT_ProcessFeedback()
 
             Ros_ActionServer_FJT_Goal_Complete(GOAL_ABORT_DUE_TO_ERROR);
         }
+        else if (fjt_path_tolerance_active &&
+            Ros_ActionServer_FJT_Check_PathTolerances(feedback_FollowJointTrajectory.feedback.error.positions.data,
+                fjt_path_tolerance_limits, fjt_path_tolerance_violators,
+                feedback_FollowJointTrajectory.feedback.joint_names.size) > 0)
+        {
+            //don't finish the rest of a motion which is already off its path
+            Ros_Debug_BroadcastMsg("Path tolerance violated while executing trajectory. Aborting.");
+
+            Ros_MotionControl_StopMotion(/*bKeepJobRunning = */ TRUE);
+
+            Ros_ActionServer_FJT_Goal_Complete(GOAL_ABORT_DUE_TO_PATH_TOLERANCE);
+        }
         else if ((!Ros_MotionControl_HasDataToProcess()) && !Ros_Controller_IsInMotion())
         {
             Ros_Debug_BroadcastMsg("Trajectory complete");
@@ -426,9 +721,10 @@ void Ros_ActionServer_FJT_ProcessFeedback()
     }
 }
 
-static STATUS Ros_ActionServer_FJT_Parse_GoalPosTolerances(
+static STATUS Ros_ActionServer_FJT_Parse_PosTolerances(
     control_msgs__msg__JointTolerance__Sequence const* const goal_joint_tolerances /* in */,
     rosidl_runtime_c__String__Sequence const* const joint_names /* in */,
+    double defaultTolerance /* in */,
     double* posTolerances /* out */, size_t posTolerances_len /* in */)
 {
     if (goal_joint_tolerances == NULL || joint_names == NULL || posTolerances == NULL)
@@ -439,7 +735,7 @@ static STATUS Ros_ActionServer_FJT_Parse_GoalPosTolerances(
 
     //always configure defaults
     for (int i = 0; i < posTolerances_len; ++i)
-        posTolerances[i] = DEFAULT_FJT_GOAL_POSITION_TOLERANCE;
+        posTolerances[i] = defaultTolerance;
 
     //if caller hasn't passed any JointTolerances, set all entries to default
     if (goal_joint_tolerances->size == 0)
@@ -501,6 +797,54 @@ static STATUS Ros_ActionServer_FJT_Parse_GoalPosTolerances(
     return OK;
 }
 
+static STATUS Ros_ActionServer_FJT_Parse_GoalPosTolerances(
+    control_msgs__msg__JointTolerance__Sequence const* const goal_joint_tolerances /* in */,
+    rosidl_runtime_c__String__Sequence const* const joint_names /* in */,
+    double* posTolerances /* out */, size_t posTolerances_len /* in */)
+{
+    return Ros_ActionServer_FJT_Parse_PosTolerances(goal_joint_tolerances, joint_names,
+        DEFAULT_FJT_GOAL_POSITION_TOLERANCE, posTolerances, posTolerances_len);
+}
+
+//-------------------------------------------------------------------
+// Map the 'path_tolerance' of a goal onto the joints of the feedback message.
+// Unlike the goal_tolerance, there is no default: only joints with a positive
+// tolerance are checked while the trajectory executes.
+//-------------------------------------------------------------------
+void Ros_ActionServer_FJT_InitPathTolerances(control_msgs__action__FollowJointTrajectory_SendGoal_Request const* ros_goal_request)
+{
+    double posTolerance[MR2_JTA_MAX_NUM_AXES];
+    int numAxes = feedback_FollowJointTrajectory.feedback.joint_names.size;
+
+    fjt_path_tolerance_active = FALSE;
+    for (int axis = 0; axis < MR2_JTA_MAX_NUM_AXES; axis += 1)
+        fjt_path_tolerance_limits[axis] = PATH_TOLERANCE_NOT_CHECKED;
+
+    if (ros_goal_request->goal.path_tolerance.size == 0)
+        return;
+
+    STATUS status = Ros_ActionServer_FJT_Parse_PosTolerances(
+        &ros_goal_request->goal.path_tolerance,
+        &feedback_FollowJointTrajectory.feedback.joint_names,
+        0.0, posTolerance, numAxes);
+
+    if (status != OK)
+    {
+        Ros_Debug_BroadcastMsg("%s: parsing 'path_tolerance' field failed: %d. Path is not checked.", __func__, status);
+        return;
+    }
+
+    //A tolerance of zero (not specified) or a negative tolerance means that this joint isn't checked
+    for (int axis = 0; axis < numAxes; axis += 1)
+    {
+        if (posTolerance[axis] > 0.0)
+        {
+            fjt_path_tolerance_limits[axis] = posTolerance[axis];
+            fjt_path_tolerance_active = TRUE;
+        }
+    }
+}
+
 /**
  * Note: this assumes neither 'traj_point_names' nor 'internal_jnames' contain
  * duplicate joint names. This function does not check whether this is true.
@@ -570,11 +914,11 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
         double diff;
         INT64 timeTolerance;
         INT64 trajectory_end_time_ns = rmw_uros_epoch_nanos();
+        control_msgs__action__FollowJointTrajectory_SendGoal_Request* ros_goal_request = (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)fjt_active_goal_handle->ros_goal_request;
 
         //-----------------------------------------------------------------------
         //check to see if each axis is in the desired location
         BOOL positionOk = TRUE;
-#define MR2_JTA_MAX_NUM_AXES (MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM)
         int numAxesToCheck = feedback_FollowJointTrajectory.feedback.joint_names.size;
 
         //NOTE: we allocate for the maximum nr of axes, but only check the nr of configured
@@ -587,7 +931,7 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
         //'parse' the JointTolerance elements from the goal. Map their 'name:tolerance'
         //to the 'joint_index:tolerance' we need
         STATUS statusParseGoalTolerance = Ros_ActionServer_FJT_Parse_GoalPosTolerances(
-            &g_actionServer_FJT_SendGoal_Request.goal.goal_tolerance,
+            &ros_goal_request->goal.goal_tolerance,
             &feedback_FollowJointTrajectory.feedback.joint_names,
             posTolerance, numAxesToCheck);
 
@@ -606,11 +950,11 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
         //feedback_FollowJointTrajectory.feedback)
         double lastTrajPtPositions[MR2_JTA_MAX_NUM_AXES];
         bzero(lastTrajPtPositions, sizeof(lastTrajPtPositions));
-        size_t finalTrajPtIdx = g_actionServer_FJT_SendGoal_Request.goal.trajectory.points.size - 1;
+        size_t finalTrajPtIdx = ros_goal_request->goal.trajectory.points.size - 1;
 
         STATUS statusGoalToleranceReorder = Ros_ActionServer_FJT_Reorder_TrajPt_To_Internal_Order(
-            &g_actionServer_FJT_SendGoal_Request.goal.trajectory.points.data[finalTrajPtIdx],
-            &g_actionServer_FJT_SendGoal_Request.goal.trajectory.joint_names,
+            &ros_goal_request->goal.trajectory.points.data[finalTrajPtIdx],
+            &ros_goal_request->goal.trajectory.joint_names,
             &feedback_FollowJointTrajectory.feedback.joint_names,
             lastTrajPtPositions,
             numAxesToCheck);
@@ -649,14 +993,32 @@ void Ros_ActionServer_FJT_Goal_Complete(GOAL_END_TYPE goal_end_type)
 goal_complete_skip_tolerance_comparison: ;
         //-----------------------------------------------------------------------
         //check execution time
-        control_msgs__action__FollowJointTrajectory_SendGoal_Request*  ros_goal_request = (control_msgs__action__FollowJointTrajectory_SendGoal_Request*)fjt_active_goal_handle->ros_goal_request;
         trajectory_msgs__msg__JointTrajectoryPoint__Sequence* points = &ros_goal_request->goal.trajectory.points;
         INT64 desiredTime = Ros_Duration_Msg_To_Nanos(&points->data[points->size - 1].time_from_start); //the desired time of the last point in the trajectory
 
+        //a replacement goal started part way through the trajectory it replaced
+        desiredTime += fjt_goal_time_offset_ns;
+
         INT64 totalTime = (trajectory_end_time_ns - fjt_trajectory_start_time_ns);
 
+        //a speed scale below 1.0 intentionally slows down the execution, so that time doesn't count
+        INT64 speedScaleDelay = (INT64)(Ros_MotionControl_GetSpeedScaleDelay() * 1000000.0);
+        if (speedScaleDelay > 0)
+        {
+            Ros_Debug_BroadcastMsg("FJT execution was delayed by speed scaling: %lld ns", speedScaleDelay);
+            totalTime -= speedScaleDelay;
+        }
+
+        //a precompiled trajectory only starts moving once it has been compiled completely
+        int precompileLatency_ms = Ros_IncPrecompile_GetStartupLatency();
+        if (precompileLatency_ms > 0)
+        {
+            Ros_Debug_BroadcastMsg("FJT motion started after precompiling for %d ms", precompileLatency_ms);
+            totalTime -= (INT64)precompileLatency_ms * 1000000;
+        }
+
         diff = abs(desiredTime - totalTime);
-        timeTolerance = Ros_Duration_Msg_To_Nanos(&g_actionServer_FJT_SendGoal_Request.goal.goal_time_tolerance);
+        timeTolerance = Ros_Duration_Msg_To_Nanos(&ros_goal_request->goal.goal_time_tolerance);
         if (timeTolerance == 0) //user did NOT provide a tolerance
         {
             timeTolerance = DEFAULT_FJT_GOAL_TIME_TOLERANCE;
@@ -676,7 +1038,15 @@ goal_complete_skip_tolerance_comparison: ;
             fjt_result_response.status = GOAL_STATE_SUCCEEDED;
             fjt_goal_state = GOAL_STATE_SUCCEEDED;
 
-            rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, "Trajectory completed successfully!");
+            if (precompileLatency_ms > 0)
+            {
+                char msgBuffer[100] = { 0 };
+                snprintf(msgBuffer, sizeof(msgBuffer), "Trajectory completed successfully! Motion started after %d ms of precompilation.",
+                    precompileLatency_ms);
+                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, msgBuffer);
+            }
+            else
+                rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, "Trajectory completed successfully!");
 
             fjt_result_response.result.error_code = control_msgs__action__FollowJointTrajectory_Result__SUCCESSFUL;
         }
@@ -714,14 +1084,21 @@ goal_complete_skip_tolerance_comparison: ;
             }
             else if (!timeOk)
             {
-                builtin_interfaces__msg__Duration durationDesired = points->data[points->size - 1].time_from_start;
+                builtin_interfaces__msg__Duration durationDesired;
                 builtin_interfaces__msg__Duration durationActual;
+                Ros_Nanos_To_Duration_Msg(desiredTime, &durationDesired);
                 Ros_Nanos_To_Duration_Msg(totalTime, &durationActual);
 
                 sprintf(msgBuffer,
                     "Execution time was outside tolerance. Target time was %d.%u seconds. Actual time was %d.%u seconds.",
                     durationDesired.sec, durationDesired.nanosec,
                     durationActual.sec, durationActual.nanosec);
+                if (precompileLatency_ms > 0)
+                {
+                    char formatBuffer[64] = { 0 };
+                    snprintf(formatBuffer, 64, " Motion started after %d ms of precompilation.", precompileLatency_ms);
+                    strcat(msgBuffer, formatBuffer);
+                }
                 rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, msgBuffer);
                 fjt_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__GOAL_TOLERANCE_VIOLATED, FAIL_TRAJ_TIME);
             }
@@ -759,6 +1136,39 @@ goal_complete_skip_tolerance_comparison: ;
         Ros_ActionServer_FJT_DeleteFeedbackMessage();
     }
 
+    //**********************************************************************
+    else if (goal_end_type == GOAL_ABORT_DUE_TO_PATH_TOLERANCE)
+    {
+        fjt_result_response.status = GOAL_STATE_ABORTED;
+        fjt_goal_state = GOAL_STATE_ABORTED;
+
+        char msgBuffer[500] = { 0 };
+        snprintf(msgBuffer, sizeof(msgBuffer), "Position was outside path tolerance. Motion was stopped.");
+        for (int axis = 0; axis < feedback_FollowJointTrajectory.feedback.joint_names.size; axis += 1)
+        {
+            //append info on which joints were outside tolerance
+            if (fjt_path_tolerance_violators[axis])
+            {
+                char formatBuffer[64] = { 0 };
+                snprintf(formatBuffer, 64, " [%s: %.5f deviation]",
+                    feedback_FollowJointTrajectory.feedback.joint_names.data[axis].data,
+                    fjt_path_tolerance_violators[axis]);
+                if (strlen(msgBuffer) + strlen(formatBuffer) < sizeof(msgBuffer))
+                    strcat(msgBuffer, formatBuffer);
+            }
+        }
+        rosidl_runtime_c__String__assign(&fjt_result_response.result.error_string, msgBuffer);
+
+        fjt_result_response.result.error_code = RESULT_REPONSE_ERROR_CODE(control_msgs__action__FollowJointTrajectory_Result__PATH_TOLERANCE_VIOLATED, FAIL_TRAJ_PATH_TOLERANCE);
+
+        Ros_Debug_BroadcastMsg(fjt_result_response.result.error_string.data);
+
+        Ros_ActionServer_FJT_DeleteFeedbackMessage();
+    }
+
+    //appended to successful results too (they already carry a message), so every executed goal can be compared
+    Ros_ActionServer_FJT_AppendIncQueueStats(&fjt_result_response.result.error_string);
+
     fjt_result_message_ready = TRUE;
 
     //If this flag remains TRUE, it can cause a race condition at the start of
@@ -772,10 +1182,39 @@ goal_complete_skip_tolerance_comparison: ;
     Ros_Debug_BroadcastMsg("FJT action complete");
 }
 
+//Report how well the increment queue of each group was kept filled while the goal executed,
+//so agent placement and QoS settings can be tuned (see Ros_MotionControl_UpdateIncQueueStats)
+void Ros_ActionServer_FJT_AppendIncQueueStats(rosidl_runtime_c__String* error_string)
+{
+    char statsBuffer[400] = { 0 };
+    char msgBuffer[1000] = { 0 };
+
+    strcpy(statsBuffer, "Increment queue:");
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        IncQueueStats const* stats = &g_Ros_Controller.ctrlGroups[groupIndex]->incQueueStats;
+        char formatBuffer[96] = { 0 };
+
+        snprintf(formatBuffer, sizeof(formatBuffer), " [Group #%d: min fill %d, %d underruns, longest %d cycles]",
+            groupIndex, stats->minFill, stats->underrunCount, stats->longestUnderrun);
+        strncat(statsBuffer, formatBuffer, sizeof(statsBuffer) - strlen(statsBuffer) - 1);
+    }
+    Ros_Debug_BroadcastMsg(statsBuffer);
+
+    snprintf(msgBuffer, sizeof(msgBuffer), "%s %s", error_string->data != NULL ? error_string->data : "", statsBuffer);
+    rosidl_runtime_c__String__assign(error_string, msgBuffer);
+}
+
 bool Ros_ActionServer_FJT_Goal_Cancel(rclc_action_goal_handle_t* goal_handle, void* context)
 {
     (void)context;
-    (void)goal_handle;
+
+    //a goal which is rejected or preempted has already stopped executing
+    if (goal_handle != fjt_active_goal_handle)
+    {
+        Ros_Debug_BroadcastMsg("Goal is not executing - ignoring cancel request");
+        return false;
+    }
 
     Ros_Debug_BroadcastMsg("Goal Canceled");
 
@@ -801,14 +1240,26 @@ void Ros_ActionServer_FJT_ProcessResult()
         }
 
     }
-    else if (fjt_rejected_goal_handle && fjt_result_message_ready)
+
+    //Sending the result releases the goal handle, along with the memory of its request. A new goal
+    //could then overwrite the points which the groups still need until they reach the splice time.
+    if (fjt_preempted_goal_handle && !Ros_MotionControl_IsSplicePending())
     {
-        rc = rclc_action_send_result(fjt_rejected_goal_handle, GOAL_STATE_ABORTED, &fjt_result_response);
+        rc = rclc_action_send_result(fjt_preempted_goal_handle, fjt_preempted_result_response.status, &fjt_preempted_result_response);
         if (rc == RCL_RET_OK)
         {
-            micro_ros_string_utilities_destroy(&fjt_result_response.result.error_string);
+            micro_ros_string_utilities_destroy(&fjt_preempted_result_response.result.error_string);
+            fjt_preempted_goal_handle = NULL;
+        }
+    }
+
+    if (fjt_rejected_goal_handle)
+    {
+        rc = rclc_action_send_result(fjt_rejected_goal_handle, GOAL_STATE_ABORTED, &fjt_rejected_result_response);
+        if (rc == RCL_RET_OK)
+        {
+            micro_ros_string_utilities_destroy(&fjt_rejected_result_response.result.error_string);
             fjt_rejected_goal_handle = NULL;
-            fjt_result_message_ready = FALSE;
         }
     }
 }
@@ -8,16 +8,19 @@
 #ifndef MOTOROS2_ACTION_SERVER_FJT_H
 #define MOTOROS2_ACTION_SERVER_FJT_H
 
-#define MAX_NUMBER_OF_POINTS_PER_TRAJECTORY 200
+#define MAX_NUMBER_OF_POINTS_PER_TRAJECTORY 10000 //upper limit, the actual limit depends on the number of axes (g_actionServer_FJT_MaxNumberOfPoints)
 #define MIN_NUMBER_OF_POINTS_PER_TRAJECTORY 2   //current position and destination
+#define MAX_NUMBER_OF_FJT_GOALS 2   //executing goal + the goal which replaces it (see allow_fjt_goal_replacement)
 
 #define DEFAULT_FJT_GOAL_POSITION_TOLERANCE  (0.01) //radians per axis or meters per axis
 #define DEFAULT_FJT_GOAL_TIME_TOLERANCE      (500000000LL) //nanoseconds (0.5 seconds)
 
 extern rclc_action_server_t g_actionServerFollowJointTrajectory;
 
-extern control_msgs__action__FollowJointTrajectory_SendGoal_Request g_actionServer_FJT_SendGoal_Request;
+extern control_msgs__action__FollowJointTrajectory_SendGoal_Request g_actionServer_FJT_SendGoal_Request[MAX_NUMBER_OF_FJT_GOALS];
 extern UINT32 g_actionServer_FJT_SendGoal_Request__sizeof;
+extern UINT32 g_actionServer_FJT_NumberOfGoals;
+extern UINT32 g_actionServer_FJT_MaxNumberOfPoints;
 
 extern void Ros_ActionServer_FJT_Initialize();
 extern void Ros_ActionServer_FJT_Cleanup();
@@ -27,7 +30,7 @@ extern void Ros_ActionServer_FJT_ProcessFeedback();
 extern void Ros_ActionServer_FJT_ProcessResult();
 extern bool Ros_ActionServer_FJT_Goal_Cancel(rclc_action_goal_handle_t* goal_handle, void* context);
 
-extern void Ros_ActionServer_FJT_UpdateProgressTracker(MP_EXPOS_DATA* incrementData);
+extern void Ros_ActionServer_FJT_UpdateProgressTracker(MP_EXPOS_DATA* incrementData, MP_PULSE_POS_RSP_DATA const cmdPulsePos[]);
 
 extern BOOL Ros_MotionControl_AllGroupsInitComplete;
 
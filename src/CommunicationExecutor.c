@@ -203,6 +203,9 @@ void Ros_Communication_PublishActionFeedback(rcl_timer_t* timer, int64_t last_ca
 {
     Ros_ActionServer_FJT_ProcessFeedback();
     Ros_ActionServer_FJT_ProcessResult();
+    Ros_SubscriberQueueTrajPoints_PublishStatus();
+    Ros_IncMoveTiming_Publish();
+    Ros_IncQueueStatus_Publish();
 }
 
 static void Ros_Communication_MonitorUserLanState(rcl_timer_t* timer, int64_t last_call_time)
@@ -346,11 +349,13 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
     motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_TIMER_ADD_USERLAN_MONITOR,
         "Failed adding timer (%d)", (int)rc);
 
+    //NOTE: rclc places the request of each goal handle at (index * size), so the size is that of a single
+    //element of the array (the sequences of the requests live in a separate static buffer)
     rc = rclc_executor_add_action_server(&executor_motion_control,
         &g_actionServerFollowJointTrajectory,
-        1,
-        &g_actionServer_FJT_SendGoal_Request,
-        g_actionServer_FJT_SendGoal_Request__sizeof,
+        g_actionServer_FJT_NumberOfGoals,
+        g_actionServer_FJT_SendGoal_Request,
+        sizeof(g_actionServer_FJT_SendGoal_Request[0]),
         Ros_ActionServer_FJT_Goal_Received,
         Ros_ActionServer_FJT_Goal_Cancel,
         &g_actionServerFollowJointTrajectory);
@@ -376,6 +381,11 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
         &g_messages_StartPointQueueMode.response, Ros_ServiceStartPointQueueMode_Trigger);
     motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SERVICE_START_QUEUE_MODE, "Failed adding service (%d)", (int)rc);
 
+    rc = rclc_executor_add_service(
+        &executor_motion_control, &g_serviceStartRawStreamingMode, &g_messages_StartRawStreamingMode.request,
+        &g_messages_StartRawStreamingMode.response, Ros_ServiceStartRawStreamingMode_Trigger);
+    motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SERVICE_START_RAW_STREAMING_MODE, "Failed adding service (%d)", (int)rc);
+
     rc = rclc_executor_add_service(
         &executor_motion_control, &g_serviceQueueTrajPoint, g_messages_QueueTrajPoint.request,
         g_messages_QueueTrajPoint.response, Ros_ServiceQueueTrajPoint_Trigger);
@@ -386,6 +396,31 @@ void Ros_Communication_StartExecutors(SEM_ID semCommunicationExecutorStatus)
         &g_messages_SelectMotionTool.response, Ros_ServiceSelectMotionTool_Trigger);
     motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SERVICE_SELECT_MOTION_TOOL, "Failed adding service (%d)", (int)rc);
 
+    rc = rclc_executor_add_service(
+        &executor_motion_control, &g_serviceResetIncMoveTiming, &g_messages_ResetIncMoveTiming.request,
+        &g_messages_ResetIncMoveTiming.response, Ros_ServiceResetIncMoveTiming_Trigger);
+    motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SERVICE_RESET_INC_MOVE_TIMING, "Failed adding service (%d)", (int)rc);
+
+    rc = rclc_executor_add_subscription(
+        &executor_motion_control, &g_subscriberSpeedScale, &g_messages_SpeedScale,
+        Ros_SubscriberSpeedScale_Callback, ON_NEW_DATA);
+    motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SUBSCRIBER_SPEED_SCALE, "Failed adding subscriber (%d)", (int)rc);
+
+    rc = rclc_executor_add_subscription(
+        &executor_motion_control, &g_subscriberRawIncrements, &g_messages_RawIncrements,
+        Ros_SubscriberRawIncrements_Callback, ON_NEW_DATA);
+    motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SUBSCRIBER_RAW_INCREMENTS, "Failed adding subscriber (%d)", (int)rc);
+
+    rc = rclc_executor_add_subscription(
+        &executor_motion_control, &g_subscriberQueueTrajPoints, &g_messages_QueueTrajPoints,
+        Ros_SubscriberQueueTrajPoints_Callback, ON_NEW_DATA);
+    motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SUBSCRIBER_QUEUE_TRAJ_POINTS, "Failed adding subscriber (%d)", (int)rc);
+
+    rc = rclc_executor_add_subscription(
+        &executor_motion_control, &g_subscriberQueueCartesianPoints, &g_messages_QueueCartesianPoints,
+        Ros_SubscriberQueueCartesianPoints_Callback, ON_NEW_DATA);
+    motoRos_RCLAssertOK_withMsg(rc, SUBCODE_FAIL_ADD_SUBSCRIBER_QUEUE_CARTESIAN_POINTS, "Failed adding subscriber (%d)", (int)rc);
+
     //==========================================================
     //Add entities to I/O executor
     //
@@ -18,10 +18,16 @@
 //      service reset                                       1
 //      service start_traj_mode                             1
 //      service start_point_queue_mode                      1
+//      service start_raw_streaming_mode                    1
 //      service stop_traj_mode                              1
 //      service queue_traj_point                            1
 //      service select_tool                                 1
-#define QUANTITY_OF_HANDLES_FOR_MOTION_EXECUTOR             (9)
+//      service reset_inc_move_timing                       1
+//      subscriber speed_scale                              1
+//      subscriber raw_increments                           1
+//      subscriber queue_traj_points                        1
+//      subscriber queue_cartesian_points                   1
+#define QUANTITY_OF_HANDLES_FOR_MOTION_EXECUTOR             (15)
 
 // total number of handles =
 //      timers +                                            1
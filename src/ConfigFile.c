@@ -123,6 +123,18 @@ Configuration_Item Ros_ConfigFile_Items[] =
     { "ignore_missing_calib_data", &g_nodeConfigSettings.ignore_missing_calib_data, Value_Bool },
     { "debug_broadcast_enabled", &g_nodeConfigSettings.debug_broadcast_enabled, Value_Bool },
     { "debug_broadcast_port", &g_nodeConfigSettings.debug_broadcast_port, Value_UserLanPort },
+    { "quintic_interpolation", &g_nodeConfigSettings.quintic_interpolation, Value_Bool },
+    { "fixed_point_interpolation", &g_nodeConfigSettings.fixed_point_interpolation, Value_Bool },
+    { "point_queue_depth", &g_nodeConfigSettings.point_queue_depth, Value_Int },
+    { "speed_scale_ramp_time", &g_nodeConfigSettings.speed_scale_ramp_time, Value_Int },
+    { "allow_fjt_goal_replacement", &g_nodeConfigSettings.allow_fjt_goal_replacement, Value_Bool },
+    { "allow_raw_streaming", &g_nodeConfigSettings.allow_raw_streaming, Value_Bool },
+    { "increment_queue_depth_trajectory", &g_nodeConfigSettings.increment_queue_depth_trajectory, Value_Int },
+    { "increment_queue_depth_point_queue", &g_nodeConfigSettings.increment_queue_depth_point_queue, Value_Int },
+    { "increment_queue_depth_raw_streaming", &g_nodeConfigSettings.increment_queue_depth_raw_streaming, Value_Int },
+    { "adaptive_increment_queue_depth", &g_nodeConfigSettings.adaptive_increment_queue_depth, Value_Bool },
+    { "precompile_trajectories", &g_nodeConfigSettings.precompile_trajectories, Value_Bool },
+    { "path_tolerance_servo_lag", &g_nodeConfigSettings.path_tolerance_servo_lag, Value_Int },
 };
 
 void Ros_ConfigFile_SetAllDefaultValues()
@@ -223,6 +235,39 @@ void Ros_ConfigFile_SetAllDefaultValues()
 
     //ignore_missing_calib_data
     g_nodeConfigSettings.ignore_missing_calib_data = DEFAULT_IGNORE_MISSING_CALIB;
+
+    //quintic_interpolation
+    g_nodeConfigSettings.quintic_interpolation = DEFAULT_QUINTIC_INTERPOLATION;
+
+    //fixed_point_interpolation
+    g_nodeConfigSettings.fixed_point_interpolation = DEFAULT_FIXED_POINT_INTERPOLATION;
+
+    //point_queue_depth
+    g_nodeConfigSettings.point_queue_depth = DEFAULT_POINT_QUEUE_DEPTH;
+
+    //speed_scale_ramp_time
+    g_nodeConfigSettings.speed_scale_ramp_time = DEFAULT_SPEED_SCALE_RAMP_TIME;
+
+    //allow_fjt_goal_replacement
+    g_nodeConfigSettings.allow_fjt_goal_replacement = DEFAULT_ALLOW_FJT_GOAL_REPLACEMENT;
+
+    //allow_raw_streaming
+    g_nodeConfigSettings.allow_raw_streaming = DEFAULT_ALLOW_RAW_STREAMING;
+
+    //increment_queue_depth_*
+    g_nodeConfigSettings.increment_queue_depth_trajectory = DEFAULT_INCREMENT_QUEUE_DEPTH;
+    g_nodeConfigSettings.increment_queue_depth_point_queue = DEFAULT_INCREMENT_QUEUE_DEPTH;
+    g_nodeConfigSettings.increment_queue_depth_raw_streaming = DEFAULT_INCREMENT_QUEUE_DEPTH;
+
+    //adaptive_increment_queue_depth
+    g_nodeConfigSettings.adaptive_increment_queue_depth = DEFAULT_ADAPTIVE_INCREMENT_QUEUE_DEPTH;
+
+    //=========
+    //precompile_trajectories
+    g_nodeConfigSettings.precompile_trajectories = DEFAULT_PRECOMPILE_TRAJECTORIES;
+
+    //path_tolerance_servo_lag
+    g_nodeConfigSettings.path_tolerance_servo_lag = DEFAULT_PATH_TOLERANCE_SERVO_LAG;
 }
 
 void Ros_ConfigFile_CheckYamlEvent(yaml_event_t* event)
@@ -631,6 +676,66 @@ void Ros_ConfigFile_ValidateNonCriticalSettings()
         g_nodeConfigSettings.controller_status_monitor_period = DEFAULT_CONTROLLER_IO_PERIOD;
     }
 
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.point_queue_depth < MIN_POINT_QUEUE_DEPTH ||
+        g_nodeConfigSettings.point_queue_depth > MAX_POINT_QUEUE_DEPTH)
+    {
+        Ros_Debug_BroadcastMsg("point_queue_depth value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.point_queue_depth, DEFAULT_POINT_QUEUE_DEPTH);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid point_queue_depth", SUBCODE_CONFIGURATION_INVALID_POINT_QUEUE_DEPTH);
+
+        g_nodeConfigSettings.point_queue_depth = DEFAULT_POINT_QUEUE_DEPTH;
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.speed_scale_ramp_time < MIN_SPEED_SCALE_RAMP_TIME ||
+        g_nodeConfigSettings.speed_scale_ramp_time > MAX_SPEED_SCALE_RAMP_TIME)
+    {
+        Ros_Debug_BroadcastMsg("speed_scale_ramp_time value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.speed_scale_ramp_time, DEFAULT_SPEED_SCALE_RAMP_TIME);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid speed_scale_ramp_time", SUBCODE_CONFIGURATION_INVALID_SPEED_SCALE_RAMP_TIME);
+
+        g_nodeConfigSettings.speed_scale_ramp_time = DEFAULT_SPEED_SCALE_RAMP_TIME;
+    }
+
+    //-----------------------------------------------------------------------------
+    struct
+    {
+        char const* name;
+        int* value;
+    } incQueueDepths[] = {
+        { "increment_queue_depth_trajectory", &g_nodeConfigSettings.increment_queue_depth_trajectory },
+        { "increment_queue_depth_point_queue", &g_nodeConfigSettings.increment_queue_depth_point_queue },
+        { "increment_queue_depth_raw_streaming", &g_nodeConfigSettings.increment_queue_depth_raw_streaming },
+    };
+    for (int i = 0; i < (int)(sizeof(incQueueDepths) / sizeof(incQueueDepths[0])); i += 1)
+    {
+        if (*incQueueDepths[i].value < MIN_INCREMENT_QUEUE_DEPTH ||
+            *incQueueDepths[i].value > MAX_INCREMENT_QUEUE_DEPTH)
+        {
+            Ros_Debug_BroadcastMsg("%s value %d is invalid; reverting to default of %d",
+                incQueueDepths[i].name, *incQueueDepths[i].value, DEFAULT_INCREMENT_QUEUE_DEPTH);
+
+            mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid increment_queue_depth", SUBCODE_CONFIGURATION_INVALID_INCREMENT_QUEUE_DEPTH);
+
+            *incQueueDepths[i].value = DEFAULT_INCREMENT_QUEUE_DEPTH;
+        }
+    }
+
+    //-----------------------------------------------------------------------------
+    if (g_nodeConfigSettings.path_tolerance_servo_lag < MIN_PATH_TOLERANCE_SERVO_LAG ||
+        g_nodeConfigSettings.path_tolerance_servo_lag > MAX_PATH_TOLERANCE_SERVO_LAG)
+    {
+        Ros_Debug_BroadcastMsg("path_tolerance_servo_lag value %d is invalid; reverting to default of %d",
+            g_nodeConfigSettings.path_tolerance_servo_lag, DEFAULT_PATH_TOLERANCE_SERVO_LAG);
+
+        mpSetAlarm(ALARM_CONFIGURATION_FAIL, "Invalid path_tolerance_servo_lag", SUBCODE_CONFIGURATION_INVALID_PATH_TOLERANCE_SERVO_LAG);
+
+        g_nodeConfigSettings.path_tolerance_servo_lag = DEFAULT_PATH_TOLERANCE_SERVO_LAG;
+    }
+
     //-----------------------------------------------------------------------------
     if (g_nodeConfigSettings.userlan_monitor_enabled)
     {
@@ -743,6 +848,18 @@ void Ros_ConfigFile_PrintActiveConfiguration(Ros_Configuration_Settings const* c
     Ros_Debug_BroadcastMsg("Config: ignore_missing_calib_data = %d", config->ignore_missing_calib_data);
     Ros_Debug_BroadcastMsg("Config: debug_broadcast_enabled = %d", config->debug_broadcast_enabled);
     Ros_Debug_BroadcastMsg("Config: debug_broadcast_port = %d", config->debug_broadcast_port);
+    Ros_Debug_BroadcastMsg("Config: quintic_interpolation = %d", config->quintic_interpolation);
+    Ros_Debug_BroadcastMsg("Config: fixed_point_interpolation = %d", config->fixed_point_interpolation);
+    Ros_Debug_BroadcastMsg("Config: point_queue_depth = %d", config->point_queue_depth);
+    Ros_Debug_BroadcastMsg("Config: speed_scale_ramp_time = %d", config->speed_scale_ramp_time);
+    Ros_Debug_BroadcastMsg("Config: allow_fjt_goal_replacement = %d", config->allow_fjt_goal_replacement);
+    Ros_Debug_BroadcastMsg("Config: allow_raw_streaming = %d", config->allow_raw_streaming);
+    Ros_Debug_BroadcastMsg("Config: increment_queue_depth_trajectory = %d", config->increment_queue_depth_trajectory);
+    Ros_Debug_BroadcastMsg("Config: increment_queue_depth_point_queue = %d", config->increment_queue_depth_point_queue);
+    Ros_Debug_BroadcastMsg("Config: increment_queue_depth_raw_streaming = %d", config->increment_queue_depth_raw_streaming);
+    Ros_Debug_BroadcastMsg("Config: adaptive_increment_queue_depth = %d", config->adaptive_increment_queue_depth);
+    Ros_Debug_BroadcastMsg("Config: precompile_trajectories = %d", config->precompile_trajectories);
+    Ros_Debug_BroadcastMsg("Config: path_tolerance_servo_lag = %d", config->path_tolerance_servo_lag);
 }
 
 void Ros_ConfigFile_Parse()
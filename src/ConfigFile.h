@@ -102,6 +102,34 @@ typedef enum
 
 #define DEFAULT_IGNORE_MISSING_CALIB            FALSE
 
+#define DEFAULT_QUINTIC_INTERPOLATION           FALSE
+
+#define DEFAULT_FIXED_POINT_INTERPOLATION       FALSE
+
+#define DEFAULT_POINT_QUEUE_DEPTH       1
+#define MIN_POINT_QUEUE_DEPTH           1
+#define MAX_POINT_QUEUE_DEPTH           (TRAJECTORY_WINDOW_SIZE - 1) //one entry of the window holds the start of the active segment
+
+#define DEFAULT_SPEED_SCALE_RAMP_TIME   500     //ms
+#define MIN_SPEED_SCALE_RAMP_TIME       10      //ms
+#define MAX_SPEED_SCALE_RAMP_TIME       10000   //ms
+
+#define DEFAULT_ALLOW_FJT_GOAL_REPLACEMENT      FALSE
+
+#define DEFAULT_ALLOW_RAW_STREAMING             FALSE
+
+#define DEFAULT_INCREMENT_QUEUE_DEPTH   200     //interpolation cycles
+#define MIN_INCREMENT_QUEUE_DEPTH       10
+#define MAX_INCREMENT_QUEUE_DEPTH       Q_SIZE
+
+#define DEFAULT_ADAPTIVE_INCREMENT_QUEUE_DEPTH  FALSE
+
+#define DEFAULT_PRECOMPILE_TRAJECTORIES         FALSE
+
+#define DEFAULT_PATH_TOLERANCE_SERVO_LAG        16      //ms
+#define MIN_PATH_TOLERANCE_SERVO_LAG            0       //ms
+#define MAX_PATH_TOLERANCE_SERVO_LAG            200     //ms
+
 #define DEFAULT_ULAN_DEBUG_BROADCAST_ENABLED     TRUE
 
 #if defined (YRC1000)
@@ -152,6 +180,27 @@ typedef struct
 
     BOOL ignore_missing_calib_data;
 
+    BOOL quintic_interpolation;
+
+    BOOL fixed_point_interpolation;
+
+    int point_queue_depth;
+
+    int speed_scale_ramp_time;
+
+    BOOL allow_fjt_goal_replacement;
+
+    BOOL allow_raw_streaming;
+
+    int increment_queue_depth_trajectory;
+    int increment_queue_depth_point_queue;
+    int increment_queue_depth_raw_streaming;
+    BOOL adaptive_increment_queue_depth;
+
+    BOOL precompile_trajectories;
+
+    int path_tolerance_servo_lag;
+
     BOOL debug_broadcast_enabled;
     Ros_UserLan_Port_Setting debug_broadcast_port;
 } Ros_Configuration_Settings;
@@ -122,6 +122,13 @@ BOOL Ros_Controller_Initialize()
             g_Ros_Controller.ctrlGroups[groupIndex] = NULL;
     }
 
+    //one frame of the increment queue holds the increments of all groups
+    if (!Ros_Controller_IncQ_Init(&g_Ros_Controller.incQueue, g_Ros_Controller.numGroup))
+        bInitOk = FALSE;
+
+    //the joint names are final now, so they can be indexed for fast lookups
+    Ros_Controller_BuildJointNameLookup(&g_Ros_Controller);
+
     //get the robot calibration data for multi-robot systems
     const BOOL bCalibLoadedOk = Ros_Controller_LoadGroupCalibrationData(&g_Ros_Controller);
     //see whether the user should be notified about failures (it's OK to not
@@ -227,6 +234,72 @@ BOOL Ros_Controller_Initialize()
     return bInitOk;
 }
 
+//-------------------------------------------------------------------
+// Build a table of the joint names of all groups, sorted by name,
+// so a joint can be found with a binary search instead of comparing
+// against the name of every axis of every group.
+//-------------------------------------------------------------------
+void Ros_Controller_BuildJointNameLookup(Controller* const controller)
+{
+    controller->jointNameLookupCount = 0;
+
+    for (int groupIndex = 0; groupIndex < controller->numGroup; groupIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = controller->ctrlGroups[groupIndex];
+        if (ctrlGroup == NULL)
+            continue;
+
+        for (int jointIndex = 0; jointIndex < MP_GRP_AXES_NUM; jointIndex += 1)
+        {
+            char const* name = ctrlGroup->jointNames_userDefined[jointIndex];
+            if (strlen(name) == 0)
+                continue;
+
+            //insertion sort: there are at most MAX_CONTROLLABLE_AXES entries
+            int i = controller->jointNameLookupCount;
+            while (i > 0 && strcmp(controller->jointNameLookup[i - 1].name, name) > 0)
+            {
+                controller->jointNameLookup[i] = controller->jointNameLookup[i - 1];
+                i -= 1;
+            }
+
+            controller->jointNameLookup[i].name = name;
+            controller->jointNameLookup[i].groupIndex = (UINT8)groupIndex;
+            controller->jointNameLookup[i].jointIndex = (UINT8)jointIndex;
+            controller->jointNameLookupCount += 1;
+        }
+    }
+}
+
+//-------------------------------------------------------------------
+// Find the group and the joint index (moto order) of a joint name
+// using the table built by Ros_Controller_BuildJointNameLookup.
+//-------------------------------------------------------------------
+BOOL Ros_Controller_LookupJointName(Controller const* controller, char const* name, int* group_idx, int* joint_idx)
+{
+    int low = 0;
+    int high = controller->jointNameLookupCount - 1;
+
+    while (low <= high)
+    {
+        int mid = (low + high) / 2;
+        int cmp = strcmp(name, controller->jointNameLookup[mid].name);
+
+        if (cmp == 0)
+        {
+            *group_idx = controller->jointNameLookup[mid].groupIndex;
+            *joint_idx = controller->jointNameLookup[mid].jointIndex;
+            return TRUE;
+        }
+        else if (cmp < 0)
+            high = mid - 1;
+        else
+            low = mid + 1;
+    }
+
+    return FALSE;
+}
+
 void Ros_Controller_Cleanup()
 {
     rcl_ret_t ret;
@@ -250,6 +323,8 @@ void Ros_Controller_Cleanup()
     mpDeleteTask(g_Ros_Controller.tidIncMoveThread);
     g_Ros_Controller.tidIncMoveThread = INVALID_TASK;
 
+    Ros_Controller_IncQ_Cleanup(&g_Ros_Controller.incQueue);
+
     Ros_Debug_BroadcastMsg("Cleanup publisher robot status");
     ret = rcl_publisher_fini(&g_publishers_RobotStatus.robotStatus, &g_microRosNodeInfo.node);
     if (ret != RCL_RET_OK)
@@ -866,3 +941,148 @@ BOOL Ros_Controller_ShouldWarnNoCalibDataLoaded(Controller const* controller, BO
         TRUE  == bPublishTfEnabled &&
         FALSE == bCalibLoadedOk);
 }
+
+//-------------------------------------------------------------------
+// Allocate the frames of the increment queue for numGroup groups
+//-------------------------------------------------------------------
+BOOL Ros_Controller_IncQ_Init(Incremental_q* q, int numGroup)
+{
+    bzero(q, sizeof(Incremental_q));
+
+    q->numGroup = numGroup;
+    q->data = (Incremental_data*)mpMalloc(sizeof(Incremental_data) * Q_RING_LEN * numGroup);
+    if (q->data == NULL)
+        return FALSE;
+
+    bzero(q->data, sizeof(Incremental_data) * Q_RING_LEN * numGroup);
+    return TRUE;
+}
+
+void Ros_Controller_IncQ_Cleanup(Incremental_q* q)
+{
+    if (q->data != NULL)
+        mpFree(q->data);
+    q->data = NULL;
+    q->numGroup = 0;
+}
+
+//-------------------------------------------------------------------
+// Get the number of frames a group has written which haven't been
+// read yet. A group may be behind the tail after the queue was
+// cleared, in which case it has no frames in the queue.
+//-------------------------------------------------------------------
+int Ros_Controller_IncQ_Count(Incremental_q const* q, int groupIndex)
+{
+    INT32 count = (INT32)(q->head[groupIndex] - q->tail);
+
+    return (count > 0) ? count : 0;
+}
+
+//-------------------------------------------------------------------
+// Get the number of frames which have been written by all groups
+// and can be read by the consumer
+//-------------------------------------------------------------------
+int Ros_Controller_IncQ_FrameCount(Incremental_q const* q)
+{
+    int frameCount = (q->numGroup > 0) ? Q_SIZE : 0;
+
+    for (int groupIndex = 0; groupIndex < q->numGroup; groupIndex += 1)
+    {
+        int count = Ros_Controller_IncQ_Count(q, groupIndex);
+        if (count < frameCount)
+            frameCount = count;
+    }
+
+    return frameCount;
+}
+
+//-------------------------------------------------------------------
+// Write the increments of one group into the next frame of that group.
+// Returns FALSE if the queue is full. (Producer side only)
+//-------------------------------------------------------------------
+BOOL Ros_Controller_IncQ_Push(Incremental_q* q, int groupIndex, Incremental_data const* dataToEnQ)
+{
+    UINT32 head = q->head[groupIndex];
+    UINT32 tail = q->tail;
+
+    if ((INT32)(head - tail) < 0) //queue was cleared, continue at the first frame which will be read
+        head = tail;
+
+    if ((INT32)(head - tail) >= Q_SIZE) //queue is full
+        return FALSE;
+
+    // The increments must be completely written before the frame is published to the consumer
+    Q_MEMORY_BARRIER();
+    q->data[(head % Q_RING_LEN) * q->numGroup + groupIndex] = *dataToEnQ;
+    Q_MEMORY_BARRIER();
+    q->head[groupIndex] = head + 1;
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Get the increments of all groups in a frame (indexed by group)
+//-------------------------------------------------------------------
+Incremental_data const* Ros_Controller_IncQ_Frame(Incremental_q const* q, UINT32 sequence)
+{
+    return &q->data[(sequence % Q_RING_LEN) * q->numGroup];
+}
+
+//-------------------------------------------------------------------
+// Release a frame which has been read by the consumer. Returns FALSE
+// if the queue was cleared while the frame was being read, in which
+// case the data must be discarded. (Consumer side only)
+//-------------------------------------------------------------------
+BOOL Ros_Controller_IncQ_Release(Incremental_q* q, UINT32 sequence)
+{
+    Q_MEMORY_BARRIER();
+    return __sync_bool_compare_and_swap(&q->tail, sequence, sequence + 1);
+}
+
+//-------------------------------------------------------------------
+// Discard all frames in the queue. No need to delete the data.
+//-------------------------------------------------------------------
+void Ros_Controller_IncQ_Clear(Incremental_q* q)
+{
+    UINT32 tail;
+    UINT32 newTail;
+
+    // compare-and-swap, so a frame which is released by the consumer
+    // at the same time can't put back the data which was just cleared
+    do
+    {
+        tail = q->tail;
+
+        //skip past the group which is furthest ahead
+        newTail = tail;
+        for (int groupIndex = 0; groupIndex < q->numGroup; groupIndex += 1)
+        {
+            if ((INT32)(q->head[groupIndex] - newTail) > 0)
+                newTail = q->head[groupIndex];
+        }
+    } while (!__sync_bool_compare_and_swap(&q->tail, tail, newTail));
+}
+
+//-------------------------------------------------------------------
+// Discard the frames which have not been written by all groups, so
+// every group continues at the same frame. The complete frames are
+// kept. (Only while none of the producers is writing)
+//-------------------------------------------------------------------
+void Ros_Controller_IncQ_Resync(Incremental_q* q)
+{
+    UINT32 minHead;
+
+    if (q->numGroup <= 0)
+        return;
+
+    minHead = q->head[0];
+    for (int groupIndex = 1; groupIndex < q->numGroup; groupIndex += 1)
+    {
+        if ((INT32)(q->head[groupIndex] - minHead) < 0)
+            minHead = q->head[groupIndex];
+    }
+
+    //(a head which ends up behind the tail continues at the tail, see Ros_Controller_IncQ_Push)
+    for (int groupIndex = 0; groupIndex < q->numGroup; groupIndex += 1)
+        q->head[groupIndex] = minHead;
+}
@@ -29,6 +29,7 @@
 #define INVALID_TASK                        -1
 
 #define MAX_CONTROLLABLE_GROUPS             8
+#define MAX_CONTROLLABLE_AXES               (MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM)
 
 #define MASK_ISALARM_ACTIVEALARM            0x02
 #define MASK_ISALARM_ACTIVEERROR            0x01
@@ -67,6 +68,35 @@ typedef enum
     IO_ROBOTSTATUS_MAX
 } IoStatusIndex;
 
+// The increment queue is a ring buffer of frames. Each frame holds the increments of all groups
+// for one interpolation period, so the IncMoveTask moves all groups from the same frame. Each
+// group has its own producer (the AddToIncQueue task of the group), which writes the group's
+// part of the frames and advances the group's head. A frame can only be read once every group
+// has written it. The queue is accessed without a lock: head and tail are free-running sequence
+// numbers, and a frame is stored at slot (sequence % Q_RING_LEN). The accesses are ordered with
+// Q_MEMORY_BARRIER.
+
+// Orders the accesses to data which is shared between tasks without a lock (the increment queue
+// and the sequence-numbered snapshots). The controller CPU (x86) does not reorder stores with
+// other stores or loads with other loads, so it is sufficient to prevent the compiler from
+// reordering the accesses.
+#define Q_MEMORY_BARRIER() __asm__ __volatile__("" : : : "memory")
+
+typedef struct
+{
+    volatile UINT32 head[MAX_CONTROLLABLE_GROUPS];  // sequence number of the next frame to write, per group (only modified by the producer of the group)
+    volatile UINT32 tail;                           // sequence number of the next frame to read (modified by the consumer and by Ros_Controller_IncQ_Clear)
+    int numGroup;                                   // number of groups in each frame
+    Incremental_data* data;                         // Q_RING_LEN frames of numGroup increments each
+} Incremental_q;
+
+typedef struct
+{
+    char const* name;                                       // Points to the name in CtrlGroup::jointNames_userDefined
+    UINT8 groupIndex;                                       // Index of the group in Controller::ctrlGroups
+    UINT8 jointIndex;                                       // Index of the joint in the group (moto order)
+} JointNameLookupEntry;
+
 typedef struct
 {
     UINT16 interpolPeriod;                                  // Interpolation period of the controller
@@ -74,6 +104,8 @@ typedef struct
     //int numRobot;                                         // Actual number of defined robot
     int totalAxesCount;                                     // Number of axes attached to the controller (all groups)
     CtrlGroup* ctrlGroups[MAX_CONTROLLABLE_GROUPS];         // Array of the controller control group
+    JointNameLookupEntry jointNameLookup[MAX_CONTROLLABLE_AXES]; // Joint names of all groups, sorted by name
+    int jointNameLookupCount;                               // Number of valid entries in jointNameLookup
 
     UINT8 rosTrafficLanPort;
     UCHAR rosTrafficMacAddr[6];
@@ -88,6 +120,7 @@ typedef struct
     BOOL bMpIncMoveError;                                   // Flag indicating that the incremental motion API failed
     BOOL bPrevAlarmState;                                   // Flag indicating if there was an active ALARM during the last I/O cycle
 
+    Incremental_q incQueue;                                 // Increments for each interpolation period of all groups (Ros_Controller_IncQ_*)
     int tidIncMoveThread;                                   // ThreadId for sending the incremental move to the controller
 } Controller;
 
@@ -110,6 +143,9 @@ extern void Ros_Controller_Cleanup();
 
 extern BOOL Ros_Controller_IsValidGroupNo(int groupNo);
 
+extern void Ros_Controller_BuildJointNameLookup(Controller* const controller);
+extern BOOL Ros_Controller_LookupJointName(Controller const* controller, char const* name, int* group_idx, int* joint_idx);
+
 extern void Ros_Controller_StatusInit();
 extern BOOL Ros_Controller_StatusRead(USHORT ioStatus[IO_ROBOTSTATUS_MAX]);
 extern BOOL Ros_Controller_IoStatusUpdate();
@@ -148,6 +184,19 @@ extern int Ros_Controller_GetAlarmCode();
 //retrieve all active alarms (and a possible error) and store them in 'active_alarms'
 extern int Ros_Controller_GetActiveAlarmCodes(USHORT active_alarms[MAX_ALARM_COUNT + MAX_ERROR_COUNT]);
 
+//Lock-free access to the increment queue. Push may only be called by the producer of the group and
+//Release only by the consumer. Count, FrameCount and Clear may be called from any task,
+//Resync only while none of the producers is writing.
+extern BOOL Ros_Controller_IncQ_Init(Incremental_q* q, int numGroup);
+extern void Ros_Controller_IncQ_Cleanup(Incremental_q* q);
+extern int Ros_Controller_IncQ_Count(Incremental_q const* q, int groupIndex);
+extern int Ros_Controller_IncQ_FrameCount(Incremental_q const* q);
+extern BOOL Ros_Controller_IncQ_Push(Incremental_q* q, int groupIndex, Incremental_data const* dataToEnQ);
+extern Incremental_data const* Ros_Controller_IncQ_Frame(Incremental_q const* q, UINT32 sequence);
+extern BOOL Ros_Controller_IncQ_Release(Incremental_q* q, UINT32 sequence);
+extern void Ros_Controller_IncQ_Clear(Incremental_q* q);
+extern void Ros_Controller_IncQ_Resync(Incremental_q* q);
+
 //TODO(gavanderhoorn): make static, see comment on definition
 extern BOOL Ros_Controller_ShouldWarnNoCalibDataLoaded(Controller const* controller, BOOL bCalibLoadedOk, BOOL bPublishTfEnabled);
 
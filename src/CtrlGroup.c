@@ -162,8 +162,11 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupIndex, BOOL bIsLastGrpToInit, float int
                 ctrlGroup->axisType.type[i] = AXIS_INVALID;
         }
 
-        bzero(&ctrlGroup->inc_q, sizeof(Incremental_q));
-        ctrlGroup->inc_q.q_lock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+        Ros_CtrlGroup_InitJointTransform(ctrlGroup);
+
+        ctrlGroup->incQueueDepth = g_nodeConfigSettings.increment_queue_depth_trajectory; //until a motion mode is started
+        ctrlGroup->incQueueRefillWait = -1;
+        ctrlGroup->incQueueStats.minFill = -1;
 
         // Calculate maximum speed in radian per second
         bzero(maxSpeedPulse, sizeof(maxSpeedPulse));
@@ -225,6 +228,7 @@ CtrlGroup* Ros_CtrlGroup_Create(int groupIndex, BOOL bIsLastGrpToInit, float int
     if (ctrlGroup)
     {
         ctrlGroup->hasDataToProcess = FALSE;
+        ctrlGroup->semAddToIncQueue = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
 
         Ros_Debug_BroadcastMsg("Creating new task: Add To Inc Q (Group %d)", groupIndex + 1);
 
@@ -250,7 +254,8 @@ void Ros_CtrlGrp_Cleanup(CtrlGroup* ctrlGroup)
     mpDeleteTask(ctrlGroup->tidAddToIncQueue);
     ctrlGroup->tidAddToIncQueue = INVALID_TASK;
 
-    mpSemDelete(ctrlGroup->inc_q.q_lock);
+    mpSemDelete(ctrlGroup->semAddToIncQueue);
+    ctrlGroup->semAddToIncQueue = NULL;
 }
 
 
@@ -312,19 +317,27 @@ BOOL Ros_CtrlGroup_GetPulsePosCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_
     // For MPL80/100 robot type (SLUBT): Controller automatically moves the B-axis
     // to maintain orientation as other axes are moved.
     if (ctrlGroup->bIsBaxisSlave)
-    {
-        //temporary storage for B axis compensation
-        double rosAnglePos[MP_GRP_AXES_NUM];
-
-        //B axis compensation works on the ROS ANGLE positions, not on MOTO PULSE positions
-        Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, pulsePos, rosAnglePos);
-        rosAnglePos[3] += -rosAnglePos[1] + rosAnglePos[2];
-        Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(ctrlGroup, rosAnglePos, pulsePos);
-    }
+        Ros_CtrlGroup_CompensateBaxisSlave(ctrlGroup, pulsePos);
 
     return TRUE;
 }
 
+//-------------------------------------------------------------------
+// Add the motion of the L and U axes to the commanded pulse position
+// of the B axis of a robot with a slaved B axis (bIsBaxisSlave)
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_CompensateBaxisSlave(CtrlGroup const* ctrlGroup, long pulsePos[MAX_PULSE_AXES])
+{
+    //B axis compensation works on the ROS ANGLE positions, not on MOTO PULSE positions.
+    //Only the B axis (ROS joint 3) changes, so the other axes aren't converted back and forth.
+    JointTransform const* transform = &ctrlGroup->jointTransform;
+    int axisB = transform->toRosIndex[3];
+    double rosAngleB = pulsePos[axisB] / transform->toRosDivisor[3];
+
+    rosAngleB += -(pulsePos[transform->toRosIndex[1]] / transform->toRosDivisor[1]) + (pulsePos[transform->toRosIndex[2]] / transform->toRosDivisor[2]);
+    pulsePos[axisB] = (int)(rosAngleB * transform->toMotoFactor[axisB]);
+}
+
 
 //-------------------------------------------------------------------
 // Get the corrected feedback pulse position in pulse.
@@ -518,39 +531,6 @@ BOOL Ros_CtrlGroup_GetEncoderTemperature(CtrlGroup const* const ctrlGroup, long
     return TRUE;
 }
 
-//Convert the Motoman position units (pulses) to ROS position units (radians/meters).
-//This function must be called BEFORE calling Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder.
-//The joints must be in Motoman (non-sequential) ordering.
-void Ros_CtrlGroup_ConvertMotoUnitsToRosUnits(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
-{
-    int i;
-    double conversion = 1;
-
-    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
-
-    //Delta: (SLU--T-) All rotary axes
-    //Scara: (SLUR---) U-axis is linear
-    //Large Palletizing: (SLU--T-) All rotary axes
-    //High Speed Picking: (SLU-BT-) All rotary axes
-    for (i = 0; i < MAX_PULSE_AXES; i += 1)
-    {
-        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
-        {
-            continue;
-        }
-
-        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
-            conversion = ctrlGroup->pulseToRad.PtoR[i];
-        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
-            conversion = ctrlGroup->pulseToMeter.PtoM[i];
-        else
-            conversion = 1.0;
-
-        rosPos[i] = motopulsePos[i] / conversion;
-    }
-
-}
-
 void Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(CtrlGroup* ctrlGroup, double const motoPos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
 {
     int i;
@@ -606,12 +586,10 @@ void Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(CtrlGroup* ctrlGr
 //-------------------------------------------------------------------
 void Ros_CtrlGroup_ConvertToRosPos(CtrlGroup* ctrlGroup, long const motopulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
 {
-    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
-
-    //call this first, due to expected joint ordering 
-    Ros_CtrlGroup_ConvertMotoUnitsToRosUnits(ctrlGroup, motopulsePos, rosUnitsWithMotoOrder);
+    JointTransform const* transform = &ctrlGroup->jointTransform;
 
-    Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(ctrlGroup, rosUnitsWithMotoOrder, rosPos);
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+        rosPos[i] = (motopulsePos[transform->toRosIndex[i]] * transform->toRosMask[i]) / transform->toRosDivisor[i];
 }
 
 // Convert Motoman torque to ROS torque by re-ordering the joints
@@ -626,30 +604,9 @@ void Ros_CtrlGroup_ConvertToRosTorque(CtrlGroup* ctrlGroup, double const motoTor
 //The joints must be in Motoman (non-sequential) ordering.
 void Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES])
 {
-    double conversion = 1;
-
-    bzero(motopulsePos, sizeof(long) * MAX_PULSE_AXES);
-
-    //Delta: (SLU--T-) All rotary axes
-    //Scara: (SLUR---) U-axis is linear
-    //Large Palletizing: (SLU--T-) All rotary axes
-    //High Speed Picking: (SLU-BT-) All rotary axes
+    //invalid axes have a factor of 0.0
     for (int i = 0; i < MAX_PULSE_AXES; i += 1)
-    {
-        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
-        {
-            continue;
-        }
-
-        if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
-            conversion = ctrlGroup->pulseToRad.PtoR[i];
-        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
-            conversion = ctrlGroup->pulseToMeter.PtoM[i];
-        else
-            conversion = 1.0;
-
-        motopulsePos[i] = (int)(rosPos[i] * conversion);
-    }
+        motopulsePos[i] = (int)(rosPos[i] * ctrlGroup->jointTransform.toMotoFactor[i]);
 }
 
 void Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], double motoPos[MAX_PULSE_AXES])
@@ -711,12 +668,73 @@ void Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(CtrlGroup* ctrlGr
 //-------------------------------------------------------------------
 void Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(CtrlGroup* ctrlGroup, double const radPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES])
 {
-    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+    JointTransform const* transform = &ctrlGroup->jointTransform;
+
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+        motopulsePos[i] = (int)(radPos[transform->toMotoIndex[i]] * transform->toMotoFactor[i]);
+}
+
+//-------------------------------------------------------------------
+// Precompute the conversion between ROS joints and pulses of a group
+// (see JointTransform). Must be called once the axis types and the
+// conversion ratios of the group are known. The joint reordering is
+// taken from Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder
+// (and the reverse), by reordering joint numbers instead of positions.
+//-------------------------------------------------------------------
+void Ros_CtrlGroup_InitJointTransform(CtrlGroup* ctrlGroup)
+{
+    JointTransform* transform = &ctrlGroup->jointTransform;
+    double jointNumbers[MAX_PULSE_AXES];
+    double reordered[MAX_PULSE_AXES];
+    double pulsesPerUnit[MAX_PULSE_AXES];
+    int i, index;
+
+    //Delta: (SLU--T-) All rotary axes
+    //Scara: (SLUR---) U-axis is linear
+    //Large Palletizing: (SLU--T-) All rotary axes
+    //High Speed Picking: (SLU-BT-) All rotary axes
+    for (i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
+            pulsesPerUnit[i] = 0.0;
+        else if (ctrlGroup->axisType.type[i] == AXIS_ROTATION)
+            pulsesPerUnit[i] = ctrlGroup->pulseToRad.PtoR[i];
+        else if (ctrlGroup->axisType.type[i] == AXIS_LINEAR)
+            pulsesPerUnit[i] = ctrlGroup->pulseToMeter.PtoM[i];
+        else
+            pulsesPerUnit[i] = 1.0;
 
-    Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(ctrlGroup, radPos, rosUnitsWithMotoOrder);
+        jointNumbers[i] = i + 1; //0 marks an entry which isn't used after reordering
+    }
+
+    //ROS joint of each moto axis
+    Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(ctrlGroup, jointNumbers, reordered);
+    for (i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        index = (int)reordered[i] - 1;
+        transform->toMotoIndex[i] = (index >= 0) ? index : 0;
+        transform->toMotoFactor[i] = (index >= 0) ? pulsesPerUnit[i] : 0.0;
+    }
 
-    //must call this after Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder due to expected joint ordering
-    Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, rosUnitsWithMotoOrder, motopulsePos);
+    //moto axis of each ROS joint
+    bzero(reordered, sizeof(reordered)); //entries of unused joints are left untouched
+    Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(ctrlGroup, jointNumbers, reordered);
+    for (i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        index = (int)reordered[i] - 1;
+        if (index >= 0 && pulsesPerUnit[index] != 0.0)
+        {
+            transform->toRosIndex[i] = index;
+            transform->toRosMask[i] = 1.0;
+            transform->toRosDivisor[i] = pulsesPerUnit[index];
+        }
+        else
+        {
+            transform->toRosIndex[i] = 0;
+            transform->toRosMask[i] = 0.0;
+            transform->toRosDivisor[i] = 1.0;
+        }
+    }
 }
 
 //-------------------------------------------------------------------
@@ -8,19 +8,14 @@
 #ifndef MOTOROS2_CTRL_GROUP_H
 #define MOTOROS2_CTRL_GROUP_H
 
-
-#define Q_SIZE 200
-
-#if (DX100 || DX200 || FS100)
-#define Q_LOCK_TIMEOUT 1000
-#else
-#define Q_LOCK_TIMEOUT 5000  //YRC1000 tick period is 0.2 ms
-#endif
-
-#define Q_OFFSET_IDX( a, b, c ) (((a)+(b)) >= (c) ) ? ((a)+(b)-(c)) \
-                : ( (((a)+(b)) < 0 ) ? ((a)+(b)+(c)) : ((a)+(b)) )
+// The increment queue is accessed without a lock, see Incremental_q and Q_MEMORY_BARRIER in ControllerStatusIO.h
+#define Q_SIZE 500                  // capacity of the queue in frames (upper limit of the configurable depth)
+#define Q_RING_LEN 512              // frames in the ring buffer. Must be a power of two (and larger than Q_SIZE), so the sequence numbers can wrap around.
+#define Q_HIGH_WATERMARK(grp) ((grp)->incQueueDepth)       // the producer of a group stops adding increments once the queue holds this many for the group
+#define Q_LOW_WATERMARK(grp) ((grp)->incQueueDepth / 2)    // the consumer wakes the producer once the queue is drained down to this many
 
 #define MAX_JOINT_NAME_LENGTH               32
+#define TRAJECTORY_WINDOW_SIZE              16  // number of trajectory points converted ahead of the increment generator
 #define MAX_TF_FRAME_NAME_LENGTH            96
 
 typedef struct
@@ -32,14 +27,6 @@ typedef struct
     LONG inc[MP_GRP_AXES_NUM];
 } Incremental_data;
 
-typedef struct
-{
-    SEM_ID q_lock;
-    LONG cnt;
-    LONG idx;
-    Incremental_data data[Q_SIZE];
-} Incremental_q;
-
 // jointMotionData values are in radian and joint order in sequential order
 typedef struct
 {
@@ -47,8 +34,33 @@ typedef struct
     UINT64 time;                    // time in millisecond
     double pos[MP_GRP_AXES_NUM];    // position in radians
     double vel[MP_GRP_AXES_NUM];    // velocity in radians/s
+    double acc[MP_GRP_AXES_NUM];    // acceleration in radians/s^2 (only used for quintic interpolation)
 } JointMotionData;
 
+// Precomputed conversion between the ROS joint positions of a group (radian/meter, sequential
+// joint order) and Motoman pulse positions (moto joint order). It combines the joint reordering
+// of 7, 4 and 5 axis robots with the unit conversion of each axis, so a conversion is a single
+// loop without any branches. Entries of unused joints and axes point at index 0 and scale to 0.
+typedef struct
+{
+    int toRosIndex[MAX_PULSE_AXES];         // moto axis of each ROS joint
+    double toRosMask[MAX_PULSE_AXES];       // 1.0 for each ROS joint which is used, 0.0 otherwise
+    double toRosDivisor[MAX_PULSE_AXES];    // pulses per radian/meter of each ROS joint (1.0 if unused)
+    int toMotoIndex[MAX_PULSE_AXES];        // ROS joint of each moto axis
+    double toMotoFactor[MAX_PULSE_AXES];    // pulses per radian/meter of each moto axis (0.0 if unused)
+} JointTransform;
+
+// Fill level of the increment queue of a group, while its producer still has increments to add.
+// The queue draining at the end of a trajectory is not an underrun. (see Ros_MotionControl_UpdateIncQueueStats)
+typedef struct
+{
+    int minFill;                    // lowest number of increments in the queue (-1 if not measured yet)
+    int underrunCount;              // number of times the queue ran empty
+    int longestUnderrun;            // longest time the queue was empty, in interpolation cycles
+    int currentUnderrun;            // interpolation cycles the queue has been empty for (0 if it isn't)
+    BOOL bPrimed;                   // the queue has held increments since the statistics were reset
+} IncQueueStats;
+
 //---------------------------------------------------------------
 // CtrlGroup:
 // Structure containing all the data related to a control group
@@ -65,17 +77,32 @@ typedef struct
     double maxSpeed[MP_GRP_AXES_NUM];           // maximum joint speed in radian/sec (rotational) or meter/sec (linear) (ROS joint-order)
     int tool;                                   // selected tool for the motion
 
-    Incremental_q inc_q;                        // incremental queue
-    UINT64 q_time;                              // time to which the queue has been processed
+    UINT64 q_time;                              // time to which the increment queue has been processed for this group
+    int incQueueDepth;                          // number of increments the queue is filled up to (depends on the motion mode, see Ros_MotionControl_InitIncQueueDepth)
+    int incQueueLatencyPeak;                    // adaptive_increment_queue_depth: decaying peak of the number of cycles the producer took to refill the queue after being woken up
+    int incQueueRefillWait;                     // adaptive_increment_queue_depth: cycles since the producer was woken up (-1 if no refill is pending)
+    int incQueuePrevCount;                      // adaptive_increment_queue_depth: number of increments left in the queue after the previous cycle
+    IncQueueStats incQueueStats;                // underruns of the increment queue since the start of the trajectory (updated by the IncMoveTask)
 
     JointMotionData* trajectoryIterator;        // joint motion command data in radian
     JointMotionData* prevTrajectoryIterator;    // joint motion command data in radian
-    JointMotionData trajectoryToProcess[MAX_NUMBER_OF_POINTS_PER_TRAJECTORY];   // joint motion command data in radian to process
+    JointMotionData trajectoryToProcess[TRAJECTORY_WINDOW_SIZE];   // rolling window of joint motion command data in radian to process
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* trajectoryPoints; // points of the trajectory which are loaded into trajectoryToProcess (MOTION_MODE_TRAJECTORY)
+    int trajectoryNextPointIndex;               // index in trajectoryPoints of the next point to load into trajectoryToProcess
+    UINT64 trajectoryTimeOffset;                // time in millisecond added to each loaded point (start of a replacement trajectory which was spliced in)
+    int trajJointIndex[MP_GRP_AXES_NUM];        // index of each axis (moto order) in the joint list of the incoming trajectory
+    int pointQueueUnderrunCount;                // number of times the point queue ran empty while the group was still moving (MOTION_MODE_POINTQUEUE)
 
     BOOL hasDataToProcess;                      // indicates that there is data to process
-    UINT64 timeLeftover_ms;                     // Time left over after reaching the end of a trajectory to complete the interpolation period
+    double timeLeftover_ms;                     // Time left over after reaching the end of a trajectory to complete the interpolation period
+    LONG pendingInc[MP_GRP_AXES_NUM];           // Increments of the partial interpolation period at the end of a segment. They are queued together with the first increments of the next segment.
+    BOOL bPendingInc;                           // pendingInc holds increments which have not been queued yet
+    UINT32 segmentCount;                        // number of segments completed since the start of the trajectory (see Ros_MotionControl_DecideFlushPendingInc)
+    UINT32 speedScaleCycle;                     // number of interpolation cycles generated since the start of the trajectory (time base of the speed scale ramp)
+    double speedScaleDelay_ms;                  // how far the interpolation clock has fallen behind real time because of speed scaling
     long prevPulsePos[MAX_PULSE_AXES];          // The commanded pulse position that the trajectory starts at (Ros_MotionServer_StartTrajMode)
     AXIS_MOTION_TYPE axisType;                  // Indicates whether axis is rotary or linear
+    JointTransform jointTransform;              // conversion between ROS joints and pulses (Ros_CtrlGroup_InitJointTransform)
     char jointNames_userDefined[MP_GRP_AXES_NUM][MAX_JOINT_NAME_LENGTH]; //string name for each joint in 'moto' (non-sequential) joint order
 
     BOOL bIsBaxisSlave;                         // Indicates the B axis will automatically move to maintain orientation as other axes are moved
@@ -89,6 +116,7 @@ typedef struct
     JOINT_FEEDBACK_SPEED_ADDRESSES speedFeedbackRegisterAddress; //CIO address for the registers containing feedback speed
 
     int tidAddToIncQueue;
+    SEM_ID semAddToIncQueue;                    // signaled when the AddToIncQueue task has new data to process or room in the increment queue
 
     //-------------------------------------------------------------------
     //Publishers
@@ -117,6 +145,7 @@ extern void Ros_CtrlGrp_Cleanup(CtrlGroup* ctrlGroup);
 extern MP_GRP_ID_TYPE Ros_mpCtrlGrpNo2GrpId(int groupNo);
 
 extern BOOL Ros_CtrlGroup_GetPulsePosCmd(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_CompensateBaxisSlave(CtrlGroup const* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
 extern BOOL Ros_CtrlGroup_GetFBPulsePos(CtrlGroup* ctrlGroup, long pulsePos[MAX_PULSE_AXES]);
 extern BOOL Ros_CtrlGroup_GetFBServoSpeed(CtrlGroup* ctrlGroup, long pulseSpeed[MAX_PULSE_AXES]);
 
@@ -127,7 +156,10 @@ extern BOOL Ros_CtrlGroup_GetEncoderTemperature(CtrlGroup const* const ctrlGroup
 extern void Ros_CtrlGroup_ConvertToRosPos(CtrlGroup* ctrlGroup, long const pulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES]);
 extern void Ros_CtrlGroup_ConvertToRosTorque(CtrlGroup* ctrlGroup, double const motoTorque[MAX_PULSE_AXES], double rosTorque[MAX_PULSE_AXES]);
 extern void Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(CtrlGroup* ctrlGroup, double const radPos[MAX_PULSE_AXES], long pulsePos[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(CtrlGroup* ctrlGroup, double const motoPos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], double motoPos[MAX_PULSE_AXES]);
 extern void Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(CtrlGroup* ctrlGroup, double const rosPos[MAX_PULSE_AXES], long motopulsePos[MAX_PULSE_AXES]);
+extern void Ros_CtrlGroup_InitJointTransform(CtrlGroup* ctrlGroup);
 
 extern UCHAR Ros_CtrlGroup_GetAxisConfig(CtrlGroup* ctrlGroup);
 
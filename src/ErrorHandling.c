@@ -122,6 +122,8 @@ const char* const Ros_ErrorHandling_Init_Trajectory_Status_ToString(Init_Traject
         return motoros2_interfaces__msg__InitTrajEnum__INIT_TRAJ_INVALID_ENDING_ACCELERATION_STR;
     case INIT_TRAJ_DUPLICATE_JOINT_NAME:
         return motoros2_interfaces__msg__InitTrajEnum__INIT_TRAJ_DUPLICATE_JOINT_NAME_STR;
+    case INIT_TRAJ_INSUFFICIENT_WAYPOINT_MEMORY:
+        return "Not enough memory allocated to store the computed velocities of the waypoints";
     default:
         return motoros2_interfaces__msg__InitTrajEnum__INIT_TRAJ_UNSPECIFIED_STR;
     }
@@ -56,6 +56,7 @@ typedef enum
     INIT_TRAJ_INVALID_ENDING_VELOCITY = motoros2_interfaces__msg__InitTrajEnum__INIT_TRAJ_INVALID_ENDING_VELOCITY,
     INIT_TRAJ_INVALID_ENDING_ACCELERATION = motoros2_interfaces__msg__InitTrajEnum__INIT_TRAJ_INVALID_ENDING_ACCELERATION,
     INIT_TRAJ_DUPLICATE_JOINT_NAME = motoros2_interfaces__msg__InitTrajEnum__INIT_TRAJ_DUPLICATE_JOINT_NAME,
+    INIT_TRAJ_INSUFFICIENT_WAYPOINT_MEMORY, //MotoROS2 specific, not part of InitTrajEnum
 } Init_Trajectory_Status;
 
 typedef enum
@@ -65,6 +66,8 @@ typedef enum
     FAIL_TRAJ_TIME,
     FAIL_TRAJ_ALARM,
     FAIL_TRAJ_TOLERANCE_PARSE,
+    FAIL_TRAJ_PREEMPTED,
+    FAIL_TRAJ_PATH_TOLERANCE,
 } Failed_Trajectory_Status;
 
 //**********************************************************************
@@ -100,6 +103,7 @@ typedef enum
     SUBCODE_EXECUTOR,
     SUBCODE_INCREMENTAL_MOTION,
     SUBCODE_ADD_TO_INC_Q,
+    SUBCODE_INC_PRECOMPILE,
 } ALARM_TASK_CREATE_FAIL_SUBCODE; //8010
 
 typedef enum
@@ -176,6 +180,23 @@ typedef enum
     SUBCODE_FAIL_INVALID_BASE_TRACK_MOTION_TYPE,
     SUBCODE_DEBUG_INIT_FAIL_MP_NICDATA,
     SUBCODE_CONFIGURATION_FILE_YAML_PARSING_ERROR,
+    SUBCODE_FAIL_INIT_SUBSCRIBER_SPEED_SCALE,
+    SUBCODE_FAIL_ADD_SUBSCRIBER_SPEED_SCALE,
+    SUBCODE_FAIL_INIT_SERVICE_START_RAW_STREAMING_MODE,
+    SUBCODE_FAIL_ADD_SERVICE_START_RAW_STREAMING_MODE,
+    SUBCODE_FAIL_INIT_SUBSCRIBER_RAW_INCREMENTS,
+    SUBCODE_FAIL_ADD_SUBSCRIBER_RAW_INCREMENTS,
+    SUBCODE_FAIL_INIT_SUBSCRIBER_QUEUE_TRAJ_POINTS,
+    SUBCODE_FAIL_ADD_SUBSCRIBER_QUEUE_TRAJ_POINTS,
+    SUBCODE_FAIL_INIT_PUBLISHER_QUEUE_TRAJ_POINTS_STATUS,
+    SUBCODE_FAIL_INIT_PUBLISHER_INC_MOVE_TIMING,
+    SUBCODE_FAIL_INIT_SERVICE_RESET_INC_MOVE_TIMING,
+    SUBCODE_FAIL_ADD_SERVICE_RESET_INC_MOVE_TIMING,
+    SUBCODE_FAIL_INIT_PUBLISHER_INC_QUEUE_STATUS,
+    SUBCODE_FAIL_INIT_SUBSCRIBER_QUEUE_CARTESIAN_POINTS,
+    SUBCODE_FAIL_ADD_SUBSCRIBER_QUEUE_CARTESIAN_POINTS,
+    SUBCODE_FAIL_CREATE_PUBLISHER_TRANSFORM_STATIC,
+    SUBCODE_FAIL_ALLOCATE_TRANSFORM_STATIC,
 
 } ALARM_ASSERTION_FAIL_SUBCODE; //8011
 
@@ -207,6 +228,10 @@ typedef enum
     SUBCODE_CONFIGURATION_RUNTIME_USERLAN_LINKUP_ERR,
     SUBCODE_CONFIGURATION_NO_CALIB_FILES_LOADED,
     SUBCODE_CONFIGURATION_INVALID_DEBUG_BROADCAST_PORT,
+    SUBCODE_CONFIGURATION_INVALID_POINT_QUEUE_DEPTH,
+    SUBCODE_CONFIGURATION_INVALID_SPEED_SCALE_RAMP_TIME,
+    SUBCODE_CONFIGURATION_INVALID_INCREMENT_QUEUE_DEPTH,
+    SUBCODE_CONFIGURATION_INVALID_PATH_TOLERANCE_SERVO_LAG,
 } ALARM_CONFIGURATION_FAIL_SUBCODE; //8013
 
 typedef enum
@@ -0,0 +1,182 @@
+//FsuSpeedLimit.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+void Ros_FsuSpeedLimit_Reset(FsuSpeedLimitState* state)
+{
+    bzero(state, sizeof(FsuSpeedLimitState));
+}
+
+//-------------------------------------------------------------------
+// Forget the pulses which have not been processed yet (ie: the robot
+// is not moving, so it may be moved externally).
+//-------------------------------------------------------------------
+void Ros_FsuSpeedLimit_ClearPending(FsuSpeedLimitState* state)
+{
+    bzero(state->toProcessPulses, sizeof(state->toProcessPulses));
+}
+
+//-------------------------------------------------------------------
+// The increment queue holds one frame per cycle for all groups (see
+// Incremental_q), so a frame can only be read for all groups at once.
+// If any group still has enough unprocessed pulses from the previous
+// cycles, the frame is held for all of them. The other groups are then
+// sent their own unprocessed pulses only (if any), so all groups stay
+// at the same time of the trajectory, instead of drifting apart for
+// as long as the FSU speed limit is active.
+//-------------------------------------------------------------------
+BOOL Ros_FsuSpeedLimit_MustHoldFrame(FsuSpeedLimitState const states[], int numGroup)
+{
+    for (int i = 0; i < numGroup; i++)
+    {
+        if (states[i].bSkipReadingQ)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+//-------------------------------------------------------------------
+// Reconcile the pulses which were processed by the controller with the
+// ones which were sent to it, and determine the increment for this cycle.
+//
+// bNewIncrement: 'inc' was just read from the increment queue
+// processedPulses: pulses of the previous increment which were actually processed (accepted) by the controller
+// maxIncrement: maximum increment of each axis (fallback if no speed is known)
+// inc: [in] increment read from the queue (0 if none), [out] increment to send to the controller
+//
+// Returns TRUE if at least one axis still has unprocessed pulses.
+//-------------------------------------------------------------------
+BOOL Ros_FsuSpeedLimit_Reconcile(FsuSpeedLimitState* state, BOOL bNewIncrement, LONG const processedPulses[MP_GRP_AXES_NUM],
+    UINT32 const maxIncrement[MP_GRP_AXES_NUM], LONG inc[MP_GRP_AXES_NUM])
+{
+    LONG newPulseInc[MP_GRP_AXES_NUM];
+    BOOL isMissingPulse = FALSE;
+    BOOL hasUnprocessedData = FALSE;
+    int axis;
+
+    memcpy(newPulseInc, inc, sizeof(newPulseInc));
+
+    // record the speed associate with the next amount of pulses
+    if (bNewIncrement)
+    {
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        {
+            state->maxSpeed[axis] = abs(newPulseInc[axis]);
+            state->maxSpeedRemain[axis] = abs(newPulseInc[axis]);
+        }
+    }
+
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+    {
+        // Remove the processed pulses from the amount to process.
+        // If everything was processed, then there should by 0 pulses left. Otherwise FSU Speed limit prevented processing
+        state->toProcessPulses[axis] -= processedPulses[axis];
+        if (state->toProcessPulses[axis] != 0)
+            isMissingPulse = TRUE;
+
+        // Add the new pulses to be processed for this iteration
+        state->toProcessPulses[axis] += newPulseInc[axis];
+
+        if (state->toProcessPulses[axis] != 0)
+            hasUnprocessedData = TRUE;
+    }
+
+    // Check if pulses are missing which means that the FSU speed limit is enabled
+    if (isMissingPulse)
+    {
+        UINT64 max_inc;
+
+        // Prevent going faster than original requested speed once speed limit turns off
+        // Check if the speed (inc) of previous interation should be considered by checking
+        // if the unprocessed pulses from that speed setting still remains.
+        // If all the pulses of previous increment were processed, then transfer the current
+        // speed and process the next increment from the increment queue.
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        {
+            // Check if has pulses to process
+            if (state->toProcessPulses[axis] == 0)
+                state->prevMaxSpeedRemain[axis] = 0;
+            else
+                state->prevMaxSpeedRemain[axis] = abs(state->prevMaxSpeedRemain[axis]) - abs(processedPulses[axis]);
+        }
+
+        // Check if still have data to process from previous iteration
+        state->bSkipReadingQ = FALSE;
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        {
+            if (state->prevMaxSpeedRemain[axis] > 0)
+                state->bSkipReadingQ = TRUE;
+        }
+
+        if (!state->bSkipReadingQ)
+        {
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+            {
+                // Transfer the current speed as the new prevSpeed
+                state->prevMaxSpeed[axis] = state->maxSpeed[axis];
+                state->prevMaxSpeedRemain[axis] += state->maxSpeedRemain[axis];
+            }
+        }
+
+        // Set the number of pulse that can be sent without exceeding speed
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        {
+            // Check if has pulses to process
+            if (state->toProcessPulses[axis] == 0)
+                continue;
+
+            // Maximum inc that should be send ()
+            if (state->prevMaxSpeed[axis] > 0)
+                // if previous speed is defined use it
+                max_inc = state->prevMaxSpeed[axis];
+            else
+            {
+                if (state->maxSpeed[axis] > 0)
+                    // else fallback on current speed if defined
+                    max_inc = state->maxSpeed[axis];
+                else if (newPulseInc[axis] != 0)
+                    // use the current speed if none zero.
+                    max_inc = abs(newPulseInc[axis]);
+                else
+                    // otherwise use the axis max speed
+                    max_inc = maxIncrement[axis];
+
+                if (max_inc > 1)
+                    Ros_Debug_BroadcastMsg("Warning undefined speed: Axis %d Defaulting Max Inc: %d (prevSpeed: %d curSpeed %d)",
+                        axis, (int)max_inc, (int)state->prevMaxSpeed[axis], (int)state->maxSpeed[axis]);
+            }
+
+            // Set new increment and recalculate unsent pulses
+            if (abs(state->toProcessPulses[axis]) <= max_inc)
+            {
+                // Pulses to send is small than max, so send everything
+                inc[axis] = state->toProcessPulses[axis];
+            }
+            else
+            {
+                // Pulses to send is too high, so send the amount matching the maximum speed
+                if (state->toProcessPulses[axis] >= 0)
+                    inc[axis] = max_inc;
+                else
+                    inc[axis] = -max_inc;
+            }
+        }
+    }
+    else
+    {
+        // No PFL Speed Limit detected
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        {
+            state->prevMaxSpeed[axis] = abs(inc[axis]);
+            state->prevMaxSpeedRemain[axis] = abs(inc[axis]);
+        }
+    }
+
+    return hasUnprocessedData;
+}
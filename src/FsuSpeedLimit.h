@@ -0,0 +1,36 @@
+//FsuSpeedLimit.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_FSU_SPEED_LIMIT_H
+#define MOTOROS2_FSU_SPEED_LIMIT_H
+
+//---------------------------------------------------------------
+// FsuSpeedLimitState:
+// When the FSU speed limit is active, some pulses of an interpolation cycle may not be processed by the controller.
+// To track the true amount of pulses processed, the IncMoveTask compares the command position with the one of the
+// previous cycle. If the amount processed doesn't match the amount sent at the previous cycle, the unprocessed pulses
+// are sent again. To keep the motion smooth, the 'maximum speed' (max pulses per cycle) is tracked and used to skip
+// reading more pulse increments from the queue if the amount of unprocessed pulses is larger than the detected speed.
+// The 'maximum speed' is also used to prevent exceeding the commanded speed once the FSU speed limit is removed.
+//---------------------------------------------------------------
+typedef struct
+{
+    LONG toProcessPulses[MP_GRP_AXES_NUM];      // Total pulses that still need to be sent to the command
+    LONG maxSpeed[MP_GRP_AXES_NUM];             // ROS speed (amount of pulses for one cycle from the data queue) that should not be exceeded
+    LONG maxSpeedRemain[MP_GRP_AXES_NUM];       // Number of pulses (absolute) that remains to be processed at the 'maxSpeed'
+    LONG prevMaxSpeed[MP_GRP_AXES_NUM];         // Previous data queue reading 'maxSpeed'
+    LONG prevMaxSpeedRemain[MP_GRP_AXES_NUM];   // Previous data queue reading 'maxSpeedRemain'
+    BOOL bSkipReadingQ;                         // Skip reading more data from the increment queue (there is enough unprocessed from previous cycles remaining)
+} FsuSpeedLimitState;
+
+extern void Ros_FsuSpeedLimit_Reset(FsuSpeedLimitState* state);
+extern void Ros_FsuSpeedLimit_ClearPending(FsuSpeedLimitState* state);
+extern BOOL Ros_FsuSpeedLimit_MustHoldFrame(FsuSpeedLimitState const states[], int numGroup);
+extern BOOL Ros_FsuSpeedLimit_Reconcile(FsuSpeedLimitState* state, BOOL bNewIncrement, LONG const processedPulses[MP_GRP_AXES_NUM],
+    UINT32 const maxIncrement[MP_GRP_AXES_NUM], LONG inc[MP_GRP_AXES_NUM]);
+
+#endif  // MOTOROS2_FSU_SPEED_LIMIT_H
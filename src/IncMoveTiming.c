@@ -0,0 +1,207 @@
+//IncMoveTiming.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_publisher_t g_publisherIncMoveTiming;
+
+//The histograms are only written by the increment-move task. The executor only reads them (a
+//published message may mix samples of two cycles, which is acceptable for diagnostics) and
+//requests a reset, which is then carried out by the increment-move task.
+typedef struct
+{
+    IncMoveTimingHistogram histograms[INC_MOVE_TIMING_NUM_PHASES];
+    volatile BOOL bResetRequested;
+
+    UINT32 ticksPerUs;                      //0 until the timestamp counter has been calibrated
+    UINT64 tsCalibrationStart;
+    int calibrationCycles;
+    UINT64 tsPrevWake;
+    BOOL bHasPrevWake;
+
+    int elapsedSincePublish;                //ms
+    std_msgs__msg__Int32MultiArray msgTiming;
+    int32_t timingData[INC_MOVE_TIMING_MSG_SIZE];
+} IncMoveTimingState;
+
+static IncMoveTimingState Ros_IncMoveTiming;
+
+void Ros_IncMoveTiming_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(pub_inc_move_timing_init);
+
+    //the histograms are published periodically, so a lost message doesn't have to hold up the executor
+    rcl_ret_t ret = rclc_publisher_init_best_effort(&g_publisherIncMoveTiming, &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray), TOPIC_NAME_INC_MOVE_TIMING);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_PUBLISHER_INC_MOVE_TIMING, "Failed to init publisher (%d)", (int)ret);
+
+    //the message uses a static buffer for its data (the layout is left empty)
+    Ros_IncMoveTiming.elapsedSincePublish = 0;
+    std_msgs__msg__Int32MultiArray__init(&Ros_IncMoveTiming.msgTiming);
+    Ros_IncMoveTiming.msgTiming.data.data = Ros_IncMoveTiming.timingData;
+    Ros_IncMoveTiming.msgTiming.data.size = INC_MOVE_TIMING_MSG_SIZE;
+    Ros_IncMoveTiming.msgTiming.data.capacity = INC_MOVE_TIMING_MSG_SIZE;
+
+    MOTOROS2_MEM_TRACE_REPORT(pub_inc_move_timing_init);
+}
+
+void Ros_IncMoveTiming_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(pub_inc_move_timing_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup publisher inc move timing");
+    ret = rcl_publisher_fini(&g_publisherIncMoveTiming, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up inc move timing publisher: %d", ret);
+
+    //the data is a static buffer, so it must not be released by __fini
+    Ros_IncMoveTiming.msgTiming.data.data = NULL;
+    Ros_IncMoveTiming.msgTiming.data.size = Ros_IncMoveTiming.msgTiming.data.capacity = 0;
+    std_msgs__msg__Int32MultiArray__fini(&Ros_IncMoveTiming.msgTiming);
+
+    MOTOROS2_MEM_TRACE_REPORT(pub_inc_move_timing_fini);
+}
+
+//-------------------------------------------------------------------
+// Index of the histogram bucket for a duration (in microseconds)
+//-------------------------------------------------------------------
+int Ros_IncMoveTiming_BucketIndex(UINT32 us)
+{
+    int index = 0;
+
+    while (us > 0 && index < INC_MOVE_TIMING_NUM_BUCKETS - 1)
+    {
+        us >>= 1;
+        index++;
+    }
+    return index;
+}
+
+void Ros_IncMoveTiming_AddSample(IncMoveTimingHistogram* histogram, UINT32 us)
+{
+    histogram->buckets[Ros_IncMoveTiming_BucketIndex(us)]++;
+    histogram->count++;
+    if (us > histogram->max_us)
+        histogram->max_us = us;
+}
+
+//-------------------------------------------------------------------
+// Number of timestamp counter ticks between two timestamps (saturated to 32 bits,
+// which avoids 64-bit divisions in the increment-move task)
+//-------------------------------------------------------------------
+static UINT32 Ros_IncMoveTiming_Ticks(UINT64 tsStart, UINT64 tsEnd)
+{
+    UINT64 ticks = (tsEnd > tsStart) ? (tsEnd - tsStart) : 0;
+    return (ticks > 0xFFFFFFFFULL) ? 0xFFFFFFFF : (UINT32)ticks;
+}
+
+//-------------------------------------------------------------------
+// Must be called when the increment-move task starts, before the first cycle
+//-------------------------------------------------------------------
+void Ros_IncMoveTiming_TaskStart()
+{
+    //the calibration is kept, the frequency of the timestamp counter doesn't change
+    bzero(Ros_IncMoveTiming.histograms, sizeof(Ros_IncMoveTiming.histograms));
+    Ros_IncMoveTiming.bResetRequested = FALSE;
+    Ros_IncMoveTiming.calibrationCycles = 0;
+    Ros_IncMoveTiming.bHasPrevWake = FALSE;
+}
+
+//-------------------------------------------------------------------
+// Must be called by the increment-move task right after it wakes up
+//-------------------------------------------------------------------
+void Ros_IncMoveTiming_StartCycle(UINT64 tsWake)
+{
+    if (Ros_IncMoveTiming.bResetRequested)
+    {
+        bzero(Ros_IncMoveTiming.histograms, sizeof(Ros_IncMoveTiming.histograms));
+        Ros_IncMoveTiming.bResetRequested = FALSE;
+    }
+
+    if (Ros_IncMoveTiming.ticksPerUs == 0)
+    {
+        //Calibrate the timestamp counter against the interpolation clock. Averaging over
+        //many cycles makes the jitter of the individual wake-ups negligible.
+        if (Ros_IncMoveTiming.calibrationCycles == 0)
+            Ros_IncMoveTiming.tsCalibrationStart = tsWake;
+        else if (Ros_IncMoveTiming.calibrationCycles == INC_MOVE_TIMING_CALIBRATION_CYCLES)
+        {
+            UINT32 calibrationUs = INC_MOVE_TIMING_CALIBRATION_CYCLES * g_Ros_Controller.interpolPeriod * 1000;
+            Ros_IncMoveTiming.ticksPerUs = Ros_IncMoveTiming_Ticks(Ros_IncMoveTiming.tsCalibrationStart, tsWake) / calibrationUs;
+            if (Ros_IncMoveTiming.ticksPerUs == 0)
+                Ros_IncMoveTiming.ticksPerUs = 1;
+            Ros_Debug_BroadcastMsg("%s: timestamp counter runs at %d ticks/us", __func__, Ros_IncMoveTiming.ticksPerUs);
+        }
+        Ros_IncMoveTiming.calibrationCycles++;
+    }
+    else if (Ros_IncMoveTiming.bHasPrevWake)
+    {
+        int periodUs = Ros_IncMoveTiming_Ticks(Ros_IncMoveTiming.tsPrevWake, tsWake) / Ros_IncMoveTiming.ticksPerUs;
+        Ros_IncMoveTiming_AddSample(&Ros_IncMoveTiming.histograms[INC_MOVE_TIMING_WAKE_JITTER],
+            abs(periodUs - g_Ros_Controller.interpolPeriod * 1000));
+    }
+
+    Ros_IncMoveTiming.tsPrevWake = tsWake;
+    Ros_IncMoveTiming.bHasPrevWake = TRUE;
+}
+
+//-------------------------------------------------------------------
+// Records the duration of a phase. Nothing is recorded until the timestamp counter has been calibrated.
+//-------------------------------------------------------------------
+void Ros_IncMoveTiming_Record(IncMoveTimingPhase phase, UINT64 tsStart, UINT64 tsEnd)
+{
+    if (Ros_IncMoveTiming.ticksPerUs == 0)
+        return;
+
+    Ros_IncMoveTiming_AddSample(&Ros_IncMoveTiming.histograms[phase],
+        Ros_IncMoveTiming_Ticks(tsStart, tsEnd) / Ros_IncMoveTiming.ticksPerUs);
+}
+
+void Ros_IncMoveTiming_RequestReset()
+{
+    Ros_IncMoveTiming.bResetRequested = TRUE;
+}
+
+IncMoveTimingHistogram const* Ros_IncMoveTiming_GetHistogram(IncMoveTimingPhase phase)
+{
+    return &Ros_IncMoveTiming.histograms[phase];
+}
+
+//-------------------------------------------------------------------
+// Discards the calibration of the timestamp counter, it is calibrated again by the next cycles
+//-------------------------------------------------------------------
+void Ros_IncMoveTiming_ResetCalibration()
+{
+    Ros_IncMoveTiming.ticksPerUs = 0;
+    Ros_IncMoveTiming.calibrationCycles = 0;
+}
+
+void Ros_IncMoveTiming_Publish()
+{
+    //called at the period of the action feedback, but the histograms are only published at a lower rate
+    Ros_IncMoveTiming.elapsedSincePublish += g_nodeConfigSettings.action_feedback_publisher_period;
+    if (Ros_IncMoveTiming.elapsedSincePublish < INC_MOVE_TIMING_PUBLISH_PERIOD)
+        return;
+    Ros_IncMoveTiming.elapsedSincePublish = 0;
+
+    int phase, bucket;
+    for (phase = 0; phase < INC_MOVE_TIMING_NUM_PHASES; phase++)
+    {
+        IncMoveTimingHistogram const* histogram = Ros_IncMoveTiming_GetHistogram(phase);
+        int32_t* data = &Ros_IncMoveTiming.timingData[phase * INC_MOVE_TIMING_FIELDS_PER_PHASE];
+
+        data[INC_MOVE_TIMING_FIELD_COUNT] = histogram->count;
+        data[INC_MOVE_TIMING_FIELD_MAX] = histogram->max_us;
+        for (bucket = 0; bucket < INC_MOVE_TIMING_NUM_BUCKETS; bucket++)
+            data[INC_MOVE_TIMING_FIELD_BUCKETS + bucket] = histogram->buckets[bucket];
+    }
+
+    rcl_ret_t ret = rcl_publish(&g_publisherIncMoveTiming, &Ros_IncMoveTiming.msgTiming, NULL);
+    // publishing can fail, but we choose to ignore those errors in this implementation
+    RCL_UNUSED(ret);
+}
@@ -0,0 +1,71 @@
+//IncMoveTiming.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_INC_MOVE_TIMING_H
+#define MOTOROS2_INC_MOVE_TIMING_H
+
+#define INC_MOVE_TIMING_NUM_BUCKETS             16      // bucket 0: < 1 us, bucket n: [2^(n-1), 2^n) us, last bucket: open-ended
+#define INC_MOVE_TIMING_CALIBRATION_CYCLES      128     // interpolation cycles used to calibrate the timestamp counter
+#define INC_MOVE_TIMING_PUBLISH_PERIOD          1000    // in milliseconds
+
+//Phases of a cycle of the increment-move task which are timed
+typedef enum
+{
+    INC_MOVE_TIMING_WAKE_JITTER,        //deviation of the time between two wake-ups from the interpolation period
+    INC_MOVE_TIMING_READ_QUEUE,         //reading a frame from the increment queue
+    INC_MOVE_TIMING_PULSE_CHECK,        //FSU missing-pulse bookkeeping (including mpGetPulsePos)
+    INC_MOVE_TIMING_INC_MOVE,           //mpExRcsIncrementMove
+    INC_MOVE_TIMING_TOTAL,              //from the wake-up until the increment has been sent
+    INC_MOVE_TIMING_NUM_PHASES
+} IncMoveTimingPhase;
+
+//Elements of the data of the timing message, for each of the phases
+typedef enum
+{
+    INC_MOVE_TIMING_FIELD_COUNT,        //number of samples
+    INC_MOVE_TIMING_FIELD_MAX,          //longest sample (us)
+    INC_MOVE_TIMING_FIELD_BUCKETS,      //first of the INC_MOVE_TIMING_NUM_BUCKETS histogram buckets
+    INC_MOVE_TIMING_FIELDS_PER_PHASE = INC_MOVE_TIMING_FIELD_BUCKETS + INC_MOVE_TIMING_NUM_BUCKETS
+} IncMoveTimingField;
+
+#define INC_MOVE_TIMING_MSG_SIZE        (INC_MOVE_TIMING_NUM_PHASES * INC_MOVE_TIMING_FIELDS_PER_PHASE)
+
+typedef struct
+{
+    UINT32 buckets[INC_MOVE_TIMING_NUM_BUCKETS];
+    UINT32 count;
+    UINT32 max_us;
+} IncMoveTimingHistogram;
+
+extern rcl_publisher_t g_publisherIncMoveTiming;
+
+extern void Ros_IncMoveTiming_Initialize();
+extern void Ros_IncMoveTiming_Cleanup();
+
+//Reads the timestamp counter of the CPU
+static inline UINT64 Ros_IncMoveTiming_Now()
+{
+    UINT32 lo, hi;
+    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((UINT64)hi << 32) | lo;
+}
+
+//Called by the increment-move task
+extern void Ros_IncMoveTiming_TaskStart();
+extern void Ros_IncMoveTiming_StartCycle(UINT64 tsWake);
+extern void Ros_IncMoveTiming_Record(IncMoveTimingPhase phase, UINT64 tsStart, UINT64 tsEnd);
+
+//Called by the executor
+extern void Ros_IncMoveTiming_RequestReset();
+extern void Ros_IncMoveTiming_Publish();
+
+extern int Ros_IncMoveTiming_BucketIndex(UINT32 us);
+extern void Ros_IncMoveTiming_AddSample(IncMoveTimingHistogram* histogram, UINT32 us);
+extern IncMoveTimingHistogram const* Ros_IncMoveTiming_GetHistogram(IncMoveTimingPhase phase);
+extern void Ros_IncMoveTiming_ResetCalibration();
+
+#endif  // MOTOROS2_INC_MOVE_TIMING_H
@@ -0,0 +1,315 @@
+//IncPrecompile.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+//The state is changed by the executor (a new goal, or a stop) and by the compile task (a finished
+//compilation). Each new goal increments the generation, so a compilation which was overtaken by a
+//newer goal or by a stop is discarded.
+typedef struct
+{
+    SEM_ID lock;
+    SEM_ID semCompile;
+    int tidCompile;
+
+    volatile IncPrecompileState state;
+    volatile UINT32 generation;
+    ULONG tickStart;                                // the goal was accepted
+    volatile int startupLatency_ms;                 // how long the motion of 'latencyGeneration' waited for the compile task
+    volatile UINT32 latencyGeneration;
+
+    INT16* buffer;                                  // NULL if precompilation is disabled
+    IncStream streams[MAX_CONTROLLABLE_GROUPS];
+} IncPrecompileData;
+
+static IncPrecompileData Ros_IncPrecompile;
+
+void Ros_IncPrecompile_Initialize()
+{
+    Ros_IncPrecompile.state = INC_PRECOMPILE_IDLE;
+    Ros_IncPrecompile.tidCompile = INVALID_TASK;
+    Ros_IncPrecompile.buffer = NULL;
+
+    if (!g_nodeConfigSettings.precompile_trajectories)
+        return;
+
+    Ros_IncPrecompile.buffer = (INT16*)mpMalloc(INC_PRECOMPILE_BUFFER_SIZE * sizeof(INT16));
+    if (Ros_IncPrecompile.buffer == NULL)
+    {
+        //not fatal, all trajectories are converted just in time instead
+        Ros_Debug_BroadcastMsg("WARNING: Failed to allocate %d bytes for precompiled trajectories. Precompilation is disabled.",
+            (int)(INC_PRECOMPILE_BUFFER_SIZE * sizeof(INT16)));
+        return;
+    }
+
+    Ros_IncPrecompile.lock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+    Ros_IncPrecompile.semCompile = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+
+    Ros_Debug_BroadcastMsg("Creating new task: Precompile trajectories");
+
+    //the lowest priority available to MotoPlus applications, the task yields regularly (see Ros_IncPrecompile_KeepCompiling)
+    Ros_IncPrecompile.tidCompile = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
+                                                (FUNCPTR)Ros_IncPrecompile_CompileTask,
+                                                0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    if (Ros_IncPrecompile.tidCompile == ERROR)
+    {
+        Ros_IncPrecompile.tidCompile = INVALID_TASK;
+        mpSetAlarm(ALARM_TASK_CREATE_FAIL, APPLICATION_NAME " FAILED TO CREATE TASK", SUBCODE_INC_PRECOMPILE);
+    }
+}
+
+void Ros_IncPrecompile_Cleanup()
+{
+    if (Ros_IncPrecompile.buffer == NULL)
+        return;
+
+    if (Ros_IncPrecompile.tidCompile != INVALID_TASK)
+    {
+        mpDeleteTask(Ros_IncPrecompile.tidCompile);
+        Ros_IncPrecompile.tidCompile = INVALID_TASK;
+    }
+
+    mpSemDelete(Ros_IncPrecompile.semCompile);
+    mpSemDelete(Ros_IncPrecompile.lock);
+
+    Ros_IncPrecompile.state = INC_PRECOMPILE_IDLE;
+    mpFree(Ros_IncPrecompile.buffer);
+    Ros_IncPrecompile.buffer = NULL;
+}
+
+void Ros_IncPrecompile_InitStream(IncStream* stream, INT16* buffer, int capacity, UINT32 axisMask)
+{
+    bzero(stream, sizeof(IncStream));
+    stream->data = buffer;
+    stream->capacity = capacity;
+    stream->axisMask = axisMask;
+}
+
+//-------------------------------------------------------------------
+// Appends an increment to the stream. Returns FALSE if it doesn't fit.
+//-------------------------------------------------------------------
+BOOL Ros_IncPrecompile_Encode(IncStream* stream, LONG const inc[MP_GRP_AXES_NUM])
+{
+    LONG delta[MP_GRP_AXES_NUM];
+    int words = 0;
+    int axis;
+
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+    {
+        if (!(stream->axisMask & (1 << axis)))
+            continue;
+
+        delta[axis] = inc[axis] - stream->encodeInc[axis];
+        words += (labs(delta[axis]) <= INC_PRECOMPILE_MAX_SHORT_DELTA) ? 1 : 3;
+    }
+
+    if (stream->length + words > stream->capacity)
+        return FALSE;
+
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+    {
+        if (!(stream->axisMask & (1 << axis)))
+            continue;
+
+        if (labs(delta[axis]) <= INC_PRECOMPILE_MAX_SHORT_DELTA)
+            stream->data[stream->length++] = (INT16)delta[axis];
+        else
+        {
+            stream->data[stream->length++] = INC_PRECOMPILE_ESCAPE;
+            stream->data[stream->length++] = (INT16)(((UINT32)delta[axis]) >> 16);
+            stream->data[stream->length++] = (INT16)(((UINT32)delta[axis]) & 0xFFFF);
+        }
+        stream->encodeInc[axis] = inc[axis];
+    }
+
+    stream->numIncrements++;
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Reads the next increment from the stream. Returns FALSE at the end of the stream.
+//-------------------------------------------------------------------
+BOOL Ros_IncPrecompile_Decode(IncStream* stream, LONG inc[MP_GRP_AXES_NUM])
+{
+    int axis;
+
+    if (stream->readIndex >= stream->length)
+        return FALSE;
+
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+    {
+        if (!(stream->axisMask & (1 << axis)))
+        {
+            inc[axis] = 0;
+            continue;
+        }
+
+        INT16 word = stream->data[stream->readIndex++];
+        if (word == INC_PRECOMPILE_ESCAPE)
+        {
+            UINT32 high = (UINT16)stream->data[stream->readIndex++];
+            UINT32 low = (UINT16)stream->data[stream->readIndex++];
+            stream->decodeInc[axis] += (LONG)((high << 16) | low);
+        }
+        else
+            stream->decodeInc[axis] += word;
+
+        inc[axis] = stream->decodeInc[axis];
+    }
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Called while a new trajectory is initialized, before the increment generators
+// are released. They wait until the compile task is done.
+//-------------------------------------------------------------------
+void Ros_IncPrecompile_Start()
+{
+    if (Ros_IncPrecompile.buffer == NULL || Ros_IncPrecompile.tidCompile == INVALID_TASK)
+        return;
+
+    mpSemTake(Ros_IncPrecompile.lock, WAIT_FOREVER);
+    Ros_IncPrecompile.generation += 1;
+    Ros_IncPrecompile.state = INC_PRECOMPILE_COMPILING;
+    Ros_IncPrecompile.tickStart = tickGet();
+    mpSemGive(Ros_IncPrecompile.lock);
+
+    mpSemGive(Ros_IncPrecompile.semCompile);
+}
+
+//-------------------------------------------------------------------
+// The active trajectory is stopped, or the next one is converted just in time
+//-------------------------------------------------------------------
+void Ros_IncPrecompile_Cancel()
+{
+    if (Ros_IncPrecompile.buffer == NULL)
+        return;
+
+    mpSemTake(Ros_IncPrecompile.lock, WAIT_FOREVER);
+    Ros_IncPrecompile.generation += 1;
+    Ros_IncPrecompile.state = INC_PRECOMPILE_IDLE;
+    mpSemGive(Ros_IncPrecompile.lock);
+}
+
+BOOL Ros_IncPrecompile_IsPending()
+{
+    return Ros_IncPrecompile.state == INC_PRECOMPILE_COMPILING;
+}
+
+BOOL Ros_IncPrecompile_IsReady()
+{
+    return Ros_IncPrecompile.state == INC_PRECOMPILE_READY;
+}
+
+//-------------------------------------------------------------------
+// Called by Ros_MotionControl_CompileTrajectory for each cycle. Returns FALSE
+// if the compilation has been overtaken by a newer goal or a stop.
+//-------------------------------------------------------------------
+BOOL Ros_IncPrecompile_KeepCompiling(UINT32 generation, int cycle)
+{
+    //the executor runs at the same priority, it must not be held up for the whole compilation
+    if ((cycle % INC_PRECOMPILE_YIELD_CYCLES) == 0)
+        mpTaskDelay(0);
+
+    return (generation == Ros_IncPrecompile.generation);
+}
+
+//-------------------------------------------------------------------
+// The time the active trajectory waited for the compile task before its motion
+// could start. 0 if it wasn't precompiled (or was stopped in the meantime).
+//-------------------------------------------------------------------
+int Ros_IncPrecompile_GetStartupLatency()
+{
+    int latency_ms = 0;
+
+    if (Ros_IncPrecompile.buffer == NULL)
+        return 0;
+
+    mpSemTake(Ros_IncPrecompile.lock, WAIT_FOREVER);
+    if (Ros_IncPrecompile.latencyGeneration == Ros_IncPrecompile.generation)
+        latency_ms = Ros_IncPrecompile.startupLatency_ms;
+    mpSemGive(Ros_IncPrecompile.lock);
+
+    return latency_ms;
+}
+
+BOOL Ros_IncPrecompile_NextIncrement(CtrlGroup* ctrlGroup, LONG inc[MP_GRP_AXES_NUM])
+{
+    if (!Ros_IncPrecompile_IsReady())
+        return FALSE;
+
+    return Ros_IncPrecompile_Decode(&Ros_IncPrecompile.streams[ctrlGroup->groupNo], inc);
+}
+
+//-------------------------------------------------------------------
+// Task that converts each new trajectory into compressed increment streams,
+// so the increment generators only have to replay them during motion.
+//-------------------------------------------------------------------
+void Ros_IncPrecompile_CompileTask()
+{
+    UINT32 generation;
+    UINT32 axisMask;
+    int grpIndex, axis, used;
+    BOOL bOk;
+
+    FOREVER
+    {
+        mpSemTake(Ros_IncPrecompile.semCompile, WAIT_FOREVER);
+
+        mpSemTake(Ros_IncPrecompile.lock, WAIT_FOREVER);
+        generation = Ros_IncPrecompile.generation;
+        bOk = (Ros_IncPrecompile.state == INC_PRECOMPILE_COMPILING);
+        mpSemGive(Ros_IncPrecompile.lock);
+
+        //the streams of all groups share the buffer
+        used = 0;
+        for (grpIndex = 0; bOk && grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        {
+            CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+
+            axisMask = 0;
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+            {
+                if (!Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, axis))
+                    axisMask |= (1 << axis);
+            }
+
+            Ros_IncPrecompile_InitStream(&Ros_IncPrecompile.streams[grpIndex], &Ros_IncPrecompile.buffer[used],
+                INC_PRECOMPILE_BUFFER_SIZE - used, axisMask);
+            bOk = Ros_MotionControl_CompileTrajectory(ctrlGroup, &Ros_IncPrecompile.streams[grpIndex], generation);
+            used += Ros_IncPrecompile.streams[grpIndex].length;
+        }
+
+        mpSemTake(Ros_IncPrecompile.lock, WAIT_FOREVER);
+        if (generation != Ros_IncPrecompile.generation)
+        {
+            //overtaken, nothing to report
+            mpSemGive(Ros_IncPrecompile.lock);
+            continue;
+        }
+        int latency_ms = (int)((tickGet() - Ros_IncPrecompile.tickStart) * mpGetRtc());
+        Ros_IncPrecompile.startupLatency_ms = latency_ms;
+        Ros_IncPrecompile.latencyGeneration = generation;
+        Ros_IncPrecompile.state = bOk ? INC_PRECOMPILE_READY : INC_PRECOMPILE_FAILED;
+        mpSemGive(Ros_IncPrecompile.lock);
+
+        if (bOk)
+        {
+            Ros_Debug_BroadcastMsg("Trajectory precompiled in %d ms: %d cycles, %d of %d words used",
+                latency_ms, Ros_IncPrecompile.streams[0].numIncrements, used, INC_PRECOMPILE_BUFFER_SIZE);
+        }
+        else
+        {
+            Ros_Debug_BroadcastMsg("WARNING: Trajectory doesn't fit in the precompilation buffer (%d words). Converting it during motion instead (delay: %d ms).",
+                INC_PRECOMPILE_BUFFER_SIZE, latency_ms);
+        }
+
+        //either way, the increment generators can start
+        Ros_MotionControl_SignalAddToIncQueue_All();
+    }
+}
@@ -0,0 +1,61 @@
+//IncPrecompile.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_INC_PRECOMPILE_H
+#define MOTOROS2_INC_PRECOMPILE_H
+
+#define INC_PRECOMPILE_BUFFER_SIZE      131072      // 16-bit words, shared by the streams of all groups (256 KB)
+#define INC_PRECOMPILE_ESCAPE           (-32768)    // the next two words hold a change which doesn't fit in 16 bits
+#define INC_PRECOMPILE_MAX_SHORT_DELTA  32767
+#define INC_PRECOMPILE_YIELD_CYCLES     250         // the compile task gives other tasks a chance to run after this many cycles
+
+typedef enum
+{
+    INC_PRECOMPILE_IDLE,        // the active trajectory (if any) is converted just in time
+    INC_PRECOMPILE_COMPILING,   // the increment generators wait for the compile task
+    INC_PRECOMPILE_READY,       // the increment generators replay the compiled streams
+    INC_PRECOMPILE_FAILED,      // the trajectory didn't fit, it is converted just in time instead
+} IncPrecompileState;
+
+//---------------------------------------------------------------
+// IncStream:
+// The increments of one group for a whole trajectory. Each increment is stored as its
+// change from the previous increment of the same axis (which is small, as long as the
+// acceleration is bounded), in a single 16-bit word. Larger changes are escaped and
+// take three words. Invalid axes are not stored at all.
+//---------------------------------------------------------------
+typedef struct
+{
+    INT16* data;
+    int capacity;                           // words
+    int length;                             // words
+    UINT32 axisMask;                        // bit n is set if axis n is stored
+    int numIncrements;
+
+    LONG encodeInc[MP_GRP_AXES_NUM];        // last increment written
+    int readIndex;                          // words
+    LONG decodeInc[MP_GRP_AXES_NUM];        // last increment read
+} IncStream;
+
+extern void Ros_IncPrecompile_Initialize();
+extern void Ros_IncPrecompile_Cleanup();
+
+extern void Ros_IncPrecompile_InitStream(IncStream* stream, INT16* buffer, int capacity, UINT32 axisMask);
+extern BOOL Ros_IncPrecompile_Encode(IncStream* stream, LONG const inc[MP_GRP_AXES_NUM]);
+extern BOOL Ros_IncPrecompile_Decode(IncStream* stream, LONG inc[MP_GRP_AXES_NUM]);
+
+extern void Ros_IncPrecompile_Start();
+extern void Ros_IncPrecompile_Cancel();
+extern BOOL Ros_IncPrecompile_IsPending();
+extern BOOL Ros_IncPrecompile_IsReady();
+extern BOOL Ros_IncPrecompile_KeepCompiling(UINT32 generation, int cycle);
+extern int Ros_IncPrecompile_GetStartupLatency();
+extern BOOL Ros_IncPrecompile_NextIncrement(CtrlGroup* ctrlGroup, LONG inc[MP_GRP_AXES_NUM]);
+
+extern void Ros_IncPrecompile_CompileTask();
+
+#endif  // MOTOROS2_INC_PRECOMPILE_H
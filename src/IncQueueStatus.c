@@ -0,0 +1,82 @@
+//IncQueueStatus.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_publisher_t g_publisherIncQueueStatus;
+
+typedef struct
+{
+    int elapsedSincePublish;                //ms
+    std_msgs__msg__Int32MultiArray msgStatus;
+    int32_t statusData[INC_QUEUE_STATUS_MAX_SIZE];
+} IncQueueStatusState;
+
+static IncQueueStatusState Ros_IncQueueStatus;
+
+void Ros_IncQueueStatus_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(pub_inc_queue_status_init);
+
+    //the status is published periodically, so a lost message doesn't have to hold up the executor
+    rcl_ret_t ret = rclc_publisher_init_best_effort(&g_publisherIncQueueStatus, &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray), TOPIC_NAME_INC_QUEUE_STATUS);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_PUBLISHER_INC_QUEUE_STATUS, "Failed to init publisher (%d)", (int)ret);
+
+    //the message uses a static buffer for its data (the layout is left empty)
+    Ros_IncQueueStatus.elapsedSincePublish = 0;
+    std_msgs__msg__Int32MultiArray__init(&Ros_IncQueueStatus.msgStatus);
+    Ros_IncQueueStatus.msgStatus.data.data = Ros_IncQueueStatus.statusData;
+    Ros_IncQueueStatus.msgStatus.data.size = g_Ros_Controller.numGroup * INC_QUEUE_STATUS_FIELDS_PER_GROUP;
+    Ros_IncQueueStatus.msgStatus.data.capacity = INC_QUEUE_STATUS_MAX_SIZE;
+
+    MOTOROS2_MEM_TRACE_REPORT(pub_inc_queue_status_init);
+}
+
+void Ros_IncQueueStatus_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(pub_inc_queue_status_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup publisher inc queue status");
+    ret = rcl_publisher_fini(&g_publisherIncQueueStatus, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up inc queue status publisher: %d", ret);
+
+    //the data is a static buffer, so it must not be released by __fini
+    Ros_IncQueueStatus.msgStatus.data.data = NULL;
+    Ros_IncQueueStatus.msgStatus.data.size = Ros_IncQueueStatus.msgStatus.data.capacity = 0;
+    std_msgs__msg__Int32MultiArray__fini(&Ros_IncQueueStatus.msgStatus);
+
+    MOTOROS2_MEM_TRACE_REPORT(pub_inc_queue_status_fini);
+}
+
+void Ros_IncQueueStatus_Publish()
+{
+    //called at the period of the action feedback, but the status is only published at a lower rate
+    Ros_IncQueueStatus.elapsedSincePublish += g_nodeConfigSettings.action_feedback_publisher_period;
+    if (Ros_IncQueueStatus.elapsedSincePublish < INC_QUEUE_STATUS_PUBLISH_PERIOD)
+        return;
+    Ros_IncQueueStatus.elapsedSincePublish = 0;
+
+    //the statistics are updated by the IncMoveTask while they are read here, which is acceptable for diagnostics
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
+        int32_t* data = &Ros_IncQueueStatus.statusData[groupIndex * INC_QUEUE_STATUS_FIELDS_PER_GROUP];
+
+        data[INC_QUEUE_STATUS_FILL] = Ros_Controller_IncQ_Count(&g_Ros_Controller.incQueue, groupIndex);
+        data[INC_QUEUE_STATUS_DEPTH] = ctrlGroup->incQueueDepth;
+        data[INC_QUEUE_STATUS_MIN_FILL] = ctrlGroup->incQueueStats.minFill;
+        data[INC_QUEUE_STATUS_UNDERRUNS] = ctrlGroup->incQueueStats.underrunCount;
+        data[INC_QUEUE_STATUS_LONGEST_UNDERRUN] = ctrlGroup->incQueueStats.longestUnderrun;
+    }
+
+    rcl_ret_t ret = rcl_publish(&g_publisherIncQueueStatus, &Ros_IncQueueStatus.msgStatus, NULL);
+    // publishing can fail, but we choose to ignore those errors in this implementation
+    RCL_UNUSED(ret);
+}
@@ -0,0 +1,33 @@
+//IncQueueStatus.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_INC_QUEUE_STATUS_H
+#define MOTOROS2_INC_QUEUE_STATUS_H
+
+#define INC_QUEUE_STATUS_PUBLISH_PERIOD     100     // in milliseconds
+
+//Elements of the data of the status message, for each of the groups
+typedef enum
+{
+    INC_QUEUE_STATUS_FILL,                  //number of increments currently in the queue
+    INC_QUEUE_STATUS_DEPTH,                 //number of increments the queue is filled up to (CtrlGroup::incQueueDepth)
+    INC_QUEUE_STATUS_MIN_FILL,              //lowest fill while the producer still had increments to add (-1 if not measured yet)
+    INC_QUEUE_STATUS_UNDERRUNS,             //number of underruns
+    INC_QUEUE_STATUS_LONGEST_UNDERRUN,      //longest underrun, in interpolation cycles
+    INC_QUEUE_STATUS_FIELDS_PER_GROUP
+} IncQueueStatusField;
+
+#define INC_QUEUE_STATUS_MAX_SIZE           (MAX_CONTROLLABLE_GROUPS * INC_QUEUE_STATUS_FIELDS_PER_GROUP)
+
+extern rcl_publisher_t g_publisherIncQueueStatus;
+
+extern void Ros_IncQueueStatus_Initialize();
+extern void Ros_IncQueueStatus_Cleanup();
+
+extern void Ros_IncQueueStatus_Publish();
+
+#endif  // MOTOROS2_INC_QUEUE_STATUS_H
@@ -8,22 +8,134 @@
 #include "MotoROS.h"
 
 /// <summary>
-/// For each point in an incoming trajectory, process the data for a SINGLE JOINT.
-/// The time, pos, and vel are copied from the trajectory structure into the internal
-/// buffer for the specific control group object.
+/// For each point in an incoming trajectory, validate the data for a SINGLE JOINT.
+/// The time of each point is checked, as well as the final velocity when executing
+/// an entire trajectory.
 /// </summary>
 /// <param name="in_jointTrajData">Pointer to the head of the incoming trajectory</param>
 /// <param name="incomingAxisIndex">Index of the joint in the in_jointTrajData structure</param>
-/// <param name="ctrlGroup">CtrlGroup object where this joint belongs</param>
-/// <param name="ctrlGroupAxisIndex">Index of the joint in the CtrlGroup object</param>
-/// <param name="out_jointMotionData">Pointer to the head of the array containing the data which will be later broken into increments</param>
-/// <returns></returns>
-Init_Trajectory_Status Ros_MotionControl_ConvertTrajectoryToJointMotionData(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* in_jointTrajData, 
-    int incomingAxisIndex, CtrlGroup* ctrlGroup, int ctrlGroupAxisIndex, JointMotionData* out_jointMotionData);
+/// <returns>INIT_TRAJ_OK if the data is valid, otherwise the reason it was rejected</returns>
+Init_Trajectory_Status Ros_MotionControl_ValidateTrajectoryJoint(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* in_jointTrajData, int incomingAxisIndex);
 
 /// <summary>
-/// Given a joint name, search through each control group and axis to find
-/// the control group + axis number of the corresponding joint
+/// Validate all points of an incoming trajectory: the number of positions and velocities of each
+/// point, the time of each point (see Ros_MotionControl_ValidateTrajectoryJoint) and the speed
+/// and increment limits of each group. The joint names must already be mapped onto the groups.
+/// </summary>
+/// <param name="sequenceOfPoints">Points of the incoming trajectory</param>
+/// <returns>INIT_TRAJ_OK if the data is valid, otherwise the reason it was rejected</returns>
+Init_Trajectory_Status Ros_MotionControl_ValidateTrajectoryData(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints);
+
+/// <summary>
+/// Copy the time, pos, and vel of a single incoming trajectory point into the internal buffer
+/// for the specific control group object. The joints are picked from the incoming point using
+/// ctrlGroup->trajJointIndex.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object to convert the point for</param>
+/// <param name="in_trajPoint">Incoming trajectory point</param>
+/// <param name="out_jointMotionData">Entry of the internal buffer which will be later broken into increments</param>
+void Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(CtrlGroup* ctrlGroup,
+    trajectory_msgs__msg__JointTrajectoryPoint const* in_trajPoint, JointMotionData* out_jointMotionData);
+
+/// <summary>
+/// Load the next point of the active trajectory into a free entry of the rolling window of
+/// the control group. If all points have been loaded, the entry is left invalid. This marks
+/// the end of the trajectory.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object to load the point for</param>
+/// <param name="out_jointMotionData">Free entry in ctrlGroup->trajectoryToProcess</param>
+void Ros_MotionControl_LoadNextTrajectoryPoint(CtrlGroup* ctrlGroup, JointMotionData* out_jointMotionData);
+
+/// <summary>
+/// Convert a point of the active trajectory of the control group (ctrlGroup->trajectoryPoints), including
+/// the time offset of a spliced trajectory and the compensation of a B-axis slave.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object to convert the point for</param>
+/// <param name="pointIndex">Index of the point in ctrlGroup->trajectoryPoints</param>
+/// <param name="out_jointMotionData">The converted point</param>
+void Ros_MotionControl_LoadTrajectoryPoint(CtrlGroup* ctrlGroup, int pointIndex, JointMotionData* out_jointMotionData);
+
+/// <summary>
+/// Queue the increments of the active trajectory of a group from its precompiled stream (see
+/// IncPrecompile.c), instead of interpolating them. Returns once the stream has been queued
+/// completely or motion is stopped. The trajectory is done either way.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object of the calling AddToIncQueue task</param>
+void Ros_MotionControl_ReplayPrecompiledTrajectory(CtrlGroup* ctrlGroup);
+
+/// <summary>
+/// Switch a group over to the replacement trajectory of Ros_MotionControl_SpliceTrajectory, once the
+/// segment which starts at ctrlGroup->prevTrajectoryIterator reaches the splice time. That segment
+/// is cut short to end at the first point of the replacement, and the rest of the rolling window is
+/// reloaded from the replacement. Does nothing if no splice is pending for the group.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object which has just advanced to its next segment</param>
+void Ros_MotionControl_ApplyPendingSplice(CtrlGroup* ctrlGroup);
+
+/// <summary>
+/// Advance an iterator of the rolling window, wrapping around at the end of the buffer.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object which owns the buffer</param>
+/// <param name="iterator">Entry in ctrlGroup->trajectoryToProcess</param>
+/// <returns>The next entry in ctrlGroup->trajectoryToProcess</returns>
+JointMotionData* Ros_MotionControl_NextInTrajectoryWindow(CtrlGroup* ctrlGroup, JointMotionData* iterator);
+
+//Interpolation of one segment of a trajectory, one interpolation cycle at a time. The just-in-time
+//conversion (Ros_MotionControl_AddToIncQueueProcess) and the precompilation (Ros_MotionControl_CompileTrajectory)
+//both use it, so they generate exactly the same increments.
+typedef struct
+{
+    JointMotionData const* startTrajData;
+    JointMotionData const* endTrajData;
+    TrajectorySegment segment;          // Polynomial coefficients between startTrajData and endTrajData
+    PulseSegment pulseSegment;          // Same polynomial, in pulses (see fixed_point_interpolation)
+    BOOL bUsePulseSegment;
+    double calculationTime_ms;          // time in ms at which the last interpolation took place
+} SegmentInterpolation;
+
+/// <summary>
+/// Prepare the interpolation of the segment between two points of a trajectory.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object which owns the trajectory</param>
+/// <param name="startTrajData">Start of the segment (must stay valid until the segment is done)</param>
+/// <param name="endTrajData">End of the segment (must stay valid until the segment is done)</param>
+/// <param name="interpolation">Interpolation state which is initialized</param>
+void Ros_MotionControl_StartSegmentInterpolation(CtrlGroup* ctrlGroup, JointMotionData const* startTrajData, JointMotionData const* endTrajData,
+    SegmentInterpolation* interpolation);
+
+/// <summary>
+/// Advance the interpolation of a segment by one cycle and compute the increments of that cycle.
+/// If the cycle reaches the end of the segment, curTrajData becomes the end point, and the part of
+/// the cycle which is left after it is returned in timeLeftover_ms.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object which owns the trajectory</param>
+/// <param name="interpolation">Interpolation state of the segment</param>
+/// <param name="timeInc_ms">Time increment of this cycle</param>
+/// <param name="curTrajData">Interpolated point. Its position and velocity are not updated by the fixed-point interpolation, except at the end of the segment.</param>
+/// <param name="prevPulsePos">Pulse position of the previous cycle, updated to the one of this cycle</param>
+/// <param name="inc">Increments of this cycle</param>
+/// <param name="timeLeftover_ms">Time left of the cycle after the end of the segment (0.0 if it doesn't end within this cycle)</param>
+void Ros_MotionControl_StepSegmentInterpolation(CtrlGroup* ctrlGroup, SegmentInterpolation* interpolation, double timeInc_ms,
+    JointMotionData* curTrajData, long prevPulsePos[MP_GRP_AXES_NUM], LONG inc[MP_GRP_AXES_NUM], double* timeLeftover_ms);
+
+/// <summary>
+/// Decide whether the partial increment at the end of the segment which the group just completed
+/// is queued by itself. The group which completes the segment first decides for all groups.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object which completed the segment</param>
+/// <param name="bFlush">Choice of this group, if it is the first to complete the segment</param>
+/// <returns>TRUE if the partial increment is queued by itself</returns>
+BOOL Ros_MotionControl_DecideFlushPendingInc(CtrlGroup* ctrlGroup, BOOL bFlush);
+
+/// <summary>
+/// Block the AddToIncQueue task of a group until it is signaled (or until ADD_TO_INC_Q_WAIT_TIMEOUT expires).
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object of the calling task</param>
+void Ros_MotionControl_WaitForSignal(CtrlGroup* ctrlGroup);
+
+/// <summary>
+/// Given a joint name, look up the control group + axis number of the
+/// corresponding joint in the joint name table of the controller
 /// </summary>
 /// <param name="jointName">Pointer to the head of the incoming trajectory</param>
 /// <param name="group_idx">Index of the control group which has the joint corresponding to jointName</param>
@@ -33,23 +145,122 @@ BOOL Ros_MotionControl_FindCtrlGroupAndIndex(rosidl_runtime_c__String* jointName
 
 
 /// <summary>
-/// Go through a list of joint names and see if there are any duplicates. 
+/// Map each joint name of a request to its control group and axis, and store the
+/// index in the incoming joint list in CtrlGroup::trajJointIndex. The mapping of the
+/// previous request is cached, so a stream of requests which all use the same list
+/// of joint names doesn't have to look up each name again. The lists are compared by
+/// their hash, so the names are only compared (looked up) when the list changes.
 /// </summary>
 /// <param name="jointNames">A pointer to the structure containing all of the request joint names</param>
-/// <returns>TRUE if there are duplicate names, FALSE if there are no duplicate names</returns>
-BOOL Ros_MotionControl_HasDuplicateNames(rosidl_runtime_c__String__Sequence* jointNames);
+/// <returns>INIT_TRAJ_OK, INIT_TRAJ_INVALID_JOINTNAME or INIT_TRAJ_DUPLICATE_JOINT_NAME</returns>
+Init_Trajectory_Status Ros_MotionControl_MapJointNames(rosidl_runtime_c__String__Sequence* jointNames);
+
+/// <summary>
+/// Get the speed scale to apply to the next interpolation cycle of a group and advance the
+/// group to the following cycle. Speed scaling only applies to MOTION_MODE_TRAJECTORY. In
+/// point-queue mode, the client is in control of the timing, so the scale is always 1.0.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object which is generating the cycle</param>
+/// <returns>Factor by which the interpolation clock advances relative to real time</returns>
+double Ros_MotionControl_StepSpeedScale(CtrlGroup* ctrlGroup);
+
+/// <summary>
+/// Watchdog of the raw-streaming mode. Called by the IncMoveTask at the start of every interpolation
+/// cycle. If the increment queue ran empty while the last queued cycle was still moving, the underrun
+/// is latched: no more increments are sent and further increments are rejected until the mode is
+/// started again. The robot is held by Ros_MotionControl_HandleRawStreamingUnderrun, as that can't
+/// be done from the IncMoveTask without delaying it for many interpolation cycles.
+/// </summary>
+void Ros_MotionControl_CheckRawStreamingUnderrun();
+
+/// <summary>
+/// Set the depth of the increment queue of all groups to the value configured for a motion mode
+/// and discard the refill latency measured by the adaptive depth.
+/// </summary>
+/// <param name="mode">Motion mode which is being started</param>
+void Ros_MotionControl_InitIncQueueDepth(MOTION_MODE mode);
+
+/// <summary>
+/// Measure how many cycles the AddToIncQueue task of a group takes to refill the increment queue after
+/// it was woken up, and size the queue depth from it (adaptive_increment_queue_depth). Called by the
+/// IncMoveTask once per cycle for each group of which the queue was read. Not used for raw streaming,
+/// as the client decides when the queue is refilled.
+/// </summary>
+/// <param name="ctrlGroup">CtrlGroup object of which the queue was read</param>
+/// <param name="countBeforeRead">Number of increments in the queue at the start of the cycle</param>
+/// <param name="countAfterRead">Number of increments left in the queue at the end of the cycle</param>
+/// <param name="bSignaled">TRUE if the AddToIncQueue task was woken up during this cycle</param>
+/// <returns>TRUE if the AddToIncQueue task must be woken up, because the depth was raised above twice the number of
+/// increments left (the queue won't be drained down to the low watermark anymore)</returns>
+BOOL Ros_MotionControl_TrackIncQueueRefill(CtrlGroup* ctrlGroup, int countBeforeRead, int countAfterRead, BOOL bSignaled);
+
+/// <summary>
+/// Update the underrun statistics of the increment queue of all groups (CtrlGroup::incQueueStats).
+/// Called by the IncMoveTask at the start of every interpolation cycle.
+/// </summary>
+void Ros_MotionControl_TrackIncQueueUnderrun();
+
+JointNameMappingCache Ros_MotionControl_JointNameCache;
 
 BOOL Ros_MotionControl_AllGroupsInitComplete = FALSE;
 
+//additional information about why Ros_MotionControl_Init rejected a trajectory (empty if there is none)
+char Ros_MotionControl_InitTrajectoryDetails[INIT_TRAJ_DETAILS_LENGTH];
+
+//speed scale requested by the user (see Ros_MotionControl_SetSpeedScale). The ramp is updated by the
+//executor, while the AddToIncQueue tasks read it every cycle. The lock only serializes the updates.
+//The readers don't take it: the sequence is odd while the ramp is written, and a reader retries if
+//it changed while the ramp was copied (see Ros_MotionControl_ReadSpeedScaleRamp and Q_MEMORY_BARRIER).
+SpeedScaleRamp Ros_MotionControl_SpeedScaleRamp = { SPEED_SCALE_MAX, SPEED_SCALE_MAX, 0 };
+volatile UINT32 Ros_MotionControl_SpeedScaleSequence = 0;
+SEM_ID Ros_MotionControl_SpeedScaleLock = NULL;
+
 MOTION_MODE Ros_MotionControl_ActiveMotionMode = MOTION_MODE_INACTIVE;
 
 BOOL Ros_MotionControl_MustInitializePointQueue = TRUE; //first point of streaming trajectory must match current-position
 
+//state of the raw-streaming mode. The executor queues the increments, the IncMoveTask checks for underruns.
+typedef struct
+{
+    UINT64 time;                //ms, time of the last cycle which was queued
+    BOOL bMoving;               //the last cycle which was queued has a non-zero increment
+    BOOL bUnderrun;             //latched when the queue ran empty while moving (cleared by Ros_MotionControl_ResetRawStreaming)
+    BOOL bHoldPending;          //an underrun was latched, but the robot hasn't been held yet (Ros_MotionControl_HandleRawStreamingUnderrun)
+    int underrunCount;          //total number of underruns (not reset when the mode is started again)
+} RawStreamingState;
+
+RawStreamingState Ros_MotionControl_RawStreaming;
+
+//replacement trajectory which is waiting to be spliced into the active one (see Ros_MotionControl_SpliceTrajectory).
+//The lock is held while a splice is posted and while a group switches over to the replacement.
+typedef struct
+{
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points;
+    UINT64 spliceTime;                          //ms, on the timeline of the active trajectory
+    BOOL bPending[MAX_CONTROLLABLE_GROUPS];     //group hasn't switched over to the replacement yet
+} TrajectorySplice;
+
+TrajectorySplice Ros_MotionControl_PendingSplice;
+SEM_ID Ros_MotionControl_SpliceLock = NULL;
+
+//whether the partial increment at the end of a segment was queued by itself, because the next point was not
+//available yet, or together with the first increment of the next segment. All groups must make the same choice,
+//or they end up an interpolation period apart in the increment queue. The first group to reach the end of a
+//segment makes the choice for all groups. Groups are never more than a window of points apart.
+typedef struct
+{
+    UINT32 decidedCount;        //number of segments for which the choice has been made
+    UINT32 flushMask;           //bit (segment % 32) is set if the partial increment of that segment was queued by itself
+} PendingIncDecision;
+
+PendingIncDecision Ros_MotionControl_PendingIncDecision;
+SEM_ID Ros_MotionControl_PendingIncLock = NULL;
+
 Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence* sequenceGoalJointNames, trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints)
 {
     long requestPulsePos[MAX_PULSE_AXES];
     long currentPulsePos[MAX_PULSE_AXES];
-    int grpIndex, jointIndexInTraj, pointIndex;
+    int grpIndex;
 
     //Verify we're not already running a trajectory
     if (Ros_MotionControl_HasDataToProcess())
@@ -59,12 +270,32 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
     }
 
     Ros_MotionControl_AllGroupsInitComplete = FALSE;
+    bzero(Ros_MotionControl_InitTrajectoryDetails, sizeof(Ros_MotionControl_InitTrajectoryDetails));
+
+    //A group which stopped producing in the middle of the previous trajectory may have left a partial frame
+    //in the queue. Drop it, so all groups start the new trajectory at the same frame.
+    Ros_Controller_IncQ_Resync(&g_Ros_Controller.incQueue);
+
+    if (Ros_MotionControl_PendingIncLock == NULL)
+        Ros_MotionControl_PendingIncLock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+    bzero(&Ros_MotionControl_PendingIncDecision, sizeof(Ros_MotionControl_PendingIncDecision));
 
     //Init internal storage for each group
     for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
         g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
-        bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryPoints = sequenceOfPoints;
+        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryNextPointIndex = 0;
+        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryTimeOffset = 0;
+        bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess));
+    }
+
+    //a replacement for the previous trajectory is no longer relevant
+    if (Ros_MotionControl_SpliceLock != NULL)
+    {
+        mpSemTake(Ros_MotionControl_SpliceLock, WAIT_FOREVER);
+        bzero(&Ros_MotionControl_PendingSplice, sizeof(Ros_MotionControl_PendingSplice));
+        mpSemGive(Ros_MotionControl_SpliceLock);
     }
 
     
@@ -74,51 +305,19 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
         return INIT_TRAJ_INCOMPLETE_JOINTLIST;
     }
 
-    //for each point in the trajectory
-    for (pointIndex = 0; pointIndex < sequenceOfPoints->size; pointIndex += 1)
-    {
-        //verify that we have positions for each axis
-        if (sequenceOfPoints->data[pointIndex].positions.size != g_Ros_Controller.totalAxesCount)
-        {
-            Ros_Debug_BroadcastMsg("Each point in the trajectory must have positions for all axes (pt: %d).", pointIndex);
-            return INIT_TRAJ_WRONG_NUMBER_OF_POSITIONS;
-        }
-
-        //verify that we have velocities for each axis
-        if (sequenceOfPoints->data[pointIndex].velocities.size != g_Ros_Controller.totalAxesCount)
-        {
-            Ros_Debug_BroadcastMsg("Each point in the trajectory must have velocities for all axes (pt: %d).", pointIndex);
-            return INIT_TRAJ_WRONG_NUMBER_OF_VELOCITIES;
-        }
-    }
-
     //===================================
-    //When a goal is received, the all of the points in the trajectory are processed, one joint at a time.
-    //For each of those joints, this iterates over all of the CtrlGroup objects and compares the joint names.
-    //This allows it to find the correct CtrlGroup object and the joint index (in moto order) in the JointMotionData array.
+    //When a goal is received, the joint names are first mapped onto the correct CtrlGroup object and the
+    //joint index (in moto order) in the JointMotionData array.
+    //Then all of the points in the trajectory are validated, one joint at a time.
     //===================================
 
-    if (Ros_MotionControl_HasDuplicateNames(sequenceGoalJointNames))
-    {
-        return INIT_TRAJ_DUPLICATE_JOINT_NAME;
-    }
-
-    //for each joint/axis in a single trajectory point
-    for (jointIndexInTraj = 0; jointIndexInTraj < sequenceGoalJointNames->size; jointIndexInTraj += 1)
-    {
-        int jointIndexInCtrlGroup;
-        CtrlGroup* ctrlGroup;
+    Init_Trajectory_Status mapStatus = Ros_MotionControl_MapJointNames(sequenceGoalJointNames);
+    if (mapStatus != INIT_TRAJ_OK)
+        return mapStatus;
 
-        if (!Ros_MotionControl_FindCtrlGroupAndIndex(&sequenceGoalJointNames->data[jointIndexInTraj], &grpIndex, &jointIndexInCtrlGroup))
-        {
-            return INIT_TRAJ_INVALID_JOINTNAME;
-        }
-        ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
-        //this processes all points in the trajectory array FOR A SINGLE AXIS at a time
-        Init_Trajectory_Status convertStatus = Ros_MotionControl_ConvertTrajectoryToJointMotionData(sequenceOfPoints, jointIndexInTraj, ctrlGroup, jointIndexInCtrlGroup, ctrlGroup->trajectoryToProcess);
-        if (convertStatus != INIT_TRAJ_OK)
-            return convertStatus;
-        } //for each joint in a single trajectory point
+    Init_Trajectory_Status validateStatus = Ros_MotionControl_ValidateTrajectoryData(sequenceOfPoints);
+    if (validateStatus != INIT_TRAJ_OK)
+        return validateStatus;
 
     for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
@@ -126,21 +325,18 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
         CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
         Ros_Debug_BroadcastMsg("Initializing trajectory for group #%d", ctrlGroup->groupNo);
 
-        //---------------
-        // For MPL80/100 robot type (SLU-BT): Controller automatically moves the B-axis
-        // to maintain orientation as other axes are moved.
-        if (ctrlGroup->bIsBaxisSlave)
-        {
-            for (int i = 0; i < sequenceOfPoints->size; i += 1)
-            {
-                //This is radians in MOTO joint order
-                ctrlGroup->trajectoryToProcess[i].pos[4] += -ctrlGroup->trajectoryToProcess[i].pos[1] + ctrlGroup->trajectoryToProcess[i].pos[2];
-                ctrlGroup->trajectoryToProcess[i].vel[4] += -ctrlGroup->trajectoryToProcess[i].vel[1] + ctrlGroup->trajectoryToProcess[i].vel[2];
-            }
-        }
+        //Fill the rolling window. The remaining points are loaded as the window is processed.
+        //The points are marked valid right away, but the Ros_MotionControl_AllGroupsInitComplete flag
+        //prevents the AddToIncQueueProcess loop from processing increments before all groups are synchronized.
+        for (int i = 0; i < TRAJECTORY_WINDOW_SIZE; i += 1)
+            Ros_MotionControl_LoadNextTrajectoryPoint(ctrlGroup, &ctrlGroup->trajectoryToProcess[i]);
 
         // Assign start position
         ctrlGroup->timeLeftover_ms = 0;
+        ctrlGroup->bPendingInc = FALSE;
+        ctrlGroup->segmentCount = 0;
+        ctrlGroup->speedScaleCycle = 0;
+        ctrlGroup->speedScaleDelay_ms = 0.0;
         ctrlGroup->q_time = ctrlGroup->trajectoryToProcess->time;
 
         //Convert start position to pulse format
@@ -168,7 +364,7 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
                 {
                     g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess = FALSE;
                     g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
-                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess));
                 }
 
                 return INIT_TRAJ_INVALID_STARTING_POS;
@@ -183,7 +379,7 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
                 {
                     g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess = FALSE;
                     g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryIterator = NULL;
-                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(JointMotionData) * MAX_NUMBER_OF_POINTS_PER_TRAJECTORY);
+                    bzero(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess, sizeof(g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryToProcess));
                 }
 
                 // excessive speed
@@ -191,14 +387,6 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
             }
         }
 
-        //Although there are additional groups to process, we'll set this flag to indicate that the point is ready for processing.
-        //The Ros_MotionControl_AllGroupsInitComplete flag has not been set yet. That will prevent the AddToIncQueueProcess loop
-        //from processing increments before all groups are synchronized.
-        for (int i = 0; i < sequenceOfPoints->size; i += 1)
-        {
-            ctrlGroup->trajectoryToProcess[i].valid = TRUE;
-        }
-
         memcpy(ctrlGroup->prevPulsePos, currentPulsePos, sizeof(currentPulsePos));
         ctrlGroup->prevTrajectoryIterator = &ctrlGroup->trajectoryToProcess[0];
         ctrlGroup->trajectoryIterator = &ctrlGroup->trajectoryToProcess[1];
@@ -207,7 +395,32 @@ Init_Trajectory_Status Ros_MotionControl_Init(rosidl_runtime_c__String__Sequence
 
     } //for each group in the controller
 
+    //The cycle count of each group restarts with the new trajectory, so the ramp has to restart as well.
+    //The new trajectory starts right away at the most recently requested speed scale.
+    double speedScale = SPEED_SCALE_MAX;
+    if (Ros_MotionControl_SpeedScaleLock != NULL)
+    {
+        SpeedScaleRamp ramp;
+
+        mpSemTake(Ros_MotionControl_SpeedScaleLock, WAIT_FOREVER);
+        ramp.startScale = Ros_MotionControl_SpeedScaleRamp.targetScale;
+        ramp.targetScale = Ros_MotionControl_SpeedScaleRamp.targetScale;
+        ramp.startCycle = 0;
+        Ros_MotionControl_WriteSpeedScaleRamp(&ramp);
+        speedScale = ramp.targetScale;
+        mpSemGive(Ros_MotionControl_SpeedScaleLock);
+    }
+
+    //A precompiled trajectory is replayed at full speed. At a lower speed scale, it is converted just in time.
+    if (g_nodeConfigSettings.precompile_trajectories && Ros_MotionControl_IsMotionMode_Trajectory() && speedScale >= SPEED_SCALE_MAX)
+        Ros_IncPrecompile_Start();
+    else
+        Ros_IncPrecompile_Cancel();
+
+    Ros_MotionControl_ResetIncQueueStats();
+
     Ros_MotionControl_AllGroupsInitComplete = TRUE;
+    Ros_MotionControl_SignalAddToIncQueue_All();
 
     return INIT_TRAJ_OK;
 }
@@ -220,6 +433,35 @@ Init_Trajectory_Status Ros_MotionControl_InitTrajectory(control_msgs__action__Fo
     if (pending_ros_goal_request == NULL || pending_ros_goal_request->goal.trajectory.points.size < MIN_NUMBER_OF_POINTS_PER_TRAJECTORY)
         return INIT_TRAJ_TOO_SMALL;
 
+    //The timing of a trajectory which only contains waypoints is computed here. The
+    //joint names are mapped first, as the limits of each joint are needed for that.
+    if (Ros_MotionControl_IsSparseTrajectory(&pending_ros_goal_request->goal.trajectory.points))
+    {
+        Init_Trajectory_Status status;
+
+        if (Ros_MotionControl_HasDataToProcess())
+            return INIT_TRAJ_ALREADY_IN_MOTION;
+
+        bzero(Ros_MotionControl_InitTrajectoryDetails, sizeof(Ros_MotionControl_InitTrajectoryDetails));
+
+        if (g_Ros_Controller.totalAxesCount != pending_ros_goal_request->goal.trajectory.joint_names.size)
+        {
+            Ros_Debug_BroadcastMsg("Trajectory must contain data for all %d joints.", g_Ros_Controller.totalAxesCount);
+            return INIT_TRAJ_INCOMPLETE_JOINTLIST;
+        }
+
+        status = Ros_MotionControl_MapJointNames(&pending_ros_goal_request->goal.trajectory.joint_names);
+        if (status != INIT_TRAJ_OK)
+            return status;
+
+        Ros_Debug_BroadcastMsg("Computing the timing of %d waypoints", (int)pending_ros_goal_request->goal.trajectory.points.size);
+        status = Ros_MotionControl_TimeParameterizeTrajectory(g_Ros_Controller.ctrlGroups, g_Ros_Controller.numGroup,
+            g_Ros_Controller.totalAxesCount, &pending_ros_goal_request->goal.trajectory.points,
+            g_Ros_Controller.interpolPeriod, g_nodeConfigSettings.quintic_interpolation);
+        if (status != INIT_TRAJ_OK)
+            return status;
+    }
+
     return Ros_MotionControl_Init(&pending_ros_goal_request->goal.trajectory.joint_names, &pending_ros_goal_request->goal.trajectory.points);
 }
 
@@ -236,842 +478,2426 @@ Init_Trajectory_Status Ros_MotionControl_InitPointQueue(motoros2_interfaces__srv
     pointSequence.size = 1;
     pointSequence.data = &request->point; //no additional memory is allocated this way
 
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        g_Ros_Controller.ctrlGroups[grpIndex]->pointQueueUnderrunCount = 0;
+
     status = Ros_MotionControl_Init(&request->joint_names, &pointSequence);
 
+    //pointSequence only lives on the stack of this function. The following points
+    //are placed in the window by Ros_MotionControl_ProcessQueuedTrajectoryPoint.
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        g_Ros_Controller.ctrlGroups[grpIndex]->trajectoryPoints = NULL;
+
     if (status == INIT_TRAJ_OK)
         Ros_MotionControl_MustInitializePointQueue = FALSE;
 
     return status;
 }
 
-Init_Trajectory_Status Ros_MotionControl_ConvertTrajectoryToJointMotionData(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* in_jointTrajData, 
-    int incomingAxisIndex, CtrlGroup* ctrlGroup, int ctrlGroupAxisIndex, JointMotionData* out_jointMotionData)
+Init_Trajectory_Status Ros_MotionControl_ValidateTrajectoryData(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints)
 {
-    for (int i = 0; i < in_jointTrajData->size; i += 1) //for each point in trajectory
+    int grpIndex, jointIndexInTraj, pointIndex;
+
+    //for each point in the trajectory
+    for (pointIndex = 0; pointIndex < sequenceOfPoints->size; pointIndex += 1)
     {
-        INT64 millis = Ros_Duration_Msg_To_Millis(&in_jointTrajData->data[i].time_from_start);
-        if (millis < 0)
+        //verify that we have positions for each axis
+        if (sequenceOfPoints->data[pointIndex].positions.size != g_Ros_Controller.totalAxesCount)
         {
-            Ros_Debug_BroadcastMsg("The trajectory [time_from_start] may not be negative (pt: %d).", i);
-            return INIT_TRAJ_INVALID_TIME;
+            Ros_Debug_BroadcastMsg("Each point in the trajectory must have positions for all axes (pt: %d).", pointIndex);
+            return INIT_TRAJ_WRONG_NUMBER_OF_POSITIONS;
         }
-        if (millis == 0 && i != 0) //a time of 0 will cause the accel calculations to fail
+
+        //verify that we have velocities for each axis
+        if (sequenceOfPoints->data[pointIndex].velocities.size != g_Ros_Controller.totalAxesCount)
         {
-            Ros_Debug_BroadcastMsg("The trajectory [time_from_start] may only be '0' for the first point in a trajectory (pt: %d).", i);
-            return INIT_TRAJ_INVALID_TIME;
+            Ros_Debug_BroadcastMsg("Each point in the trajectory must have velocities for all axes (pt: %d).", pointIndex);
+            return INIT_TRAJ_WRONG_NUMBER_OF_VELOCITIES;
         }
-        out_jointMotionData[i].time = millis;
+    }
 
-        if (i != 0)
+    //for each joint/axis in a single trajectory point
+    for (jointIndexInTraj = 0; jointIndexInTraj < g_Ros_Controller.totalAxesCount; jointIndexInTraj += 1)
+    {
+        //this validates all points in the trajectory array FOR A SINGLE AXIS at a time
+        Init_Trajectory_Status validateStatus = Ros_MotionControl_ValidateTrajectoryJoint(sequenceOfPoints, jointIndexInTraj);
+        if (validateStatus != INIT_TRAJ_OK)
+            return validateStatus;
+    } //for each joint in a single trajectory point
+
+    //check the limits of each group for the entire trajectory before any motion is started
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        TrajectoryLimitViolation violation;
+
+        Init_Trajectory_Status limitStatus = Ros_MotionControl_ValidateTrajectoryLimits(ctrlGroup, sequenceOfPoints,
+            g_Ros_Controller.interpolPeriod, g_nodeConfigSettings.quintic_interpolation, &violation);
+        if (limitStatus != INIT_TRAJ_OK)
         {
-            //ensure that the time is greater than the previous point.
-            //Check this using out_jointMotionData as time has already been converted
-            //to a single scalar per point which is easier to compare against than
-            //the msg__Duration struct in in_jointTrajData.
-            if (out_jointMotionData[i].time < out_jointMotionData[i - 1].time)
+            if (violation.limitType == TRAJ_LIMIT_INCREMENT)
             {
-                Ros_Debug_BroadcastMsg("Each point in the trajectory must have a [time_from_start] greater than the previous (pt: %d).", i);
-                return INIT_TRAJ_BACKWARD_TIME;
+                snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                    "pt: %d, group: %d, axis: %d, increment of %.1f pulses/cycle exceeds the limit of %.0f",
+                    violation.pointIndex, ctrlGroup->groupNo, violation.axis, violation.value, violation.limit);
             }
-        }
-
-        //Last point in the trajectory. This only applies when receiving an entire trajectory through the FJT action.
-        if (Ros_MotionControl_IsMotionMode_Trajectory() && i == (in_jointTrajData->size - 1))
-        {
-            //verify that the robot is commanded to stop at the end of the trajectory
-            if (fabs(in_jointTrajData->data[i].velocities.data[incomingAxisIndex]) > EPSILON_TOLERANCE_DOUBLE) // float version of "!=0"
+            else if (violation.limitType == TRAJ_LIMIT_ACCELERATION)
             {
-                Ros_Debug_BroadcastMsg("The final point in a trajectory must specify a target velocity of '0'.");
-                return INIT_TRAJ_INVALID_ENDING_VELOCITY;
+                snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                    "pt: %d, group: %d, axis: %d, acceleration of %.2f exceeds the limit of %.2f",
+                    violation.pointIndex, ctrlGroup->groupNo, violation.axis, violation.value, violation.limit);
             }
-
-            //Acceleration is not used. But we want to ensure the trajectory is well behaved and well shaped.
-            //The JointTrajectoryController from ros(2)_control can sometimes behave rather strangely when the
-            //last point doesn't have zero vel/acc (probably caused by the spline interpolation doing weird 
-            //things with non - zero values for velocityand acceleration).
-            // ------------------------------------------
-            //UPDATE (2023/05/23): It seems that MoveIt doesn't follow this practice. All trajectories from MoveIt have a
-            // non-zero acceleration at the end of the trajectory. So we'll remove this check for now.
-            // This may be restored in a future update.
-            // 
-            //if ((in_jointTrajData->data[i].accelerations.size > incomingAxisIndex) &&
-            //    fabs(in_jointTrajData->data[i].accelerations.data[incomingAxisIndex]) > EPSILON_TOLERANCE_DOUBLE) // float version of "!=0"
-            //{
-            //    Ros_Debug_BroadcastMsg("The final point in a trajectory must specify a target acceleration of '0'.");
-            //    return INIT_TRAJ_INVALID_ENDING_ACCELERATION;
-            //}
+            else
+            {
+                snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                    "pt: %d, group: %d, axis: %d, velocity of %.4f exceeds the limit of %.4f",
+                    violation.pointIndex, ctrlGroup->groupNo, violation.axis, violation.value, violation.limit);
+            }
+            Ros_Debug_BroadcastMsg("ERROR: Trajectory exceeds the limits (%s)", Ros_MotionControl_InitTrajectoryDetails);
+            return limitStatus;
         }
-
-        out_jointMotionData[i].pos[ctrlGroupAxisIndex] = in_jointTrajData->data[i].positions.data[incomingAxisIndex];
-        out_jointMotionData[i].vel[ctrlGroupAxisIndex] = in_jointTrajData->data[i].velocities.data[incomingAxisIndex];
     }
 
     return INIT_TRAJ_OK;
 }
 
 //-----------------------------------------------------------------------
-// Task that handles in the background messages that may have long processing
-// time so that they don't block other message from being processed.
+// Replace the remainder of the active trajectory with a new one, without
+// stopping the motion
 //-----------------------------------------------------------------------
-void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
+Init_Trajectory_Status Ros_MotionControl_SpliceTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request, INT64 spliceTime)
 {
-    int i;
+    rosidl_runtime_c__String__Sequence* sequenceGoalJointNames;
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence* sequenceOfPoints;
+    JointNameMappingCache* cache = &Ros_MotionControl_JointNameCache;
+    JointMotionData activeState;
+    JointMotionData replacementStart;
+    long activePulsePos[MAX_PULSE_AXES];
+    long replacementPulsePos[MAX_PULSE_AXES];
+    Init_Trajectory_Status status;
+    int grpIndex, i;
 
-    while (TRUE)
-    {
-        if (Ros_MotionControl_AllGroupsInitComplete)
-        {
-            // if there is no message to process, delay and try again
-            if (!g_Ros_Controller.bStopMotion && ctrlGroup->hasDataToProcess && ctrlGroup->trajectoryIterator != NULL && ctrlGroup->trajectoryIterator->valid)
-            {
+    if (pending_ros_goal_request == NULL || pending_ros_goal_request->goal.trajectory.points.size < MIN_NUMBER_OF_POINTS_PER_TRAJECTORY)
+        return INIT_TRAJ_TOO_SMALL;
 
-                Ros_Debug_BroadcastMsg("Processing next point in trajectory [Group #%d - T=%.3f: (%7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f)]",
-                    ctrlGroup->groupNo, (double)ctrlGroup->trajectoryIterator->time * 0.001,
-                    ctrlGroup->trajectoryIterator->pos[0], ctrlGroup->trajectoryIterator->pos[1], ctrlGroup->trajectoryIterator->pos[2],
-                    ctrlGroup->trajectoryIterator->pos[3], ctrlGroup->trajectoryIterator->pos[4], ctrlGroup->trajectoryIterator->pos[5],
-                    ctrlGroup->trajectoryIterator->pos[6], ctrlGroup->trajectoryIterator->pos[7]);
+    sequenceGoalJointNames = &pending_ros_goal_request->goal.trajectory.joint_names;
+    sequenceOfPoints = &pending_ros_goal_request->goal.trajectory.points;
+    bzero(Ros_MotionControl_InitTrajectoryDetails, sizeof(Ros_MotionControl_InitTrajectoryDetails));
 
-                //-------------------------------------
-                // Check that incoming data is valid
-                for (i = 0; i < ctrlGroup->numAxes; i++)
-                {
-                    // Velocity check
-                    if (abs(ctrlGroup->trajectoryIterator->vel[i]) > ctrlGroup->maxSpeed[i])
-                    {
-                        // excessive speed
-                        Ros_Debug_BroadcastMsg("ERROR: Invalid speed in message TrajPointFull data: \n  axis: %d, speed: %f, limit: %f\n",
-                            i, ctrlGroup->trajectoryIterator->vel[i], ctrlGroup->maxSpeed[i]);
+    if (Ros_MotionControl_SpliceLock == NULL || !Ros_MotionControl_AllGroupsInitComplete || !Ros_MotionControl_HasDataToProcess())
+    {
+        snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+            "the active trajectory has already been processed completely");
+        return INIT_TRAJ_ALREADY_IN_MOTION;
+    }
 
-                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
-                        ctrlGroup->hasDataToProcess = FALSE;
-                        continue;
-                    }
-                }
+    if (Ros_IncPrecompile_IsPending() || Ros_IncPrecompile_IsReady())
+    {
+        snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+            "the active trajectory has been precompiled, it can't be replaced");
+        return INIT_TRAJ_ALREADY_IN_MOTION;
+    }
 
-                //-------------------------------------
+    //The replacement is converted with the joint mapping of the active trajectory (CtrlGroup::trajJointIndex).
+    //It can't be remapped while the active trajectory is still being processed, so the joints must be in the same order.
+    if (!Ros_MotionControl_IsSameJointOrder(cache, sequenceGoalJointNames))
+    {
+        snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+            "a replacement trajectory must list the joints in the same order as the active trajectory");
+        return INIT_TRAJ_INVALID_JOINTNAME;
+    }
 
-                JointMotionData _startTrajData;
-                JointMotionData* startTrajData;
-                JointMotionData* endTrajData;
-                JointMotionData* curTrajData;
-                double interval;                    // Time between startTime and the new data time
-                double accCoef1[MP_GRP_AXES_NUM];   // Acceleration coefficient 1
-                double accCoef2[MP_GRP_AXES_NUM];   // Acceleration coefficient 2
-                UINT64 timeInc_ms;                  // time increment in millisecond
-                UINT64 calculationTime_ms;          // time in ms at which the interpolation takes place
-                long newPulsePos[MP_GRP_AXES_NUM];
-                Incremental_data incData;
+    status = Ros_MotionControl_ValidateTrajectoryData(sequenceOfPoints);
+    if (status != INIT_TRAJ_OK)
+        return status;
 
-                // Initialization of pointers and memory
-                curTrajData = ctrlGroup->prevTrajectoryIterator;
-                endTrajData = ctrlGroup->trajectoryIterator;
-                startTrajData = &_startTrajData;
-                // Set the start of the trajectory interpolation as the current position (which should be the end of last interpolation)
-                memcpy(startTrajData, curTrajData, sizeof(JointMotionData));
+    if (Ros_Duration_Msg_To_Millis(&sequenceOfPoints->data[0].time_from_start) != 0)
+    {
+        snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+            "the first point of a replacement trajectory must have a time_from_start of 0");
+        return INIT_TRAJ_INVALID_TIME;
+    }
 
-                // For MPL80/100 robot type (SLUBT): Controller automatically moves the B-axis
-                // to maintain orientation as other axes are moved.
-                if (ctrlGroup->bIsBaxisSlave)
-                {
-                    //moto joint order
-                    endTrajData->pos[4] += -endTrajData->pos[1] + endTrajData->pos[2];
-                    endTrajData->vel[4] += -endTrajData->vel[1] + endTrajData->vel[2];
-                }
+    //The first point of the replacement must match the state of the active trajectory at the splice time
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
 
-                bzero(newPulsePos, sizeof(newPulsePos));
-                bzero(&incData, sizeof(incData));
-                incData.frame = MP_INC_PULSE_DTYPE;
-                incData.tool = ctrlGroup->tool;
+        if (!Ros_MotionControl_SampleTrajectory(ctrlGroup, ctrlGroup->trajectoryPoints, spliceTime - (INT64)ctrlGroup->trajectoryTimeOffset,
+            g_nodeConfigSettings.quintic_interpolation, &activeState))
+        {
+            snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                "group: %d, the splice time of %lld ms is not within the active trajectory", ctrlGroup->groupNo, spliceTime);
+            return INIT_TRAJ_INVALID_TIME;
+        }
 
-                // Calculate an acceleration coefficients
-                bzero(&accCoef1, sizeof(accCoef1));
-                bzero(&accCoef2, sizeof(accCoef2));
-                interval = (endTrajData->time - startTrajData->time) / 1000.0;  // time difference in sec
-                if (interval > 0.0)
-                {
-                    for (i = 0; i < ctrlGroup->numAxes; i++)
-                    {
-                        //Calculate acceleration coefficient (convert interval to seconds
-                        accCoef1[i] = (6 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval))
-                            - (2 * (endTrajData->vel[i] + 2 * startTrajData->vel[i]) / interval);
-                        accCoef2[i] = (-12 * (endTrajData->pos[i] - startTrajData->pos[i]) / (interval * interval * interval))
-                            + (6 * (endTrajData->vel[i] + startTrajData->vel[i]) / (interval * interval));
-                    }
-                }
-                else
-                {
-                    Ros_Debug_BroadcastMsg("Warning: Group %d - Time difference between endTrajData (%lld) and startTrajData (%lld) is 0 or less.\n", ctrlGroup->groupNo, endTrajData->time, startTrajData->time);
-                }
+        bzero(&replacementStart, sizeof(replacementStart));
+        Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(ctrlGroup, &sequenceOfPoints->data[0], &replacementStart);
 
-                // Initialize calculation variable before entering while loop
-                calculationTime_ms = startTrajData->time;
-                if (ctrlGroup->timeLeftover_ms == 0)
-                    timeInc_ms = g_Ros_Controller.interpolPeriod;
-                else
-                    timeInc_ms = ctrlGroup->timeLeftover_ms;
+        Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, activeState.pos, activePulsePos);
+        Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, replacementStart.pos, replacementPulsePos);
+
+        for (i = 0; i < ctrlGroup->numAxes; i += 1)
+        {
+            if (abs(replacementPulsePos[i] - activePulsePos[i]) > START_MAX_PULSE_DEVIATION)
+            {
+                snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                    "pt: 0, group: %d, axis: %d, position is %ld pulses away from the active trajectory at %lld ms",
+                    ctrlGroup->groupNo, i, replacementPulsePos[i] - activePulsePos[i], spliceTime);
+                return INIT_TRAJ_INVALID_STARTING_POS;
+            }
+
+            if (fabs(replacementStart.vel[i] - activeState.vel[i]) > SPLICE_MAX_VELOCITY_DEVIATION)
+            {
+                snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                    "pt: 0, group: %d, axis: %d, velocity of %.4f doesn't match the active trajectory (%.4f) at %lld ms",
+                    ctrlGroup->groupNo, i, replacementStart.vel[i], activeState.vel[i], spliceTime);
+                return INIT_TRAJ_INVALID_VELOCITY;
+            }
+        }
+    }
+
+    //Each group switches over once it reaches the splice time. This is only possible if none of the groups
+    //has started the segment which contains the splice time yet. (The lock keeps the groups from switching
+    //over while this is checked.)
+    mpSemTake(Ros_MotionControl_SpliceLock, WAIT_FOREVER);
+
+    status = INIT_TRAJ_OK;
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup && status == INIT_TRAJ_OK; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+
+        if (Ros_MotionControl_PendingSplice.bPending[grpIndex])
+        {
+            snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                "another replacement trajectory is waiting to be spliced in");
+            status = INIT_TRAJ_ALREADY_IN_MOTION;
+        }
+        else if (!Ros_MotionControl_IsBeforeSpliceTime(ctrlGroup, (UINT64)spliceTime))
+        {
+            snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                "group: %d, the active trajectory has already been processed past the splice time of %lld ms", ctrlGroup->groupNo, spliceTime);
+            status = INIT_TRAJ_ALREADY_IN_MOTION;
+        }
+    }
+
+    if (status == INIT_TRAJ_OK)
+    {
+        Ros_MotionControl_PendingSplice.points = sequenceOfPoints;
+        Ros_MotionControl_PendingSplice.spliceTime = (UINT64)spliceTime;
+        for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+            Ros_MotionControl_PendingSplice.bPending[grpIndex] = TRUE;
+    }
+
+    mpSemGive(Ros_MotionControl_SpliceLock);
+
+    if (status == INIT_TRAJ_OK)
+        Ros_Debug_BroadcastMsg("Replacement trajectory will be spliced in at %lld ms", spliceTime);
+    else
+        Ros_Debug_BroadcastMsg("ERROR: Replacement trajectory can't be spliced in (%s)", Ros_MotionControl_InitTrajectoryDetails);
+
+    return status;
+}
+
+//-----------------------------------------------------------------------
+// Whether the joints of a replacement trajectory are listed in the same order
+// as those of the active trajectory (the last successfully mapped list)
+//-----------------------------------------------------------------------
+BOOL Ros_MotionControl_IsSameJointOrder(JointNameMappingCache const* cache, rosidl_runtime_c__String__Sequence const* jointNames)
+{
+    BOOL bSameJointOrder = (cache->count == jointNames->size);
+
+    for (int i = 0; bSameJointOrder && i < jointNames->size; i += 1)
+        bSameJointOrder = (strncmp(cache->names[i], jointNames->data[i].data, MAX_JOINT_NAME_LENGTH) == 0);
+
+    return bSameJointOrder;
+}
+
+//-----------------------------------------------------------------------
+// Whether a group can still switch over at the splice time: it must not have
+// started the segment which contains the splice time yet
+//-----------------------------------------------------------------------
+BOOL Ros_MotionControl_IsBeforeSpliceTime(CtrlGroup const* ctrlGroup, UINT64 spliceTime)
+{
+    JointMotionData const* iterator = ctrlGroup->trajectoryIterator;
+
+    return ctrlGroup->hasDataToProcess && iterator != NULL && iterator->valid && iterator->time < spliceTime;
+}
+
+void Ros_MotionControl_ApplyPendingSplice(CtrlGroup* ctrlGroup)
+{
+    TrajectorySplice* splice = &Ros_MotionControl_PendingSplice;
+
+    if (Ros_MotionControl_SpliceLock == NULL)
+        return;
+
+    //The lock is taken even if no splice is pending. Otherwise a splice which is posted while this group
+    //advances its iterators could be missed, and the group would switch over at a later segment instead.
+    mpSemTake(Ros_MotionControl_SpliceLock, WAIT_FOREVER);
+
+    JointMotionData* iterator = ctrlGroup->trajectoryIterator;
+    if (splice->bPending[ctrlGroup->groupNo] && (!iterator->valid || iterator->time >= splice->spliceTime))
+    {
+        ctrlGroup->trajectoryPoints = splice->points;
+        ctrlGroup->trajectoryNextPointIndex = 0;
+        ctrlGroup->trajectoryTimeOffset = splice->spliceTime;
+
+        //The segment which starts at prevTrajectoryIterator now ends at the first point of the replacement.
+        //The remaining entries of the window are reloaded with the points which follow it.
+        do
+        {
+            Ros_MotionControl_LoadNextTrajectoryPoint(ctrlGroup, iterator);
+            iterator = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, iterator);
+        } while (iterator != ctrlGroup->prevTrajectoryIterator);
+
+        splice->bPending[ctrlGroup->groupNo] = FALSE;
+        Ros_Debug_BroadcastMsg("Group #%d - Replacement trajectory spliced in at %llu ms", ctrlGroup->groupNo, splice->spliceTime);
+    }
+
+    mpSemGive(Ros_MotionControl_SpliceLock);
+}
+
+BOOL Ros_MotionControl_IsSplicePending()
+{
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        //a group which stopped processing will never switch over
+        if (Ros_MotionControl_PendingSplice.bPending[grpIndex] && g_Ros_Controller.ctrlGroups[grpIndex]->hasDataToProcess)
+            return TRUE;
+    }
+
+    return FALSE;
+}
+
+void Ros_MotionControl_InitTrajectorySplice()
+{
+    bzero(&Ros_MotionControl_PendingSplice, sizeof(Ros_MotionControl_PendingSplice));
+
+    if (Ros_MotionControl_SpliceLock == NULL)
+        Ros_MotionControl_SpliceLock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
+}
+
+void Ros_MotionControl_CleanupTrajectorySplice()
+{
+    if (Ros_MotionControl_SpliceLock != NULL)
+    {
+        mpSemDelete(Ros_MotionControl_SpliceLock);
+        Ros_MotionControl_SpliceLock = NULL;
+    }
+}
+
+Init_Trajectory_Status Ros_MotionControl_ValidateTrajectoryJoint(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* in_jointTrajData, int incomingAxisIndex)
+{
+    INT64 prevMillis = 0;
+
+    for (int i = 0; i < in_jointTrajData->size; i += 1) //for each point in trajectory
+    {
+        INT64 millis = Ros_Duration_Msg_To_Millis(&in_jointTrajData->data[i].time_from_start);
+        if (millis < 0)
+        {
+            Ros_Debug_BroadcastMsg("The trajectory [time_from_start] may not be negative (pt: %d).", i);
+            return INIT_TRAJ_INVALID_TIME;
+        }
+        if (millis == 0 && i != 0) //a time of 0 will cause the accel calculations to fail
+        {
+            Ros_Debug_BroadcastMsg("The trajectory [time_from_start] may only be '0' for the first point in a trajectory (pt: %d).", i);
+            return INIT_TRAJ_INVALID_TIME;
+        }
+
+        if (i != 0)
+        {
+            //ensure that the time is greater than the previous point.
+            //Check this using the converted time, as that is a single scalar per point
+            //which is easier to compare against than the msg__Duration struct in in_jointTrajData.
+            if (millis < prevMillis)
+            {
+                Ros_Debug_BroadcastMsg("Each point in the trajectory must have a [time_from_start] greater than the previous (pt: %d).", i);
+                return INIT_TRAJ_BACKWARD_TIME;
+            }
+        }
+        prevMillis = millis;
+
+        //Last point in the trajectory. This only applies when receiving an entire trajectory through the FJT action.
+        if (Ros_MotionControl_IsMotionMode_Trajectory() && i == (in_jointTrajData->size - 1))
+        {
+            //verify that the robot is commanded to stop at the end of the trajectory
+            if (fabs(in_jointTrajData->data[i].velocities.data[incomingAxisIndex]) > EPSILON_TOLERANCE_DOUBLE) // float version of "!=0"
+            {
+                Ros_Debug_BroadcastMsg("The final point in a trajectory must specify a target velocity of '0'.");
+                return INIT_TRAJ_INVALID_ENDING_VELOCITY;
+            }
+
+            //Acceleration is not used. But we want to ensure the trajectory is well behaved and well shaped.
+            //The JointTrajectoryController from ros(2)_control can sometimes behave rather strangely when the
+            //last point doesn't have zero vel/acc (probably caused by the spline interpolation doing weird 
+            //things with non - zero values for velocityand acceleration).
+            // ------------------------------------------
+            //UPDATE (2023/05/23): It seems that MoveIt doesn't follow this practice. All trajectories from MoveIt have a
+            // non-zero acceleration at the end of the trajectory. So we'll remove this check for now.
+            // This may be restored in a future update.
+            // 
+            //if ((in_jointTrajData->data[i].accelerations.size > incomingAxisIndex) &&
+            //    fabs(in_jointTrajData->data[i].accelerations.data[incomingAxisIndex]) > EPSILON_TOLERANCE_DOUBLE) // float version of "!=0"
+            //{
+            //    Ros_Debug_BroadcastMsg("The final point in a trajectory must specify a target acceleration of '0'.");
+            //    return INIT_TRAJ_INVALID_ENDING_ACCELERATION;
+            //}
+        }
+    }
+
+    return INIT_TRAJ_OK;
+}
+
+Init_Trajectory_Status Ros_MotionControl_ValidateTrajectoryLimits(CtrlGroup* ctrlGroup, trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points,
+    int interpolPeriod, BOOL bQuintic, TrajectoryLimitViolation* violation)
+{
+    JointMotionData pointData[2];
+    JointMotionData* startData = &pointData[0];
+    JointMotionData* endData = &pointData[1];
+    TrajectorySegment segment;
+    double peakSpeed[MP_GRP_AXES_NUM];
+    double peakAcc[MP_GRP_AXES_NUM];
+    double const* pulsesPerUnit = ctrlGroup->jointTransform.toMotoFactor; //0.0 for invalid axes
+    double cycleTime = interpolPeriod / 1000.0; // in sec
+    int axis;
+
+    bzero(violation, sizeof(TrajectoryLimitViolation));
+    violation->pointIndex = -1;
+
+    bzero(pointData, sizeof(pointData));
+
+    for (int pointIndex = 0; pointIndex < points->size; pointIndex += 1)
+    {
+        //(the same conversion as for the execution, including the B-axis compensation)
+        Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(ctrlGroup, &points->data[pointIndex], endData);
+
+        //velocity of the point itself
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+        {
+            double speedLimit = Ros_MotionControl_GetMotoAxisSpeedLimit(ctrlGroup, axis);
+            if (pulsesPerUnit[axis] != 0.0 && fabs(endData->vel[axis]) > speedLimit)
+            {
+                violation->pointIndex = pointIndex;
+                violation->axis = axis;
+                violation->limitType = TRAJ_LIMIT_VELOCITY;
+                violation->value = endData->vel[axis];
+                violation->limit = speedLimit;
+                return INIT_TRAJ_INVALID_VELOCITY;
+            }
+        }
+
+        //increments per interpolation cycle of the segment which ends at this point
+        if (pointIndex > 0)
+        {
+            double interval = (endData->time - startData->time) / 1000.0;
+
+            Ros_MotionControl_ComputeSegment(startData, endData, MP_GRP_AXES_NUM, bQuintic, &segment);
+            Ros_MotionControl_SegmentPeakSpeed(&segment, MP_GRP_AXES_NUM, interval, peakSpeed);
+
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            {
+                double peakIncrement = peakSpeed[axis] * cycleTime * pulsesPerUnit[axis];
+                if (peakIncrement > ctrlGroup->maxInc.maxIncrement[axis] && pulsesPerUnit[axis] != 0.0)
+                {
+                    violation->pointIndex = pointIndex;
+                    violation->axis = axis;
+                    violation->limitType = TRAJ_LIMIT_INCREMENT;
+                    violation->value = peakIncrement;
+                    violation->limit = ctrlGroup->maxInc.maxIncrement[axis];
+                    return INIT_TRAJ_INVALID_VELOCITY;
+                }
+            }
+
+            //acceleration implied by the segment
+            Ros_MotionControl_SegmentPeakAcceleration(&segment, MP_GRP_AXES_NUM, interval, peakAcc);
+
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            {
+                double accLimit = Ros_MotionControl_GetMotoAxisSpeedLimit(ctrlGroup, axis) / TRAJECTORY_LIMIT_ACCEL_TIME;
+                if (peakAcc[axis] > accLimit && pulsesPerUnit[axis] != 0.0)
+                {
+                    violation->pointIndex = pointIndex;
+                    violation->axis = axis;
+                    violation->limitType = TRAJ_LIMIT_ACCELERATION;
+                    violation->value = peakAcc[axis];
+                    violation->limit = accLimit;
+                    return INIT_TRAJ_INVALID_VELOCITY;
+                }
+            }
+        }
+
+        //the end of this segment is the start of the next one
+        JointMotionData* swap = startData;
+        startData = endData;
+        endData = swap;
+    }
+
+    return INIT_TRAJ_OK;
+}
+
+//-------------------------------------------------------------------
+// A sparse trajectory only contains the positions of its waypoints. The
+// timing is computed by Ros_MotionControl_TimeParameterizeTrajectory.
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_IsSparseTrajectory(trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points)
+{
+    if (points->size == 0)
+        return FALSE;
+
+    for (int pointIndex = 0; pointIndex < points->size; pointIndex += 1)
+    {
+        if (points->data[pointIndex].velocities.size != 0 || points->data[pointIndex].accelerations.size != 0)
+            return FALSE;
+    }
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Velocity of each joint at the waypoints, for the current timing. The robot
+// passes a waypoint at the (time-weighted) average speed of the adjacent segments,
+// but no faster than the slower of both, so the joint doesn't overshoot. It stops
+// at the first and the last waypoint, and where a joint reverses.
+//-------------------------------------------------------------------
+static void Ros_MotionControl_SetWaypointVelocities(trajectory_msgs__msg__JointTrajectoryPoint__Sequence* points, int numAxes)
+{
+    for (int pointIndex = 0; pointIndex < points->size; pointIndex += 1)
+    {
+        trajectory_msgs__msg__JointTrajectoryPoint* point = &points->data[pointIndex];
+
+        for (int joint = 0; joint < numAxes; joint += 1)
+        {
+            double vel = 0.0;
+
+            if (pointIndex > 0 && pointIndex < (points->size - 1))
+            {
+                trajectory_msgs__msg__JointTrajectoryPoint const* prev = &points->data[pointIndex - 1];
+                trajectory_msgs__msg__JointTrajectoryPoint const* next = &points->data[pointIndex + 1];
+                double t0 = (Ros_Duration_Msg_To_Millis(&point->time_from_start) - Ros_Duration_Msg_To_Millis(&prev->time_from_start)) / 1000.0;
+                double t1 = (Ros_Duration_Msg_To_Millis(&next->time_from_start) - Ros_Duration_Msg_To_Millis(&point->time_from_start)) / 1000.0;
+                double s0 = (point->positions.data[joint] - prev->positions.data[joint]) / t0;
+                double s1 = (next->positions.data[joint] - point->positions.data[joint]) / t1;
+
+                if (s0 * s1 > 0.0)
+                {
+                    vel = (s0 * t1 + s1 * t0) / (t0 + t1);
+                    if (fabs(vel) > fabs(s0))
+                        vel = s0;
+                    if (fabs(vel) > fabs(s1))
+                        vel = s1;
+                }
+            }
+
+            point->velocities.data[joint] = vel;
+        }
+    }
+}
+
+//-------------------------------------------------------------------
+// Compute a speed and acceleration bounded timing for a sparse trajectory. The
+// duration of each segment is sized so that a rest to rest motion of its slowest
+// joint stays within the speed limit of each axis (maxSpeed and maxInc) and the
+// acceleration and jerk limits derived from it (see SPARSE_TRAJECTORY_*). This
+// only sizes the segments: the velocities at the waypoints are a heuristic (see
+// Ros_MotionControl_SetWaypointVelocities) and the accelerations are 0, so the
+// executed spline is not a minimum-jerk trajectory. The times, velocities and
+// accelerations are written into the points, after which the trajectory is
+// processed like any other. A segment which still exceeds the increment limits
+// of a group is slowed down until it doesn't.
+//-------------------------------------------------------------------
+Init_Trajectory_Status Ros_MotionControl_TimeParameterizeTrajectory(CtrlGroup* const ctrlGroups[], int numGroup, int numAxes,
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence* points, int interpolPeriod, BOOL bQuintic)
+{
+    double speedLimit[MAX_CONTROLLABLE_AXES];
+    double cycleTime = interpolPeriod / 1000.0; // in sec
+    TrajectoryLimitViolation violation;
+    INT64 timeMs = 0;
+    int grpIndex, axis, joint, pointIndex, attempt;
+
+    //speed limit of each joint, in the order of the trajectory
+    bzero(speedLimit, sizeof(speedLimit));
+    for (grpIndex = 0; grpIndex < numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = ctrlGroups[grpIndex];
+
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+        {
+            double pulsesPerUnit = fabs(ctrlGroup->jointTransform.toMotoFactor[axis]); //0.0 for invalid axes
+            if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, axis) || pulsesPerUnit == 0.0)
+                continue;
+
+            double limit = Ros_MotionControl_GetMotoAxisSpeedLimit(ctrlGroup, axis);
+            double incrementLimit = ctrlGroup->maxInc.maxIncrement[axis] / (cycleTime * pulsesPerUnit);
+            if (incrementLimit < limit)
+                limit = incrementLimit;
+
+            speedLimit[ctrlGroup->trajJointIndex[axis]] = limit * SPARSE_TRAJECTORY_SPEED_RATIO;
+        }
+    }
+
+    for (joint = 0; joint < numAxes; joint += 1)
+    {
+        if (speedLimit[joint] <= 0.0)
+            return INIT_TRAJ_INCOMPLETE_JOINTLIST;
+    }
+
+    //The goal is only modified once all of its points have been checked
+    for (pointIndex = 0; pointIndex < points->size; pointIndex += 1)
+    {
+        trajectory_msgs__msg__JointTrajectoryPoint const* point = &points->data[pointIndex];
+
+        if (point->positions.size != numAxes)
+        {
+            Ros_Debug_BroadcastMsg("Each point in the trajectory must have positions for all axes (pt: %d).", pointIndex);
+            return INIT_TRAJ_WRONG_NUMBER_OF_POSITIONS;
+        }
+
+        //The computed velocities and accelerations are stored in the memory of the goal. The
+        //FJT server allocates it for all axes of the controller (see Ros_ActionServer_FJT_Init),
+        //so this only fails for a caller which doesn't follow that rule.
+        if (point->velocities.capacity < numAxes || point->accelerations.capacity < numAxes)
+        {
+            Ros_Debug_BroadcastMsg("Not enough memory in the goal to store the velocities of the waypoints (pt: %d).", pointIndex);
+            return INIT_TRAJ_INSUFFICIENT_WAYPOINT_MEMORY;
+        }
+
+        //The timing of the client is never overwritten. A goal which specifies it for some of its
+        //waypoints, but not the velocities, is ambiguous.
+        if (Ros_Duration_Msg_To_Millis(&point->time_from_start) != 0)
+        {
+            snprintf(Ros_MotionControl_InitTrajectoryDetails, INIT_TRAJ_DETAILS_LENGTH,
+                "pt: %d, a goal without velocities must leave the time_from_start of all its points at 0", pointIndex);
+            return INIT_TRAJ_INVALID_TIME;
+        }
+    }
+
+    for (pointIndex = 0; pointIndex < points->size; pointIndex += 1)
+    {
+        trajectory_msgs__msg__JointTrajectoryPoint* point = &points->data[pointIndex];
+
+        point->velocities.size = numAxes;
+        point->accelerations.size = numAxes;
+        for (joint = 0; joint < numAxes; joint += 1)
+            point->accelerations.data[joint] = 0.0;
+
+        if (pointIndex > 0)
+        {
+            trajectory_msgs__msg__JointTrajectoryPoint const* prev = &points->data[pointIndex - 1];
+            double duration = cycleTime;
+
+            //bound the duration with the peaks of a rest to rest minimum-jerk motion over 'distance' in 'duration':
+            //speed 1.875 * d/T, acceleration 5.77 * d/T^2, jerk 60 * d/T^3
+            for (joint = 0; joint < numAxes; joint += 1)
+            {
+                double distance = fabs(point->positions.data[joint] - prev->positions.data[joint]);
+                double maxSpeed = speedLimit[joint];
+                double maxAcc = maxSpeed / SPARSE_TRAJECTORY_ACCEL_TIME;
+                double maxJerk = maxAcc / SPARSE_TRAJECTORY_JERK_TIME;
+
+                double minDuration[3];
+
+                minDuration[0] = 1.875 * distance / maxSpeed;
+                minDuration[1] = sqrt(5.7735 * distance / maxAcc);
+                minDuration[2] = pow(60.0 * distance / maxJerk, 1.0 / 3.0);
+                for (int limit = 0; limit < 3; limit += 1)
+                {
+                    if (minDuration[limit] > duration)
+                        duration = minDuration[limit];
+                }
+            }
+
+            timeMs += (INT64)ceil(duration * 1000.0);
+        }
+
+        Ros_Millis_To_Duration_Msg(timeMs, &point->time_from_start);
+    }
+
+    for (attempt = 0; attempt < SPARSE_TRAJECTORY_MAX_STRETCH; attempt += 1)
+    {
+        BOOL bWithinLimits = TRUE;
+
+        Ros_MotionControl_SetWaypointVelocities(points, numAxes);
+
+        for (grpIndex = 0; bWithinLimits && grpIndex < numGroup; grpIndex += 1)
+        {
+            if (Ros_MotionControl_ValidateTrajectoryLimits(ctrlGroups[grpIndex], points, interpolPeriod, bQuintic, &violation) != INIT_TRAJ_OK)
+                bWithinLimits = FALSE;
+        }
+
+        if (bWithinLimits)
+            return INIT_TRAJ_OK;
+
+        if (violation.pointIndex < 1)
+            break;
+
+        //slow down the segment which ends at the violation, the following points move along
+        INT64 segmentStart = Ros_Duration_Msg_To_Millis(&points->data[violation.pointIndex - 1].time_from_start);
+        INT64 segmentEnd = Ros_Duration_Msg_To_Millis(&points->data[violation.pointIndex].time_from_start);
+        INT64 extraMs = (INT64)ceil((segmentEnd - segmentStart) * (SPARSE_TRAJECTORY_STRETCH - 1.0));
+
+        for (pointIndex = violation.pointIndex; pointIndex < points->size; pointIndex += 1)
+        {
+            builtin_interfaces__msg__Duration* time = &points->data[pointIndex].time_from_start;
+            Ros_Millis_To_Duration_Msg(Ros_Duration_Msg_To_Millis(time) + extraMs, time);
+        }
+    }
+
+    Ros_Debug_BroadcastMsg("Unable to compute the timing of the sparse trajectory within the limits of the robot.");
+    return INIT_TRAJ_INVALID_VELOCITY;
+}
+
+char const* Ros_MotionControl_GetInitTrajectoryDetails()
+{
+    return Ros_MotionControl_InitTrajectoryDetails;
+}
+
+void Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(CtrlGroup* ctrlGroup,
+    trajectory_msgs__msg__JointTrajectoryPoint const* in_trajPoint, JointMotionData* out_jointMotionData)
+{
+    out_jointMotionData->time = Ros_Duration_Msg_To_Millis(&in_trajPoint->time_from_start);
+
+    for (int axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+    {
+        if (Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, axis))
+            continue;
+
+        int incomingAxisIndex = ctrlGroup->trajJointIndex[axis];
+        out_jointMotionData->pos[axis] = in_trajPoint->positions.data[incomingAxisIndex];
+        out_jointMotionData->vel[axis] = in_trajPoint->velocities.data[incomingAxisIndex];
+
+        //accelerations are optional. Without them, the point is treated as having zero acceleration.
+        if (in_trajPoint->accelerations.size == g_Ros_Controller.totalAxesCount)
+            out_jointMotionData->acc[axis] = in_trajPoint->accelerations.data[incomingAxisIndex];
+        else
+            out_jointMotionData->acc[axis] = 0.0;
+    }
+
+    //---------------
+    // For MPL80/100 robot type (SLU-BT): Controller automatically moves the B-axis
+    // to maintain orientation as other axes are moved. This is the only place the
+    // compensation is applied, so every point is compensated exactly once.
+    if (ctrlGroup->bIsBaxisSlave)
+    {
+        //This is radians in MOTO joint order
+        out_jointMotionData->pos[4] += -out_jointMotionData->pos[1] + out_jointMotionData->pos[2];
+        out_jointMotionData->vel[4] += -out_jointMotionData->vel[1] + out_jointMotionData->vel[2];
+        out_jointMotionData->acc[4] += -out_jointMotionData->acc[1] + out_jointMotionData->acc[2];
+    }
+}
+
+//-------------------------------------------------------------------
+// Speed limit of an axis in moto joint order (ctrlGroup->maxSpeed is
+// in ROS joint order)
+//-------------------------------------------------------------------
+double Ros_MotionControl_GetMotoAxisSpeedLimit(CtrlGroup const* ctrlGroup, int motoAxis)
+{
+    return ctrlGroup->maxSpeed[ctrlGroup->jointTransform.toMotoIndex[motoAxis]];
+}
+
+void Ros_MotionControl_LoadNextTrajectoryPoint(CtrlGroup* ctrlGroup, JointMotionData* out_jointMotionData)
+{
+    bzero(out_jointMotionData, sizeof(JointMotionData));
+
+    if (ctrlGroup->trajectoryPoints == NULL || ctrlGroup->trajectoryNextPointIndex >= ctrlGroup->trajectoryPoints->size)
+        return;
+
+    Ros_MotionControl_LoadTrajectoryPoint(ctrlGroup, ctrlGroup->trajectoryNextPointIndex, out_jointMotionData);
+    ctrlGroup->trajectoryNextPointIndex += 1;
+}
+
+void Ros_MotionControl_LoadTrajectoryPoint(CtrlGroup* ctrlGroup, int pointIndex, JointMotionData* out_jointMotionData)
+{
+    bzero(out_jointMotionData, sizeof(JointMotionData));
+
+    Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(ctrlGroup,
+        &ctrlGroup->trajectoryPoints->data[pointIndex], out_jointMotionData);
+    out_jointMotionData->time += ctrlGroup->trajectoryTimeOffset;
+    out_jointMotionData->valid = TRUE;
+}
+
+JointMotionData* Ros_MotionControl_NextInTrajectoryWindow(CtrlGroup* ctrlGroup, JointMotionData* iterator)
+{
+    iterator += 1; // pointer increments sizeof(JointMotionData) bytes
+    if (iterator == &ctrlGroup->trajectoryToProcess[TRAJECTORY_WINDOW_SIZE])
+        iterator = &ctrlGroup->trajectoryToProcess[0];
+
+    return iterator;
+}
+
+//-----------------------------------------------------------------------
+// Task that handles in the background messages that may have long processing
+// time so that they don't block other message from being processed.
+//-----------------------------------------------------------------------
+void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup)
+{
+    int i;
+
+    while (TRUE)
+    {
+        // (while the trajectory is being precompiled, it is left untouched)
+        if (Ros_MotionControl_AllGroupsInitComplete && !Ros_IncPrecompile_IsPending())
+        {
+            if (Ros_IncPrecompile_IsReady() && !g_Ros_Controller.bStopMotion && ctrlGroup->hasDataToProcess)
+            {
+                Ros_MotionControl_ReplayPrecompiledTrajectory(ctrlGroup);
+            }
+            // if there is no message to process, delay and try again
+            else if (!g_Ros_Controller.bStopMotion && ctrlGroup->hasDataToProcess && ctrlGroup->trajectoryIterator != NULL && ctrlGroup->trajectoryIterator->valid)
+            {
+
+                Ros_Debug_BroadcastMsg("Processing next point in trajectory [Group #%d - T=%.3f: (%7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f, %7.4f)]",
+                    ctrlGroup->groupNo, (double)ctrlGroup->trajectoryIterator->time * 0.001,
+                    ctrlGroup->trajectoryIterator->pos[0], ctrlGroup->trajectoryIterator->pos[1], ctrlGroup->trajectoryIterator->pos[2],
+                    ctrlGroup->trajectoryIterator->pos[3], ctrlGroup->trajectoryIterator->pos[4], ctrlGroup->trajectoryIterator->pos[5],
+                    ctrlGroup->trajectoryIterator->pos[6], ctrlGroup->trajectoryIterator->pos[7]);
+
+                //-------------------------------------
+                // Check that incoming data is valid
+                for (i = 0; i < ctrlGroup->numAxes; i++)
+                {
+                    // Velocity check
+                    if (abs(ctrlGroup->trajectoryIterator->vel[i]) > ctrlGroup->maxSpeed[i])
+                    {
+                        // excessive speed
+                        Ros_Debug_BroadcastMsg("ERROR: Invalid speed in message TrajPointFull data: \n  axis: %d, speed: %f, limit: %f\n",
+                            i, ctrlGroup->trajectoryIterator->vel[i], ctrlGroup->maxSpeed[i]);
+
+                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                        ctrlGroup->hasDataToProcess = FALSE;
+                        continue;
+                    }
+                }
+
+                //-------------------------------------
+
+                JointMotionData _startTrajData;
+                JointMotionData* startTrajData;
+                JointMotionData* endTrajData;
+                JointMotionData* curTrajData;
+                SegmentInterpolation interpolation;
+                double timeInc_ms;                  // time increment in millisecond
+                double timeLeftover_ms;             // part of this interpolation period after the end of the segment
+                double speedScale;                  // rate at which the interpolation clock advances relative to real time
+                BOOL bUseTimeLeftover;              // first cycle of the segment completes the interpolation period of the previous one
+                Incremental_data incData;
+
+                // Initialization of pointers and memory
+                curTrajData = ctrlGroup->prevTrajectoryIterator;
+                endTrajData = ctrlGroup->trajectoryIterator;
+                startTrajData = &_startTrajData;
+                // Set the start of the trajectory interpolation as the current position (which should be the end of last interpolation)
+                // (the B-axis compensation was applied when the point was converted, see Ros_MotionControl_ConvertTrajectoryPointToJointMotionData)
+                memcpy(startTrajData, curTrajData, sizeof(JointMotionData));
+
+                bzero(&incData, sizeof(incData));
+                incData.frame = MP_INC_PULSE_DTYPE;
+                incData.tool = ctrlGroup->tool;
+
+                if (endTrajData->time <= startTrajData->time)
+                {
+                    Ros_Debug_BroadcastMsg("Warning: Group %d - Time difference between endTrajData (%lld) and startTrajData (%lld) is 0 or less.\n", ctrlGroup->groupNo, endTrajData->time, startTrajData->time);
+                }
+
+                // Calculate the polynomial coefficients once for the whole segment
+                Ros_MotionControl_StartSegmentInterpolation(ctrlGroup, startTrajData, endTrajData, &interpolation);
+                bUseTimeLeftover = (ctrlGroup->timeLeftover_ms > 0.0);
+
+                // While interpolation time is smaller than new ROS point time
+                // (Ros_MotionControl_AddPulseIncPointToQ blocks this task once the queue is filled up to the high watermark)
+                while ((curTrajData->time < endTrajData->time) && Ros_Controller_IsMotionReady())
+                {
+                    // Determine the time increment of this cycle. With a speed scale below 1.0, the
+                    // interpolation clock runs slower than real time. The geometry of the path is unchanged.
+                    speedScale = Ros_MotionControl_StepSpeedScale(ctrlGroup);
+                    if (bUseTimeLeftover)
+                    {
+                        timeInc_ms = ctrlGroup->timeLeftover_ms;
+                        ctrlGroup->timeLeftover_ms = 0;
+                        bUseTimeLeftover = FALSE;
+                    }
+                    else
+                        timeInc_ms = g_Ros_Controller.interpolPeriod * speedScale;
+
+                    // Calculate the increment (this also advances ctrlGroup->prevPulsePos)
+                    Ros_MotionControl_StepSegmentInterpolation(ctrlGroup, &interpolation, timeInc_ms,
+                        curTrajData, ctrlGroup->prevPulsePos, incData.inc, &timeLeftover_ms);
+                    incData.time = curTrajData->time;
+
+                    if (timeLeftover_ms > 0.0)
+                    {
+                        // The next interpolation increment is the remainder to reach the next interpolation cycle
+                        ctrlGroup->timeLeftover_ms = timeLeftover_ms;
+
+                        // Each frame of the queue covers one full interpolation period. The rest of this
+                        // period is covered by the first increment of the next segment.
+                        for (i = 0; i < MP_GRP_AXES_NUM; i++)
+                            ctrlGroup->pendingInc[i] = incData.inc[i];
+                        ctrlGroup->bPendingInc = TRUE;
+                    }
+                    else
+                    {
+                        if (ctrlGroup->bPendingInc)
+                        {
+                            for (i = 0; i < MP_GRP_AXES_NUM; i++)
+                                incData.inc[i] += ctrlGroup->pendingInc[i];
+                            ctrlGroup->bPendingInc = FALSE;
+                        }
+
+                        // Add the increment to the queue
+                        if (!Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData))
+                        {
+                            bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                            ctrlGroup->hasDataToProcess = FALSE;
+                            continue;
+                        }
+                    }
+                }
+
+                // The fixed-point interpolation skips the position in ROS units. Catch up, if the
+                // segment was interrupted before its end.
+                if (interpolation.bUsePulseSegment && curTrajData->time < endTrajData->time)
+                {
+                    Ros_MotionControl_EvaluateSegment(&interpolation.segment, ctrlGroup->numAxes, (curTrajData->time - startTrajData->time) / 1000.0,
+                        curTrajData->pos, curTrajData->vel);
+                }
+
+                curTrajData->valid = FALSE;
+
+                if (Ros_MotionControl_IsMotionMode_Trajectory())
+                {
+                    // The start of this segment is no longer needed. Reuse its entry in the window for the next point.
+                    Ros_MotionControl_LoadNextTrajectoryPoint(ctrlGroup, ctrlGroup->prevTrajectoryIterator);
+
+                    ctrlGroup->prevTrajectoryIterator = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, ctrlGroup->prevTrajectoryIterator);
+                    ctrlGroup->trajectoryIterator = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, ctrlGroup->trajectoryIterator);
+
+                    // A replacement trajectory takes over from here, if the next segment reaches its start
+                    Ros_MotionControl_ApplyPendingSplice(ctrlGroup);
+
+                    if (!ctrlGroup->trajectoryIterator->valid)
+                    {
+                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                        ctrlGroup->hasDataToProcess = FALSE;
+                        Ros_Debug_BroadcastMsg("Done processing final point in trajectory (Group #%d)", ctrlGroup->groupNo);
+                    }
+                }
+                else if (Ros_MotionControl_IsMotionMode_PointQueue())
+                {
+                    // The start of this segment is no longer needed. Its entry in the window becomes free for a queued point.
+                    bzero(ctrlGroup->prevTrajectoryIterator, sizeof(JointMotionData));
+
+                    ctrlGroup->prevTrajectoryIterator = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, ctrlGroup->prevTrajectoryIterator);
+                    ctrlGroup->trajectoryIterator = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, ctrlGroup->trajectoryIterator);
+
+                    if (!ctrlGroup->trajectoryIterator->valid)
+                    {
+                        //The client didn't queue the next point in time. This is only a problem if the
+                        //robot was supposed to keep moving, as it will now stop at this point.
+                        for (i = 0; i < ctrlGroup->numAxes; i++)
+                        {
+                            if (fabs(ctrlGroup->prevTrajectoryIterator->vel[i]) > EPSILON_TOLERANCE_DOUBLE)
+                            {
+                                ctrlGroup->pointQueueUnderrunCount += 1;
+                                Ros_Debug_BroadcastMsg("Point queue underrun (Group #%d): no next point queued while moving", ctrlGroup->groupNo);
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                // If there is no next segment to complete the last interpolation period, its partial increment is
+                // queued by itself. (A group which stopped processing can't wait for the choice of the others.)
+                BOOL bFlushPendingInc = Ros_MotionControl_DecideFlushPendingInc(ctrlGroup,
+                    !ctrlGroup->hasDataToProcess || !ctrlGroup->trajectoryIterator->valid);
+                ctrlGroup->segmentCount += 1;
+
+                if (ctrlGroup->bPendingInc && !g_Ros_Controller.bStopMotion
+                    && (bFlushPendingInc || !ctrlGroup->hasDataToProcess))
+                {
+                    // (incData.time is still the end of the segment)
+                    for (i = 0; i < MP_GRP_AXES_NUM; i++)
+                        incData.inc[i] = ctrlGroup->pendingInc[i];
+                    ctrlGroup->bPendingInc = FALSE;
+
+                    Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData);
+                }
+
+            } // IF this group has a point to process
+            else
+            {
+                if (g_Ros_Controller.bStopMotion || Ros_MotionControl_IsMotionMode_Trajectory())
+                {
+                    bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+                    ctrlGroup->hasDataToProcess = FALSE;
+                }
+            }
+        }
+
+        // Only wait for a signal if the next point can't be processed right away
+        if (!Ros_MotionControl_AllGroupsInitComplete || Ros_IncPrecompile_IsPending() || g_Ros_Controller.bStopMotion || !Ros_Controller_IsMotionReady()
+            || !ctrlGroup->hasDataToProcess || ctrlGroup->trajectoryIterator == NULL || !ctrlGroup->trajectoryIterator->valid)
+        {
+            Ros_MotionControl_WaitForSignal(ctrlGroup);
+        }
+    } // WHILE (TRUE)
+}
+
+void Ros_MotionControl_StartSegmentInterpolation(CtrlGroup* ctrlGroup, JointMotionData const* startTrajData, JointMotionData const* endTrajData,
+    SegmentInterpolation* interpolation)
+{
+    double interval = (endTrajData->time - startTrajData->time) / 1000.0;  // time difference in sec
+
+    interpolation->startTrajData = startTrajData;
+    interpolation->endTrajData = endTrajData;
+    Ros_MotionControl_ComputeSegment(startTrajData, endTrajData, ctrlGroup->numAxes, g_nodeConfigSettings.quintic_interpolation, &interpolation->segment);
+    interpolation->bUsePulseSegment = g_nodeConfigSettings.fixed_point_interpolation
+        && Ros_MotionControl_ComputePulseSegment(ctrlGroup, &interpolation->segment, interval, &interpolation->pulseSegment);
+    interpolation->calculationTime_ms = startTrajData->time;
+}
+
+void Ros_MotionControl_StepSegmentInterpolation(CtrlGroup* ctrlGroup, SegmentInterpolation* interpolation, double timeInc_ms,
+    JointMotionData* curTrajData, long prevPulsePos[MP_GRP_AXES_NUM], LONG inc[MP_GRP_AXES_NUM], double* timeLeftover_ms)
+{
+    JointMotionData const* startTrajData = interpolation->startTrajData;
+    JointMotionData const* endTrajData = interpolation->endTrajData;
+    long newPulsePos[MP_GRP_AXES_NUM];
+    int i;
+
+    bzero(newPulsePos, sizeof(newPulsePos));
+    *timeLeftover_ms = 0.0;
+
+    // Increment calculation time by next time increment
+    interpolation->calculationTime_ms += timeInc_ms;
+    // time since the start of the segment in second
+    double interpolTime = (interpolation->calculationTime_ms - startTrajData->time) / 1000.0;
+
+    if (interpolation->calculationTime_ms < endTrajData->time)  // Make calculation for full interpolation clock
+    {
+        // Set new interpolation time to calculation time
+        curTrajData->time = (UINT64)interpolation->calculationTime_ms;
+
+        if (interpolation->bUsePulseSegment)
+        {
+            // Calculate the new position in pulses directly. curTrajData->pos and vel are
+            // only updated once the segment is left.
+            Ros_MotionControl_EvaluatePulseSegment(&interpolation->pulseSegment, interpolTime, newPulsePos);
+        }
+        else
+        {
+            // For each axis calculate the new position and velocity at the interpolation time
+            Ros_MotionControl_EvaluateSegment(&interpolation->segment, ctrlGroup->numAxes, interpolTime, curTrajData->pos, curTrajData->vel);
+
+            // Convert position in motoman pulse joint
+            Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, curTrajData->pos, newPulsePos);
+        }
+    }
+    else  // Make calculation for partial interpolation cycle
+    {
+        // Set the current trajectory data equal to the end trajectory
+        memcpy(curTrajData, endTrajData, sizeof(JointMotionData));
+
+        if (interpolation->calculationTime_ms > endTrajData->time)
+            *timeLeftover_ms = interpolation->calculationTime_ms - endTrajData->time;
+
+        // Convert position in motoman pulse joint
+        Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, curTrajData->pos, newPulsePos);
+    }
+
+    for (i = 0; i < MP_GRP_AXES_NUM; i++)
+    {
+        if (!Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
+            inc[i] = (newPulsePos[i] - prevPulsePos[i]);
+        else
+            inc[i] = 0;
+    }
+
+    // Copy data to the previous pulse position for next iteration
+    memcpy(prevPulsePos, newPulsePos, sizeof(newPulsePos));
+}
+
+BOOL Ros_MotionControl_DecideFlushPendingInc(CtrlGroup* ctrlGroup, BOOL bFlush)
+{
+    PendingIncDecision* decision = &Ros_MotionControl_PendingIncDecision;
+    UINT32 segmentBit = 1u << (ctrlGroup->segmentCount % 32);
+
+    if (Ros_MotionControl_PendingIncLock == NULL)
+        return bFlush;
+
+    mpSemTake(Ros_MotionControl_PendingIncLock, WAIT_FOREVER);
+
+    if ((INT32)(ctrlGroup->segmentCount - decision->decidedCount) >= 0)
+    {
+        //first group to complete this segment
+        if (bFlush)
+            decision->flushMask |= segmentBit;
+        else
+            decision->flushMask &= ~segmentBit;
+        decision->decidedCount = ctrlGroup->segmentCount + 1;
+    }
+    else
+        bFlush = ((decision->flushMask & segmentBit) != 0);
+
+    mpSemGive(Ros_MotionControl_PendingIncLock);
+
+    return bFlush;
+}
+
+void Ros_MotionControl_ReplayPrecompiledTrajectory(CtrlGroup* ctrlGroup)
+{
+    Incremental_data incData;
+    LONG inc[MP_GRP_AXES_NUM];
+    BOOL bDone = FALSE;
+    int i;
+
+    bzero(&incData, sizeof(incData));
+    incData.frame = MP_INC_PULSE_DTYPE;
+    incData.tool = ctrlGroup->tool;
+
+    // (Ros_MotionControl_AddPulseIncPointToQ blocks this task once the queue is filled up to the high watermark)
+    while (!g_Ros_Controller.bStopMotion && Ros_Controller_IsMotionReady())
+    {
+        if (!Ros_IncPrecompile_NextIncrement(ctrlGroup, inc))
+        {
+            bDone = TRUE;
+            break;
+        }
+
+        // (as for the interpolation, the start of the window follows the interpolation time)
+        ctrlGroup->prevTrajectoryIterator->time += g_Ros_Controller.interpolPeriod;
+        incData.time = ctrlGroup->prevTrajectoryIterator->time;
+        for (i = 0; i < MP_GRP_AXES_NUM; i++)
+        {
+            incData.inc[i] = inc[i];
+            ctrlGroup->prevPulsePos[i] += inc[i];
+        }
+
+        // As with the interpolated increments, the rest of the trajectory is abandoned if this fails
+        if (!Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData))
+        {
+            bDone = TRUE;
+            break;
+        }
+    }
+
+    // The robot isn't ready to move yet. Continue once it is.
+    if (!bDone && !g_Ros_Controller.bStopMotion)
+        return;
+
+    bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
+    ctrlGroup->hasDataToProcess = FALSE;
+    Ros_Debug_BroadcastMsg("Done replaying precompiled trajectory (Group #%d)", ctrlGroup->groupNo);
+}
+
+void Ros_MotionControl_WaitForSignal(CtrlGroup* ctrlGroup)
+{
+    int timeoutTicks = ADD_TO_INC_Q_WAIT_TIMEOUT / mpGetRtc(); //Tick length varies between controller models
+    if (timeoutTicks < 1)
+        timeoutTicks = 1;
+
+    mpSemTake(ctrlGroup->semAddToIncQueue, timeoutTicks);
+}
+
+//-------------------------------------------------------------------
+// Wake up the AddToIncQueue task of a group, because it has new data
+// to process, its queue has room again or motion is being stopped
+//-------------------------------------------------------------------
+void Ros_MotionControl_SignalAddToIncQueue(CtrlGroup* ctrlGroup)
+{
+    mpSemGive(ctrlGroup->semAddToIncQueue);
+}
+
+void Ros_MotionControl_SignalAddToIncQueue_All()
+{
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        Ros_MotionControl_SignalAddToIncQueue(g_Ros_Controller.ctrlGroups[grpIndex]);
+}
+
+//-------------------------------------------------------------------
+// Calculate the coefficients of the cubic polynomial which matches the
+// position and velocity of both the start and the end of a segment.
+// If bQuintic is set, a quintic polynomial is used instead, which also
+// matches the acceleration at both ends (C2 continuous at waypoints).
+//-------------------------------------------------------------------
+void Ros_MotionControl_ComputeSegment(JointMotionData const* startTrajData, JointMotionData const* endTrajData, int numAxes, BOOL bQuintic, TrajectorySegment* segment)
+{
+    double interval = (endTrajData->time - startTrajData->time) / 1000.0;  // time difference in sec
+    int i;
+
+    bzero(segment, sizeof(TrajectorySegment));
+
+    for (i = 0; i < numAxes; i++)
+    {
+        segment->c0[i] = startTrajData->pos[i];
+        segment->c1[i] = startTrajData->vel[i];
+
+        if (interval > 0.0 && bQuintic)
+        {
+            double deltaPos = endTrajData->pos[i] - startTrajData->pos[i];
+            double interval2 = interval * interval;
+            double interval3 = interval2 * interval;
+
+            segment->c2[i] = startTrajData->acc[i] / 2;
+            segment->c3[i] = ((20 * deltaPos)
+                - ((8 * endTrajData->vel[i] + 12 * startTrajData->vel[i]) * interval)
+                - ((3 * startTrajData->acc[i] - endTrajData->acc[i]) * interval2)) / (2 * interval3);
+            segment->c4[i] = ((-30 * deltaPos)
+                + ((14 * endTrajData->vel[i] + 16 * startTrajData->vel[i]) * interval)
+                + ((3 * startTrajData->acc[i] - 2 * endTrajData->acc[i]) * interval2)) / (2 * interval3 * interval);
+            segment->c5[i] = ((12 * deltaPos)
+                - (6 * (endTrajData->vel[i] + startTrajData->vel[i]) * interval)
+                - ((startTrajData->acc[i] - endTrajData->acc[i]) * interval2)) / (2 * interval3 * interval2);
+        }
+        else if (interval > 0.0)
+        {
+            double deltaPos = endTrajData->pos[i] - startTrajData->pos[i];
+
+            segment->c2[i] = (3 * deltaPos / (interval * interval))
+                - ((endTrajData->vel[i] + 2 * startTrajData->vel[i]) / interval);
+            segment->c3[i] = (-2 * deltaPos / (interval * interval * interval))
+                + ((endTrajData->vel[i] + startTrajData->vel[i]) / (interval * interval));
+        }
+    }
+}
+
+//-------------------------------------------------------------------
+// Calculate the highest absolute velocity of each axis within a segment.
+// For cubic segments, the velocity is a parabola, so the only candidate
+// besides the start and the end is its vertex. Quintic segments are
+// sampled at SEGMENT_PEAK_SPEED_SAMPLES points instead.
+//-------------------------------------------------------------------
+void Ros_MotionControl_SegmentPeakSpeed(TrajectorySegment const* segment, int numAxes, double interval, double peakSpeed[MP_GRP_AXES_NUM])
+{
+    double pos[MP_GRP_AXES_NUM];
+    double vel[MP_GRP_AXES_NUM];
+    BOOL bIsQuintic = FALSE;
+    int i;
+
+    //velocity at the start and the end
+    Ros_MotionControl_EvaluateSegment(segment, numAxes, interval, pos, vel);
+    for (i = 0; i < numAxes; i++)
+    {
+        peakSpeed[i] = fabs(segment->c1[i]);
+        if (fabs(vel[i]) > peakSpeed[i])
+            peakSpeed[i] = fabs(vel[i]);
+
+        if (segment->c4[i] != 0.0 || segment->c5[i] != 0.0)
+            bIsQuintic = TRUE;
+    }
+
+    if (interval <= 0.0)
+        return;
+
+    if (bIsQuintic)
+    {
+        for (int sample = 1; sample < SEGMENT_PEAK_SPEED_SAMPLES; sample += 1)
+        {
+            Ros_MotionControl_EvaluateSegment(segment, numAxes, interval * sample / SEGMENT_PEAK_SPEED_SAMPLES, pos, vel);
+            for (i = 0; i < numAxes; i++)
+            {
+                if (fabs(vel[i]) > peakSpeed[i])
+                    peakSpeed[i] = fabs(vel[i]);
+            }
+        }
+    }
+    else
+    {
+        for (i = 0; i < numAxes; i++)
+        {
+            //vel(t) = c1 + 2*c2*t + 3*c3*t^2 has its vertex at t = -c2 / (3*c3)
+            if (segment->c3[i] != 0.0)
+            {
+                double t = -segment->c2[i] / (3 * segment->c3[i]);
+                if (t > 0.0 && t < interval)
+                {
+                    double v = (3 * segment->c3[i] * t + 2 * segment->c2[i]) * t + segment->c1[i];
+                    if (fabs(v) > peakSpeed[i])
+                        peakSpeed[i] = fabs(v);
+                }
+            }
+        }
+    }
+}
+
+//-------------------------------------------------------------------
+// Calculate the highest absolute acceleration of each axis within a
+// segment. For cubic segments, the acceleration is linear, so it peaks
+// at the start or the end. Quintic segments are sampled at
+// SEGMENT_PEAK_SPEED_SAMPLES points in between as well.
+//-------------------------------------------------------------------
+void Ros_MotionControl_SegmentPeakAcceleration(TrajectorySegment const* segment, int numAxes, double interval, double peakAcc[MP_GRP_AXES_NUM])
+{
+    int samples = 1;
+    int i;
+
+    for (i = 0; i < numAxes; i++)
+    {
+        if (segment->c4[i] != 0.0 || segment->c5[i] != 0.0)
+            samples = SEGMENT_PEAK_SPEED_SAMPLES;
+        peakAcc[i] = fabs(2 * segment->c2[i]);
+    }
+
+    if (interval <= 0.0)
+        return;
+
+    for (int sample = 1; sample <= samples; sample += 1)
+    {
+        double t = interval * sample / samples;
+
+        for (i = 0; i < numAxes; i++)
+        {
+            //acc(t) = 2*c2 + 6*c3*t + 12*c4*t^2 + 20*c5*t^3
+            double acc = ((20 * segment->c5[i] * t + 12 * segment->c4[i]) * t + 6 * segment->c3[i]) * t + 2 * segment->c2[i];
+            if (fabs(acc) > peakAcc[i])
+                peakAcc[i] = fabs(acc);
+        }
+    }
+}
+
+//-------------------------------------------------------------------
+// Evaluate the position and velocity of all axes of a segment
+// using Horner's scheme
+//-------------------------------------------------------------------
+void Ros_MotionControl_EvaluateSegment(TrajectorySegment const* segment, int numAxes, double interpolTime, double pos[MP_GRP_AXES_NUM], double vel[MP_GRP_AXES_NUM])
+{
+    double t = interpolTime;
+    int i;
+
+    for (i = 0; i < numAxes; i++)
+    {
+        pos[i] = ((((segment->c5[i] * t + segment->c4[i]) * t + segment->c3[i]) * t + segment->c2[i]) * t + segment->c1[i]) * t + segment->c0[i];
+        vel[i] = (((5 * segment->c5[i] * t + 4 * segment->c4[i]) * t + 3 * segment->c3[i]) * t + 2 * segment->c2[i]) * t + segment->c1[i];
+    }
+}
+
+//-------------------------------------------------------------------
+// Convert the coefficients of a segment into pulses, scaled to the
+// duration of the segment (see PulseSegment). This is done once per
+// segment, so the increments of each interpolation cycle can be
+// calculated without any floating point math or unit conversion.
+// Returns FALSE if the segment can't be represented, in which case
+// the caller has to fall back to Ros_MotionControl_EvaluateSegment.
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_ComputePulseSegment(CtrlGroup* ctrlGroup, TrajectorySegment const* segment, double interval, PulseSegment* pulseSegment)
+{
+    double const* coefficients[6] = { segment->c0, segment->c1, segment->c2, segment->c3, segment->c4, segment->c5 };
+    double fractionScale = (double)(1 << PULSE_SEGMENT_FRACTION_BITS);
+    int axis, k;
 
-                int iterationCounter = 0;
-                // While interpolation time is smaller than new ROS point time
-                while ((curTrajData->time < endTrajData->time) && Ros_Controller_IsMotionReady())
+    bzero(pulseSegment, sizeof(PulseSegment));
+
+    if (interval <= 0.0)
+        return FALSE;
+
+    pulseSegment->timeScale = (double)(1LL << PULSE_SEGMENT_TIME_BITS) / interval;
+
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+    {
+        double pulsesPerUnit = ctrlGroup->jointTransform.toMotoFactor[axis];
+        double intervalPower = 1.0;
+        double range = 0.0;
+
+        for (k = 0; k < 6; k += 1)
+        {
+            double a = coefficients[k][axis] * intervalPower * pulsesPerUnit * fractionScale;
+
+            if (k > 0)
+            {
+                //the sum of the higher order terms bounds all intermediate values of the evaluation
+                range += fabs(a);
+                if (range >= (double)PULSE_SEGMENT_MAX_RANGE * fractionScale)
+                    return FALSE;
+            }
+            else if (fabs(a) >= (double)(LONG_MAX - PULSE_SEGMENT_MAX_RANGE) * fractionScale)
+                return FALSE;   //the position must still fit in a long after adding the higher order terms
+
+            pulseSegment->a[k][axis] = (INT64)(a < 0.0 ? a - 0.5 : a + 0.5);
+            intervalPower *= interval;
+        }
+    }
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Evaluate the pulse position of all axes of a segment, using Horner's
+// scheme in 64 bit fixed-point arithmetic. The result is truncated the
+// same way as Ros_CtrlGroup_ConvertRosUnitsToMotoUnits, and it is an
+// absolute position: the fraction of a pulse which is not commanded in
+// one cycle is carried over to the increment of the next one.
+//-------------------------------------------------------------------
+void Ros_MotionControl_EvaluatePulseSegment(PulseSegment const* pulseSegment, double interpolTime, long pulsePos[MP_GRP_AXES_NUM])
+{
+    INT64 u = (INT64)(interpolTime * pulseSegment->timeScale + 0.5);
+    int axis, k;
+
+    if (u < 0)
+        u = 0;
+    else if (u > (1LL << PULSE_SEGMENT_TIME_BITS))
+        u = (1LL << PULSE_SEGMENT_TIME_BITS);
+
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+    {
+        INT64 acc = pulseSegment->a[5][axis];
+        INT64 pos;
+
+        for (k = 4; k > 0; k -= 1)
+            acc = ((acc * u) >> PULSE_SEGMENT_TIME_BITS) + pulseSegment->a[k][axis];
+        pos = ((acc * u) >> PULSE_SEGMENT_TIME_BITS) + pulseSegment->a[0][axis];
+
+        //truncate toward zero
+        if (pos >= 0)
+            pulsePos[axis] = (long)(pos >> PULSE_SEGMENT_FRACTION_BITS);
+        else
+            pulsePos[axis] = -(long)((-pos) >> PULSE_SEGMENT_FRACTION_BITS);
+    }
+}
+
+//-------------------------------------------------------------------
+// Interpolate the position and velocity of a trajectory at a given time
+// (ms, relative to the start of the trajectory), the same way the
+// AddToIncQueue task does. Returns FALSE if the time is outside of the
+// trajectory.
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_SampleTrajectory(CtrlGroup* ctrlGroup, trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points,
+    INT64 time, BOOL bQuintic, JointMotionData* out_jointMotionData)
+{
+    JointMotionData startTrajData;
+    JointMotionData endTrajData;
+    TrajectorySegment segment;
+    int pointIndex;
+
+    bzero(out_jointMotionData, sizeof(JointMotionData));
+
+    if (points == NULL || points->size < 2 || time < Ros_Duration_Msg_To_Millis(&points->data[0].time_from_start))
+        return FALSE;
+
+    //find the segment which ends at or after the requested time
+    for (pointIndex = 1; pointIndex < points->size; pointIndex += 1)
+    {
+        if (Ros_Duration_Msg_To_Millis(&points->data[pointIndex].time_from_start) >= time)
+            break;
+    }
+
+    if (pointIndex == points->size)
+        return FALSE;
+
+    Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(ctrlGroup, &points->data[pointIndex - 1], &startTrajData);
+    Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(ctrlGroup, &points->data[pointIndex], &endTrajData);
+
+    Ros_MotionControl_ComputeSegment(&startTrajData, &endTrajData, ctrlGroup->numAxes, bQuintic, &segment);
+    Ros_MotionControl_EvaluateSegment(&segment, ctrlGroup->numAxes, (time - (INT64)startTrajData.time) / 1000.0,
+        out_jointMotionData->pos, out_jointMotionData->vel);
+
+    out_jointMotionData->time = (UINT64)time;
+    out_jointMotionData->valid = TRUE;
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Convert the whole active trajectory of a group into increments, at a
+// speed scale of 1.0. The increments are generated by the same steps as
+// in Ros_MotionControl_AddToIncQueueProcess (but without the limit of the
+// rolling window), so they are identical to the ones it would queue. The
+// trajectory starts at ctrlGroup->prevPulsePos.
+// Returns FALSE if the increments don't fit in the stream, or if the
+// compilation was overtaken by a newer goal or a stop.
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_CompileTrajectory(CtrlGroup* ctrlGroup, IncStream* stream, UINT32 generation)
+{
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points = ctrlGroup->trajectoryPoints;
+    JointMotionData startTrajData;
+    JointMotionData endTrajData;
+    JointMotionData curTrajData;
+    SegmentInterpolation interpolation;
+    long prevPulsePos[MP_GRP_AXES_NUM];
+    LONG inc[MP_GRP_AXES_NUM];
+    LONG pendingInc[MP_GRP_AXES_NUM];
+    BOOL bPendingInc = FALSE;
+    double timeInc_ms;
+    double timeLeftover_ms = 0.0;
+    int pointIndex, i;
+    int cycle = 0;
+
+    if (points == NULL || points->size < 2)
+        return FALSE;
+
+    memcpy(prevPulsePos, ctrlGroup->prevPulsePos, sizeof(prevPulsePos));
+    Ros_MotionControl_LoadTrajectoryPoint(ctrlGroup, 0, &curTrajData);
+
+    for (pointIndex = 1; pointIndex < points->size; pointIndex += 1)
+    {
+        // Each segment starts where the previous one ended
+        memcpy(&startTrajData, &curTrajData, sizeof(JointMotionData));
+        Ros_MotionControl_LoadTrajectoryPoint(ctrlGroup, pointIndex, &endTrajData);
+        Ros_MotionControl_StartSegmentInterpolation(ctrlGroup, &startTrajData, &endTrajData, &interpolation);
+
+        while (curTrajData.time < endTrajData.time)
+        {
+            // The first cycle of a segment completes the interpolation period of the previous one
+            if (timeLeftover_ms > 0.0)
+            {
+                timeInc_ms = timeLeftover_ms;
+                timeLeftover_ms = 0.0;
+            }
+            else
+                timeInc_ms = g_Ros_Controller.interpolPeriod * SPEED_SCALE_MAX;
+
+            Ros_MotionControl_StepSegmentInterpolation(ctrlGroup, &interpolation, timeInc_ms,
+                &curTrajData, prevPulsePos, inc, &timeLeftover_ms);
+
+            if (timeLeftover_ms > 0.0)
+            {
+                // Queued together with the first increments of the next segment
+                memcpy(pendingInc, inc, sizeof(pendingInc));
+                bPendingInc = TRUE;
+                continue;
+            }
+
+            if (bPendingInc)
+            {
+                for (i = 0; i < MP_GRP_AXES_NUM; i++)
+                    inc[i] += pendingInc[i];
+                bPendingInc = FALSE;
+            }
+
+            cycle += 1;
+            if (!Ros_IncPrecompile_KeepCompiling(generation, cycle) || !Ros_IncPrecompile_Encode(stream, inc))
+                return FALSE;
+        }
+    }
+
+    // There is no next segment to complete the last interpolation period
+    if (bPendingInc && !Ros_IncPrecompile_Encode(stream, pendingInc))
+        return FALSE;
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Adds pulse increments for one interpolation period to the inc move queue
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_AddPulseIncPointToQ(CtrlGroup* ctrlGroup, Incremental_data const* dataToEnQ)
+{
+    Incremental_q* q = &g_Ros_Controller.incQueue;
+
+    if (Ros_Controller_IncQ_Count(q, ctrlGroup->groupNo) >= Q_HIGH_WATERMARK(ctrlGroup))
+    {
+        //wait for the IncMoveTask to drain the queue down to the low watermark. It signals
+        //this task when it does, so the queue is refilled in bursts instead of one item at a time.
+        while (Ros_Controller_IncQ_Count(q, ctrlGroup->groupNo) > Q_LOW_WATERMARK(ctrlGroup))
+        {
+            Ros_MotionControl_WaitForSignal(ctrlGroup);
+
+            //make sure we don't get stuck in infinite loop
+            if (!Ros_Controller_IsMotionReady() || g_Ros_Controller.bStopMotion) //<- they probably pressed HOLD or ESTOP
+            {
+                return FALSE;
+            }
+        }
+    }
+
+    return Ros_Controller_IncQ_Push(q, ctrlGroup->groupNo, dataToEnQ);
+}
+
+UINT16 Ros_MotionControl_ProcessQueuedTrajectoryPoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request)
+{
+    if (Ros_MotionControl_MustInitializePointQueue)
+    {
+        Ros_Debug_BroadcastMsg("Initial point in trajectory queue");
+
+        Init_Trajectory_Status status;
+        status = Ros_MotionControl_InitPointQueue(request);
+
+        if (status == INIT_TRAJ_OK)
+        {
+            return motoros2_interfaces__msg__QueueResultEnum__SUCCESS;
+        }
+        else
+        {
+            return status;
+        }
+    }
+
+    //------------------------------------------------------------
+    //The trajectory contains information for all groups. Determine which groups are used by looking at the 'joint names'.
+    int grpIndex, jointIndexInTraj;
+
+    if (g_Ros_Controller.totalAxesCount != request->joint_names.size)
+    {
+        Ros_Debug_BroadcastMsg("Queued point must contain data for all %d joints.", g_Ros_Controller.totalAxesCount);
+        return motoros2_interfaces__msg__QueueResultEnum__INVALID_JOINT_LIST;
+    }
+
+    //===================================
+    //Incoming points are processed one joint at a time.
+    //The joint names are mapped onto the correct CtrlGroup object and the joint index (in moto order)
+    //in the JointMotionData array. Clients normally send the same joint_names with every point, in
+    //which case the mapping of the previous point is reused.
+    //===================================
+
+    //precheck to ensure all groups are ready to accept a new point
+    JointMotionData* queueSlot[MAX_CONTROLLABLE_GROUPS];
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        int queuedPoints = 0;
+
+        //The queued points follow the point which is currently being processed in the window
+        queueSlot[grpIndex] = ctrlGroup->trajectoryIterator;
+        while (queueSlot[grpIndex] != NULL && queueSlot[grpIndex]->valid)
+        {
+            queuedPoints += 1;
+            if (queuedPoints >= g_nodeConfigSettings.point_queue_depth)
+            {
+                //The queue of this control group is full.
+                //Wait for a point to be processed before adding a new point.
+                return motoros2_interfaces__msg__QueueResultEnum__BUSY;
+            }
+            queueSlot[grpIndex] = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, queueSlot[grpIndex]);
+        }
+    }
+
+    Init_Trajectory_Status mapStatus = Ros_MotionControl_MapJointNames(&request->joint_names);
+    if (mapStatus == INIT_TRAJ_DUPLICATE_JOINT_NAME)
+    {
+        return INIT_TRAJ_DUPLICATE_JOINT_NAME;
+    }
+    else if (mapStatus != INIT_TRAJ_OK)
+    {
+        return motoros2_interfaces__msg__QueueResultEnum__INVALID_JOINT_LIST;
+    }
+
+    // for point queuing, we create a single-point trajectory, store the incoming
+    // point in it and send it off for processing by the trajectory processing
+    // pipeline.
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence pointSequence;
+
+    pointSequence.capacity = 1;
+    pointSequence.size = 1;
+    pointSequence.data = &request->point; //no additional memory is allocated this way
+
+    //for each joint/axis in a single trajectory point
+    for (jointIndexInTraj = 0; jointIndexInTraj < request->joint_names.size; jointIndexInTraj += 1)
+    {
+        Init_Trajectory_Status status = Ros_MotionControl_ValidateTrajectoryJoint(&pointSequence, jointIndexInTraj);
+        if (status != INIT_TRAJ_OK)
+        {
+            Ros_Debug_BroadcastMsg("Failed to parse incoming trajectory point.");
+            return motoros2_interfaces__msg__QueueResultEnum__UNABLE_TO_PROCESS_POINT;
+        }
+    }
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+
+        //NOTE: The `Ros_MotionControl_Init` function populated the first position of the window with the initial point
+        //      in the queue. Followup points are placed in the window after the point which is currently being processed.
+        //      As a destination is reached, the iterators advance so it becomes the starting point for the next destination.
+        //      The point is marked valid last, as that makes it visible to Ros_MotionControl_AddToIncQueueProcess.
+        Ros_MotionControl_ConvertTrajectoryPointToJointMotionData(ctrlGroup, &request->point, queueSlot[grpIndex]);
+        queueSlot[grpIndex]->valid = TRUE;
+        Ros_MotionControl_SignalAddToIncQueue(ctrlGroup);
+    }
+
+    return motoros2_interfaces__msg__QueueResultEnum__SUCCESS;
+}
+
+//-------------------------------------------------------------------
+// Check whether the initial point of the point queue has been received
+// since point-queue mode was started
+//-------------------------------------------------------------------
+BOOL Ros_MotionControl_IsPointQueueInitialized()
+{
+    return !Ros_MotionControl_MustInitializePointQueue;
+}
+
+//-------------------------------------------------------------------
+// Task to move the robot at each interpolation increment
+//-------------------------------------------------------------------
+void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
+{
+    MP_EXPOS_DATA moveData;
+
+    Incremental_q* q;
+    Incremental_data const* frame;
+    UINT32 readSeq;
+    UINT64 frameTime[MAX_CONTROLLABLE_GROUPS];
+    BOOL bSkipFrame;
+    int i;
+    int ret;
+    int axis;
+    UINT64 tsWake, tsPhase, tsNow;
+
+    MP_CTRL_GRP_SEND_DATA ctrlGrpData;
+    MP_PULSE_POS_RSP_DATA prevPulsePosData[MAX_CONTROLLABLE_GROUPS];
+    MP_PULSE_POS_RSP_DATA pulsePosData;
+
+    // --- FSU Speed Limit related ---
+    // When FSU speed limitation is active, some pulses for an interpolation cycle may not be processed by the controller.
+    // The unprocessed pulses are tracked and resent for each group (see FsuSpeedLimitState).
+    FsuSpeedLimitState fsuState[MAX_CONTROLLABLE_GROUPS];
+    LONG processedPulses[MP_GRP_AXES_NUM];                              // Amount of pulses from the last command that were actually processed (accepted)
+    BOOL queueRead[MAX_CONTROLLABLE_GROUPS];                            // Flag indicating that new increment data was retrieve from the queue on this cycle.
+    BOOL hasUnprocessedData;                                            // Flag that at least one axis (any group) still has unprecessed data. (Used to continue sending data after the queue is empty.)
+
+    for (i = 0; i < MAX_CONTROLLABLE_GROUPS; i++)
+        Ros_FsuSpeedLimit_Reset(&fsuState[i]);
+    bzero(processedPulses, sizeof(LONG) * MP_GRP_AXES_NUM);
+    bzero(queueRead, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
+
+    hasUnprocessedData = FALSE;
+
+    Ros_Debug_BroadcastMsg("IncMoveTask Started");
+
+    Ros_IncMoveTiming_TaskStart();
+
+    bzero(&moveData, sizeof(moveData));
+
+    for (i = 0; i < g_Ros_Controller.numGroup; i++)
+    {
+        moveData.ctrl_grp |= (0x01 << i);
+        moveData.grp_pos_info[i].pos_tag.data[0] = Ros_CtrlGroup_GetAxisConfig(g_Ros_Controller.ctrlGroups[i]);
+
+        ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
+        mpGetPulsePos(&ctrlGrpData, &prevPulsePosData[i]);
+    }
+
+    FOREVER
+    {
+        mpClkAnnounce(MP_INTERPOLATION_CLK);
+
+        tsWake = Ros_IncMoveTiming_Now();
+        Ros_IncMoveTiming_StartCycle(tsWake);
+
+        Ros_MotionControl_TrackIncQueueUnderrun();
+        Ros_MotionControl_CheckRawStreamingUnderrun();
+
+        if (Ros_Controller_IsMotionReady()
+            && (Ros_MotionControl_HasDataInQueue() || hasUnprocessedData)
+            && !g_Ros_Controller.bStopMotion
+            && !(Ros_MotionControl_IsMotionMode_RawStreaming() && Ros_MotionControl_RawStreaming.bUnderrun))
+        {
+            // Retrieve the pulse increments of all groups for this cycle. A frame is only read once
+            // every group has written it. If the FSU speed limit holds back any of the groups, the
+            // frame is left in the queue for all of them (see Ros_FsuSpeedLimit_MustHoldFrame).
+            tsPhase = Ros_IncMoveTiming_Now();
+            bSkipFrame = Ros_FsuSpeedLimit_MustHoldFrame(fsuState, g_Ros_Controller.numGroup);
+            for (i = 0; i < g_Ros_Controller.numGroup; i++)
+                queueRead[i] = FALSE;
+
+            q = &g_Ros_Controller.incQueue;
+            readSeq = q->tail;
+            Q_MEMORY_BARRIER();
+
+            if (!bSkipFrame && Ros_Controller_IncQ_FrameCount(q) > 0)
+            {
+                frame = Ros_Controller_IncQ_Frame(q, readSeq);
+                for (i = 0; i < g_Ros_Controller.numGroup; i++)
+                {
+                    moveData.grp_pos_info[i].pos_tag.data[2] = frame[i].tool;
+                    moveData.grp_pos_info[i].pos_tag.data[3] = frame[i].frame;
+                    moveData.grp_pos_info[i].pos_tag.data[4] = frame[i].user;
+                    memcpy(&moveData.grp_pos_info[i].pos, &frame[i].inc, sizeof(LONG) * MP_GRP_AXES_NUM);
+                    frameTime[i] = frame[i].time;
+                }
+
+                // Hand the frame back to the producers
+                if (Ros_Controller_IncQ_Release(q, readSeq))
                 {
-                    iterationCounter += 1;
-                    //Relinquish CPU control after some number of iterations. Prevent starvation of other tasks.
-                    if (iterationCounter >= 15) //15 is an arbitrary number
+                    for (i = 0; i < g_Ros_Controller.numGroup; i++)
                     {
-                        Ros_Sleep(g_Ros_Controller.interpolPeriod);
-                        iterationCounter = 0;
-                    }
+                        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[i];
+
+                        queueRead[i] = TRUE;
+                        ctrlGroup->q_time = frameTime[i];
+
+                        // Wake the producer of the group when the queue drops to the low watermark
+                        int qCount = Ros_Controller_IncQ_Count(q, i);
+                        BOOL bSignaled = FALSE;
+                        if (qCount == Q_LOW_WATERMARK(ctrlGroup))
+                        {
+                            Ros_MotionControl_SignalAddToIncQueue(ctrlGroup);
+                            bSignaled = TRUE;
+                        }
 
-                    // Increment calculation time by next time increment
-                    calculationTime_ms += timeInc_ms;
-                    // time increment in second
-                    double interpolTime = (calculationTime_ms - startTrajData->time) / 1000.0;
+                        if (Ros_MotionControl_TrackIncQueueRefill(ctrlGroup, qCount + 1, qCount, bSignaled))
+                            Ros_MotionControl_SignalAddToIncQueue(ctrlGroup);
+                    }
+                }
+                else
+                {
+                    // Queue was cleared while reading it, discard the data
+                    for (i = 0; i < g_Ros_Controller.numGroup; i++)
+                        bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
+                }
+            }
+            else if (bSkipFrame)
+            {
+                // Set position increment to 0, the unprocessed pulses of the previous cycles are sent below
+                for (i = 0; i < g_Ros_Controller.numGroup; i++)
+                    bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
+            }
+            else
+            {
+                // No complete frame in the queue, initialize to 0 pulse increment
+                for (i = 0; i < g_Ros_Controller.numGroup; i++)
+                {
+                    moveData.grp_pos_info[i].pos_tag.data[2] = 0;
+                    moveData.grp_pos_info[i].pos_tag.data[3] = MP_INC_PULSE_DTYPE;
+                    moveData.grp_pos_info[i].pos_tag.data[4] = 0;
+                    bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
 
-                    if (calculationTime_ms < endTrajData->time)  // Make calculation for full interpolation clock
-                    {
-                        // Set new interpolation time to calculation time
-                        curTrajData->time = calculationTime_ms;
+                    int qCount = Ros_Controller_IncQ_Count(q, i);
+                    if (Ros_MotionControl_TrackIncQueueRefill(g_Ros_Controller.ctrlGroups[i], qCount, qCount, FALSE))
+                        Ros_MotionControl_SignalAddToIncQueue(g_Ros_Controller.ctrlGroups[i]);
+                }
+            }
 
-                        // For each axis calculate the new position at the interpolation time
-                        for (i = 0; i < ctrlGroup->numAxes; i++)
-                        {
-                            // Add position change for new interpolation time
-                            curTrajData->pos[i] = startTrajData->pos[i]                         // initial position component
-                                + startTrajData->vel[i] * interpolTime                          // initial velocity component
-                                + accCoef1[i] * interpolTime * interpolTime / 2                 // accCoef1 component
-                                + accCoef2[i] * interpolTime * interpolTime * interpolTime / 6; // accCoef2 component
-
-                            // Add velocity change for new interpolation time
-                            curTrajData->vel[i] = startTrajData->vel[i]                         // initial velocity component
-                                + accCoef1[i] * interpolTime                                    // accCoef1 component
-                                + accCoef2[i] * interpolTime * interpolTime / 2;                // accCoef2 component
-                        }
+            tsNow = Ros_IncMoveTiming_Now();
+            Ros_IncMoveTiming_Record(INC_MOVE_TIMING_READ_QUEUE, tsPhase, tsNow);
+            tsPhase = tsNow;
 
-                        // Reset the timeInc_ms for the next interpolation cycle
-                        if (timeInc_ms < g_Ros_Controller.interpolPeriod)
-                        {
-                            timeInc_ms = g_Ros_Controller.interpolPeriod;
-                            ctrlGroup->timeLeftover_ms = 0;
-                        }
-                    }
-                    else  // Make calculation for partial interpolation cycle
-                    {
-                        // Set the current trajectory data equal to the end trajectory
-                        memcpy(curTrajData, endTrajData, sizeof(JointMotionData));
+            hasUnprocessedData = FALSE;
+            for (i = 0; i < g_Ros_Controller.numGroup; i++)
+            {
+                // Check if pulses are missing from last increment.
+                // Get the current controller command position and substract the previous command position
+                // to get the amount of pulses which were processed of the increment sent last cycle.
+                ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
+                mpGetPulsePos(&ctrlGrpData, &pulsePosData);
+                for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+                {
+                    processedPulses[axis] = pulsePosData.lPos[axis] - prevPulsePosData[i].lPos[axis];
+                    prevPulsePosData[i].lPos[axis] = pulsePosData.lPos[axis];
+                }
 
-                        // Set the next interpolation increment to the the remainder to reach the next interpolation cycle
-                        if (calculationTime_ms > endTrajData->time)
-                        {
-                            ctrlGroup->timeLeftover_ms = calculationTime_ms - endTrajData->time;
-                        }
-                    }
+                // If some pulses are missing, the unprocessed pulses are added to this cycle (without exceeding the commanded speed)
+                if (Ros_FsuSpeedLimit_Reconcile(&fsuState[i], queueRead[i], processedPulses,
+                    g_Ros_Controller.ctrlGroups[i]->maxInc.maxIncrement, moveData.grp_pos_info[i].pos))
+                {
+                    hasUnprocessedData = TRUE;
+                }
+            }
 
-                    // Convert position in motoman pulse joint
-                    Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(ctrlGroup, curTrajData->pos, newPulsePos);
+            tsNow = Ros_IncMoveTiming_Now();
+            Ros_IncMoveTiming_Record(INC_MOVE_TIMING_PULSE_CHECK, tsPhase, tsNow);
+            tsPhase = tsNow;
 
-                    // Calculate the increment
-                    incData.time = curTrajData->time;
-                    for (i = 0; i < MP_GRP_AXES_NUM; i++)
-                    {
-                        if (!Ros_CtrlGroup_IsInvalidAxis(ctrlGroup, i))
-                            incData.inc[i] = (newPulsePos[i] - ctrlGroup->prevPulsePos[i]);
-                        else
-                            incData.inc[i] = 0;
-                    }
+            // Make sure motion / goal has not been cancelled in the meantime.
+            // Additionally, if the Agent PC is disconnected, check to see if
+            // motion should continue.
+            if (!g_Ros_Controller.bStopMotion && (g_Ros_Communication_AgentIsConnected || !g_nodeConfigSettings.stop_motion_on_disconnect))
+            {
+                // Send pulse increment to the controller command position
+                ret = mpExRcsIncrementMove(&moveData);
 
-                    // Add the increment to the queue
-                    if (!Ros_MotionControl_AddPulseIncPointToQ(ctrlGroup, &incData))
-                    {
-                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
-                        ctrlGroup->hasDataToProcess = FALSE;
-                        continue;
-                    }
+                tsNow = Ros_IncMoveTiming_Now();
+                Ros_IncMoveTiming_Record(INC_MOVE_TIMING_INC_MOVE, tsPhase, tsNow);
+                Ros_IncMoveTiming_Record(INC_MOVE_TIMING_TOTAL, tsWake, tsNow);
 
-                    // Copy data to the previous pulse position for next iteration
-                    memcpy(ctrlGroup->prevPulsePos, newPulsePos, sizeof(ctrlGroup->prevPulsePos));
-                }
+                //prevPulsePosData holds the command position of this cycle (before the increment)
+                Ros_ActionServer_FJT_UpdateProgressTracker(&moveData, prevPulsePosData);
+            }
+            else 
+                ret = 0;
 
-                curTrajData->valid = FALSE;
+            if (ret != 0)
+            {
+                // Failure: command rejected by controller.
+                // Update controller status to help identify cause
+                Ros_Controller_IoStatusUpdate();
 
-                if (Ros_MotionControl_IsMotionMode_Trajectory())
+                if (ret == E_EXRCS_CTRL_GRP)
+                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned: %d (ctrl_grp = %d)", ret, moveData.ctrl_grp);
+                else if (ret == E_EXRCS_IMOV_UNREADY && g_Ros_Controller.bPFLEnabled)
                 {
-                    if (ctrlGroup->trajectoryIterator == &ctrlGroup->trajectoryToProcess[MAX_NUMBER_OF_POINTS_PER_TRAJECTORY]) //pointing to last possible entry in the array; don't increment iterator
-                    {
-                        bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
-                        ctrlGroup->hasDataToProcess = FALSE;
-                        Ros_Debug_BroadcastMsg("Done processing final point in trajectory (Group #%d)", ctrlGroup->groupNo);
+                    // Check if this is caused by a known cause (E-Stop, Hold, Alarm, Error)
+                    if (!Ros_Controller_IsEStop() && !Ros_Controller_IsHold()
+                        && !Ros_Controller_IsAlarm() && !Ros_Controller_IsError()) {
+                        Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned UNREADY: %d (Could be PFL Active)", E_EXRCS_IMOV_UNREADY);
+                        g_Ros_Controller.bPFLduringRosMove = TRUE;
                     }
-                    else
+                }
+                else if (ret == E_EXRCS_PFL_FUNC_BUSY && g_Ros_Controller.bPFLEnabled)
+                {
+                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned PFL Active");
+                    g_Ros_Controller.bPFLduringRosMove = TRUE;
+                }
+                else if (ret == E_EXRCS_UNDER_ENERGY_SAVING)
+                {
+                    // retry until servos turn on and motion is accepted
+                    int checkCount;
+                    for (checkCount = 0; checkCount < MOTION_START_TIMEOUT; checkCount += MOTION_START_CHECK_PERIOD)
                     {
-                        ctrlGroup->prevTrajectoryIterator += 1; // pointer increments sizeof(JointMotionData) bytes
-                        ctrlGroup->trajectoryIterator += 1; // pointer increments sizeof(JointMotionData) bytes
+                        ret = mpExRcsIncrementMove(&moveData);
+                        if (ret != E_EXRCS_UNDER_ENERGY_SAVING)
+                            break;
+
+                        Ros_Sleep(MOTION_START_CHECK_PERIOD);
                     }
+                    if (g_Ros_Controller.bMpIncMoveError)
+                        Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned Eco mode enabled");
                 }
-                else if (Ros_MotionControl_IsMotionMode_PointQueue())
+                else if(ret == E_EXRCS_IMOV_UNREADY)
                 {
-                    memcpy(ctrlGroup->prevTrajectoryIterator, ctrlGroup->trajectoryIterator, sizeof(JointMotionData));
-                    bzero(ctrlGroup->trajectoryIterator, sizeof(JointMotionData));
+                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned -1 (Not executing WAIT instruction)");
                 }
+                else
+                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned: %d", ret);
 
-            } // IF this group has a point to process
-            else
-            {
-                if (g_Ros_Controller.bStopMotion || Ros_MotionControl_IsMotionMode_Trajectory())
+                // Stop motion if motion was rejected
+                if (ret != 0)
                 {
-                    bzero(ctrlGroup->trajectoryToProcess, sizeof(ctrlGroup->trajectoryToProcess));
-                    ctrlGroup->hasDataToProcess = FALSE;
+                    // Flag to prevent further motion until Trajectory mode is reenabled
+                    g_Ros_Controller.bMpIncMoveError = TRUE;
+                    Ros_MotionControl_StopMotion(/*bKeepJobRunning = */ FALSE);
+                    Ros_Debug_BroadcastMsg("Stopping all motion");
                 }
             }
         }
+        else
+        {
+            // Reset previous position in case the robot is moved externally
+            hasUnprocessedData = FALSE;
+            for (i = 0; i < g_Ros_Controller.numGroup; i++)
+            {
+                Ros_FsuSpeedLimit_ClearPending(&fsuState[i]);
+                ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
+                mpGetPulsePos(&ctrlGrpData, &prevPulsePosData[i]);
+            }
+        }
+    }
+}
 
-        Ros_Sleep(g_Ros_Controller.interpolPeriod);
-    } // WHILE (TRUE)
+//-------------------------------------------------------------------
+// Check the number of inc_move currently in the queue for the specified group
+//-------------------------------------------------------------------
+int Ros_MotionControl_GetQueueCnt(int groupNo)
+{
+    // Check group number valid
+    if (!Ros_Controller_IsValidGroupNo(groupNo))
+        return -1;
+
+    return Ros_Controller_IncQ_Count(&g_Ros_Controller.incQueue, groupNo);
 }
 
 //-------------------------------------------------------------------
-// Adds pulse increments for one interpolation period to the inc move queue
+// Get the number of points which are queued in point-queue mode, but
+// have not been reached yet (for the group with the most queued points)
 //-------------------------------------------------------------------
-BOOL Ros_MotionControl_AddPulseIncPointToQ(CtrlGroup* ctrlGroup, Incremental_data const* dataToEnQ)
+int Ros_MotionControl_GetPointQueueDepth()
 {
-    // Set pointer to specified queue
-    Incremental_q* q = &ctrlGroup->inc_q;
+    int maxDepth = 0;
 
-    while (q->cnt >= Q_SIZE) //queue is full
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
-        //wait for items to be removed from the queue
-        Ros_Sleep(g_Ros_Controller.interpolPeriod);
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        JointMotionData* iterator = ctrlGroup->trajectoryIterator;
+        int depth = 0;
 
-        //make sure we don't get stuck in infinite loop
-        if (!Ros_Controller_IsMotionReady()) //<- they probably pressed HOLD or ESTOP
+        while (iterator != NULL && iterator->valid && depth < MAX_POINT_QUEUE_DEPTH)
         {
-            return FALSE;
+            depth += 1;
+            iterator = Ros_MotionControl_NextInTrajectoryWindow(ctrlGroup, iterator);
         }
+
+        if (depth > maxDepth)
+            maxDepth = depth;
     }
 
-    // Lock the q before manipulating it
-    if (mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
-    {
-        // Get the index of the end of the queue
-        int index = Q_OFFSET_IDX(q->idx, q->cnt, Q_SIZE);
-        // Copy data at the end of the queue
-        q->data[index] = *dataToEnQ;
-        // increase the count of elements in the queue
-        q->cnt++;
+    return maxDepth;
+}
 
-        // Unlock the q
-        mpSemGive(q->q_lock);
-    }
-    else
+//-------------------------------------------------------------------
+// Get the number of point-queue underruns since the point queue was
+// started (for the group with the most underruns)
+//-------------------------------------------------------------------
+int Ros_MotionControl_GetPointQueueUnderrunCount()
+{
+    int maxCount = 0;
+
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
-        Ros_Debug_BroadcastMsg("ERROR: Unable to add point to queue.  Queue is locked up! (Group #%d)", ctrlGroup->groupNo);
-        return FALSE;
+        if (g_Ros_Controller.ctrlGroups[grpIndex]->pointQueueUnderrunCount > maxCount)
+            maxCount = g_Ros_Controller.ctrlGroups[grpIndex]->pointQueueUnderrunCount;
     }
 
-    return TRUE;
+    return maxCount;
 }
 
-UINT16 Ros_MotionControl_ProcessQueuedTrajectoryPoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request)
+//-------------------------------------------------------------------
+// Raw-streaming mode.
+// The client publishes the pulse increments of every interpolation cycle
+// for all groups. They are copied into the increment queues as they are,
+// one entry per cycle, so the IncMoveTask passes them to the controller
+// without any interpolation.
+//
+// Layout of the data: cycle by cycle, for each group (in the order of
+// the groups on the controller) MP_GRP_AXES_NUM increments in motoman
+// joint order.
+//-------------------------------------------------------------------
+RawIncrementsStatus Ros_MotionControl_ValidateRawIncrements(CtrlGroup* const ctrlGroups[], int numGroup, int32_t const* data, size_t size)
 {
-    if (Ros_MotionControl_MustInitializePointQueue)
-    {
-        Ros_Debug_BroadcastMsg("Initial point in trajectory queue");
+    size_t sizePerCycle = numGroup * MP_GRP_AXES_NUM;
 
-        Init_Trajectory_Status status;
-        status = Ros_MotionControl_InitPointQueue(request);
+    if (size == 0 || (size % sizePerCycle) != 0 || (size / sizePerCycle) > RAW_STREAMING_MAX_CYCLES_PER_MSG)
+        return RAW_INCREMENTS_INVALID_SIZE;
 
-        if (status == INIT_TRAJ_OK)
-        {
-            return motoros2_interfaces__msg__QueueResultEnum__SUCCESS;
-        }
-        else
-        {
-            return status;
-        }
+    for (size_t index = 0; index < size; index += 1)
+    {
+        CtrlGroup* ctrlGroup = ctrlGroups[(index / MP_GRP_AXES_NUM) % numGroup];
+        int axis = index % MP_GRP_AXES_NUM;
+
+        //maxInc is 0 for axes which don't exist, so those can't be moved
+        if (abs(data[index]) > ctrlGroup->maxInc.maxIncrement[axis])
+            return RAW_INCREMENTS_EXCEEDS_MAX_INC;
     }
 
-    //------------------------------------------------------------
-    //The trajectory contains information for all groups. Determine which groups are used by looking at the 'joint names'.
-    int grpIndex, jointIndexInTraj;
+    return RAW_INCREMENTS_OK;
+}
 
-    if (g_Ros_Controller.totalAxesCount != request->joint_names.size)
+RawIncrementsStatus Ros_MotionControl_AddRawIncrements(int32_t const* data, size_t size)
+{
+    RawIncrementsStatus status;
+    Incremental_data incData;
+    int numGroup = g_Ros_Controller.numGroup;
+    int numCycles;
+    int cycle, groupIndex, axis;
+
+    if (!Ros_MotionControl_IsMotionMode_RawStreaming() || Ros_MotionControl_RawStreaming.bUnderrun)
+        return RAW_INCREMENTS_NOT_STREAMING;
+
+    status = Ros_MotionControl_ValidateRawIncrements(g_Ros_Controller.ctrlGroups, numGroup, data, size);
+    if (status != RAW_INCREMENTS_OK)
+        return status;
+
+    //all groups must accept all cycles, otherwise a frame would be left incomplete. This task is the
+    //only producer, so the queue can only have more room by the time the increments are pushed.
+    numCycles = size / (numGroup * MP_GRP_AXES_NUM);
+    for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
     {
-        Ros_Debug_BroadcastMsg("Queued point must contain data for all %d joints.", g_Ros_Controller.totalAxesCount);
-        return motoros2_interfaces__msg__QueueResultEnum__INVALID_JOINT_LIST;
+        if (Ros_Controller_IncQ_Count(&g_Ros_Controller.incQueue, groupIndex) + numCycles > Q_HIGH_WATERMARK(g_Ros_Controller.ctrlGroups[groupIndex]))
+            return RAW_INCREMENTS_QUEUE_FULL;
     }
 
-    //===================================
-    //Incoming points are processed one joint at a time.
-    //For each of those joints, this iterates over all of the CtrlGroup objects and compares the joint names.
-    //This allows it to find the correct CtrlGroup object and the joint index (in moto order) in the JointMotionData array.
-    //===================================
+    bzero(&incData, sizeof(incData));
+    incData.frame = MP_INC_PULSE_DTYPE;
 
-    //precheck to ensure all groups are ready to accept a new point
-    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    for (cycle = 0; cycle < numCycles; cycle += 1)
     {
-        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        BOOL bMoving = FALSE;
 
-        if (ctrlGroup->trajectoryIterator != NULL && ctrlGroup->trajectoryIterator->valid)
+        Ros_MotionControl_RawStreaming.time += g_Ros_Controller.interpolPeriod;
+        incData.time = Ros_MotionControl_RawStreaming.time;
+
+        for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
         {
-            //A point is already being processed for this control group.
-            //Wait for it to be processed before adding a new point.
-            return motoros2_interfaces__msg__QueueResultEnum__BUSY;
+            CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
+            int32_t const* increments = &data[(cycle * numGroup + groupIndex) * MP_GRP_AXES_NUM];
+
+            incData.tool = ctrlGroup->tool;
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            {
+                incData.inc[axis] = increments[axis];
+                if (increments[axis] != 0)
+                    bMoving = TRUE;
+            }
+
+            Ros_Controller_IncQ_Push(&g_Ros_Controller.incQueue, groupIndex, &incData);
         }
+
+        //only updated after the cycle was pushed, so the watchdog never sees a 'moving' state with an empty queue
+        Ros_MotionControl_RawStreaming.bMoving = bMoving;
     }
 
-    if (Ros_MotionControl_HasDuplicateNames(&request->joint_names))
+    return RAW_INCREMENTS_OK;
+}
+
+void Ros_MotionControl_ResetRawStreaming()
+{
+    Ros_MotionControl_ClearQ_All();
+
+    Ros_MotionControl_RawStreaming.time = 0;
+    Ros_MotionControl_RawStreaming.bMoving = FALSE;
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+        g_Ros_Controller.ctrlGroups[groupIndex]->q_time = 0;
+
+    Ros_MotionControl_RawStreaming.bUnderrun = FALSE;
+    Ros_MotionControl_RawStreaming.bHoldPending = FALSE;
+}
+
+void Ros_MotionControl_CheckRawStreamingUnderrun()
+{
+    if (!Ros_MotionControl_IsMotionMode_RawStreaming() || Ros_MotionControl_RawStreaming.bUnderrun
+        || !Ros_MotionControl_RawStreaming.bMoving || Ros_MotionControl_HasDataInQueue())
+        return;
+
+    //reject everything the client publishes from now on. The robot is held outside of this task.
+    Ros_MotionControl_RawStreaming.underrunCount += 1;
+    Ros_MotionControl_RawStreaming.bHoldPending = TRUE;
+    Ros_MotionControl_RawStreaming.bUnderrun = TRUE;
+}
+
+//-------------------------------------------------------------------
+// Hold the robot after the raw-streaming watchdog latched an underrun.
+// (Called periodically by the controller status task)
+//-------------------------------------------------------------------
+void Ros_MotionControl_HandleRawStreamingUnderrun()
+{
+    if (!Ros_MotionControl_RawStreaming.bHoldPending)
+        return;
+
+    Ros_MotionControl_RawStreaming.bHoldPending = FALSE;
+    Ros_Debug_BroadcastMsg("Raw streaming underrun: increment queue empty while moving. Holding the robot. Please call '%s' to start streaming again.",
+        SERVICE_NAME_START_RAW_STREAMING_MODE);
+
+    Ros_MotionControl_StopMotion(/*bKeepJobRunning = */ FALSE);
+}
+
+int Ros_MotionControl_GetRawStreamingUnderrunCount()
+{
+    return Ros_MotionControl_RawStreaming.underrunCount;
+}
+
+//-------------------------------------------------------------------
+// Depth of the increment queue.
+// The AddToIncQueue task fills the queue up to the depth and is woken up
+// again once the IncMoveTask drained it to half the depth. A deeper queue
+// absorbs longer stalls of the AddToIncQueue task, but adds latency
+// between a new command and the resulting motion.
+//-------------------------------------------------------------------
+int Ros_MotionControl_GetConfiguredIncQueueDepth(MOTION_MODE mode)
+{
+    switch (mode)
     {
-        return INIT_TRAJ_DUPLICATE_JOINT_NAME;
+    case MOTION_MODE_POINTQUEUE:
+        return g_nodeConfigSettings.increment_queue_depth_point_queue;
+    case MOTION_MODE_RAWSTREAMING:
+        return g_nodeConfigSettings.increment_queue_depth_raw_streaming;
+    default:
+        return g_nodeConfigSettings.increment_queue_depth_trajectory;
     }
+}
 
-    //for each joint/axis in a single trajectory point
-    for (jointIndexInTraj = 0; jointIndexInTraj < request->joint_names.size; jointIndexInTraj += 1)
+void Ros_MotionControl_InitIncQueueDepth(MOTION_MODE mode)
+{
+    int depth = Ros_MotionControl_GetConfiguredIncQueueDepth(mode);
+
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
     {
-        int  jointIndexInCtrlGroup;
-        CtrlGroup* ctrlGroup;
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
 
-        if (!Ros_MotionControl_FindCtrlGroupAndIndex(&request->joint_names.data[jointIndexInTraj], &grpIndex, &jointIndexInCtrlGroup))
-        {
-            return motoros2_interfaces__msg__QueueResultEnum__INVALID_JOINT_LIST;
-        }
-        ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        ctrlGroup->incQueueDepth = depth;
+        ctrlGroup->incQueueLatencyPeak = 0;
+        ctrlGroup->incQueueRefillWait = -1;
+        ctrlGroup->incQueuePrevCount = 0;
+    }
 
-        // for point queuing, we create a single-point trajectory, store the incoming
-        // point in it and send it off for processing by the trajectory processing
-        // pipeline.
-        trajectory_msgs__msg__JointTrajectoryPoint__Sequence pointSequence;
+    Ros_Debug_BroadcastMsg("%s: increment queue depth = %d%s", __func__, depth,
+        (g_nodeConfigSettings.adaptive_increment_queue_depth && mode != MOTION_MODE_RAWSTREAMING) ? " (adaptive)" : "");
+}
 
-        pointSequence.capacity = 1;
-        pointSequence.size = 1;
-        pointSequence.data = &request->point; //no additional memory is allocated this way
+int Ros_MotionControl_ComputeAdaptiveIncQueueDepth(int* latencyPeak, int refillLatency, int maxDepth)
+{
+    //a slower refill is taken as the new peak immediately, faster ones only let it decay slowly
+    *latencyPeak -= *latencyPeak / ADAPTIVE_INC_QUEUE_LATENCY_DECAY;
+    if (refillLatency > *latencyPeak)
+        *latencyPeak = refillLatency;
+
+    int depth = *latencyPeak * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR;
+    if (depth < MIN_INCREMENT_QUEUE_DEPTH)
+        depth = MIN_INCREMENT_QUEUE_DEPTH;
+    if (depth > maxDepth)
+        depth = maxDepth;
+
+    return depth;
+}
 
-        //NOTE: I'm using the SECOND point in the 200 point buffer to hold the converted data. The `Ros_MotionControl_Init` function
-        //      populated the first buffer position with the initial point in the queue. Followup points are placed in the second 
-        //      buffer position. As the destination in position 2 is processed, it is moved into position 1 to become the starting
-        //      point for the next destination.
-        Init_Trajectory_Status status = Ros_MotionControl_ConvertTrajectoryToJointMotionData(&pointSequence, jointIndexInTraj, ctrlGroup, jointIndexInCtrlGroup, ctrlGroup->trajectoryIterator);
-        if (status != INIT_TRAJ_OK)
-        {
-            Ros_Debug_BroadcastMsg("Failed to parse incoming trajectory point.");
-            return motoros2_interfaces__msg__QueueResultEnum__UNABLE_TO_PROCESS_POINT;
-        }
-    }
+BOOL Ros_MotionControl_TrackIncQueueRefill(CtrlGroup* ctrlGroup, int countBeforeRead, int countAfterRead, BOOL bSignaled)
+{
+    BOOL bWake = FALSE;
 
-    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    if (!g_nodeConfigSettings.adaptive_increment_queue_depth || Ros_MotionControl_IsMotionMode_RawStreaming())
+        return FALSE;
+
+    if (ctrlGroup->incQueueRefillWait >= 0)
     {
-        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        ctrlGroup->incQueueRefillWait += 1;
 
-        ctrlGroup->trajectoryIterator->valid = TRUE;
+        if (countBeforeRead > ctrlGroup->incQueuePrevCount)
+        {
+            //the AddToIncQueue task has added increments since the previous cycle
+            ctrlGroup->incQueueDepth = Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&ctrlGroup->incQueueLatencyPeak,
+                ctrlGroup->incQueueRefillWait, Ros_MotionControl_GetConfiguredIncQueueDepth(Ros_MotionControl_ActiveMotionMode));
+            ctrlGroup->incQueueRefillWait = -1;
+
+            //If the depth was raised, the count can already be below the new low watermark. The IncMoveTask
+            //only wakes the AddToIncQueue task when the count reaches it, so it would sleep until its wait
+            //times out (and let the queue run empty).
+            bWake = !bSignaled && (countAfterRead < Q_LOW_WATERMARK(ctrlGroup));
+        }
+        else if (countBeforeRead == 0)
+        {
+            //the queue ran empty before it was refilled. That is only a stall of the AddToIncQueue task
+            //if it still had increments to add (otherwise the end of the trajectory has been reached).
+            if (ctrlGroup->hasDataToProcess)
+            {
+                ctrlGroup->incQueueDepth = Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&ctrlGroup->incQueueLatencyPeak,
+                    ctrlGroup->incQueueRefillWait, Ros_MotionControl_GetConfiguredIncQueueDepth(Ros_MotionControl_ActiveMotionMode));
+            }
+            ctrlGroup->incQueueRefillWait = -1;
+        }
     }
 
-    return motoros2_interfaces__msg__QueueResultEnum__SUCCESS;
+    if (bSignaled || bWake)
+        ctrlGroup->incQueueRefillWait = 0;
+    ctrlGroup->incQueuePrevCount = countAfterRead;
+
+    return bWake;
 }
 
 //-------------------------------------------------------------------
-// Task to move the robot at each interpolation increment
+// Underrun accounting of the increment queue.
+// An underrun is the queue of a group running empty while its producer
+// still has increments to add. The queue draining at the end of a
+// trajectory (or while the point queue waits for the next point) is not
+// an underrun, as the robot is supposed to come to a stop there.
 //-------------------------------------------------------------------
-void Ros_MotionControl_IncMoveLoopStart() //<-- IP_CLK priority task
+void Ros_MotionControl_ResetIncQueueStats()
 {
-    MP_EXPOS_DATA moveData;
-
-    Incremental_q* q;
-    int i;
-    int ret;
-    UINT64 inc_data_time;
-    UINT64 q_time;
-    int axis;
-
-    MP_CTRL_GRP_SEND_DATA ctrlGrpData;
-    MP_PULSE_POS_RSP_DATA prevPulsePosData[MAX_CONTROLLABLE_GROUPS];
-    MP_PULSE_POS_RSP_DATA pulsePosData;
-
-    // --- FSU Speed Limit related ---
-    // When FSU speed limitation is active, some pulses for an interpolation cycle may not be processed by the controller.
-    // To track the true amount of pulses processed, we keep track of the command position and by substracting the
-    // the previous position from the current one, we can confirm the amount if pulses precessed.
-    // If the amount processed doesn't match the amount sent at the previous cycle, we resend the unprocessed pulses amount.
-    // To keep the motion smooth, the 'maximum speed' (max pulses per cycle) is tracked and used to skip reading
-    // more pulse increment from the queue if the amount of unprocessed pulses is larger than the detected speed.
-    // The 'maximum speed' is also used to prevent exceeding the commanded speed once the FSU Speed Limit is removed.
-    //
-    // The following set of variables are used to track FSU speed limitation.
-    LONG newPulseInc[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];         // Pulse increments that we just retrieved from the incQueue
-    LONG toProcessPulses[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];     // Total pulses that still need to be sent to the command
-    LONG processedPulses[MP_GRP_AXES_NUM];                              // Amount of pulses from the last command that were actually processed (accepted)
-    LONG maxSpeed[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];            // ROS speed (amount of pulses for one cycle from the data queue) that should not be exceeded
-    LONG maxSpeedRemain[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];      // Number of pulses (absolute) that remains to be processed at the 'maxSpeed'
-    LONG prevMaxSpeed[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];        // Previous data queue reading 'maxSpeed'
-    LONG prevMaxSpeedRemain[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];  // Previous data queue reading 'maxSpeedRemain'
-    BOOL skipReadingQ[MAX_CONTROLLABLE_GROUPS];                         // Flag indicating to skip reading more data from the increment queue (there is enough unprocessed from previous cycles remaining)
-    BOOL queueRead[MAX_CONTROLLABLE_GROUPS];                            // Flag indicating that new increment data was retrieve from the queue on this cycle.
-    BOOL isMissingPulse;                                                // Flag that there are pulses send in last cycle that are missing from the command (pulses were not processed)
-    BOOL hasUnprocessedData;                                            // Flag that at least one axis (any group) still has unprecessed data. (Used to continue sending data after the queue is empty.)
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
+    {
+        IncQueueStats* stats = &g_Ros_Controller.ctrlGroups[groupIndex]->incQueueStats;
 
-    bzero(newPulseInc, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-    bzero(toProcessPulses, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-    bzero(processedPulses, sizeof(LONG) * MP_GRP_AXES_NUM);
-    bzero(prevMaxSpeed, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-    bzero(prevMaxSpeedRemain, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-    bzero(maxSpeed, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-    bzero(maxSpeedRemain, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-    bzero(skipReadingQ, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
-    bzero(queueRead, sizeof(BOOL) * MAX_CONTROLLABLE_GROUPS);
+        bzero(stats, sizeof(IncQueueStats));
+        stats->minFill = -1;
+    }
+}
 
-    isMissingPulse = FALSE;
-    hasUnprocessedData = FALSE;
+BOOL Ros_MotionControl_UpdateIncQueueStats(IncQueueStats* stats, int count, BOOL bProducing)
+{
+    if (!bProducing)
+    {
+        stats->currentUnderrun = 0;
+        return FALSE;
+    }
 
-    Ros_Debug_BroadcastMsg("IncMoveTask Started");
+    //the queue is empty until the producer added the first increments of the trajectory
+    if (!stats->bPrimed)
+    {
+        if (count == 0)
+            return FALSE;
+        stats->bPrimed = TRUE;
+    }
 
-    bzero(&moveData, sizeof(moveData));
+    if (stats->minFill < 0 || count < stats->minFill)
+        stats->minFill = count;
 
-    for (i = 0; i < g_Ros_Controller.numGroup; i++)
+    if (count > 0)
     {
-        moveData.ctrl_grp |= (0x01 << i);
-        moveData.grp_pos_info[i].pos_tag.data[0] = Ros_CtrlGroup_GetAxisConfig(g_Ros_Controller.ctrlGroups[i]);
+        stats->currentUnderrun = 0;
+        return FALSE;
+    }
 
-        ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
-        mpGetPulsePos(&ctrlGrpData, &prevPulsePosData[i]);
+    stats->currentUnderrun += 1;
+    if (stats->currentUnderrun > stats->longestUnderrun)
+        stats->longestUnderrun = stats->currentUnderrun;
+
+    if (stats->currentUnderrun == 1)
+    {
+        stats->underrunCount += 1;
+        return TRUE;
     }
+    return FALSE;
+}
 
-    FOREVER
+void Ros_MotionControl_TrackIncQueueUnderrun()
+{
+    if (!Ros_Controller_IsMotionReady() || g_Ros_Controller.bStopMotion)
+        return;
+
+    for (int groupIndex = 0; groupIndex < g_Ros_Controller.numGroup; groupIndex += 1)
     {
-        mpClkAnnounce(MP_INTERPOLATION_CLK);
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[groupIndex];
+        JointMotionData const* iterator = ctrlGroup->trajectoryIterator;
+        BOOL bProducing;
 
-        if (Ros_Controller_IsMotionReady()
-            && (Ros_MotionControl_HasDataInQueue() || hasUnprocessedData)
-            && !g_Ros_Controller.bStopMotion)
+        if (Ros_MotionControl_IsMotionMode_RawStreaming())
+            bProducing = Ros_MotionControl_RawStreaming.bMoving && !Ros_MotionControl_RawStreaming.bUnderrun;
+        else
+            bProducing = Ros_MotionControl_AllGroupsInitComplete && !Ros_IncPrecompile_IsPending()
+                && ctrlGroup->hasDataToProcess && iterator != NULL && iterator->valid;
+
+        if (Ros_MotionControl_UpdateIncQueueStats(&ctrlGroup->incQueueStats,
+            Ros_Controller_IncQ_Count(&g_Ros_Controller.incQueue, groupIndex), bProducing))
         {
-            // For each control group, retrieve the new pulse increments for this cycle
-            for (i = 0; i < g_Ros_Controller.numGroup; i++)
-            {
-                queueRead[i] = FALSE;
-                if (skipReadingQ[i])
-                {
-                    // Reset skip flag and set position increment to 0
-                    skipReadingQ[i] = FALSE;
-                    bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
-                }
-                else
-                {
-                    // Retrieve position increment from the queue.
-                    q = &g_Ros_Controller.ctrlGroups[i]->inc_q;
+            Ros_Debug_BroadcastMsg("Increment queue underrun (Group #%d): queue ran empty mid-trajectory", ctrlGroup->groupNo);
+        }
+    }
+}
 
-                    // Lock the q before manipulating it
-                    if (mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
-                    {
-                        if (q->cnt > 0)
-                        {
-                            // Initialize moveData with the next data from the queue
-                            inc_data_time = q->data[q->idx].time;
-                            q_time = g_Ros_Controller.ctrlGroups[i]->q_time;
-                            moveData.grp_pos_info[i].pos_tag.data[2] = q->data[q->idx].tool;
-                            moveData.grp_pos_info[i].pos_tag.data[3] = q->data[q->idx].frame;
-                            moveData.grp_pos_info[i].pos_tag.data[4] = q->data[q->idx].user;
-
-                            memcpy(&moveData.grp_pos_info[i].pos, &q->data[q->idx].inc, sizeof(LONG) * MP_GRP_AXES_NUM);
-                            queueRead[i] = TRUE;
-
-                            // increment index in the queue and decrease the count
-                            q->idx = Q_OFFSET_IDX(q->idx, 1, Q_SIZE);
-                            q->cnt--;
-
-                            // Check if complete interpolation period covered.
-                            // (Because time period of data received from ROS may not be a multiple of the
-                            // controller interpolation clock period, the queue may contain partiel period and
-                            // more than one queue increment maybe required to complete the interpolation period)
-                            while (q->cnt > 0)
-                            {
-                                if ((q_time <= q->data[q->idx].time)
-                                    && (q->data[q->idx].time - q_time <= g_Ros_Controller.interpolPeriod))
-                                {
-                                    // next incMove is part of same interpolation period
-
-                                    // check that information is in the same format
-                                    if ((moveData.grp_pos_info[i].pos_tag.data[2] != q->data[q->idx].tool)
-                                        || (moveData.grp_pos_info[i].pos_tag.data[3] != q->data[q->idx].frame)
-                                        || (moveData.grp_pos_info[i].pos_tag.data[4] != q->data[q->idx].user))
-                                    {
-                                        // Different format can't combine information
-                                        break;
-                                    }
-
-                                    // add next incMove to current incMove
-                                    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                                        moveData.grp_pos_info[i].pos[axis] += q->data[q->idx].inc[axis];
-                                    inc_data_time = q->data[q->idx].time;
-
-                                    // increment index in the queue and decrease the count
-                                    q->idx = Q_OFFSET_IDX(q->idx, 1, Q_SIZE);
-                                    q->cnt--;
-                                }
-                                else
-                                {
-                                    // interpolation period complete
-                                    break;
-                                }
-                            }
+//-------------------------------------------------------------------
+// Speed scaling of the active trajectory.
+// The scale time-warps the interpolation clock: at a scale of 0.5, each
+// interpolation cycle only advances the trajectory by half a period, so
+// the same path is followed at half the speed. Changes are applied with
+// a linear ramp, which takes 'speed_scale_ramp_time' for a change from
+// 0.0 to 1.0.
+//-------------------------------------------------------------------
+void Ros_MotionControl_InitSpeedScale()
+{
+    SpeedScaleRamp ramp = { SPEED_SCALE_MAX, SPEED_SCALE_MAX, 0 };
 
-                            g_Ros_Controller.ctrlGroups[i]->q_time = inc_data_time;
-                        }
-                        else
-                        {
-                            // Queue is empty, initialize to 0 pulse increment
-                            moveData.grp_pos_info[i].pos_tag.data[2] = 0;
-                            moveData.grp_pos_info[i].pos_tag.data[3] = MP_INC_PULSE_DTYPE;
-                            moveData.grp_pos_info[i].pos_tag.data[4] = 0;
-                            bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
-                        }
+    if (Ros_MotionControl_SpeedScaleLock == NULL)
+        Ros_MotionControl_SpeedScaleLock = mpSemBCreate(SEM_Q_FIFO, SEM_FULL);
 
-                        // Unlock the q
-                        mpSemGive(q->q_lock);
-                    }
-                    else
-                    {
-                        Ros_Debug_BroadcastMsg("ERROR: Can't get data from queue. Queue is locked up (Group #%d)", g_Ros_Controller.ctrlGroups[i]->groupNo);
-                        bzero(&moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
-                        continue;
-                    }
-                }
-            }
+    mpSemTake(Ros_MotionControl_SpeedScaleLock, WAIT_FOREVER);
+    Ros_MotionControl_WriteSpeedScaleRamp(&ramp);
+    mpSemGive(Ros_MotionControl_SpeedScaleLock);
+}
 
-            hasUnprocessedData = FALSE;
-            for (i = 0; i < g_Ros_Controller.numGroup; i++)
-            {
-                memcpy(newPulseInc[i], moveData.grp_pos_info[i].pos, sizeof(LONG) * MP_GRP_AXES_NUM);
+void Ros_MotionControl_CleanupSpeedScale()
+{
+    if (Ros_MotionControl_SpeedScaleLock != NULL)
+    {
+        mpSemDelete(Ros_MotionControl_SpeedScaleLock);
+        Ros_MotionControl_SpeedScaleLock = NULL;
+    }
+}
 
-                // record the speed associate with the next amount of pulses
-                if (queueRead[i])
-                {
-                    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                    {
-                        maxSpeed[i][axis] = abs(newPulseInc[i][axis]);
-                        maxSpeedRemain[i][axis] = abs(newPulseInc[i][axis]);
-                    }
-                }
+//-------------------------------------------------------------------
+// Publish a new ramp. The caller must hold Ros_MotionControl_SpeedScaleLock.
+//-------------------------------------------------------------------
+void Ros_MotionControl_WriteSpeedScaleRamp(SpeedScaleRamp const* ramp)
+{
+    Ros_MotionControl_SpeedScaleSequence += 1;
+    Q_MEMORY_BARRIER();
+    Ros_MotionControl_SpeedScaleRamp = *ramp;
+    Q_MEMORY_BARRIER();
+    Ros_MotionControl_SpeedScaleSequence += 1;
+}
 
-                // Check if pulses are missing from last increment.
-                // Get the current controller command position and substract the previous command position
-                // and check if it matches the amount if increment sent last cycle.  If it doesn't then
-                // some pulses are missing and the amount of unprocessed pulses needs to be added to this cycle.
-                ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
-                mpGetPulsePos(&ctrlGrpData, &pulsePosData);
-                isMissingPulse = FALSE;                
-                for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                {
-                    // Check how many pulses we processed from last increment
-                    processedPulses[axis] = pulsePosData.lPos[axis] - prevPulsePosData[i].lPos[axis];
-                    prevPulsePosData[i].lPos[axis] = pulsePosData.lPos[axis];
+//-------------------------------------------------------------------
+// Copy the current ramp without taking the lock (see Q_MEMORY_BARRIER
+// for why the barriers are sufficient). The AddToIncQueue tasks can
+// preempt the executor in the middle of an update, which they would
+// wait for forever. So after SPEED_SCALE_READ_ATTEMPTS, the ramp is
+// read with the lock instead, which lets the update complete.
+//-------------------------------------------------------------------
+void Ros_MotionControl_ReadSpeedScaleRamp(SpeedScaleRamp* ramp)
+{
+    for (int attempt = 0; attempt < SPEED_SCALE_READ_ATTEMPTS; attempt += 1)
+    {
+        UINT32 sequence = Ros_MotionControl_SpeedScaleSequence;
+        Q_MEMORY_BARRIER();
+        if (sequence & 1)
+            continue;
 
-                    // Remove those pulses from the amount to process.  
-                    // If everything was processed, then there should by 0 pulses left. Otherwise FSU Speed limit prevented processing
-                    toProcessPulses[i][axis] -= processedPulses[axis];
-                    if (toProcessPulses[i][axis] != 0)
-                        isMissingPulse = TRUE;
+        *ramp = Ros_MotionControl_SpeedScaleRamp;
+        Q_MEMORY_BARRIER();
 
-                    // Add the new pulses to be processed for this iteration 
-                    toProcessPulses[i][axis] += newPulseInc[i][axis];
+        if (Ros_MotionControl_SpeedScaleSequence == sequence)
+            return;
+    }
 
-                    if (toProcessPulses[i][axis] != 0)
-                        hasUnprocessedData = TRUE;
-                }
+    mpSemTake(Ros_MotionControl_SpeedScaleLock, WAIT_FOREVER);
+    *ramp = Ros_MotionControl_SpeedScaleRamp;
+    mpSemGive(Ros_MotionControl_SpeedScaleLock);
+}
 
-                // Check if pulses are missing which means that the FSU speed limit is enabled
-                if (isMissingPulse)
-                {
-                    UINT64 max_inc;
-
-                    // Prevent going faster than original requested speed once speed limit turns off
-                    // Check if the speed (inc) of previous interation should be considered by checking 
-                    // if the unprocessed pulses from that speed setting still remains.
-                    // If all the pulses of previous increment were processed, then transfer the current 
-                    // speed and process the next increment from the increment queue.
-                    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                    {
-                        // Check if has pulses to process
-                        if (toProcessPulses[i][axis] == 0)
-                            prevMaxSpeedRemain[i][axis] = 0;
-                        else
-                            prevMaxSpeedRemain[i][axis] = abs(prevMaxSpeedRemain[i][axis]) - abs(processedPulses[axis]);
-                    }
+double Ros_MotionControl_EvaluateSpeedScaleRamp(SpeedScaleRamp const* ramp, UINT32 cycle, double stepPerCycle)
+{
+    INT32 elapsedCycles = (INT32)(cycle - ramp->startCycle); //signed, so a ramp which starts in the future is handled as well
+    double change = fabs(ramp->targetScale - ramp->startScale);
 
-                    // Check if still have data to process from previous iteration
-                    skipReadingQ[i] = FALSE;
-                    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                    {
-                        if (prevMaxSpeedRemain[i][axis] > 0)
-                            skipReadingQ[i] = TRUE;
-                    }
+    if (elapsedCycles <= 0)
+        return ramp->startScale;
 
-                    if (!skipReadingQ[i]) {
-                        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++) {
-                            // Transfer the current speed as the new prevSpeed
-                            prevMaxSpeed[i][axis] = maxSpeed[i][axis];
-                            prevMaxSpeedRemain[i][axis] += maxSpeedRemain[i][axis];
-                        }
-                    }
+    if (elapsedCycles * stepPerCycle >= change)
+        return ramp->targetScale;
 
-                    // Set the number of pulse that can be sent without exceeding speed
-                    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                    {
-                        // Check if has pulses to process
-                        if (toProcessPulses[i][axis] == 0)
-                            continue;
+    if (ramp->targetScale > ramp->startScale)
+        return ramp->startScale + (elapsedCycles * stepPerCycle);
+    else
+        return ramp->startScale - (elapsedCycles * stepPerCycle);
+}
 
-                        // Maximum inc that should be send ()
-                        if (prevMaxSpeed[i][axis] > 0)
-                            // if previous speed is defined use it
-                            max_inc = prevMaxSpeed[i][axis];
-                        else
-                        {
-                            if (maxSpeed[i][axis] > 0)
-                                // else fallback on current speed if defined
-                                max_inc = maxSpeed[i][axis];
-                            else if (newPulseInc[i][axis] != 0)
-                                // use the current speed if none zero.
-                                max_inc = abs(newPulseInc[i][axis]);
-                            else
-                                // otherwise use the axis max speed
-                                max_inc = g_Ros_Controller.ctrlGroups[i]->maxInc.maxIncrement[axis];
-
-                            if(max_inc > 1)
-                                Ros_Debug_BroadcastMsg("Warning undefined speed: Axis %d Defaulting Max Inc: %d (prevSpeed: %d curSpeed %d)",
-                                axis, max_inc, prevMaxSpeed[i][axis], maxSpeed[i][axis]);
+void Ros_MotionControl_SetSpeedScale(double speedScale)
+{
+    double stepPerCycle = (double)g_Ros_Controller.interpolPeriod / g_nodeConfigSettings.speed_scale_ramp_time;
+    UINT32 nextCycle = 0;
+    double startScale;
 
-                        }
+    if (speedScale < SPEED_SCALE_MIN)
+        speedScale = SPEED_SCALE_MIN;
+    else if (speedScale > SPEED_SCALE_MAX)
+        speedScale = SPEED_SCALE_MAX;
 
-                        // Set new increment and recalculate unsent pulses
-                        if (abs(toProcessPulses[i][axis]) <= max_inc)
-                        {
-                            // Pulses to send is small than max, so send everything
-                            moveData.grp_pos_info[i].pos[axis] = toProcessPulses[i][axis];
-                        }
-                        else {
-                            // Pulses to send is too high, so send the amount matching the maximum speed
-                            if (toProcessPulses[i][axis] >= 0)
-                                moveData.grp_pos_info[i].pos[axis] = max_inc;
-                            else
-                                moveData.grp_pos_info[i].pos[axis] = -max_inc;
-                        }
-                    }
-                }
-                else
-                {
-                    // No PFL Speed Limit detected
-                    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
-                    {
-                        prevMaxSpeed[i][axis] = abs(moveData.grp_pos_info[i].pos[axis]);
-                        prevMaxSpeedRemain[i][axis] = abs(moveData.grp_pos_info[i].pos[axis]);
-                    }
-                }
-            }
+    if (Ros_MotionControl_SpeedScaleLock == NULL)
+        return;
 
-            // Make sure motion / goal has not been cancelled in the meantime.
-            // Additionally, if the Agent PC is disconnected, check to see if
-            // motion should continue.
-            if (!g_Ros_Controller.bStopMotion && (g_Ros_Communication_AgentIsConnected || !g_nodeConfigSettings.stop_motion_on_disconnect))
-            {
-                // Send pulse increment to the controller command position
-                ret = mpExRcsIncrementMove(&moveData);
+    mpSemTake(Ros_MotionControl_SpeedScaleLock, WAIT_FOREVER);
 
-                Ros_ActionServer_FJT_UpdateProgressTracker(&moveData);
-            }
-            else 
-                ret = 0;
+    //The new ramp starts after the last cycle which has been generated by any group. Groups
+    //which are behind will apply it at the same cycle, so they stay synchronized.
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        if ((INT32)(g_Ros_Controller.ctrlGroups[grpIndex]->speedScaleCycle - nextCycle) > 0)
+            nextCycle = g_Ros_Controller.ctrlGroups[grpIndex]->speedScaleCycle;
+    }
 
-            if (ret != 0)
-            {
-                // Failure: command rejected by controller.
-                // Update controller status to help identify cause
-                Ros_Controller_IoStatusUpdate();
+    SpeedScaleRamp ramp;
+    startScale = Ros_MotionControl_EvaluateSpeedScaleRamp(&Ros_MotionControl_SpeedScaleRamp, nextCycle, stepPerCycle);
+    ramp.startScale = startScale;
+    ramp.targetScale = speedScale;
+    ramp.startCycle = nextCycle;
+    Ros_MotionControl_WriteSpeedScaleRamp(&ramp);
 
-                if (ret == E_EXRCS_CTRL_GRP)
-                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned: %d (ctrl_grp = %d)", ret, moveData.ctrl_grp);
-                else if (ret == E_EXRCS_IMOV_UNREADY && g_Ros_Controller.bPFLEnabled)
-                {
-                    // Check if this is caused by a known cause (E-Stop, Hold, Alarm, Error)
-                    if (!Ros_Controller_IsEStop() && !Ros_Controller_IsHold()
-                        && !Ros_Controller_IsAlarm() && !Ros_Controller_IsError()) {
-                        Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned UNREADY: %d (Could be PFL Active)", E_EXRCS_IMOV_UNREADY);
-                        g_Ros_Controller.bPFLduringRosMove = TRUE;
-                    }
-                }
-                else if (ret == E_EXRCS_PFL_FUNC_BUSY && g_Ros_Controller.bPFLEnabled)
-                {
-                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned PFL Active");
-                    g_Ros_Controller.bPFLduringRosMove = TRUE;
-                }
-                else if (ret == E_EXRCS_UNDER_ENERGY_SAVING)
-                {
-                    // retry until servos turn on and motion is accepted
-                    int checkCount;
-                    for (checkCount = 0; checkCount < MOTION_START_TIMEOUT; checkCount += MOTION_START_CHECK_PERIOD)
-                    {
-                        ret = mpExRcsIncrementMove(&moveData);
-                        if (ret != E_EXRCS_UNDER_ENERGY_SAVING)
-                            break;
+    mpSemGive(Ros_MotionControl_SpeedScaleLock);
 
-                        Ros_Sleep(MOTION_START_CHECK_PERIOD);
-                    }
-                    if (g_Ros_Controller.bMpIncMoveError)
-                        Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned Eco mode enabled");
-                }
-                else if(ret == E_EXRCS_IMOV_UNREADY)
-                {
-                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned -1 (Not executing WAIT instruction)");
-                }
-                else
-                    Ros_Debug_BroadcastMsg("mpExRcsIncrementMove returned: %d", ret);
+    Ros_Debug_BroadcastMsg("Speed scale: ramping from %.3f to %.3f", startScale, speedScale);
+}
 
-                // Stop motion if motion was rejected
-                if (ret != 0)
-                {
-                    // Flag to prevent further motion until Trajectory mode is reenabled
-                    g_Ros_Controller.bMpIncMoveError = TRUE;
-                    Ros_MotionControl_StopMotion(/*bKeepJobRunning = */ FALSE);
-                    Ros_Debug_BroadcastMsg("Stopping all motion");
-                }
-            }
-        }
-        else
-        {
-            // Reset previous position in case the robot is moved externally
-            bzero(toProcessPulses, sizeof(LONG) * MP_GRP_AXES_NUM * MAX_CONTROLLABLE_GROUPS);
-            hasUnprocessedData = FALSE;
-            for (i = 0; i < g_Ros_Controller.numGroup; i++)
-            {
-                ctrlGrpData.sCtrlGrp = g_Ros_Controller.ctrlGroups[i]->groupId;
-                mpGetPulsePos(&ctrlGrpData, &prevPulsePosData[i]);
-            }
-        }
+double Ros_MotionControl_StepSpeedScale(CtrlGroup* ctrlGroup)
+{
+    double stepPerCycle = (double)g_Ros_Controller.interpolPeriod / g_nodeConfigSettings.speed_scale_ramp_time;
+    double speedScale = SPEED_SCALE_MAX;
+
+    if (Ros_MotionControl_IsMotionMode_Trajectory() && Ros_MotionControl_SpeedScaleLock != NULL)
+    {
+        SpeedScaleRamp ramp;
+
+        Ros_MotionControl_ReadSpeedScaleRamp(&ramp);
+        speedScale = Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, ctrlGroup->speedScaleCycle, stepPerCycle);
     }
+
+    ctrlGroup->speedScaleCycle += 1;
+    ctrlGroup->speedScaleDelay_ms += g_Ros_Controller.interpolPeriod * (1.0 - speedScale);
+
+    return speedScale;
 }
 
 //-------------------------------------------------------------------
-// Check the number of inc_move currently in the specified queue
+// Time (in ms) by which the execution of the active trajectory has been
+// delayed because of speed scaling. Each group tracks the delay of the
+// cycles it has generated. All groups follow the same ramp at the same
+// cycles, so they only differ by how far ahead their AddToIncQueue task
+// is. The group which is furthest ahead is the closest to the delay at
+// which the robot will reach the end of the generated cycles.
 //-------------------------------------------------------------------
-int Ros_MotionControl_GetQueueCnt(int groupNo)
+double Ros_MotionControl_GetSpeedScaleDelay()
 {
-    Incremental_q* q;
-
-    // Check group number valid
-    if (!Ros_Controller_IsValidGroupNo(groupNo))
-        return -1;
-
-    // Set pointer to specified queue
-    q = &g_Ros_Controller.ctrlGroups[groupNo]->inc_q;
+    double delay_ms = 0.0;
 
-    // Lock the q before manipulating it
-    if (mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
-        int count = q->cnt;
-
-        // Unlock the q
-        mpSemGive(q->q_lock);
-
-        return count;
+        if (g_Ros_Controller.ctrlGroups[grpIndex]->speedScaleDelay_ms > delay_ms)
+            delay_ms = g_Ros_Controller.ctrlGroups[grpIndex]->speedScaleDelay_ms;
     }
 
-    Ros_Debug_BroadcastMsg("ERROR: Unable to access queue count.  Queue is locked up! (Group #%d)", groupNo);
-    return ERROR;
+    return delay_ms;
 }
 
 //-------------------------------------------------------------------
@@ -1079,11 +2905,16 @@ int Ros_MotionControl_GetQueueCnt(int groupNo)
 //-------------------------------------------------------------------
 BOOL Ros_MotionControl_HasDataInQueue()
 {
+    //Only complete frames are sent to the robot. A partial frame is left behind if a group stopped producing
+    //before the others, and it is only data in the queue as long as the other groups can still complete it.
+    if (Ros_Controller_IncQ_FrameCount(&g_Ros_Controller.incQueue) > 0)
+        return TRUE;
+
     for (int groupNo = 0; groupNo < g_Ros_Controller.numGroup; groupNo++)
     {
         int qCnt = Ros_MotionControl_GetQueueCnt(groupNo);
         if (qCnt > 0)
-            return TRUE;
+            return Ros_MotionControl_HasDataToProcess();
         else if (qCnt == ERROR)
             return ERROR;
     }
@@ -1093,30 +2924,10 @@ BOOL Ros_MotionControl_HasDataInQueue()
 
 BOOL Ros_MotionControl_FindCtrlGroupAndIndex(rosidl_runtime_c__String* jointName, int* group_idx, int* joint_idx)
 {
-    CtrlGroup* ctrlGroup;
-    int grpIndex;
-    int jointIndexInCtrlGroup;
     char* name = jointName->data;
 
-    //find the ctrlgroup for this joint
-    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
-    {
-        ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
-
-        for (jointIndexInCtrlGroup = 0; jointIndexInCtrlGroup < MP_GRP_AXES_NUM; jointIndexInCtrlGroup += 1)
-        {
-            char* ctrlGroupJointName = ctrlGroup->jointNames_userDefined[jointIndexInCtrlGroup];
-            if (strlen(ctrlGroupJointName) != 0)
-            {
-                if (strcmp(ctrlGroupJointName, name) == 0)
-                {
-                    *group_idx = grpIndex;
-                    *joint_idx = jointIndexInCtrlGroup;
-                    return TRUE;
-                }
-            }
-        }
-    }
+    if (Ros_Controller_LookupJointName(&g_Ros_Controller, name, group_idx, joint_idx))
+        return TRUE;
 
     Ros_Debug_BroadcastMsg("Joint name [%s] is not valid. Check motoros2_config.yaml and update accordingly.", name);
     Ros_Debug_BroadcastMsg("Valid names:");
@@ -1133,22 +2944,79 @@ BOOL Ros_MotionControl_FindCtrlGroupAndIndex(rosidl_runtime_c__String* jointName
     return FALSE;
 }
 
-BOOL Ros_MotionControl_HasDuplicateNames(rosidl_runtime_c__String__Sequence* jointNames)
+//-------------------------------------------------------------------
+// 64-bit FNV-1a hash of a list of joint names. Like the lookup, only the
+// first MAX_JOINT_NAME_LENGTH characters of a name are significant. Each
+// name is terminated in the hash, so {"ab", "c"} and {"a", "bc"} differ.
+//-------------------------------------------------------------------
+#define JOINT_NAMES_HASH_OFFSET     0xcbf29ce484222325ULL
+#define JOINT_NAMES_HASH_PRIME      0x00000100000001b3ULL
+UINT64 Ros_MotionControl_HashJointNames(rosidl_runtime_c__String__Sequence const* jointNames)
+{
+    UINT64 hash = JOINT_NAMES_HASH_OFFSET;
+
+    for (int i = 0; i < jointNames->size; i += 1)
+    {
+        char const* name = jointNames->data[i].data;
+
+        for (int c = 0; c < MAX_JOINT_NAME_LENGTH && name[c] != '\0'; c += 1)
+            hash = (hash ^ (UCHAR)name[c]) * JOINT_NAMES_HASH_PRIME;
+        hash *= JOINT_NAMES_HASH_PRIME; //terminator
+    }
+
+    return hash;
+}
+
+Init_Trajectory_Status Ros_MotionControl_MapJointNames(rosidl_runtime_c__String__Sequence* jointNames)
 {
-    for (int i = 0; i < jointNames->size - 1; i += 1)
+    JointNameMappingCache* cache = &Ros_MotionControl_JointNameCache;
+    UINT64 hash = Ros_MotionControl_HashJointNames(jointNames);
+    BOOL bSameAsCache = (cache->count > 0 && cache->count == jointNames->size && cache->hash == hash);
+    int i;
+
+    if (!bSameAsCache)
     {
-        for (int j = (i + 1); j < jointNames->size; j += 1)
+        BOOL bIsUsed[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];
+        int usedByIndex[MAX_CONTROLLABLE_GROUPS][MP_GRP_AXES_NUM];
+
+        bzero(bIsUsed, sizeof(bIsUsed));
+        cache->count = 0;
+
+        if (jointNames->size > MAX_CONTROLLABLE_AXES)
+            return INIT_TRAJ_INVALID_JOINTNAME;
+
+        for (i = 0; i < jointNames->size; i += 1)
         {
-            if (strncmp(jointNames->data[i].data,
-                jointNames->data[j].data,
-                MAX_JOINT_NAME_LENGTH) == 0)
+            int grpIndex, jointIndexInCtrlGroup;
+
+            if (!Ros_MotionControl_FindCtrlGroupAndIndex(&jointNames->data[i], &grpIndex, &jointIndexInCtrlGroup))
+                return INIT_TRAJ_INVALID_JOINTNAME;
+
+            //two names can only map onto the same axis if they are the same name
+            if (bIsUsed[grpIndex][jointIndexInCtrlGroup])
             {
-                Ros_Debug_BroadcastMsg("Joint name [%s] is used for multiple joints in the trajectory (indices: %d and %d).", jointNames->data[i].data, i, j);
-                return TRUE;
+                Ros_Debug_BroadcastMsg("Joint name [%s] is used for multiple joints in the trajectory (indices: %d and %d).",
+                    jointNames->data[i].data, usedByIndex[grpIndex][jointIndexInCtrlGroup], i);
+                return INIT_TRAJ_DUPLICATE_JOINT_NAME;
             }
+            bIsUsed[grpIndex][jointIndexInCtrlGroup] = TRUE;
+            usedByIndex[grpIndex][jointIndexInCtrlGroup] = i;
+
+            cache->groupIndex[i] = (UINT8)grpIndex;
+            cache->jointIndex[i] = (UINT8)jointIndexInCtrlGroup;
         }
+
+        //only successfully mapped lists are cached
+        for (i = 0; i < jointNames->size; i += 1)
+            strncpy(cache->names[i], jointNames->data[i].data, MAX_JOINT_NAME_LENGTH);
+        cache->count = jointNames->size;
+        cache->hash = hash;
     }
-    return FALSE;
+
+    for (i = 0; i < cache->count; i += 1)
+        g_Ros_Controller.ctrlGroups[cache->groupIndex[i]]->trajJointIndex[cache->jointIndex[i]] = i;
+
+    return INIT_TRAJ_OK;
 }
 
 //-------------------------------------------------------------------
@@ -1200,6 +3068,8 @@ BOOL Ros_MotionControl_StopMotion(BOOL bKeepJobRunning)
     // Otherwise mpExRcsIncrementMove(..) will fail trying to submit an increment
     // while INIT_ROS has already been suspended.
     g_Ros_Controller.bStopMotion = TRUE;
+    Ros_IncPrecompile_Cancel(); //a trajectory which is still being compiled must not start afterwards
+    Ros_MotionControl_SignalAddToIncQueue_All(); //so they notice bStopMotion right away
 
     holdSendData.sHold = ON;
     mpHold(&holdSendData, &stdRspData);
@@ -1249,29 +3119,12 @@ BOOL Ros_MotionControl_StopMotion(BOOL bKeepJobRunning)
 //-------------------------------------------------------------------
 BOOL Ros_MotionControl_ClearQ_All()
 {
+    // Stop addtional items from being added to the queue
     for (int groupNo = 0; groupNo < g_Ros_Controller.numGroup; groupNo++)
-    {
-        // Stop addtional items from being added to the queue
         g_Ros_Controller.ctrlGroups[groupNo]->hasDataToProcess = FALSE;
 
-        // Set pointer to specified queue
-        Incremental_q* q = &g_Ros_Controller.ctrlGroups[groupNo]->inc_q;
-
-        // Lock the q before manipulating it
-        if (mpSemTake(q->q_lock, Q_LOCK_TIMEOUT) == OK)
-        {
-            // Reset the queue.  No need to modify index or delete data
-            q->cnt = 0;
-
-            // Unlock the q
-            mpSemGive(q->q_lock);
-        }
-        else
-        {
-            Ros_Debug_BroadcastMsg("ERROR: Unable to clear queue.  Queue is locked up! (Group #%d)", groupNo);
-            return FALSE;
-        }
-    }
+    // Reset the queue.  No need to delete data
+    Ros_Controller_IncQ_Clear(&g_Ros_Controller.incQueue);
 
     return TRUE;
 }
@@ -1570,6 +3423,8 @@ MotionNotReadyCode Ros_MotionControl_StartMotionMode(MOTION_MODE mode, rosidl_ru
     {
         //set an indicator of which motion mode is now active
         Ros_MotionControl_ActiveMotionMode = mode;
+        Ros_MotionControl_InitIncQueueDepth(mode);
+        Ros_MotionControl_ResetIncQueueStats();
         Ros_Debug_BroadcastMsg("Ros_MotionControl_ActiveMotionMode = %d", Ros_MotionControl_ActiveMotionMode);
 
         //This indicates that the next incoming point will be the FIRST point in
@@ -1610,12 +3465,8 @@ BOOL Ros_MotionControl_IsMotionMode_PointQueue()
 
 BOOL Ros_MotionControl_IsMotionMode_RawStreaming()
 {
-    return FALSE;
-    
-    //TODO
-    // 
-    //return (Ros_MotionControl_ActiveMotionMode ==
-    //    STREAMING_RAW_INCREMENTS);
+    return (Ros_MotionControl_ActiveMotionMode ==
+        MOTION_MODE_RAWSTREAMING);
 }
 
 void Ros_MotionControl_ValidateMotionModeIsOk()
@@ -1632,6 +3483,13 @@ void Ros_MotionControl_ValidateMotionModeIsOk()
             Ros_Debug_BroadcastMsg("Stopping point-queue motion mode. Please call '%s' to start a new queue.", SERVICE_NAME_START_POINT_QUEUE_MODE);
             Ros_MotionControl_StopTrajMode();
         }
+        else if (Ros_MotionControl_IsMotionMode_RawStreaming())
+        {
+            //Same as for the point queue: the increments of the client are relative to the
+            //position at which the robot stopped, so the client has to start a new stream.
+            Ros_Debug_BroadcastMsg("Stopping raw-streaming motion mode. Please call '%s' to start streaming again.", SERVICE_NAME_START_RAW_STREAMING_MODE);
+            Ros_MotionControl_StopTrajMode();
+        }
 
         //TODO: Determine if this should be done for Trajecotry-Mode too
     }
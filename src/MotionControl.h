@@ -9,28 +9,175 @@
 #define MOTOROS2_MOTION_CONTROL_H
 
 #define START_MAX_PULSE_DEVIATION           30
+#define SPLICE_MAX_VELOCITY_DEVIATION       0.01  // rad/s (or m/s) between a replacement trajectory and the active trajectory at the splice time
 
 #define MOTION_START_TIMEOUT                5000  // in milliseconds
 #define MOTION_START_CHECK_PERIOD           50  // in millisecond
 #define MOTION_START_ERROR_MESSAGE_LENGTH  256
 #define MOTION_STOP_TIMEOUT                 20
+#define INIT_TRAJ_DETAILS_LENGTH            128
+#define SEGMENT_PEAK_SPEED_SAMPLES          16
+#define TRAJECTORY_LIMIT_ACCEL_TIME         0.025 // in seconds, the shortest time in which a trajectory may take an axis to its speed limit (defines the acceleration limit checked at goal acceptance)
+#define ADD_TO_INC_Q_WAIT_TIMEOUT           100  // in millisecond (upper bound on how long the AddToIncQueue task sleeps without a signal)
+
+#define SPARSE_TRAJECTORY_SPEED_RATIO       0.9   // fraction of the speed limit of each axis used by the timing of sparse trajectories
+#define SPARSE_TRAJECTORY_ACCEL_TIME        0.25  // in seconds, the time it takes an axis to reach its speed limit (defines the acceleration limit)
+#define SPARSE_TRAJECTORY_JERK_TIME         0.1   // in seconds, the time it takes an axis to reach its acceleration limit (defines the jerk limit)
+#define SPARSE_TRAJECTORY_STRETCH           1.25  // a segment which exceeds the increment limits is slowed down by this factor
+#define SPARSE_TRAJECTORY_MAX_STRETCH       32    // attempts before a sparse trajectory is rejected
+
+#define SPEED_SCALE_MIN                     0.0
+#define SPEED_SCALE_MAX                     1.0  // the trajectory is never executed faster than planned, so it stays within the limits checked at goal acceptance
+#define SPEED_SCALE_READ_ATTEMPTS           3    // lock-free reads of the speed scale ramp before the lock is taken
+
+#define RAW_STREAMING_MAX_CYCLES_PER_MSG    8   // interpolation cycles of increments in a single raw_increments message
+
+#define ADAPTIVE_INC_QUEUE_DEPTH_FACTOR     4   // adaptive depth = factor * peak refill latency (the producer is woken at half the depth, so this leaves a 2x margin)
+#define ADAPTIVE_INC_QUEUE_LATENCY_DECAY    16  // the peak refill latency decays by 1/16th for each refill which was faster
 
 typedef enum
 {
     MOTION_MODE_INACTIVE,
     MOTION_MODE_TRAJECTORY,
-    MOTION_MODE_POINTQUEUE
+    MOTION_MODE_POINTQUEUE,
+    MOTION_MODE_RAWSTREAMING
 } MOTION_MODE;
 
+//Result of Ros_MotionControl_AddRawIncrements. Increments are only queued if the whole message is OK.
+typedef enum
+{
+    RAW_INCREMENTS_OK,
+    RAW_INCREMENTS_NOT_STREAMING,       //raw-streaming mode is not active (or was stopped by an underrun)
+    RAW_INCREMENTS_INVALID_SIZE,        //size is not a multiple of the increments of one cycle, or too many cycles
+    RAW_INCREMENTS_EXCEEDS_MAX_INC,     //an increment exceeds maxInc of its axis (or is non-zero for an invalid axis)
+    RAW_INCREMENTS_QUEUE_FULL,          //not enough room in the increment queue of at least one group
+} RawIncrementsStatus;
+
+//Polynomial coefficients of one trajectory segment for all axes of a group. Each coefficient
+//is stored as a separate array, so evaluating all axes is a simple loop over contiguous data.
+//  pos(t) = c0 + c1*t + c2*t^2 + c3*t^3 + c4*t^4 + c5*t^5     (t in seconds since the start of the segment)
+//c4 and c5 are only non-zero for quintic segments.
+typedef struct
+{
+    double c0[MP_GRP_AXES_NUM];
+    double c1[MP_GRP_AXES_NUM];
+    double c2[MP_GRP_AXES_NUM];
+    double c3[MP_GRP_AXES_NUM];
+    double c4[MP_GRP_AXES_NUM];
+    double c5[MP_GRP_AXES_NUM];
+} TrajectorySegment;
+
+#define PULSE_SEGMENT_FRACTION_BITS         8           // fraction bits of the pulse coefficients
+#define PULSE_SEGMENT_TIME_BITS             28          // fraction bits of the normalized segment time
+#define PULSE_SEGMENT_MAX_RANGE             (1 << 26)   // in pulses (keeps all intermediate products of the evaluation within 64 bits)
+
+//Polynomial coefficients of one trajectory segment, converted to pulses and scaled to the
+//duration of the segment, so it can be evaluated with integer arithmetic only.
+//  pulses(u) = a0 + a1*u + a2*u^2 + a3*u^3 + a4*u^4 + a5*u^5     (u = t / interval, from 0.0 to 1.0)
+//Coefficients are fixed-point numbers with PULSE_SEGMENT_FRACTION_BITS fraction bits. u is a
+//fixed-point number with PULSE_SEGMENT_TIME_BITS fraction bits.
+typedef struct
+{
+    INT64 a[6][MP_GRP_AXES_NUM];
+    double timeScale;   //conversion from seconds since the start of the segment to u
+} PulseSegment;
+
+//Linear ramp of the speed scale, as a function of the interpolation cycle of the active trajectory.
+//All groups generate their increments for the same cycles, so they all follow the same ramp.
+typedef struct
+{
+    double startScale;      //scale up to and including startCycle
+    double targetScale;     //scale at the end of the ramp
+    UINT32 startCycle;      //interpolation cycle at which the ramp starts
+} SpeedScaleRamp;
+
+typedef enum
+{
+    TRAJ_LIMIT_VELOCITY,        //the velocity of a point exceeds maxSpeed
+    TRAJ_LIMIT_INCREMENT,       //the interpolated increment per cycle of a segment exceeds maxInc
+    TRAJ_LIMIT_ACCELERATION,    //the interpolated acceleration of a segment exceeds maxSpeed / TRAJECTORY_LIMIT_ACCEL_TIME
+} TrajectoryLimitType;
+
+//First limit violation found by Ros_MotionControl_ValidateTrajectoryLimits
+typedef struct
+{
+    int pointIndex;                 //index of the offending point in the trajectory (for a segment: the end point)
+    int axis;                       //offending axis (moto order)
+    TrajectoryLimitType limitType;  //which limit was exceeded
+    double value;                   //offending value (velocity, acceleration or pulses per interpolation cycle)
+    double limit;                   //limit which was exceeded
+} TrajectoryLimitViolation;
+
+//joint names of the last request which was mapped successfully and the group + axis of each
+typedef struct
+{
+    int count;
+    UINT64 hash;    //hash of the names (see Ros_MotionControl_HashJointNames). A request with the same count and hash reuses the mapping.
+    char names[MAX_CONTROLLABLE_AXES][MAX_JOINT_NAME_LENGTH];
+    UINT8 groupIndex[MAX_CONTROLLABLE_AXES];
+    UINT8 jointIndex[MAX_CONTROLLABLE_AXES];
+} JointNameMappingCache;
+
 extern Init_Trajectory_Status Ros_MotionControl_InitTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request);
+extern Init_Trajectory_Status Ros_MotionControl_SpliceTrajectory(control_msgs__action__FollowJointTrajectory_SendGoal_Request* pending_ros_goal_request, INT64 spliceTime);
+extern BOOL Ros_MotionControl_IsSplicePending();
+extern UINT64 Ros_MotionControl_HashJointNames(rosidl_runtime_c__String__Sequence const* jointNames);
+extern BOOL Ros_MotionControl_IsSameJointOrder(JointNameMappingCache const* cache, rosidl_runtime_c__String__Sequence const* jointNames);
+extern BOOL Ros_MotionControl_IsBeforeSpliceTime(CtrlGroup const* ctrlGroup, UINT64 spliceTime);
+extern void Ros_MotionControl_InitTrajectorySplice();
+extern void Ros_MotionControl_CleanupTrajectorySplice();
 extern void Ros_MotionControl_IncMoveLoopStart();
 extern void Ros_MotionControl_AddToIncQueueProcess(CtrlGroup* ctrlGroup);
 extern UINT16 Ros_MotionControl_ProcessQueuedTrajectoryPoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request);
+extern BOOL Ros_MotionControl_IsPointQueueInitialized();
+extern BOOL Ros_MotionControl_MustInitializePointQueue;
 extern BOOL Ros_MotionControl_AddPulseIncPointToQ(CtrlGroup* ctrlGroup, Incremental_data const* dataToEnQ);
+extern void Ros_MotionControl_SignalAddToIncQueue(CtrlGroup* ctrlGroup);
+extern void Ros_MotionControl_SignalAddToIncQueue_All();
+extern void Ros_MotionControl_WaitForSignal(CtrlGroup* ctrlGroup);
+extern void Ros_MotionControl_ComputeSegment(JointMotionData const* startTrajData, JointMotionData const* endTrajData, int numAxes, BOOL bQuintic, TrajectorySegment* segment);
+extern void Ros_MotionControl_SegmentPeakSpeed(TrajectorySegment const* segment, int numAxes, double interval, double peakSpeed[MP_GRP_AXES_NUM]);
+extern void Ros_MotionControl_SegmentPeakAcceleration(TrajectorySegment const* segment, int numAxes, double interval, double peakAcc[MP_GRP_AXES_NUM]);
+extern double Ros_MotionControl_GetMotoAxisSpeedLimit(CtrlGroup const* ctrlGroup, int motoAxis);
+extern Init_Trajectory_Status Ros_MotionControl_ValidateTrajectoryLimits(CtrlGroup* ctrlGroup, trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points, int interpolPeriod, BOOL bQuintic, TrajectoryLimitViolation* violation);
+extern BOOL Ros_MotionControl_IsSparseTrajectory(trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points);
+//Writes time_from_start, velocities and accelerations into the points of the goal. The velocities
+//and accelerations of each point must have a capacity of numAxes, which the goal memory of the
+//FJT server provides. Returns INIT_TRAJ_INSUFFICIENT_WAYPOINT_MEMORY (without modifying the
+//points) otherwise.
+extern Init_Trajectory_Status Ros_MotionControl_TimeParameterizeTrajectory(CtrlGroup* const ctrlGroups[], int numGroup, int numAxes,
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence* points, int interpolPeriod, BOOL bQuintic);
+extern char const* Ros_MotionControl_GetInitTrajectoryDetails();
+extern BOOL Ros_MotionControl_SampleTrajectory(CtrlGroup* ctrlGroup, trajectory_msgs__msg__JointTrajectoryPoint__Sequence const* points, INT64 time, BOOL bQuintic, JointMotionData* out_jointMotionData);
+extern BOOL Ros_MotionControl_CompileTrajectory(CtrlGroup* ctrlGroup, IncStream* stream, UINT32 generation);
+extern void Ros_MotionControl_EvaluateSegment(TrajectorySegment const* segment, int numAxes, double interpolTime, double pos[MP_GRP_AXES_NUM], double vel[MP_GRP_AXES_NUM]);
+extern BOOL Ros_MotionControl_ComputePulseSegment(CtrlGroup* ctrlGroup, TrajectorySegment const* segment, double interval, PulseSegment* pulseSegment);
+extern void Ros_MotionControl_EvaluatePulseSegment(PulseSegment const* pulseSegment, double interpolTime, long pulsePos[MP_GRP_AXES_NUM]);
+extern RawIncrementsStatus Ros_MotionControl_ValidateRawIncrements(CtrlGroup* const ctrlGroups[], int numGroup, int32_t const* data, size_t size);
+extern RawIncrementsStatus Ros_MotionControl_AddRawIncrements(int32_t const* data, size_t size);
+extern void Ros_MotionControl_ResetRawStreaming();
+extern int Ros_MotionControl_GetRawStreamingUnderrunCount();
+extern void Ros_MotionControl_HandleRawStreamingUnderrun();
+extern int Ros_MotionControl_GetConfiguredIncQueueDepth(MOTION_MODE mode);
+extern int Ros_MotionControl_ComputeAdaptiveIncQueueDepth(int* latencyPeak, int refillLatency, int maxDepth);
+extern BOOL Ros_MotionControl_TrackIncQueueRefill(CtrlGroup* ctrlGroup, int countBeforeRead, int countAfterRead, BOOL bSignaled);
+extern void Ros_MotionControl_ResetIncQueueStats();
+extern BOOL Ros_MotionControl_UpdateIncQueueStats(IncQueueStats* stats, int count, BOOL bProducing);
 extern BOOL Ros_MotionControl_HasDataInQueue();
 extern BOOL Ros_MotionControl_HasDataToProcess();
 extern BOOL Ros_MotionControl_IsRosControllingMotion();
 extern int Ros_MotionControl_GetQueueCnt(int groupNo);
+extern int Ros_MotionControl_GetPointQueueDepth();
+extern int Ros_MotionControl_GetPointQueueUnderrunCount();
+extern volatile UINT32 Ros_MotionControl_SpeedScaleSequence;
+extern SEM_ID Ros_MotionControl_SpeedScaleLock;
+extern void Ros_MotionControl_InitSpeedScale();
+extern void Ros_MotionControl_CleanupSpeedScale();
+extern void Ros_MotionControl_SetSpeedScale(double speedScale);
+extern double Ros_MotionControl_EvaluateSpeedScaleRamp(SpeedScaleRamp const* ramp, UINT32 cycle, double stepPerCycle);
+extern void Ros_MotionControl_WriteSpeedScaleRamp(SpeedScaleRamp const* ramp);
+extern void Ros_MotionControl_ReadSpeedScaleRamp(SpeedScaleRamp* ramp);
+extern double Ros_MotionControl_GetSpeedScaleDelay();
 extern BOOL Ros_MotionControl_StopMotion(BOOL bKeepJobRunning);
 extern BOOL Ros_MotionControl_ClearQ_All();
 extern MotionNotReadyCode Ros_MotionControl_StartMotionMode(MOTION_MODE mode, rosidl_runtime_c__String* responseMessage);
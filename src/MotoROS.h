@@ -54,6 +54,8 @@
 // Data types for communication
 //============================================
 #include <std_srvs/srv/trigger.h>
+#include <std_msgs/msg/float64.h>
+#include <std_msgs/msg/int32_multi_array.h>
 #include <sensor_msgs/msg/joint_state.h>
 #include <geometry_msgs/msg/pose.h>
 #include <geometry_msgs/msg/transform_stamped.h>
@@ -62,6 +64,7 @@
 #include <industrial_msgs/msg/robot_status.h>
 #include <trajectory_msgs/msg/joint_trajectory.h>
 #include <trajectory_msgs/msg/joint_trajectory_point.h>
+#include <trajectory_msgs/msg/multi_dof_joint_trajectory.h>
 #include <control_msgs/action/follow_joint_trajectory.h>
 #include <motoros2_interfaces/srv/read_single_io.h>
 #include <motoros2_interfaces/srv/read_group_io.h>
@@ -100,8 +103,18 @@
 #include "ServiceResetError.h"
 #include "ServiceStartTrajMode.h"
 #include "ServiceStartPointQueueMode.h"
+#include "ServiceStartRawStreamingMode.h"
+#include "ServiceResetIncMoveTiming.h"
 #include "ServiceStopTrajMode.h"
 #include "ServiceSelectMotionTool.h"
+#include "SubscriberSpeedScale.h"
+#include "SubscriberRawIncrements.h"
+#include "SubscriberQueueTrajPoints.h"
+#include "SubscriberQueueCartesianPoints.h"
+#include "IncMoveTiming.h"
+#include "IncQueueStatus.h"
+#include "FsuSpeedLimit.h"
+#include "IncPrecompile.h"
 #include "MotionControl.h"
 #include "ConfigFile.h"
 #include "RosApiNameConstants.h"
@@ -112,6 +125,12 @@
 #include "Tests_ControllerStatusIO.h"
 #include "Tests_ActionServer_FJT.h"
 #include "Tests_TimeConversionUtils.h"
+#include "Tests_MotionControl.h"
+#include "Tests_FsuSpeedLimit.h"
+#include "Tests_IncPrecompile.h"
+#include "Tests_ServiceQueueTrajPoint.h"
+#include "Tests_SubscriberQueueTrajPoints.h"
+#include "Tests_PositionMonitor.h"
 #include "FauxCommandLineArgs.h"
 #include "InformCheckerAndGenerator.h"
 #include "MathConstants.h"
@@ -10,10 +10,42 @@
 PositionMonitor_Publishers g_publishers_PositionMonitor;
 PositionMonitor_Messages g_messages_PositionMonitor;
 
+//The inputs of the last transforms calculated for each group. As long as they don't change (ie: the
+//robot is standing still), the transforms in the TF message are still valid and only get a new stamp.
+typedef struct
+{
+    BOOL bValid;
+    long pulsePos[MAX_PULSE_AXES];
+    long pulsePosTrack[MAX_PULSE_AXES];
+    int tool;
+    MP_COORD toolData;
+
+    MP_FRAME frameTcpToTool0;                   // derived from toolData
+} PositionMonitor_TransformInputs;
+
+static PositionMonitor_TransformInputs transformInputs[MAX_CONTROLLABLE_GROUPS];
+
+#define TF_INPUTS_CHANGED_POSITION      0x01    // feedback position (or base track position)
+#define TF_INPUTS_CHANGED_TOOL          0x02    // tool number or tool definition
+#define TF_INPUTS_CHANGED_CALIBRATION   0x04    // first calculation (calibration is only loaded at startup)
+
+//Each link of a robot is either in the TF message (it changes with the position of the robot) or
+//in the static TF message (it only changes with the tool or the calibration). Not used for other groups.
+static geometry_msgs__msg__TransformStamped* tfLinks[MAX_CONTROLLABLE_GROUPS][NUMBER_TRANSFORM_LINKS_PER_ROBOT];
+static BOOL bTfStaticChanged;
+
+//The motoman flange ("tool0") and the ROS "flange" only differ by a constant rotation
+static MP_FRAME frameTool0ToFlange;
+static MP_FRAME frameFlangeToTool0;
+
 
 static void Ros_PositionMonitor_Initialize_GlobalJointStatePublisher(rmw_qos_profile_t const* const qos_profile);
 static void Ros_PositionMonitor_Initialize_PerGroupJointStatePublisher(rmw_qos_profile_t const* const qos_profile, CtrlGroup* const ctrlGroup, int grpIndex);
-static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const* const qos_profile, int totalRobots);
+static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const* const qos_profile);
+static void Ros_PositionMonitor_CountTfLinks(int* numLinks, int* numStaticLinks);
+static void Ros_PositionMonitor_Initialize_TfLinks(tf2_msgs__msg__TFMessage* transform, tf2_msgs__msg__TFMessage* transformStatic);
+static UINT32 Ros_PositionMonitor_TransformInputsChanged(int groupIndex, long const* pulsePos_moto, long const* pulsePos_moto_track, MP_COORD const* toolData);
+static void Ros_PositionMonitor_UpdateStaticLinks(int groupIndex, UINT32 changed);
 
 
 void Ros_PositionMonitor_Initialize()
@@ -29,20 +61,18 @@ void Ros_PositionMonitor_Initialize()
 
     //==================================
     //create a JointState publisher for each group
-    int totalRobots = 0;
     for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex++)
     {
         CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
         Ros_PositionMonitor_Initialize_PerGroupJointStatePublisher(qos_profile_js, ctrlGroup, grpIndex);
-        if (Ros_CtrlGroup_IsRobot(ctrlGroup))
-            totalRobots += 1;
     }
 
     //==================================
     //Create publisher for cartesian transform
     //Rviz2 expects the QoS to be RELIABLE, but user could have configured something else
     const rmw_qos_profile_t* qos_profile_tf = Ros_ConfigFile_To_Rmw_Qos_Profile(g_nodeConfigSettings.qos_tf);
-    Ros_PositionMonitor_Initialize_TfPublisher(qos_profile_tf, totalRobots);
+    bzero(transformInputs, sizeof(transformInputs));
+    Ros_PositionMonitor_Initialize_TfPublisher(qos_profile_tf);
 
     MOTOROS2_MEM_TRACE_REPORT(pos_mon_init);
 }
@@ -153,13 +183,16 @@ static void Ros_PositionMonitor_Initialize_PerGroupJointStatePublisher(rmw_qos_p
     rosidl_runtime_c__float64__Sequence__init(&ctrlGroup->msgJointState->effort, ctrlGroup->numAxes);
 }
 
-static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const* const qos_profile, int totalRobots)
+static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const* const qos_profile)
 {
     char formatBuffer[MAX_TF_FRAME_NAME_LENGTH];
+    char formatBufferStatic[MAX_TF_FRAME_NAME_LENGTH];
 
-    // default TF topic name
+    // default TF topic names
     bzero(formatBuffer, MAX_TF_FRAME_NAME_LENGTH);
     snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%s", TOPIC_NAME_TF);
+    bzero(formatBufferStatic, MAX_TF_FRAME_NAME_LENGTH);
+    snprintf(formatBufferStatic, MAX_TF_FRAME_NAME_LENGTH, "%s", TOPIC_NAME_TF_STATIC);
 
     //check whether we should make the topic name absolute (so it can't/won't
     //be namespaced any further)
@@ -167,9 +200,10 @@ static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const*
     {
         Ros_Debug_BroadcastMsg("PositionMonitor: TF topic absolute");
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "/%s", TOPIC_NAME_TF);
+        snprintf(formatBufferStatic, MAX_TF_FRAME_NAME_LENGTH, "/%s", TOPIC_NAME_TF_STATIC);
     }
 
-    Ros_Debug_BroadcastMsg("PositionMonitor: publishing TF to '%s'", formatBuffer);
+    Ros_Debug_BroadcastMsg("PositionMonitor: publishing TF to '%s' and '%s'", formatBuffer, formatBufferStatic);
 
     //-------------
     //create TF publisher (non-static)
@@ -181,37 +215,124 @@ static void Ros_PositionMonitor_Initialize_TfPublisher(rmw_qos_profile_t const*
         qos_profile);
     motoRos_RCLAssertOK(ret, SUBCODE_FAIL_CREATE_PUBLISHER_TRANSFORM);
 
+    //-------------
+    //create TF publisher (static)
+    //This is latched (like the tf2_ros StaticTransformBroadcaster), so listeners which start
+    //later still receive the last message.
+    rmw_qos_profile_t qos_profile_static = *qos_profile;
+    qos_profile_static.history = RMW_QOS_POLICY_HISTORY_KEEP_LAST;
+    qos_profile_static.depth = 1;
+    qos_profile_static.reliability = RMW_QOS_POLICY_RELIABILITY_RELIABLE;
+    qos_profile_static.durability = RMW_QOS_POLICY_DURABILITY_TRANSIENT_LOCAL;
+
+    ret = rclc_publisher_init(
+        &g_publishers_PositionMonitor.transformStatic,
+        &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(tf2_msgs, msg, TFMessage),
+        formatBufferStatic,
+        &qos_profile_static);
+    motoRos_RCLAssertOK(ret, SUBCODE_FAIL_CREATE_PUBLISHER_TRANSFORM_STATIC);
+
     //--------------
-    //create message for cartesian transform
-    g_messages_PositionMonitor.transform = tf2_msgs__msg__TFMessage__create();
+    int numLinks, numStaticLinks;
+    Ros_PositionMonitor_CountTfLinks(&numLinks, &numStaticLinks);
 
-    motoRosAssert(geometry_msgs__msg__TransformStamped__Sequence__init(&g_messages_PositionMonitor.transform->transforms, totalRobots * NUMBER_TRANSFORM_LINKS_PER_ROBOT),
+    //--------------
+    //create messages for cartesian transform
+    g_messages_PositionMonitor.transform = tf2_msgs__msg__TFMessage__create();
+    motoRosAssert(geometry_msgs__msg__TransformStamped__Sequence__init(&g_messages_PositionMonitor.transform->transforms, numLinks),
                   SUBCODE_FAIL_ALLOCATE_TRANSFORM);
 
+    g_messages_PositionMonitor.transformStatic = tf2_msgs__msg__TFMessage__create();
+    motoRosAssert(geometry_msgs__msg__TransformStamped__Sequence__init(&g_messages_PositionMonitor.transformStatic->transforms, numStaticLinks),
+                  SUBCODE_FAIL_ALLOCATE_TRANSFORM_STATIC);
+
+    Ros_PositionMonitor_Initialize_TfLinks(g_messages_PositionMonitor.transform, g_messages_PositionMonitor.transformStatic);
+
+    g_messages_PositionMonitor.transform->transforms.size = numLinks;
+    g_messages_PositionMonitor.transformStatic->transforms.size = numStaticLinks;
+
+    //published with the first position
+    bTfStaticChanged = FALSE;
+}
+
+//-------------------------------------------------------------------
+// The base of a robot on a track moves, so that link is only static for the
+// other robots.
+//-------------------------------------------------------------------
+static void Ros_PositionMonitor_CountTfLinks(int* numLinks, int* numStaticLinks)
+{
+    *numLinks = 0;
+    *numStaticLinks = 0;
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        if (!Ros_CtrlGroup_IsRobot(ctrlGroup))
+            continue;
+
+        *numLinks += Ros_CtrlGroup_HasBaseTrack(ctrlGroup) ? 2 : 1;
+        *numStaticLinks += Ros_CtrlGroup_HasBaseTrack(ctrlGroup) ? 2 : 3;
+    }
+}
+
+//-------------------------------------------------------------------
+// Assign the links of each robot to the TF message or the static TF message,
+// which must have the sizes given by Ros_PositionMonitor_CountTfLinks.
+//-------------------------------------------------------------------
+static void Ros_PositionMonitor_Initialize_TfLinks(tf2_msgs__msg__TFMessage* transform, tf2_msgs__msg__TFMessage* transformStatic)
+{
+    char formatBuffer[MAX_TF_FRAME_NAME_LENGTH];
+
+    //Make rotational frames
+    MP_XYZ vectorOrg, vectorX, vectorY; //for mpMakeFrame
+    MP_COORD coordFlangeToTool0;
+    vectorOrg.x = 0;    vectorOrg.y = 0;    vectorOrg.z = 0;
+    vectorX.x = 0;      vectorX.y = 0;      vectorX.z = 1;
+    vectorY.x = 0;      vectorY.y = -1;     vectorY.z = 0;
+    mpMakeFrame(&vectorOrg, &vectorX, &vectorY, &frameTool0ToFlange);
+    mpInvFrame(&frameTool0ToFlange, &frameFlangeToTool0);
+    mpFrameToZYXeuler(&frameFlangeToTool0, &coordFlangeToTool0);
+
+    bzero(tfLinks, sizeof(tfLinks));
     bzero(formatBuffer, MAX_TF_FRAME_NAME_LENGTH);
-    int robotIterator = 0;
     const char* frame_prefix = g_nodeConfigSettings.tf_frame_prefix;
-    for (int i = 0; i < (totalRobots * NUMBER_TRANSFORM_LINKS_PER_ROBOT); i += NUMBER_TRANSFORM_LINKS_PER_ROBOT)
+    int linkIterator = 0;
+    int staticLinkIterator = 0;
+    for (int grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
     {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        if (!Ros_CtrlGroup_IsRobot(ctrlGroup))
+            continue;
+
+        geometry_msgs__msg__TransformStamped** links = tfLinks[grpIndex];
+        if (Ros_CtrlGroup_HasBaseTrack(ctrlGroup))
+            links[tfLink_WorldToBase] = &transform->transforms.data[linkIterator++];
+        else
+            links[tfLink_WorldToBase] = &transformStatic->transforms.data[staticLinkIterator++];
+        links[tfLink_BaseToFlange] = &transform->transforms.data[linkIterator++];
+        links[tfLink_FlangeToTool0] = &transformStatic->transforms.data[staticLinkIterator++];
+        links[tfLink_FlangeToTcp] = &transformStatic->transforms.data[staticLinkIterator++];
+
         snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sworld", frame_prefix);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_WorldToBase].header.frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&links[tfLink_WorldToBase]->header.frame_id, formatBuffer);
 
-        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/base", frame_prefix, robotIterator + 1);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_WorldToBase].child_frame_id, formatBuffer);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_BaseToFlange].header.frame_id, formatBuffer);
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/base", frame_prefix, grpIndex + 1);
+        rosidl_runtime_c__String__assign(&links[tfLink_WorldToBase]->child_frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&links[tfLink_BaseToFlange]->header.frame_id, formatBuffer);
 
-        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/flange", frame_prefix, robotIterator + 1);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_BaseToFlange].child_frame_id, formatBuffer);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTool0].header.frame_id, formatBuffer);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTcp].header.frame_id, formatBuffer);
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/flange", frame_prefix, grpIndex + 1);
+        rosidl_runtime_c__String__assign(&links[tfLink_BaseToFlange]->child_frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&links[tfLink_FlangeToTool0]->header.frame_id, formatBuffer);
+        rosidl_runtime_c__String__assign(&links[tfLink_FlangeToTcp]->header.frame_id, formatBuffer);
 
-        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tool0", frame_prefix, robotIterator + 1);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTool0].child_frame_id, formatBuffer);
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tool0", frame_prefix, grpIndex + 1);
+        rosidl_runtime_c__String__assign(&links[tfLink_FlangeToTool0]->child_frame_id, formatBuffer);
 
-        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tcp_%d", frame_prefix, robotIterator + 1, g_Ros_Controller.ctrlGroups[robotIterator]->tool);
-        rosidl_runtime_c__String__assign(&g_messages_PositionMonitor.transform->transforms.data[i + tfLink_FlangeToTcp].child_frame_id, formatBuffer);
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tcp_%d", frame_prefix, grpIndex + 1, ctrlGroup->tool);
+        rosidl_runtime_c__String__assign(&links[tfLink_FlangeToTcp]->child_frame_id, formatBuffer);
 
-        robotIterator += 1;
+        //this one never changes
+        Ros_MpCoord_To_GeomMsgsTransform(&coordFlangeToTool0, &links[tfLink_FlangeToTool0]->transform);
     }
 }
 
@@ -247,9 +368,101 @@ void Ros_PositionMonitor_Cleanup()
         Ros_Debug_BroadcastMsg("Failed cleaning up TF publisher: %d", ret);
     tf2_msgs__msg__TFMessage__destroy(g_messages_PositionMonitor.transform);
 
+    Ros_Debug_BroadcastMsg("Cleanup static TF publisher");
+    ret = rcl_publisher_fini(&g_publishers_PositionMonitor.transformStatic, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up static TF publisher: %d", ret);
+    tf2_msgs__msg__TFMessage__destroy(g_messages_PositionMonitor.transformStatic);
+
     MOTOROS2_MEM_TRACE_REPORT(pos_mon_fini);
 }
 
+//-------------------------------------------------------------------
+// Compare the inputs of the transforms of a group with the ones they were last
+// calculated for, and remember the new ones.
+//
+// Returns which inputs changed (TF_INPUTS_CHANGED_*), 0 if the transforms are
+// still valid.
+//-------------------------------------------------------------------
+static UINT32 Ros_PositionMonitor_TransformInputsChanged(int groupIndex, long const* pulsePos_moto, long const* pulsePos_moto_track, MP_COORD const* toolData)
+{
+    PositionMonitor_TransformInputs* inputs = &transformInputs[groupIndex];
+    CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+    UINT32 changed = 0;
+
+    if (!inputs->bValid)
+        changed = TF_INPUTS_CHANGED_POSITION | TF_INPUTS_CHANGED_TOOL | TF_INPUTS_CHANGED_CALIBRATION;
+
+    if (memcmp(inputs->pulsePos, pulsePos_moto, sizeof(inputs->pulsePos)) != 0)
+        changed |= TF_INPUTS_CHANGED_POSITION;
+
+    //the track position is only read for groups which are mounted on one
+    if (Ros_CtrlGroup_HasBaseTrack(group) && memcmp(inputs->pulsePosTrack, pulsePos_moto_track, sizeof(inputs->pulsePosTrack)) != 0)
+        changed |= TF_INPUTS_CHANGED_POSITION;
+
+    if ((inputs->tool != group->tool) || (memcmp(&inputs->toolData, toolData, sizeof(MP_COORD)) != 0))
+        changed |= TF_INPUTS_CHANGED_TOOL;
+
+    if (changed & TF_INPUTS_CHANGED_POSITION)
+    {
+        memcpy(inputs->pulsePos, pulsePos_moto, sizeof(inputs->pulsePos));
+        if (Ros_CtrlGroup_HasBaseTrack(group))
+            memcpy(inputs->pulsePosTrack, pulsePos_moto_track, sizeof(inputs->pulsePosTrack));
+    }
+
+    if (changed & TF_INPUTS_CHANGED_TOOL)
+    {
+        MP_FRAME frameTool0ToTcp;
+
+        inputs->tool = group->tool;
+        memcpy(&inputs->toolData, toolData, sizeof(MP_COORD));
+
+        mpZYXeulerToFrame(&inputs->toolData, &frameTool0ToTcp);
+        mpInvFrame(&frameTool0ToTcp, &inputs->frameTcpToTool0);
+    }
+
+    inputs->bValid = TRUE;
+    return changed;
+}
+
+//-------------------------------------------------------------------
+// Update the links of a group which are in the static TF message, and have the
+// message published again when any of them changed.
+//-------------------------------------------------------------------
+static void Ros_PositionMonitor_UpdateStaticLinks(int groupIndex, UINT32 changed)
+{
+    char formatBuffer[MAX_TF_FRAME_NAME_LENGTH];
+
+    CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+    geometry_msgs__msg__TransformStamped** links = tfLinks[groupIndex];
+
+    //the base of a robot on a track is calculated with its position
+    if (!Ros_CtrlGroup_HasBaseTrack(group) && (changed & TF_INPUTS_CHANGED_CALIBRATION))
+    {
+        Ros_MpCoord_To_GeomMsgsTransform(&group->robotCalibrationToBaseFrame, &links[tfLink_WorldToBase]->transform);
+        bTfStaticChanged = TRUE;
+    }
+
+    if (changed & TF_INPUTS_CHANGED_TOOL)
+    {
+        MP_FRAME frameTool0ToTcp, frameFlangeToTcp;
+        MP_COORD coordFlangeToTcp;
+
+        //the tool definition was stored with the inputs
+        mpZYXeulerToFrame(&transformInputs[groupIndex].toolData, &frameTool0ToTcp);
+        mpMulFrame(&frameFlangeToTool0, &frameTool0ToTcp, &frameFlangeToTcp);
+        mpFrameToZYXeuler(&frameFlangeToTcp, &coordFlangeToTcp);
+
+        Ros_MpCoord_To_GeomMsgsTransform(&coordFlangeToTcp, &links[tfLink_FlangeToTcp]->transform);
+
+        //the frame is named after the selected tool (see select_motion_tool)
+        snprintf(formatBuffer, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tcp_%d", g_nodeConfigSettings.tf_frame_prefix, groupIndex + 1, group->tool);
+        rosidl_runtime_c__String__assign(&links[tfLink_FlangeToTcp]->child_frame_id, formatBuffer);
+
+        bTfStaticChanged = TRUE;
+    }
+}
+
 void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto, long* pulsePos_moto_track, INT64 timestamp)
 {
     double track_pos_meters[MAX_PULSE_AXES];
@@ -258,6 +471,7 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
     char alarm_msg_buf[ERROR_MSG_MAX_SIZE] = { 0 };
 
     CtrlGroup* group = g_Ros_Controller.ctrlGroups[groupIndex];
+    geometry_msgs__msg__TransformStamped** links = tfLinks[groupIndex];
 
     //some things (like external axes) cannot be converted to cartesian
     if (!Ros_CtrlGroup_IsRobot(group))
@@ -265,11 +479,23 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
 
     //this CtrlGroup's pose can be converted, so update ROS transforms
 
-    //first update stamp of this group's transforms
-    for (int i = 0; i < NUMBER_TRANSFORM_LINKS_PER_ROBOT; i += 1)
-    {
-        Ros_Nanos_To_Time_Msg(timestamp, &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + i].header.stamp);
-    }
+    //first update stamp of this group's transforms (the static ones are stamped when they are published)
+    Ros_Nanos_To_Time_Msg(timestamp, &links[tfLink_BaseToFlange]->header.stamp);
+    if (Ros_CtrlGroup_HasBaseTrack(group))
+        Ros_Nanos_To_Time_Msg(timestamp, &links[tfLink_WorldToBase]->header.stamp);
+
+    //Get TCP definition (it can be edited on the pendant, without selecting another tool)
+    MP_TOOL_RSP_DATA retToolData;
+    MP_COORD coordToolData;
+    mpGetToolData(group->tool, &retToolData);
+    bzero(&coordToolData, sizeof(MP_COORD));
+    coordToolData.x = retToolData.x; coordToolData.y = retToolData.y; coordToolData.z = retToolData.z;
+    coordToolData.rx = retToolData.rx; coordToolData.ry = retToolData.ry; coordToolData.rz = retToolData.rz;
+
+    //nothing moved and the tool is the same, so the transforms in the messages are still valid
+    UINT32 changed = Ros_PositionMonitor_TransformInputsChanged(groupIndex, pulsePos_moto, pulsePos_moto_track, &coordToolData);
+    if (changed == 0)
+        return;
 
     //=======================
     // Calculate World
@@ -277,16 +503,15 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
     //---------------------------------------------------------
     //NOTE: the term 'base' is a ROS term. This is actually RF.
     //---------------------------------------------------------
-    MP_COORD coordWorldToBase;
-
-    memcpy(&coordWorldToBase, &group->robotCalibrationToBaseFrame, sizeof(MP_COORD));
-
-    if (Ros_CtrlGroup_HasBaseTrack(group)) //add in the offset of the base track motion and mounting offset
+    if (Ros_CtrlGroup_HasBaseTrack(group) && (changed & TF_INPUTS_CHANGED_POSITION)) //add in the offset of the base track motion and mounting offset
     {
+        MP_COORD coordWorldToBase;
         MP_COORD coordTrackTravel;
         MP_FRAME frameTrackTravel, frameTrackToRobot, frameWorldToTrack;
         MP_FRAME frameWorldToTravel, frameWorldToRobot;
 
+        memcpy(&coordWorldToBase, &group->robotCalibrationToBaseFrame, sizeof(MP_COORD));
+
         //TODO: This isn't going to work for a motosweep
 
         CtrlGroup* baseTrackGroup = g_Ros_Controller.ctrlGroups[group->baseTrackGroupIndex];
@@ -323,10 +548,9 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
         mpMulFrame(&frameWorldToTravel, &frameTrackToRobot, &frameWorldToRobot);
 
         mpFrameToZYXeuler(&frameWorldToRobot, &coordWorldToBase);
-    }
 
-    geometry_msgs__msg__Transform* transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_WorldToBase].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordWorldToBase, transform);
+        Ros_MpCoord_To_GeomMsgsTransform(&coordWorldToBase, &links[tfLink_WorldToBase]->transform);
+    }
 
     //============================
     // Calculate Flange and Tool0
@@ -342,11 +566,10 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
     //---------------------------------------------------------
     // <image url="$(ProjectDir)image_comments\tf_diagram.png" />
     //
-    MP_FRAME frameBaseToTcp, frameBaseToTool0, frameBaseToFlange, frameTool0ToTcp, frameTcpToTool0;
-    MP_FRAME frameTool0ToFlange, frameFlangeToTool0, frameFlangeToTcp;
-    MP_TOOL_RSP_DATA retToolData;
-    MP_COORD coordToolData, coordBaseToFlange, coordFlangeToTool0;
-    MP_XYZ vectorOrg, vectorX, vectorY; //for mpMakeFrame
+    // The flange -> tool0 link never changes, it was set in Ros_PositionMonitor_Initialize_TfPublisher.
+    //
+    MP_FRAME frameBaseToTcp, frameBaseToTool0, frameBaseToFlange;
+    MP_COORD coordBaseToFlange;
 
     long anglePos_moto[MAX_PULSE_AXES];
     mpConvPulseToAngle(groupIndex, pulsePos_moto, anglePos_moto);
@@ -355,41 +578,17 @@ void Ros_PositionMonitor_CalculateTransforms(int groupIndex, long* pulsePos_moto
     //Get current position of TCP
     mpZYXeulerToFrame(&cartesian_moto, &frameBaseToTcp);
 
-    //Get TCP definition
-    mpGetToolData(group->tool, &retToolData);
-    coordToolData.x = retToolData.x; coordToolData.y = retToolData.y; coordToolData.z = retToolData.z;
-    coordToolData.rx = retToolData.rx; coordToolData.ry = retToolData.ry; coordToolData.rz = retToolData.rz;
-
-    mpZYXeulerToFrame(&coordToolData, &frameTool0ToTcp);
-    mpInvFrame(&frameTool0ToTcp, &frameTcpToTool0);
-
-
-    mpMulFrame(&frameBaseToTcp, &frameTcpToTool0, &frameBaseToTool0);
-
-    //Make rotational frames
-    vectorOrg.x = 0;    vectorOrg.y = 0;    vectorOrg.z = 0;
-    vectorX.x = 0;      vectorX.y = 0;      vectorX.z = 1;
-    vectorY.x = 0;      vectorY.y = -1;     vectorY.z = 0;
-    mpMakeFrame(&vectorOrg, &vectorX, &vectorY, &frameTool0ToFlange);
-    mpInvFrame(&frameTool0ToFlange, &frameFlangeToTool0);
-    mpFrameToZYXeuler(&frameFlangeToTool0, &coordFlangeToTool0);
+    mpMulFrame(&frameBaseToTcp, &transformInputs[groupIndex].frameTcpToTool0, &frameBaseToTool0);
 
     mpMulFrame(&frameBaseToTool0, &frameTool0ToFlange, &frameBaseToFlange);
     mpFrameToZYXeuler(&frameBaseToFlange, &coordBaseToFlange);
 
-    mpMulFrame(&frameFlangeToTool0, &frameTool0ToTcp, &frameFlangeToTcp);
-    mpFrameToZYXeuler(&frameFlangeToTcp, &coordToolData);
+    Ros_MpCoord_To_GeomMsgsTransform(&coordBaseToFlange, &links[tfLink_BaseToFlange]->transform);
 
     //=======================
-
-    transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_BaseToFlange].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordBaseToFlange, transform);
-
-    transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_FlangeToTool0].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordFlangeToTool0, transform);
-
-    transform = &g_messages_PositionMonitor.transform->transforms.data[(groupIndex * NUMBER_TRANSFORM_LINKS_PER_ROBOT) + tfLink_FlangeToTcp].transform;
-    Ros_MpCoord_To_GeomMsgsTransform(&coordToolData, transform);
+    // Calculate Tcp (and the other links in the static TF message)
+    //=======================
+    Ros_PositionMonitor_UpdateStaticLinks(groupIndex, changed);
 }
 
 void Ros_PositionMonitor_UpdateLocation()
@@ -497,5 +696,22 @@ void Ros_PositionMonitor_UpdateLocation()
     {
         ret = rcl_publish(&g_publishers_PositionMonitor.transform, g_messages_PositionMonitor.transform, NULL);
         RCL_UNUSED(ret);
+
+        //only when the tool (or the calibration) changed
+        if (bTfStaticChanged)
+        {
+            for (int i = 0; i < g_messages_PositionMonitor.transformStatic->transforms.size; i += 1)
+                Ros_Nanos_To_Time_Msg(theTime, &g_messages_PositionMonitor.transformStatic->transforms.data[i].header.stamp);
+
+            ret = rcl_publish(&g_publishers_PositionMonitor.transformStatic, g_messages_PositionMonitor.transformStatic, NULL);
+            if (ret == RCL_RET_OK)
+                bTfStaticChanged = FALSE;
+        }
     }
 }
+
+
+//included here as this tests 'static' functions
+#define MOTOROS2_INCLUDE_TESTS_POSITION_MONITOR_C
+#include "Tests_PositionMonitor.c"
+#undef MOTOROS2_INCLUDE_TESTS_POSITION_MONITOR_C
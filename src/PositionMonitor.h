@@ -22,13 +22,15 @@ typedef struct
 {
     rcl_publisher_t jointStateAllGroups;
     rcl_publisher_t transform;
+    rcl_publisher_t transformStatic;
 } PositionMonitor_Publishers;
 extern PositionMonitor_Publishers g_publishers_PositionMonitor;
 
 typedef struct
 {
     sensor_msgs__msg__JointState* jointStateAllGroups;
-    tf2_msgs__msg__TFMessage* transform;
+    tf2_msgs__msg__TFMessage* transform;          // links which move with the robot
+    tf2_msgs__msg__TFMessage* transformStatic;    // links which only change with the tool or calibration
 } PositionMonitor_Messages;
 extern PositionMonitor_Messages g_messages_PositionMonitor;
 
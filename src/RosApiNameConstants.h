@@ -13,8 +13,16 @@
 // Topic, service and action server names
 //============================================
 #define TOPIC_NAME_TF "tf"
+#define TOPIC_NAME_TF_STATIC "tf_static"
 #define TOPIC_NAME_ROBOT_STATUS "robot_status"
 #define TOPIC_NAME_JOINT_STATES "joint_states"
+#define TOPIC_NAME_SPEED_SCALE "speed_scale"
+#define TOPIC_NAME_RAW_INCREMENTS "raw_increments"
+#define TOPIC_NAME_QUEUE_TRAJ_POINTS "queue_traj_points"
+#define TOPIC_NAME_QUEUE_TRAJ_POINTS_STATUS "queue_traj_points_status"
+#define TOPIC_NAME_QUEUE_CARTESIAN_POINTS "queue_cartesian_points"
+#define TOPIC_NAME_INC_MOVE_TIMING "inc_move_timing"
+#define TOPIC_NAME_INC_QUEUE_STATUS "inc_queue_status"
 
 #define SERVICE_NAME_READ_SINGLE_IO "read_single_io"
 #define SERVICE_NAME_READ_GROUP_IO "read_group_io"
@@ -25,9 +33,11 @@
 #define SERVICE_NAME_RESET_ERROR "reset_error"
 #define SERVICE_NAME_START_TRAJ_MODE "start_traj_mode"
 #define SERVICE_NAME_START_POINT_QUEUE_MODE "start_point_queue_mode"
+#define SERVICE_NAME_START_RAW_STREAMING_MODE "start_raw_streaming_mode"
 #define SERVICE_NAME_STOP_TRAJ_MODE "stop_traj_mode"
 #define SERVICE_NAME_QUEUE_TRAJ_POINT "queue_traj_point"
 #define SERVICE_NAME_SELECT_MOTION_TOOL "select_motion_tool"
+#define SERVICE_NAME_RESET_INC_MOVE_TIMING "reset_inc_move_timing"
 
 #define ACTION_NAME_FOLLOW_JOINT_TRAJECTORY "follow_joint_trajectory"
 
@@ -25,3 +25,18 @@ void Ros_MpCoord_To_GeomMsgsTransform(MP_COORD const* const mp_coord, geometry_m
     QuatConversion_MpCoordOrient_To_GeomMsgsQuaternion(
         mp_coord->rx, mp_coord->ry, mp_coord->rz, &ros_transform->rotation);
 }
+
+static LONG Ros_MetersToMicrometers(double meters)
+{
+    double micrometers = METERS_TO_MICROMETERS(meters);
+    return (LONG)(micrometers < 0.0 ? micrometers - 0.5 : micrometers + 0.5);
+}
+
+void Ros_GeomMsgsTransform_To_MpCoord(geometry_msgs__msg__Transform const* const ros_transform, MP_COORD* const mp_coord)
+{
+    mp_coord->x = Ros_MetersToMicrometers(ros_transform->translation.x);
+    mp_coord->y = Ros_MetersToMicrometers(ros_transform->translation.y);
+    mp_coord->z = Ros_MetersToMicrometers(ros_transform->translation.z);
+    QuatConversion_GeomMsgsQuaternion_To_MpCoordOrient(
+        &ros_transform->rotation, &mp_coord->rx, &mp_coord->ry, &mp_coord->rz);
+}
@@ -39,4 +39,19 @@ extern void Ros_MpCoord_To_GeomMsgsPose(MP_COORD const* const mp_coord, geometry
 extern void Ros_MpCoord_To_GeomMsgsTransform(MP_COORD const* const mp_coord, geometry_msgs__msg__Transform* const ros_transform);
 
 
+/**
+ * Converts a ROS `geometry_msgs/msg/Transform` to an M+ `MP_COORD` struct.
+ *
+ * This is the inverse of `Ros_MpCoord_To_GeomMsgsTransform`:
+ *
+ *  - positions are converted from meters to micro-meters (rounded to the
+ *    nearest micro-meter)
+ *  - the rotation is converted to ZYX Euler angles in one-tenth milli-degrees
+ *
+ * @param ros_transform  Input `geometry_msgs/msg/Transform`
+ * @param mp_coord       Output M+ `MP_COORD` instance
+ */
+extern void Ros_GeomMsgsTransform_To_MpCoord(geometry_msgs__msg__Transform const* const ros_transform, MP_COORD* const mp_coord);
+
+
 #endif  // MOTOROS2_ROS_MOTOPLUS_CONVERSION_UTILS_H
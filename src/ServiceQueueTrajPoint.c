@@ -68,6 +68,21 @@ void Ros_ServiceQueueTrajPoint_Cleanup()
     MOTOROS2_MEM_TRACE_REPORT(svc_queue_point_fini);
 }
 
+//-------------------------------------------------------------------
+// Append the state of the point queue to the string of a result. The
+// message is limited to QUEUE_STATUS_MSG_LEN (including the terminator).
+// If it doesn't fit, the string of the result is shortened instead of
+// cutting off the state of the queue.
+//-------------------------------------------------------------------
+void Ros_ServiceQueueTrajPoint_FormatStatus(char* statusMsg, char const* resultStr, int queued, int queueDepth, int underruns)
+{
+    char queueStatus[QUEUE_STATUS_MSG_LEN];
+    int queueStatusLen;
+
+    queueStatusLen = snprintf(queueStatus, QUEUE_STATUS_MSG_LEN, " (queued: %d/%d, underruns: %d)", queued, queueDepth, underruns);
+    snprintf(statusMsg, QUEUE_STATUS_MSG_LEN, "%.*s%s", QUEUE_STATUS_MSG_LEN - 1 - queueStatusLen, resultStr, queueStatus);
+}
+
 void Ros_ServiceQueueTrajPoint_Trigger(const void* request_msg, void* response_msg)
 {
     QueueTrajPointRequest* request = (QueueTrajPointRequest*)request_msg;
@@ -86,18 +101,24 @@ void Ros_ServiceQueueTrajPoint_Trigger(const void* request_msg, void* response_m
     else
     {
         const char* initMsg;
+        char statusMsg[QUEUE_STATUS_MSG_LEN];
         response->result_code.value = Ros_MotionControl_ProcessQueuedTrajectoryPoint(request);
 
         switch (response->result_code.value)
         {
         case motoros2_interfaces__msg__QueueResultEnum__SUCCESS: 
-            rosidl_runtime_c__String__assign(&response->message,
-                motoros2_interfaces__msg__QueueResultEnum__SUCCESS_STR);
+            //the response has no dedicated fields for the state of the queue, so it's appended to the message
+            Ros_ServiceQueueTrajPoint_FormatStatus(statusMsg, motoros2_interfaces__msg__QueueResultEnum__SUCCESS_STR,
+                Ros_MotionControl_GetPointQueueDepth(), g_nodeConfigSettings.point_queue_depth,
+                Ros_MotionControl_GetPointQueueUnderrunCount());
+            rosidl_runtime_c__String__assign(&response->message, statusMsg);
             break;
 
         case motoros2_interfaces__msg__QueueResultEnum__BUSY:
-            rosidl_runtime_c__String__assign(&response->message, 
-                motoros2_interfaces__msg__QueueResultEnum__BUSY_STR);
+            Ros_ServiceQueueTrajPoint_FormatStatus(statusMsg, motoros2_interfaces__msg__QueueResultEnum__BUSY_STR,
+                Ros_MotionControl_GetPointQueueDepth(), g_nodeConfigSettings.point_queue_depth,
+                Ros_MotionControl_GetPointQueueUnderrunCount());
+            rosidl_runtime_c__String__assign(&response->message, statusMsg);
             break;
 
         case motoros2_interfaces__msg__QueueResultEnum__INVALID_JOINT_LIST:
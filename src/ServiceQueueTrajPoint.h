@@ -8,6 +8,8 @@
 #ifndef MOTOROS2_SERVICE_QUEUE_TRAJ_POINT_H
 #define MOTOROS2_SERVICE_QUEUE_TRAJ_POINT_H
 
+#define QUEUE_STATUS_MSG_LEN    64      // the state of the queue takes up to 58 characters of it
+
 extern rcl_service_t g_serviceQueueTrajPoint;
 
 typedef struct
@@ -20,6 +22,7 @@ extern ServiceQueueTrajPoint_Messages g_messages_QueueTrajPoint;
 extern void Ros_ServiceQueueTrajPoint_Initialize();
 extern void Ros_ServiceQueueTrajPoint_Cleanup();
 
+extern void Ros_ServiceQueueTrajPoint_FormatStatus(char* statusMsg, char const* resultStr, int queued, int queueDepth, int underruns);
 extern void Ros_ServiceQueueTrajPoint_Trigger(const void* request_msg, void* response_msg);
 
 #endif  // MOTOROS2_SERVICE_QUEUE_TRAJ_POINT_H
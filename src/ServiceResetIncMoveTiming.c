@@ -0,0 +1,54 @@
+//ServiceResetIncMoveTiming.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_service_t g_serviceResetIncMoveTiming;
+
+ServiceResetIncMoveTiming_Messages g_messages_ResetIncMoveTiming;
+
+void Ros_ServiceResetIncMoveTiming_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(svc_reset_inc_move_timing_init);
+
+    const rosidl_service_type_support_t* type_support = ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger);
+
+    rcl_ret_t ret = rclc_service_init_default(&g_serviceResetIncMoveTiming, &g_microRosNodeInfo.node, type_support, SERVICE_NAME_RESET_INC_MOVE_TIMING);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_SERVICE_RESET_INC_MOVE_TIMING, "Failed to init service (%d)", (int)ret);
+
+    rosidl_runtime_c__String__init(&g_messages_ResetIncMoveTiming.response.message);
+
+    MOTOROS2_MEM_TRACE_REPORT(svc_reset_inc_move_timing_init);
+}
+
+void Ros_ServiceResetIncMoveTiming_Cleanup()
+{
+    MOTOROS2_MEM_TRACE_START(svc_reset_inc_move_timing_fini);
+
+    rcl_ret_t ret;
+
+    Ros_Debug_BroadcastMsg("Cleanup service " SERVICE_NAME_RESET_INC_MOVE_TIMING);
+    ret = rcl_service_fini(&g_serviceResetIncMoveTiming, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg(
+            "Failed cleaning up " SERVICE_NAME_RESET_INC_MOVE_TIMING " service: %d", ret);
+    rosidl_runtime_c__String__fini(&g_messages_ResetIncMoveTiming.response.message);
+
+    MOTOROS2_MEM_TRACE_REPORT(svc_reset_inc_move_timing_fini);
+}
+
+void Ros_ServiceResetIncMoveTiming_Trigger(const void* request_msg, void* response_msg)
+{
+    RCL_UNUSED(request_msg);
+    std_srvs__srv__Trigger_Response* response = (std_srvs__srv__Trigger_Response*)response_msg;
+
+    //the histograms are cleared by the increment-move task at the start of its next cycle
+    Ros_IncMoveTiming_RequestReset();
+
+    rosidl_runtime_c__String__assign(&response->message, "");
+    response->success = TRUE;
+}
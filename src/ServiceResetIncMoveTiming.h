@@ -0,0 +1,25 @@
+//ServiceResetIncMoveTiming.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_SERVICE_RESET_INC_MOVE_TIMING_H
+#define MOTOROS2_SERVICE_RESET_INC_MOVE_TIMING_H
+
+extern rcl_service_t g_serviceResetIncMoveTiming;
+
+typedef struct
+{
+    std_srvs__srv__Trigger_Request request;
+    std_srvs__srv__Trigger_Response response;
+} ServiceResetIncMoveTiming_Messages;
+extern ServiceResetIncMoveTiming_Messages g_messages_ResetIncMoveTiming;
+
+extern void Ros_ServiceResetIncMoveTiming_Initialize();
+extern void Ros_ServiceResetIncMoveTiming_Cleanup();
+
+extern void Ros_ServiceResetIncMoveTiming_Trigger(const void* request_msg, void* response_msg);
+
+#endif  // MOTOROS2_SERVICE_RESET_INC_MOVE_TIMING_H
@@ -0,0 +1,90 @@
+//ServiceStartRawStreamingMode.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_service_t g_serviceStartRawStreamingMode;
+
+ServiceStartRawStreamingMode_Messages g_messages_StartRawStreamingMode;
+
+void Ros_ServiceStartRawStreamingMode_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(svc_start_raw_streaming_mode_init);
+
+    const rosidl_service_type_support_t* type_support = ROSIDL_GET_SRV_TYPE_SUPPORT(std_srvs, srv, Trigger);
+
+    rcl_ret_t ret = rclc_service_init_default(&g_serviceStartRawStreamingMode, &g_microRosNodeInfo.node, type_support, SERVICE_NAME_START_RAW_STREAMING_MODE);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_SERVICE_START_RAW_STREAMING_MODE, "Failed to init service (%d)", (int)ret);
+
+    rosidl_runtime_c__String__init(&g_messages_StartRawStreamingMode.response.message);
+
+    MOTOROS2_MEM_TRACE_REPORT(svc_start_raw_streaming_mode_init);
+}
+
+void Ros_ServiceStartRawStreamingMode_Cleanup()
+{
+    MOTOROS2_MEM_TRACE_START(svc_start_raw_streaming_mode_fini);
+
+    rcl_ret_t ret;
+
+    Ros_Debug_BroadcastMsg("Cleanup service " SERVICE_NAME_START_RAW_STREAMING_MODE);
+    ret = rcl_service_fini(&g_serviceStartRawStreamingMode, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg(
+            "Failed cleaning up " SERVICE_NAME_START_RAW_STREAMING_MODE " service: %d", ret);
+    rosidl_runtime_c__String__fini(&g_messages_StartRawStreamingMode.response.message);
+
+    MOTOROS2_MEM_TRACE_REPORT(svc_start_raw_streaming_mode_fini);
+}
+
+void Ros_ServiceStartRawStreamingMode_Trigger(const void* request_msg, void* response_msg)
+{
+    RCL_UNUSED(request_msg);
+    std_srvs__srv__Trigger_Response* response = (std_srvs__srv__Trigger_Response*)response_msg;
+
+    rosidl_runtime_c__String__assign(&response->message, "");
+    response->success = FALSE;
+
+    if (!g_nodeConfigSettings.allow_raw_streaming)
+    {
+        rosidl_runtime_c__String__assign(&response->message,
+            "Raw streaming is disabled (see 'allow_raw_streaming' in the configuration file)");
+        Ros_Debug_BroadcastMsg("%s: %s", __func__, response->message.data);
+        return;
+    }
+
+    //restarting an active stream would drop the increments which are still queued
+    if (Ros_MotionControl_IsMotionMode_RawStreaming() && Ros_MotionControl_HasDataInQueue())
+    {
+        rosidl_runtime_c__String__assign(&response->message,
+            "Can't restart raw-streaming mode: increment queue not empty");
+        Ros_Debug_BroadcastMsg("%s: %s", __func__, response->message.data);
+        return;
+    }
+
+    MotionNotReadyCode motion_result_code = Ros_MotionControl_StartMotionMode(MOTION_MODE_RAWSTREAMING, &response->message);
+    if (motion_result_code != MOTION_READY)
+    {
+        //If it is a MOTION_NOT_READY_ERROR, then the string was already populated in the Ros_MotionControl_StartMotionMode function
+        if (motion_result_code != MOTION_NOT_READY_ERROR)
+        {
+            // map to human readable string
+            rosidl_runtime_c__String__assign(&response->message,
+                Ros_ErrorHandling_MotionNotReadyCode_ToString(motion_result_code));
+        }
+
+        Ros_Debug_BroadcastMsg("%s: %s (%d)", __func__,
+            response->message.data, motion_result_code);
+        return;
+    }
+
+    //the first increments are relative to the current position of the robot
+    Ros_MotionControl_ResetRawStreaming();
+
+    response->success = TRUE;
+    Ros_Debug_BroadcastMsg("%s: activated", __func__);
+}
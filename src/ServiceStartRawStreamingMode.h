@@ -0,0 +1,25 @@
+//ServiceStartRawStreamingMode.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_SERVICE_START_RAW_STREAMING_MODE_H
+#define MOTOROS2_SERVICE_START_RAW_STREAMING_MODE_H
+
+extern rcl_service_t g_serviceStartRawStreamingMode;
+
+typedef struct
+{
+    std_srvs__srv__Trigger_Request request;
+    std_srvs__srv__Trigger_Response response;
+} ServiceStartRawStreamingMode_Messages;
+extern ServiceStartRawStreamingMode_Messages g_messages_StartRawStreamingMode;
+
+extern void Ros_ServiceStartRawStreamingMode_Initialize();
+extern void Ros_ServiceStartRawStreamingMode_Cleanup();
+
+extern void Ros_ServiceStartRawStreamingMode_Trigger(const void* request_msg, void* response_msg);
+
+#endif  // MOTOROS2_SERVICE_START_RAW_STREAMING_MODE_H
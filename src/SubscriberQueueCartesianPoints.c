@@ -0,0 +1,310 @@
+//SubscriberQueueCartesianPoints.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_subscription_t g_subscriberQueueCartesianPoints;
+
+trajectory_msgs__msg__MultiDOFJointTrajectory g_messages_QueueCartesianPoints;
+
+static micro_ros_utilities_memory_conf_t queue_cartesian_points_msg_alloc_cfg = { 0 };
+
+//Only accessed by the motion executor
+typedef struct
+{
+    //Joint angles (M+ units) of the last point which was queued. Each pose is solved for the
+    //solution closest to them, so the robot doesn't change its configuration between points.
+    long prevAngle[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];
+    long angle[MAX_CONTROLLABLE_GROUPS][MAX_PULSE_AXES];        //solution of the point which is being queued
+    int transformIndex[MAX_CONTROLLABLE_GROUPS];                 //index of the transform of each group in the points
+    double positions[MAX_CONTROLLABLE_AXES];                     //data of the joint point which is queued
+    double velocities[MAX_CONTROLLABLE_AXES];
+} CartesianStreamState;
+
+static CartesianStreamState Ros_CartesianStream;
+
+void Ros_SubscriberQueueCartesianPoints_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(sub_queue_cartesian_points_init);
+
+    const rosidl_message_type_support_t* type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, MultiDOFJointTrajectory);
+
+    rcl_ret_t ret = rclc_subscription_init_default(&g_subscriberQueueCartesianPoints, &g_microRosNodeInfo.node, type_support, TOPIC_NAME_QUEUE_CARTESIAN_POINTS);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_SUBSCRIBER_QUEUE_CARTESIAN_POINTS, "Failed to init subscriber (%d)", (int)ret);
+
+    //one TCP frame per group
+    static micro_ros_utilities_memory_rule_t rules[] = {
+        {"header.frame_id", POINT_STREAM_MAX_FRAME_ID_LENGTH},
+        {"joint_names", MAX_CONTROLLABLE_GROUPS},
+        {"joint_names.data", MAX_TF_FRAME_NAME_LENGTH},
+        {"points", POINT_STREAM_MAX_POINTS_PER_MSG},
+        {"points.transforms", MAX_CONTROLLABLE_GROUPS},
+        {"points.velocities", MAX_CONTROLLABLE_GROUPS},
+        {"points.accelerations", MAX_CONTROLLABLE_GROUPS},
+    };
+    queue_cartesian_points_msg_alloc_cfg.max_string_capacity = MAX_TF_FRAME_NAME_LENGTH;
+    queue_cartesian_points_msg_alloc_cfg.max_ros2_type_sequence_capacity = MAX_CONTROLLABLE_GROUPS;
+    queue_cartesian_points_msg_alloc_cfg.max_basic_type_sequence_capacity = MAX_CONTROLLABLE_GROUPS;
+    queue_cartesian_points_msg_alloc_cfg.rules = rules;
+    queue_cartesian_points_msg_alloc_cfg.n_rules = sizeof(rules) / sizeof(rules[0]);
+
+    bzero(&g_messages_QueueCartesianPoints, sizeof(g_messages_QueueCartesianPoints));
+    micro_ros_utilities_create_message_memory(type_support, &g_messages_QueueCartesianPoints, queue_cartesian_points_msg_alloc_cfg);
+
+    bzero(&Ros_CartesianStream, sizeof(Ros_CartesianStream));
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_queue_cartesian_points_init);
+}
+
+void Ros_SubscriberQueueCartesianPoints_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(sub_queue_cartesian_points_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup subscriber queue cartesian points");
+    ret = rcl_subscription_fini(&g_subscriberQueueCartesianPoints, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up queue cartesian points subscriber: %d", ret);
+
+    if (g_messages_QueueCartesianPoints.points.capacity > 0)
+    {
+        micro_ros_utilities_destroy_message_memory(
+            ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, MultiDOFJointTrajectory),
+            &g_messages_QueueCartesianPoints,
+            queue_cartesian_points_msg_alloc_cfg);
+    }
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_queue_cartesian_points_fini);
+}
+
+//-------------------------------------------------------------------
+// Each group is identified by the TCP frame it publishes on /tf (ie: 'r1/tcp_0'). This
+// also makes sure the poses are for the tool which is selected for the motion.
+//-------------------------------------------------------------------
+static BOOL Ros_SubscriberQueueCartesianPoints_MapFrames(rosidl_runtime_c__String__Sequence const* frameNames)
+{
+    char expectedName[MAX_TF_FRAME_NAME_LENGTH];
+    int grpIndex, i;
+
+    if (frameNames->size != g_Ros_Controller.numGroup)
+    {
+        Ros_Debug_BroadcastMsg("Cartesian points must contain a pose for all %d groups.", g_Ros_Controller.numGroup);
+        return FALSE;
+    }
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+
+        if (!Ros_CtrlGroup_IsRobot(ctrlGroup))
+        {
+            Ros_Debug_BroadcastMsg("Cartesian points can only be queued if all groups are robots (group %d is not).", grpIndex);
+            return FALSE;
+        }
+
+        snprintf(expectedName, MAX_TF_FRAME_NAME_LENGTH, "%sr%d/tcp_%d", g_nodeConfigSettings.tf_frame_prefix, grpIndex + 1, ctrlGroup->tool);
+
+        Ros_CartesianStream.transformIndex[grpIndex] = -1;
+        for (i = 0; i < frameNames->size; i += 1)
+        {
+            if (strncmp(frameNames->data[i].data, expectedName, MAX_TF_FRAME_NAME_LENGTH) == 0)
+                Ros_CartesianStream.transformIndex[grpIndex] = i;
+        }
+
+        if (Ros_CartesianStream.transformIndex[grpIndex] < 0)
+        {
+            Ros_Debug_BroadcastMsg("Frame [%s] is missing from the joint_names of the cartesian points.", expectedName);
+            return FALSE;
+        }
+    }
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Solve the joint positions for the pose of the TCP relative to the robot base
+// (the inverse of the conversion in Ros_PositionMonitor_CalculateTransforms).
+// The solution closest to 'prevAngle' is used.
+//-------------------------------------------------------------------
+static BOOL Ros_SubscriberQueueCartesianPoints_Solve(CtrlGroup* ctrlGroup, geometry_msgs__msg__Transform const* transform,
+    long prevAngle[MAX_PULSE_AXES], long angle[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    MP_COORD coord;
+    long pulsePos[MAX_PULSE_AXES];
+    int ret;
+
+    bzero(&coord, sizeof(coord));
+    Ros_GeomMsgsTransform_To_MpCoord(transform, &coord);
+
+    ret = mpConvCartPosToAxes(ctrlGroup->groupNo, &coord, ctrlGroup->tool, 0, prevAngle, MP_KINEMA_PREVIOUS, angle);
+    if (ret != OK)
+    {
+        Ros_Debug_BroadcastMsg("Unable to solve the pose of group %d (%d)", ctrlGroup->groupNo, ret);
+        return FALSE;
+    }
+
+    bzero(pulsePos, sizeof(pulsePos));
+    ret = mpConvAngleToPulse(ctrlGroup->groupNo, angle, pulsePos);
+    if (ret != OK)
+    {
+        Ros_Debug_BroadcastMsg("Unable to convert the joint angles of group %d (%d)", ctrlGroup->groupNo, ret);
+        return FALSE;
+    }
+
+    Ros_CtrlGroup_ConvertToRosPos(ctrlGroup, pulsePos, rosPos);
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// The pose after moving at 'twist' for 'dt' seconds. The twist is expressed
+// in the base frame, so the rotation is applied from the left.
+//-------------------------------------------------------------------
+static void Ros_SubscriberQueueCartesianPoints_Integrate(geometry_msgs__msg__Transform const* transform,
+    geometry_msgs__msg__Twist const* twist, double dt, geometry_msgs__msg__Transform* ahead)
+{
+    Quaternion const* q = &transform->rotation;
+    Quaternion dq;
+    double wx = twist->angular.x * dt;
+    double wy = twist->angular.y * dt;
+    double wz = twist->angular.z * dt;
+    double angle = sqrt(wx * wx + wy * wy + wz * wz);
+
+    ahead->translation.x = transform->translation.x + twist->linear.x * dt;
+    ahead->translation.y = transform->translation.y + twist->linear.y * dt;
+    ahead->translation.z = transform->translation.z + twist->linear.z * dt;
+
+    if (angle < 1e-12)
+    {
+        ahead->rotation = *q;
+        return;
+    }
+
+    double s = sin(angle / 2.0) / angle;
+    dq.w = cos(angle / 2.0);
+    dq.x = wx * s;
+    dq.y = wy * s;
+    dq.z = wz * s;
+
+    ahead->rotation.w = dq.w * q->w - dq.x * q->x - dq.y * q->y - dq.z * q->z;
+    ahead->rotation.x = dq.w * q->x + dq.x * q->w + dq.y * q->z - dq.z * q->y;
+    ahead->rotation.y = dq.w * q->y - dq.x * q->z + dq.y * q->w + dq.z * q->x;
+    ahead->rotation.z = dq.w * q->z + dq.x * q->y - dq.y * q->x + dq.z * q->w;
+}
+
+//-------------------------------------------------------------------
+// Convert a cartesian point to the positions and velocities of all joints.
+// The velocities are derived from the pose a short step ahead (zero if the
+// point doesn't have a twist).
+//-------------------------------------------------------------------
+static BOOL Ros_SubscriberQueueCartesianPoints_SolvePoint(trajectory_msgs__msg__MultiDOFJointTrajectoryPoint const* point)
+{
+    double rosPos[MAX_PULSE_AXES];
+    double rosPosAhead[MAX_PULSE_AXES];
+    long angleAhead[MAX_PULSE_AXES];
+    geometry_msgs__msg__Transform transformAhead;
+    int grpIndex, axis;
+    int jointIndex = 0;
+
+    if (point->transforms.size != g_Ros_Controller.numGroup ||
+        (point->velocities.size != 0 && point->velocities.size != point->transforms.size))
+    {
+        Ros_Debug_BroadcastMsg("Each cartesian point must have a transform (and optionally a velocity) for all %d groups.", g_Ros_Controller.numGroup);
+        return FALSE;
+    }
+
+    for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+    {
+        CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+        int i = Ros_CartesianStream.transformIndex[grpIndex];
+
+        if (!Ros_SubscriberQueueCartesianPoints_Solve(ctrlGroup, &point->transforms.data[i],
+            Ros_CartesianStream.prevAngle[grpIndex], Ros_CartesianStream.angle[grpIndex], rosPos))
+        {
+            return FALSE;
+        }
+
+        if (point->velocities.size > 0)
+        {
+            Ros_SubscriberQueueCartesianPoints_Integrate(&point->transforms.data[i], &point->velocities.data[i],
+                CARTESIAN_STREAM_VELOCITY_STEP, &transformAhead);
+
+            if (!Ros_SubscriberQueueCartesianPoints_Solve(ctrlGroup, &transformAhead,
+                Ros_CartesianStream.angle[grpIndex], angleAhead, rosPosAhead))
+            {
+                return FALSE;
+            }
+        }
+        else
+            memcpy(rosPosAhead, rosPos, sizeof(rosPosAhead));
+
+        for (axis = 0; axis < ctrlGroup->numAxes; axis += 1)
+        {
+            Ros_CartesianStream.positions[jointIndex] = rosPos[axis];
+            Ros_CartesianStream.velocities[jointIndex] = (rosPosAhead[axis] - rosPos[axis]) / CARTESIAN_STREAM_VELOCITY_STEP;
+            jointIndex += 1;
+        }
+    }
+
+    return TRUE;
+}
+
+void Ros_SubscriberQueueCartesianPoints_Callback(const void* msg)
+{
+    trajectory_msgs__msg__MultiDOFJointTrajectory const* trajectory = (trajectory_msgs__msg__MultiDOFJointTrajectory const*)msg;
+    motoros2_interfaces__srv__QueueTrajPoint_Request request;
+    long pulsePos[MAX_PULSE_AXES];
+    int grpIndex;
+
+    if (!Ros_SubscriberQueueTrajPoints_StartMessage(&trajectory->header.stamp))
+        return;
+
+    if (!Ros_SubscriberQueueCartesianPoints_MapFrames(&trajectory->joint_names))
+    {
+        Ros_SubscriberQueueTrajPoints_RejectPoint(motoros2_interfaces__msg__QueueResultEnum__INVALID_JOINT_LIST);
+        return;
+    }
+
+    //the first point of the queue starts at the current position
+    if (!Ros_MotionControl_IsPointQueueInitialized())
+    {
+        for (grpIndex = 0; grpIndex < g_Ros_Controller.numGroup; grpIndex += 1)
+        {
+            CtrlGroup* ctrlGroup = g_Ros_Controller.ctrlGroups[grpIndex];
+
+            Ros_CtrlGroup_GetPulsePosCmd(ctrlGroup, pulsePos);
+            mpConvPulseToAngle(ctrlGroup->groupNo, pulsePos, Ros_CartesianStream.prevAngle[grpIndex]);
+        }
+    }
+
+    //The solved points are passed on to the same processing as the queue_traj_points topic.
+    //The joints are listed in the same order as on the joint_states topic.
+    bzero(&request, sizeof(request));
+    request.joint_names = g_messages_PositionMonitor.jointStateAllGroups->name;
+    request.point.positions.data = Ros_CartesianStream.positions;
+    request.point.positions.size = request.point.positions.capacity = g_Ros_Controller.totalAxesCount;
+    request.point.velocities.data = Ros_CartesianStream.velocities;
+    request.point.velocities.size = request.point.velocities.capacity = g_Ros_Controller.totalAxesCount;
+
+    for (size_t i = 0; i < trajectory->points.size; i += 1)
+    {
+        if (Ros_SubscriberQueueTrajPoints_IsQueued(&trajectory->points.data[i].time_from_start))
+            continue;
+
+        //later points can't be queued without this one
+        if (!Ros_SubscriberQueueCartesianPoints_SolvePoint(&trajectory->points.data[i]))
+        {
+            Ros_SubscriberQueueTrajPoints_RejectPoint(motoros2_interfaces__msg__QueueResultEnum__UNABLE_TO_PROCESS_POINT);
+            break;
+        }
+
+        request.point.time_from_start = trajectory->points.data[i].time_from_start;
+        if (!Ros_SubscriberQueueTrajPoints_QueuePoint(&request))
+            break;
+
+        memcpy(Ros_CartesianStream.prevAngle, Ros_CartesianStream.angle, sizeof(Ros_CartesianStream.prevAngle));
+    }
+}
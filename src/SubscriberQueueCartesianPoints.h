@@ -0,0 +1,22 @@
+//SubscriberQueueCartesianPoints.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_SUBSCRIBER_QUEUE_CARTESIAN_POINTS_H
+#define MOTOROS2_SUBSCRIBER_QUEUE_CARTESIAN_POINTS_H
+
+#define CARTESIAN_STREAM_VELOCITY_STEP      0.01    // in seconds, the joint velocities are derived from the pose this far ahead
+
+extern rcl_subscription_t g_subscriberQueueCartesianPoints;
+
+extern trajectory_msgs__msg__MultiDOFJointTrajectory g_messages_QueueCartesianPoints;
+
+extern void Ros_SubscriberQueueCartesianPoints_Initialize();
+extern void Ros_SubscriberQueueCartesianPoints_Cleanup();
+
+extern void Ros_SubscriberQueueCartesianPoints_Callback(const void* msg);
+
+#endif  // MOTOROS2_SUBSCRIBER_QUEUE_CARTESIAN_POINTS_H
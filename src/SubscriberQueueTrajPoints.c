@@ -0,0 +1,216 @@
+//SubscriberQueueTrajPoints.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_subscription_t g_subscriberQueueTrajPoints;
+rcl_publisher_t g_publisherQueueTrajPointsStatus;
+
+trajectory_msgs__msg__JointTrajectory g_messages_QueueTrajPoints;
+
+static micro_ros_utilities_memory_conf_t queue_traj_points_msg_alloc_cfg = { 0 };
+
+//state of the stream, as reported on the status topic. Only accessed by the motion executor.
+typedef struct
+{
+    UINT16 resultCode;                                  //result of the last point which was processed
+    builtin_interfaces__msg__Duration lastPointTime;    //time_from_start of the last point which was queued
+    builtin_interfaces__msg__Time lastStamp;            //header.stamp of the last message
+    int elapsedSincePublish;                            //ms
+    std_msgs__msg__Int32MultiArray msgStatus;
+    int32_t statusData[POINT_STREAM_STATUS_SIZE];
+} PointStreamState;
+
+static PointStreamState Ros_PointStream;
+
+void Ros_SubscriberQueueTrajPoints_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(sub_queue_traj_points_init);
+
+    const rosidl_message_type_support_t* type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory);
+
+    rcl_ret_t ret = rclc_subscription_init_default(&g_subscriberQueueTrajPoints, &g_microRosNodeInfo.node, type_support, TOPIC_NAME_QUEUE_TRAJ_POINTS);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_SUBSCRIBER_QUEUE_TRAJ_POINTS, "Failed to init subscriber (%d)", (int)ret);
+
+    //the status is published periodically, so a lost message doesn't have to hold up the executor
+    ret = rclc_publisher_init_best_effort(&g_publisherQueueTrajPointsStatus, &g_microRosNodeInfo.node,
+        ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray), TOPIC_NAME_QUEUE_TRAJ_POINTS_STATUS);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_PUBLISHER_QUEUE_TRAJ_POINTS_STATUS, "Failed to init publisher (%d)", (int)ret);
+
+    //Allocating for all possible axes, rather than the actual number used (same as the
+    //queue_traj_point service). A message which is too large can't be deserialized, so
+    //it would be dropped without being able to report it.
+    int maxAxes = MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM;
+    static micro_ros_utilities_memory_rule_t rules[] = {
+        {"header.frame_id", POINT_STREAM_MAX_FRAME_ID_LENGTH},
+        {"joint_names", MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM},
+        {"joint_names.data", MAX_JOINT_NAME_LENGTH},
+        {"points", POINT_STREAM_MAX_POINTS_PER_MSG},
+        {"points.positions", MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM},
+        {"points.velocities", MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM},
+        {"points.accelerations", MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM},
+        {"points.effort", MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM},
+    };
+    queue_traj_points_msg_alloc_cfg.max_string_capacity = MAX_JOINT_NAME_LENGTH;
+    queue_traj_points_msg_alloc_cfg.max_ros2_type_sequence_capacity = maxAxes;
+    queue_traj_points_msg_alloc_cfg.max_basic_type_sequence_capacity = maxAxes;
+    queue_traj_points_msg_alloc_cfg.rules = rules;
+    queue_traj_points_msg_alloc_cfg.n_rules = sizeof(rules) / sizeof(rules[0]);
+
+    bzero(&g_messages_QueueTrajPoints, sizeof(g_messages_QueueTrajPoints));
+    micro_ros_utilities_create_message_memory(type_support, &g_messages_QueueTrajPoints, queue_traj_points_msg_alloc_cfg);
+
+    //the status message uses a static buffer for its data (the layout is left empty)
+    bzero(&Ros_PointStream, sizeof(Ros_PointStream));
+    Ros_PointStream.resultCode = motoros2_interfaces__msg__QueueResultEnum__SUCCESS;
+    std_msgs__msg__Int32MultiArray__init(&Ros_PointStream.msgStatus);
+    Ros_PointStream.msgStatus.data.data = Ros_PointStream.statusData;
+    Ros_PointStream.msgStatus.data.size = POINT_STREAM_STATUS_SIZE;
+    Ros_PointStream.msgStatus.data.capacity = POINT_STREAM_STATUS_SIZE;
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_queue_traj_points_init);
+}
+
+void Ros_SubscriberQueueTrajPoints_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(sub_queue_traj_points_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup subscriber queue traj points");
+    ret = rcl_subscription_fini(&g_subscriberQueueTrajPoints, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up queue traj points subscriber: %d", ret);
+    ret = rcl_publisher_fini(&g_publisherQueueTrajPointsStatus, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up queue traj points status publisher: %d", ret);
+
+    if (g_messages_QueueTrajPoints.points.capacity > 0)
+    {
+        micro_ros_utilities_destroy_message_memory(
+            ROSIDL_GET_MSG_TYPE_SUPPORT(trajectory_msgs, msg, JointTrajectory),
+            &g_messages_QueueTrajPoints,
+            queue_traj_points_msg_alloc_cfg);
+    }
+
+    //the data is a static buffer, so it must not be released by __fini
+    Ros_PointStream.msgStatus.data.data = NULL;
+    Ros_PointStream.msgStatus.data.size = Ros_PointStream.msgStatus.data.capacity = 0;
+    std_msgs__msg__Int32MultiArray__fini(&Ros_PointStream.msgStatus);
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_queue_traj_points_fini);
+}
+
+static BOOL Ros_SubscriberQueueTrajPoints_IsAfter(builtin_interfaces__msg__Duration const* a, builtin_interfaces__msg__Duration const* b)
+{
+    return (a->sec > b->sec) || (a->sec == b->sec && a->nanosec > b->nanosec);
+}
+
+//-------------------------------------------------------------------
+// The following are shared with the queue_cartesian_points topic, which
+// reports on the same status topic.
+//-------------------------------------------------------------------
+BOOL Ros_SubscriberQueueTrajPoints_StartMessage(builtin_interfaces__msg__Time const* stamp)
+{
+    Ros_PointStream.lastStamp = *stamp;
+
+    if (!Ros_MotionControl_IsMotionMode_PointQueue())
+    {
+        Ros_PointStream.resultCode = motoros2_interfaces__msg__QueueResultEnum__WRONG_MODE;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+//-------------------------------------------------------------------
+// Points which have been queued already are skipped, so a client can simply publish
+// the same points again after they were rejected (ie: because the queue was full).
+//-------------------------------------------------------------------
+BOOL Ros_SubscriberQueueTrajPoints_IsQueued(builtin_interfaces__msg__Duration const* timeFromStart)
+{
+    return Ros_MotionControl_IsPointQueueInitialized() &&
+        !Ros_SubscriberQueueTrajPoints_IsAfter(timeFromStart, &Ros_PointStream.lastPointTime);
+}
+
+BOOL Ros_SubscriberQueueTrajPoints_QueuePoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request)
+{
+    UINT16 resultCode = Ros_MotionControl_ProcessQueuedTrajectoryPoint(request);
+
+    if (resultCode != motoros2_interfaces__msg__QueueResultEnum__SUCCESS)
+    {
+        Ros_SubscriberQueueTrajPoints_RejectPoint(resultCode);
+        return FALSE;
+    }
+
+    Ros_PointStream.resultCode = resultCode;
+    Ros_PointStream.lastPointTime = request->point.time_from_start;
+    return TRUE;
+}
+
+void Ros_SubscriberQueueTrajPoints_RejectPoint(UINT16 resultCode)
+{
+    Ros_PointStream.resultCode = resultCode;
+
+    if (resultCode != motoros2_interfaces__msg__QueueResultEnum__BUSY)
+        Ros_Debug_BroadcastMsg("Streamed point rejected (%d)", resultCode);
+}
+
+void Ros_SubscriberQueueTrajPoints_Callback(const void* msg)
+{
+    trajectory_msgs__msg__JointTrajectory const* trajectory = (trajectory_msgs__msg__JointTrajectory const*)msg;
+    motoros2_interfaces__srv__QueueTrajPoint_Request request;
+
+    if (!Ros_SubscriberQueueTrajPoints_StartMessage(&trajectory->header.stamp))
+        return;
+
+    //The points are passed on to the same processing as the queue_traj_point service, one at
+    //a time. The request only references the data of the message, so nothing is copied.
+    request.joint_names = trajectory->joint_names;
+
+    for (size_t i = 0; i < trajectory->points.size; i += 1)
+    {
+        if (Ros_SubscriberQueueTrajPoints_IsQueued(&trajectory->points.data[i].time_from_start))
+            continue;
+
+        //later points can't be queued without this one
+        request.point = trajectory->points.data[i];
+        if (!Ros_SubscriberQueueTrajPoints_QueuePoint(&request))
+            break;
+    }
+}
+
+void Ros_SubscriberQueueTrajPoints_PublishStatus()
+{
+    //called at the period of the action feedback, but the status is only published at a lower rate
+    Ros_PointStream.elapsedSincePublish += g_nodeConfigSettings.action_feedback_publisher_period;
+    if (Ros_PointStream.elapsedSincePublish < POINT_STREAM_STATUS_PERIOD)
+        return;
+    Ros_PointStream.elapsedSincePublish = 0;
+
+    if (!Ros_MotionControl_IsMotionMode_PointQueue())
+        return;
+
+    int32_t* data = Ros_PointStream.statusData;
+    data[POINT_STREAM_STATUS_RESULT_CODE] = Ros_PointStream.resultCode;
+    data[POINT_STREAM_STATUS_LAST_POINT_SEC] = Ros_PointStream.lastPointTime.sec;
+    data[POINT_STREAM_STATUS_LAST_POINT_NANOSEC] = Ros_PointStream.lastPointTime.nanosec;
+    data[POINT_STREAM_STATUS_STAMP_SEC] = Ros_PointStream.lastStamp.sec;
+    data[POINT_STREAM_STATUS_STAMP_NANOSEC] = Ros_PointStream.lastStamp.nanosec;
+    data[POINT_STREAM_STATUS_QUEUED] = Ros_MotionControl_GetPointQueueDepth();
+    data[POINT_STREAM_STATUS_QUEUE_DEPTH] = g_nodeConfigSettings.point_queue_depth;
+    data[POINT_STREAM_STATUS_UNDERRUNS] = Ros_MotionControl_GetPointQueueUnderrunCount();
+
+    rcl_ret_t ret = rcl_publish(&g_publisherQueueTrajPointsStatus, &Ros_PointStream.msgStatus, NULL);
+    // publishing can fail, but we choose to ignore those errors in this implementation
+    RCL_UNUSED(ret);
+}
+
+
+//included here as this tests 'static' functions
+#define MOTOROS2_INCLUDE_TESTS_QUEUE_TRAJ_POINTS_C
+#include "Tests_SubscriberQueueTrajPoints.c"
+#undef MOTOROS2_INCLUDE_TESTS_QUEUE_TRAJ_POINTS_C
@@ -0,0 +1,45 @@
+//SubscriberQueueTrajPoints.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_SUBSCRIBER_QUEUE_TRAJ_POINTS_H
+#define MOTOROS2_SUBSCRIBER_QUEUE_TRAJ_POINTS_H
+
+#define POINT_STREAM_MAX_POINTS_PER_MSG     4
+#define POINT_STREAM_MAX_FRAME_ID_LENGTH    32
+#define POINT_STREAM_STATUS_PERIOD          100     // in milliseconds
+
+//Elements of the data of the status message
+typedef enum
+{
+    POINT_STREAM_STATUS_RESULT_CODE,            //result of the last point which was processed (QueueResultEnum)
+    POINT_STREAM_STATUS_LAST_POINT_SEC,         //time_from_start of the last point which was queued
+    POINT_STREAM_STATUS_LAST_POINT_NANOSEC,
+    POINT_STREAM_STATUS_STAMP_SEC,              //header.stamp of the last message which was received
+    POINT_STREAM_STATUS_STAMP_NANOSEC,
+    POINT_STREAM_STATUS_QUEUED,                 //number of points which are queued, but have not been reached yet
+    POINT_STREAM_STATUS_QUEUE_DEPTH,            //configured depth of the queue (point_queue_depth)
+    POINT_STREAM_STATUS_UNDERRUNS,              //number of underruns since point-queue mode was started
+    POINT_STREAM_STATUS_SIZE
+} PointStreamStatusIndex;
+
+extern rcl_subscription_t g_subscriberQueueTrajPoints;
+extern rcl_publisher_t g_publisherQueueTrajPointsStatus;
+
+extern trajectory_msgs__msg__JointTrajectory g_messages_QueueTrajPoints;
+
+extern void Ros_SubscriberQueueTrajPoints_Initialize();
+extern void Ros_SubscriberQueueTrajPoints_Cleanup();
+
+extern BOOL Ros_SubscriberQueueTrajPoints_StartMessage(builtin_interfaces__msg__Time const* stamp);
+extern BOOL Ros_SubscriberQueueTrajPoints_IsQueued(builtin_interfaces__msg__Duration const* timeFromStart);
+extern BOOL Ros_SubscriberQueueTrajPoints_QueuePoint(motoros2_interfaces__srv__QueueTrajPoint_Request* request);
+extern void Ros_SubscriberQueueTrajPoints_RejectPoint(UINT16 resultCode);
+
+extern void Ros_SubscriberQueueTrajPoints_Callback(const void* msg);
+extern void Ros_SubscriberQueueTrajPoints_PublishStatus();
+
+#endif  // MOTOROS2_SUBSCRIBER_QUEUE_TRAJ_POINTS_H
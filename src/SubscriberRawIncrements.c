@@ -0,0 +1,103 @@
+//SubscriberRawIncrements.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_subscription_t g_subscriberRawIncrements;
+
+std_msgs__msg__Int32MultiArray g_messages_RawIncrements;
+
+static micro_ros_utilities_memory_conf_t raw_increments_msg_alloc_cfg = { 0 };
+
+static RawIncrementsStatus lastStatus = RAW_INCREMENTS_OK;
+
+void Ros_SubscriberRawIncrements_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(sub_raw_increments_init);
+
+    const rosidl_message_type_support_t* type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray);
+
+    //increments which arrive late are useless, so there is no point in having them retransmitted
+    rcl_ret_t ret = rclc_subscription_init_best_effort(&g_subscriberRawIncrements, &g_microRosNodeInfo.node, type_support, TOPIC_NAME_RAW_INCREMENTS);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_SUBSCRIBER_RAW_INCREMENTS, "Failed to init subscriber (%d)", (int)ret);
+
+    //Allocating for all possible groups, rather than the actual number used. A message which is
+    //too large can't be deserialized, so it would be dropped without being able to report it.
+    static micro_ros_utilities_memory_rule_t rules[] = {
+        {"layout.dim", RAW_INCREMENTS_MAX_DIMENSIONS},
+        {"layout.dim.label", RAW_INCREMENTS_MAX_LABEL_LENGTH},
+        {"data", RAW_STREAMING_MAX_CYCLES_PER_MSG * MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM},
+    };
+    raw_increments_msg_alloc_cfg.max_string_capacity = RAW_INCREMENTS_MAX_LABEL_LENGTH;
+    raw_increments_msg_alloc_cfg.max_ros2_type_sequence_capacity = RAW_INCREMENTS_MAX_DIMENSIONS;
+    raw_increments_msg_alloc_cfg.max_basic_type_sequence_capacity = RAW_STREAMING_MAX_CYCLES_PER_MSG * MAX_CONTROLLABLE_GROUPS * MP_GRP_AXES_NUM;
+    raw_increments_msg_alloc_cfg.rules = rules;
+    raw_increments_msg_alloc_cfg.n_rules = sizeof(rules) / sizeof(rules[0]);
+
+    bzero(&g_messages_RawIncrements, sizeof(g_messages_RawIncrements));
+    micro_ros_utilities_create_message_memory(type_support, &g_messages_RawIncrements, raw_increments_msg_alloc_cfg);
+
+    lastStatus = RAW_INCREMENTS_OK;
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_raw_increments_init);
+}
+
+void Ros_SubscriberRawIncrements_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(sub_raw_increments_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup subscriber raw increments");
+    ret = rcl_subscription_fini(&g_subscriberRawIncrements, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up raw increments subscriber: %d", ret);
+
+    if (g_messages_RawIncrements.data.capacity > 0)
+    {
+        micro_ros_utilities_destroy_message_memory(
+            ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Int32MultiArray),
+            &g_messages_RawIncrements,
+            raw_increments_msg_alloc_cfg);
+    }
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_raw_increments_fini);
+}
+
+void Ros_SubscriberRawIncrements_Callback(const void* msg)
+{
+    std_msgs__msg__Int32MultiArray const* rawIncrements = (std_msgs__msg__Int32MultiArray const*)msg;
+
+    size_t offset = rawIncrements->layout.data_offset;
+    size_t size = (offset < rawIncrements->data.size) ? (rawIncrements->data.size - offset) : 0;
+
+    RawIncrementsStatus status = Ros_MotionControl_AddRawIncrements(&rawIncrements->data.data[offset], size);
+
+    //messages arrive every few cycles, so only report changes
+    if (status != lastStatus)
+    {
+        switch (status)
+        {
+        case RAW_INCREMENTS_OK:
+            Ros_Debug_BroadcastMsg("raw_increments: accepting increments");
+            break;
+        case RAW_INCREMENTS_NOT_STREAMING:
+            Ros_Debug_BroadcastMsg("raw_increments: ignoring increments (raw-streaming mode not active)");
+            break;
+        case RAW_INCREMENTS_INVALID_SIZE:
+            Ros_Debug_BroadcastMsg("raw_increments: ignoring %d increments (expected up to %d cycles of %d)",
+                (int)size, RAW_STREAMING_MAX_CYCLES_PER_MSG, g_Ros_Controller.numGroup * MP_GRP_AXES_NUM);
+            break;
+        case RAW_INCREMENTS_EXCEEDS_MAX_INC:
+            Ros_Debug_BroadcastMsg("raw_increments: ignoring increments (exceeding maximum increment of an axis)");
+            break;
+        case RAW_INCREMENTS_QUEUE_FULL:
+            Ros_Debug_BroadcastMsg("raw_increments: ignoring increments (increment queue full)");
+            break;
+        }
+        lastStatus = status;
+    }
+}
@@ -0,0 +1,23 @@
+//SubscriberRawIncrements.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_SUBSCRIBER_RAW_INCREMENTS_H
+#define MOTOROS2_SUBSCRIBER_RAW_INCREMENTS_H
+
+#define RAW_INCREMENTS_MAX_DIMENSIONS       3   // capacity for the (optional) layout of the array
+#define RAW_INCREMENTS_MAX_LABEL_LENGTH     16
+
+extern rcl_subscription_t g_subscriberRawIncrements;
+
+extern std_msgs__msg__Int32MultiArray g_messages_RawIncrements;
+
+extern void Ros_SubscriberRawIncrements_Initialize();
+extern void Ros_SubscriberRawIncrements_Cleanup();
+
+extern void Ros_SubscriberRawIncrements_Callback(const void* msg);
+
+#endif  // MOTOROS2_SUBSCRIBER_RAW_INCREMENTS_H
@@ -0,0 +1,61 @@
+//SubscriberSpeedScale.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#include "MotoROS.h"
+
+rcl_subscription_t g_subscriberSpeedScale;
+
+std_msgs__msg__Float64 g_messages_SpeedScale;
+
+
+void Ros_SubscriberSpeedScale_Initialize()
+{
+    MOTOROS2_MEM_TRACE_START(sub_speed_scale_init);
+
+    const rosidl_message_type_support_t* type_support = ROSIDL_GET_MSG_TYPE_SUPPORT(std_msgs, msg, Float64);
+
+    rcl_ret_t ret = rclc_subscription_init_default(&g_subscriberSpeedScale, &g_microRosNodeInfo.node, type_support, TOPIC_NAME_SPEED_SCALE);
+    motoRos_RCLAssertOK_withMsg(ret, SUBCODE_FAIL_INIT_SUBSCRIBER_SPEED_SCALE, "Failed to init subscriber (%d)", (int)ret);
+
+    std_msgs__msg__Float64__init(&g_messages_SpeedScale);
+
+    //every connection starts at full speed
+    Ros_MotionControl_InitSpeedScale();
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_speed_scale_init);
+}
+
+void Ros_SubscriberSpeedScale_Cleanup()
+{
+    rcl_ret_t ret;
+    MOTOROS2_MEM_TRACE_START(sub_speed_scale_fini);
+
+    Ros_Debug_BroadcastMsg("Cleanup subscriber speed scale");
+    ret = rcl_subscription_fini(&g_subscriberSpeedScale, &g_microRosNodeInfo.node);
+    if (ret != RCL_RET_OK)
+        Ros_Debug_BroadcastMsg("Failed cleaning up speed scale subscriber: %d", ret);
+    std_msgs__msg__Float64__fini(&g_messages_SpeedScale);
+
+    Ros_MotionControl_CleanupSpeedScale();
+
+    MOTOROS2_MEM_TRACE_REPORT(sub_speed_scale_fini);
+}
+
+void Ros_SubscriberSpeedScale_Callback(const void* msg)
+{
+    std_msgs__msg__Float64 const* speedScale = (std_msgs__msg__Float64 const*)msg;
+
+    //NaN fails both comparisons, so it is rejected as well
+    if (!(speedScale->data >= SPEED_SCALE_MIN && speedScale->data <= SPEED_SCALE_MAX))
+    {
+        Ros_Debug_BroadcastMsg("speed_scale: ignoring %.3f (must be between %.1f and %.1f)",
+            speedScale->data, SPEED_SCALE_MIN, SPEED_SCALE_MAX);
+        return;
+    }
+
+    Ros_MotionControl_SetSpeedScale(speedScale->data);
+}
@@ -0,0 +1,20 @@
+//SubscriberSpeedScale.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_SUBSCRIBER_SPEED_SCALE_H
+#define MOTOROS2_SUBSCRIBER_SPEED_SCALE_H
+
+extern rcl_subscription_t g_subscriberSpeedScale;
+
+extern std_msgs__msg__Float64 g_messages_SpeedScale;
+
+extern void Ros_SubscriberSpeedScale_Initialize();
+extern void Ros_SubscriberSpeedScale_Cleanup();
+
+extern void Ros_SubscriberSpeedScale_Callback(const void* msg);
+
+#endif  // MOTOROS2_SUBSCRIBER_SPEED_SCALE_H
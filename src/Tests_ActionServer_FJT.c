@@ -349,6 +349,302 @@ static BOOL Ros_Testing_Ros_ActionServer_FJT_Parse_GoalPosTolerances_last_settin
     return bSuccess;
 }
 
+static BOOL Ros_Testing_Ros_ActionServer_FJT_Parse_PosTolerances_no_default()
+{
+    //path_tolerance has no default: joints without a JointTolerance must get the
+    //default which was passed in (0.0), not the default goal tolerance
+
+    BOOL bSuccess = TRUE;
+
+    STATUS status = 0;
+    control_msgs__msg__JointTolerance__Sequence joint_tolerances;
+    rosidl_runtime_c__String__Sequence joint_names;
+    const size_t NUM_JOINTS = 6;
+    double posTolerances[NUM_JOINTS];
+    bzero(posTolerances, sizeof(posTolerances));
+
+    rosidl_runtime_c__String__Sequence__init(&joint_names, NUM_JOINTS);
+    rosidl_runtime_c__String__assign(&joint_names.data[0], "joint0");
+    rosidl_runtime_c__String__assign(&joint_names.data[1], "joint1");
+    joint_names.size = 2;
+
+    control_msgs__msg__JointTolerance__Sequence__init(&joint_tolerances, NUM_JOINTS);
+    rosidl_runtime_c__String__assign(&joint_tolerances.data[0].name, "joint1");
+    joint_tolerances.data[0].position = 0.2;
+    joint_tolerances.size = 1;
+
+    status = Ros_ActionServer_FJT_Parse_PosTolerances(&joint_tolerances, &joint_names, 0.0, posTolerances, NUM_JOINTS);
+
+    BOOL bT00 = status == OK;
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: call: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    BOOL bT01 = (posTolerances[0] == 0.0) && (posTolerances[1] == 0.2);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: expected pos tols: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    control_msgs__msg__JointTolerance__Sequence__fini(&joint_tolerances);
+    rosidl_runtime_c__String__Sequence__fini(&joint_names);
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_Check_PathTolerances()
+{
+    //joint0 is within tolerance, joint1 is outside (in the negative direction), joint2
+    //isn't checked and joint3 is exactly at its tolerance (which is still ok)
+
+    BOOL bSuccess = TRUE;
+
+    const size_t NUM_JOINTS = 4;
+    double posErrors[] = { 0.05, -0.3, 100.0, 0.1 };
+    double limits[] = { 0.1, 0.2, PATH_TOLERANCE_NOT_CHECKED, 0.1 };
+    double violators[NUM_JOINTS];
+
+    int numViolators = Ros_ActionServer_FJT_Check_PathTolerances(posErrors, limits, violators, NUM_JOINTS);
+
+    BOOL bT00 = numViolators == 1;
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: nr of violators: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    BOOL bT01 = (violators[0] == 0.0) && (violators[1] == 0.3) && (violators[2] == 0.0) && (violators[3] == 0.0);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: recorded deviations: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    //within tolerance again
+    posErrors[1] = 0.15;
+    numViolators = Ros_ActionServer_FJT_Check_PathTolerances(posErrors, limits, violators, NUM_JOINTS);
+
+    BOOL bT02 = (numViolators == 0) && (violators[1] == 0.0);
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: no violators: %s", __func__, bT02 ? "PASS" : "FAIL");
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_ReadLaggedDesired()
+{
+    //the desired position used for the path_tolerance lags TEST_LAG_CYCLES snapshots
+    //behind the latest one (snapshot 'n' has position 'n' for its first joint)
+
+    BOOL bSuccess = TRUE;
+
+    const size_t NUM_JOINTS = 2;
+    const UINT32 TEST_LAG_CYCLES = 4;
+    double published[NUM_JOINTS];
+    double desired[NUM_JOINTS];
+    int numPublished = 0;
+
+    fjt_desired_goal_start = fjt_desired_count;
+    fjt_desired_lag_cycles = TEST_LAG_CYCLES;
+    desired[0] = -1.0;
+    desired[1] = -1.0;
+
+    for (; numPublished < TEST_LAG_CYCLES; numPublished += 1)
+    {
+        published[0] = numPublished;
+        published[1] = 0.5;
+        Ros_ActionServer_FJT_PublishDesired(published, NUM_JOINTS);
+    }
+
+    BOOL bT00 = !Ros_ActionServer_FJT_ReadLaggedDesired(desired, NUM_JOINTS) && (desired[0] == -1.0);
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: not lagging yet: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    published[0] = numPublished++;
+    Ros_ActionServer_FJT_PublishDesired(published, NUM_JOINTS);
+
+    BOOL bT01 = Ros_ActionServer_FJT_ReadLaggedDesired(desired, NUM_JOINTS) && (desired[0] == 0.0) && (desired[1] == 0.5);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: first snapshot: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    //wrap around the history
+    for (int i = 0; i < DESIRED_HISTORY_SIZE + 1; i += 1, numPublished += 1)
+    {
+        published[0] = numPublished;
+        Ros_ActionServer_FJT_PublishDesired(published, NUM_JOINTS);
+    }
+
+    BOOL bT02 = Ros_ActionServer_FJT_ReadLaggedDesired(desired, NUM_JOINTS) &&
+        (desired[0] == (double)(numPublished - 1 - TEST_LAG_CYCLES));
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: lagged snapshot after wrap: %s", __func__, bT02 ? "PASS" : "FAIL");
+
+    //the configured lag (ms) is rounded to whole interpolation cycles, and limited by the history
+    BOOL bT03 = (Ros_ActionServer_FJT_GetServoLagCycles(16, 4) == 4) && (Ros_ActionServer_FJT_GetServoLagCycles(18, 4) == 5) &&
+        (Ros_ActionServer_FJT_GetServoLagCycles(0, 4) == 0) && (Ros_ActionServer_FJT_GetServoLagCycles(1000, 1) == DESIRED_HISTORY_SIZE / 2);
+    bSuccess &= bT03;
+    Ros_Debug_BroadcastMsg("Testing %s: lag in cycles: %s", __func__, bT03 ? "PASS" : "FAIL");
+
+    fjt_desired_goal_start = fjt_desired_count;
+    fjt_desired_lag_cycles = 0;
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_IsReplacementGoal()
+{
+    BOOL bSuccess = TRUE;
+    const INT64 STAMP = 1700000000LL * 1000000000LL;
+
+    BOOL bT00 = Ros_ActionServer_FJT_IsReplacementGoal(TRUE, TRUE, FALSE, STAMP);
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: stamped goal replaces active goal: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    BOOL bT01 = !Ros_ActionServer_FJT_IsReplacementGoal(TRUE, TRUE, FALSE, 0);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: goal without stamp: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    BOOL bT02 = !Ros_ActionServer_FJT_IsReplacementGoal(FALSE, TRUE, FALSE, STAMP);
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: replacement disabled: %s", __func__, bT02 ? "PASS" : "FAIL");
+
+    BOOL bT03 = !Ros_ActionServer_FJT_IsReplacementGoal(TRUE, FALSE, FALSE, STAMP) &&
+        !Ros_ActionServer_FJT_IsReplacementGoal(TRUE, TRUE, TRUE, STAMP);
+    bSuccess &= bT03;
+    Ros_Debug_BroadcastMsg("Testing %s: no goal executing: %s", __func__, bT03 ? "PASS" : "FAIL");
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_SpliceTime()
+{
+    BOOL bSuccess = TRUE;
+    const INT64 START = 1700000000LL * 1000000000LL;
+
+    //1.5 s after the start of the active trajectory
+    INT64 spliceTime = Ros_ActionServer_FJT_GetSpliceTime(START + 1500000000LL, START, 0);
+    BOOL bT00 = (spliceTime == 1500);
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: splice time: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    //the active trajectory runs 200 ms behind real time because of speed scaling
+    spliceTime = Ros_ActionServer_FJT_GetSpliceTime(START + 1500000000LL, START, 200000000LL);
+    BOOL bT01 = (spliceTime == 1300);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: splice time with speed scale delay: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    //a stamp before the start of the active trajectory
+    spliceTime = Ros_ActionServer_FJT_GetSpliceTime(START - 1000000000LL, START, 0);
+    BOOL bT02 = (spliceTime < 0);
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: stamp in the past: %s", __func__, bT02 ? "PASS" : "FAIL");
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_SpliceJointOrder()
+{
+    //a replacement must list its joints in the same order as the active goal
+
+    BOOL bSuccess = TRUE;
+
+    JointNameMappingCache cache;
+    rosidl_runtime_c__String__Sequence jnames;
+    const size_t NUM_JOINTS = 3;
+
+    bzero(&cache, sizeof(cache));
+    strncpy(cache.names[0], "joint_1", MAX_JOINT_NAME_LENGTH);
+    strncpy(cache.names[1], "joint_2", MAX_JOINT_NAME_LENGTH);
+    strncpy(cache.names[2], "joint_3", MAX_JOINT_NAME_LENGTH);
+    cache.count = NUM_JOINTS;
+
+    rosidl_runtime_c__String__Sequence__init(&jnames, NUM_JOINTS);
+    rosidl_runtime_c__String__assign(&jnames.data[0], "joint_1");
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_2");
+    rosidl_runtime_c__String__assign(&jnames.data[2], "joint_3");
+
+    BOOL bT00 = Ros_MotionControl_IsSameJointOrder(&cache, &jnames);
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: same order: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_3");
+    rosidl_runtime_c__String__assign(&jnames.data[2], "joint_2");
+    BOOL bT01 = !Ros_MotionControl_IsSameJointOrder(&cache, &jnames);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: reordered: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    jnames.size = 2;
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_2");
+    BOOL bT02 = !Ros_MotionControl_IsSameJointOrder(&cache, &jnames);
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: subset: %s", __func__, bT02 ? "PASS" : "FAIL");
+    jnames.size = NUM_JOINTS;
+
+    rosidl_runtime_c__String__Sequence__fini(&jnames);
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_SpliceTimePassed()
+{
+    //a group can only switch over if it hasn't started the segment containing the splice time
+
+    BOOL bSuccess = TRUE;
+
+    CtrlGroup ctrlGroup;
+    JointMotionData segmentEnd;
+
+    bzero(&ctrlGroup, sizeof(ctrlGroup));
+    bzero(&segmentEnd, sizeof(segmentEnd));
+    ctrlGroup.hasDataToProcess = TRUE;
+    ctrlGroup.trajectoryIterator = &segmentEnd;
+    segmentEnd.valid = TRUE;
+    segmentEnd.time = 2000; //the group is generating the segment which ends at 2000 ms
+
+    BOOL bT00 = Ros_MotionControl_IsBeforeSpliceTime(&ctrlGroup, 2500);
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: splice time in a later segment: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    BOOL bT01 = !Ros_MotionControl_IsBeforeSpliceTime(&ctrlGroup, 1500) && !Ros_MotionControl_IsBeforeSpliceTime(&ctrlGroup, 2000);
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: splice time in the current segment: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    segmentEnd.valid = FALSE; //no more points
+    BOOL bT02 = !Ros_MotionControl_IsBeforeSpliceTime(&ctrlGroup, 2500);
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: end of the active trajectory: %s", __func__, bT02 ? "PASS" : "FAIL");
+
+    segmentEnd.valid = TRUE;
+    ctrlGroup.hasDataToProcess = FALSE;
+    BOOL bT03 = !Ros_MotionControl_IsBeforeSpliceTime(&ctrlGroup, 2500);
+    bSuccess &= bT03;
+    Ros_Debug_BroadcastMsg("Testing %s: group done processing: %s", __func__, bT03 ? "PASS" : "FAIL");
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
+static BOOL Ros_Testing_Ros_ActionServer_FJT_GoalBufferSplit()
+{
+    //with goal replacement, the static goal buffer holds two goals
+
+    BOOL bSuccess = TRUE;
+
+    size_t single = Ros_ActionServer_FJT_GetGoalBufferSize(1);
+    BOOL bT00 = (single <= SIZEOF_BUFFER_FJT_GOAL) && (single > SIZEOF_BUFFER_FJT_GOAL - sizeof(double));
+    bSuccess &= bT00;
+    Ros_Debug_BroadcastMsg("Testing %s: single goal uses the whole buffer: %s", __func__, bT00 ? "PASS" : "FAIL");
+
+    size_t half = Ros_ActionServer_FJT_GetGoalBufferSize(MAX_NUMBER_OF_FJT_GOALS);
+    BOOL bT01 = (half * MAX_NUMBER_OF_FJT_GOALS <= SIZEOF_BUFFER_FJT_GOAL) && (half >= (SIZEOF_BUFFER_FJT_GOAL / MAX_NUMBER_OF_FJT_GOALS) - sizeof(double));
+    bSuccess &= bT01;
+    Ros_Debug_BroadcastMsg("Testing %s: goals don't overlap: %s", __func__, bT01 ? "PASS" : "FAIL");
+
+    BOOL bT02 = ((half % sizeof(double)) == 0) && ((single % sizeof(double)) == 0);
+    bSuccess &= bT02;
+    Ros_Debug_BroadcastMsg("Testing %s: each goal is aligned: %s", __func__, bT02 ? "PASS" : "FAIL");
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
 static BOOL Ros_Testing_Ros_ActionServer_FJT_Reorder_TrajPt_To_Internal_Order_null_args()
 {
     BOOL bSuccess = TRUE;
@@ -678,6 +974,22 @@ BOOL Ros_Testing_ActionServer_FJT()
     bSuccess &= Ros_Testing_Ros_ActionServer_FJT_Parse_GoalPosTolerances_jtol_in_slot2();
     Ros_Debug_BroadcastMsg("~~~");
     bSuccess &= Ros_Testing_Ros_ActionServer_FJT_Parse_GoalPosTolerances_last_setting_wins();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_Parse_PosTolerances_no_default();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_Check_PathTolerances();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_ReadLaggedDesired();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_IsReplacementGoal();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_SpliceTime();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_SpliceJointOrder();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_SpliceTimePassed();
+    Ros_Debug_BroadcastMsg("~~~");
+    bSuccess &= Ros_Testing_Ros_ActionServer_FJT_GoalBufferSplit();
 
     Ros_Debug_BroadcastMsg("~~~");
     bSuccess &= Ros_Testing_Ros_ActionServer_FJT_Reorder_TrajPt_To_Internal_Order_null_args();
@@ -342,6 +342,450 @@ BOOL Ros_Testing_ControllerStatusIO_ShouldWarnNoCalibDataLoaded_R1B1R2B2()
     return bSuccess;
 }
 
+BOOL Ros_Testing_ControllerStatusIO_JointNameLookup()
+{
+    BOOL bSuccess = TRUE;
+    int groupIndex, jointIndex;
+
+    Controller controller;
+
+    CtrlGroup* grp0 = Ros_CtrlGroup_Ctor();
+    CtrlGroup* grp1 = Ros_CtrlGroup_Ctor();
+    controller.numGroup = 2;
+    controller.ctrlGroups[0] = grp0;
+    controller.ctrlGroups[1] = grp1;
+
+    Ros_Testing_ControllerStatusIO_MakeFake6dofRobot(grp0, /*groupNo=*/ 0, /*groupId=*/ MP_R1_GID);
+    Ros_Testing_ControllerStatusIO_MakeFakeBaseGroup(grp1, /*groupNo=*/ 1, /*groupId=*/ MP_B1_GID);
+
+    //names are deliberately not in alphabetical order (moto order for the robot)
+    strcpy(grp0->jointNames_userDefined[0], "group_1/joint_1");
+    strcpy(grp0->jointNames_userDefined[1], "group_1/joint_2");
+    strcpy(grp0->jointNames_userDefined[2], "group_1/joint_3");
+    strcpy(grp0->jointNames_userDefined[3], "group_1/joint_6");
+    strcpy(grp0->jointNames_userDefined[4], "group_1/joint_4");
+    strcpy(grp0->jointNames_userDefined[5], "group_1/joint_5");
+    strcpy(grp1->jointNames_userDefined[0], "base_track");
+
+    Ros_Controller_BuildJointNameLookup(&controller);
+
+    bSuccess &= (controller.jointNameLookupCount == 7);
+
+    //every joint must be found in its own group, at its own index
+    for (groupIndex = 0; groupIndex < controller.numGroup; groupIndex += 1)
+    {
+        for (jointIndex = 0; jointIndex < MP_GRP_AXES_NUM; jointIndex += 1)
+        {
+            char const* name = controller.ctrlGroups[groupIndex]->jointNames_userDefined[jointIndex];
+            int foundGroup = -1, foundJoint = -1;
+
+            if (strlen(name) == 0)
+                continue;
+
+            bSuccess &= Ros_Controller_LookupJointName(&controller, name, &foundGroup, &foundJoint);
+            bSuccess &= (foundGroup == groupIndex);
+            bSuccess &= (foundJoint == jointIndex);
+        }
+    }
+
+    //unknown names must not be found
+    bSuccess &= !Ros_Controller_LookupJointName(&controller, "group_1/joint_7", &groupIndex, &jointIndex);
+    bSuccess &= !Ros_Controller_LookupJointName(&controller, "group_1/joint_", &groupIndex, &jointIndex);
+    bSuccess &= !Ros_Controller_LookupJointName(&controller, "", &groupIndex, &jointIndex);
+
+    //report overall result
+    Ros_Debug_BroadcastMsg("Testing Ros_Testing_ControllerStatusIO_JointNameLookup: %s", bSuccess ? "PASS" : "FAIL");
+
+    Ros_CtrlGroup_Dtor(grp0);
+    Ros_CtrlGroup_Dtor(grp1);
+
+    return bSuccess;
+}
+
+BOOL Ros_Testing_ControllerStatusIO_IncQueue()
+{
+    Incremental_q queue;
+    Incremental_q* q = &queue;
+    Incremental_data incData;
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int i;
+
+    if (!Ros_Controller_IncQ_Init(q, 2))
+    {
+        Ros_Debug_BroadcastMsg("Testing Controller IncQ - init: FAIL");
+        return FALSE;
+    }
+
+    bzero(&incData, sizeof(incData));
+
+    //fill the queue completely for one group. No frame is complete until the other group is filled too.
+    bOk = (Ros_Controller_IncQ_Count(q, 0) == 0);
+    for (i = 0; i < Q_SIZE; i += 1)
+    {
+        incData.time = i;
+        bOk &= Ros_Controller_IncQ_Push(q, 0, &incData);
+    }
+    bOk &= (Ros_Controller_IncQ_Count(q, 0) == Q_SIZE);
+    bOk &= (Ros_Controller_IncQ_Push(q, 0, &incData) == FALSE);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 0);
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - fill: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the frames are complete once the second group caught up
+    bOk = TRUE;
+    for (i = 0; i < Q_SIZE; i += 1)
+    {
+        incData.time = 1000 + i;
+        bOk &= Ros_Controller_IncQ_Push(q, 1, &incData);
+    }
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == Q_SIZE);
+    bOk &= (Ros_Controller_IncQ_Frame(q, q->tail)[0].time == 0);
+    bOk &= (Ros_Controller_IncQ_Frame(q, q->tail)[1].time == 1000);
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - frames: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //consume part of it and make the write index wrap around the end of the ring
+    bOk = TRUE;
+    for (i = 0; i < 150; i += 1)
+        bOk &= Ros_Controller_IncQ_Release(q, q->tail);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == (Q_SIZE - 150));
+    for (i = 0; i < 100; i += 1)
+    {
+        incData.time = Q_SIZE + i;
+        bOk &= Ros_Controller_IncQ_Push(q, 0, &incData);
+        bOk &= Ros_Controller_IncQ_Push(q, 1, &incData);
+    }
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == (Q_SIZE - 50));
+    bOk &= ((q->head[0] % Q_RING_LEN) < (q->tail % Q_RING_LEN));
+    bOk &= (Ros_Controller_IncQ_Frame(q, q->tail)[0].time == 150);
+    bOk &= (Ros_Controller_IncQ_Frame(q, q->tail + Q_SIZE - 51)[1].time == (Q_SIZE + 99));
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - wrap around: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a release of a stale sequence number must fail after the queue was cleared
+    UINT32 staleSequence = q->tail;
+    Ros_Controller_IncQ_Clear(q);
+    bOk = (Ros_Controller_IncQ_Count(q, 0) == 0);
+    bOk &= (Ros_Controller_IncQ_Count(q, 1) == 0);
+    bOk &= (Ros_Controller_IncQ_Release(q, staleSequence) == FALSE);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 0);
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - clear: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a group which is behind when the queue is cleared continues at the first frame which will be read
+    bOk = Ros_Controller_IncQ_Push(q, 0, &incData);
+    bOk &= Ros_Controller_IncQ_Push(q, 0, &incData);
+    Ros_Controller_IncQ_Clear(q);
+    bOk &= (Ros_Controller_IncQ_Count(q, 1) == 0);
+    bOk &= Ros_Controller_IncQ_Push(q, 1, &incData);
+    bOk &= (Ros_Controller_IncQ_Count(q, 1) == 1);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 0);
+    bOk &= Ros_Controller_IncQ_Push(q, 0, &incData);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 1);
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - clear while behind: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a partial frame is dropped by a resync, the complete frames are kept
+    bOk = Ros_Controller_IncQ_Push(q, 0, &incData);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 1);
+    Ros_Controller_IncQ_Resync(q);
+    bOk &= (Ros_Controller_IncQ_Count(q, 0) == 1);
+    bOk &= (Ros_Controller_IncQ_Count(q, 1) == 1);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 1);
+    bOk &= Ros_Controller_IncQ_Push(q, 1, &incData);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 1);
+    bOk &= Ros_Controller_IncQ_Push(q, 0, &incData);
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 2);
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - resync: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the sequence numbers wrap around without disturbing the slots
+    q->tail = 0xFFFFFFF0;
+    q->head[0] = 0xFFFFFFF0;
+    q->head[1] = 0xFFFFFFF0;
+    bOk = TRUE;
+    for (i = 0; i < 32; i += 1)
+    {
+        incData.time = i;
+        bOk &= Ros_Controller_IncQ_Push(q, 0, &incData);
+        bOk &= Ros_Controller_IncQ_Push(q, 1, &incData);
+    }
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 32);
+    for (i = 0; i < 32; i += 1)
+    {
+        bOk &= (Ros_Controller_IncQ_Frame(q, q->tail)[1].time == (UINT64)i);
+        bOk &= Ros_Controller_IncQ_Release(q, q->tail);
+    }
+    bOk &= (Ros_Controller_IncQ_FrameCount(q) == 0);
+    bOk &= (q->tail == 16);
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - sequence wrap around: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    Ros_Controller_IncQ_Cleanup(q);
+    return bAllTestsPassed;
+}
+
+#define TEST_INCQ_STRESS_GROUPS     4
+#define TEST_INCQ_STRESS_STEPS      400000
+#define TEST_INCQ_STRESS_PHASE      20000   // steps before the consumer switches between slower and faster than the producers
+#define TEST_INCQ_STRESS_CLEAR_RATE 7919    // on average, one clear in this many steps
+
+//-------------------------------------------------------------------
+// Interleave the operations of the producers, the consumer and
+// Ros_Controller_IncQ_Clear in a pseudo-random (but reproducible)
+// order. The consumer copies a frame in one step and releases it in
+// a later one, so the other parties run in between. Each producer
+// numbers its increments, so a lost, duplicated or overwritten
+// increment shows up in the frames which are read.
+//-------------------------------------------------------------------
+BOOL Ros_Testing_ControllerStatusIO_IncQueueStress()
+{
+    Incremental_q queue;
+    Incremental_q* q = &queue;
+    Incremental_data incData;
+    Incremental_data frameCopy[TEST_INCQ_STRESS_GROUPS];
+    UINT64 pushCount[TEST_INCQ_STRESS_GROUPS];
+    UINT64 lastRead[TEST_INCQ_STRESS_GROUPS];
+    UINT64 pushCountAtClear[TEST_INCQ_STRESS_GROUPS];
+    UINT32 readSequence = 0;
+    BOOL bReading = FALSE;
+    int clearCount = 0;
+    int clearCountAtLastRead = 0;
+    int clearCountAtCopy = 0;
+    int framesRead = 0;
+    int framesDiscarded = 0;
+    int fullCount = 0;
+    int emptyCount = 0;
+    UINT32 random = 12345;
+    BOOL bOk = TRUE;
+    int step, groupIndex;
+
+    if (!Ros_Controller_IncQ_Init(q, TEST_INCQ_STRESS_GROUPS))
+    {
+        Ros_Debug_BroadcastMsg("Testing Controller IncQ - stress: FAIL (init)");
+        return FALSE;
+    }
+
+    bzero(&incData, sizeof(incData));
+    bzero(lastRead, sizeof(lastRead));
+    for (groupIndex = 0; groupIndex < TEST_INCQ_STRESS_GROUPS; groupIndex += 1)
+        pushCount[groupIndex] = 1;
+
+    for (step = 0; step < TEST_INCQ_STRESS_STEPS && bOk; step += 1)
+    {
+        BOOL bConsumerIsFast = ((step / TEST_INCQ_STRESS_PHASE) % 2) == 1;
+        int consumerWeight = bConsumerIsFast ? (4 * TEST_INCQ_STRESS_GROUPS) : 1;
+        UINT32 action;
+
+        random = random * 1103515245 + 12345;
+        action = (random >> 8) % (TEST_INCQ_STRESS_GROUPS + consumerWeight);
+
+        if (((random >> 4) % TEST_INCQ_STRESS_CLEAR_RATE) == 0)
+        {
+            Ros_Controller_IncQ_Clear(q);
+            clearCount += 1;
+            memcpy(pushCountAtClear, pushCount, sizeof(pushCountAtClear));
+        }
+        else if (action < TEST_INCQ_STRESS_GROUPS)
+        {
+            groupIndex = (int)action;
+            incData.time = pushCount[groupIndex];
+            incData.inc[0] = groupIndex;
+            incData.inc[1] = (LONG)pushCount[groupIndex];
+            if (Ros_Controller_IncQ_Push(q, groupIndex, &incData))
+                pushCount[groupIndex] += 1;
+            else
+                fullCount += 1;
+        }
+        else if (!bReading)
+        {
+            //take a copy of the oldest complete frame
+            if (Ros_Controller_IncQ_FrameCount(q) > 0)
+            {
+                readSequence = q->tail;
+                memcpy(frameCopy, Ros_Controller_IncQ_Frame(q, readSequence), sizeof(frameCopy));
+                clearCountAtCopy = clearCount;
+                bReading = TRUE;
+            }
+            else
+                emptyCount += 1;
+        }
+        else
+        {
+            bReading = FALSE;
+            if (Ros_Controller_IncQ_Release(q, readSequence))
+            {
+                for (groupIndex = 0; groupIndex < TEST_INCQ_STRESS_GROUPS; groupIndex += 1)
+                {
+                    //the increments of a group are read in order, without skipping any. A clear
+                    //discards all frames, so the next frame starts with the first increment of
+                    //each group which was written after the clear.
+                    bOk &= (frameCopy[groupIndex].inc[0] == groupIndex);
+                    bOk &= (frameCopy[groupIndex].inc[1] == (LONG)frameCopy[groupIndex].time);
+                    if (clearCount == clearCountAtLastRead)
+                        bOk &= (frameCopy[groupIndex].time == lastRead[groupIndex] + 1);
+                    else
+                        bOk &= (frameCopy[groupIndex].time == pushCountAtClear[groupIndex]);
+                    bOk &= (frameCopy[groupIndex].time < pushCount[groupIndex]);
+                    lastRead[groupIndex] = frameCopy[groupIndex].time;
+                }
+                clearCountAtLastRead = clearCount;
+                framesRead += 1;
+            }
+            else
+            {
+                //a release only fails if the queue was cleared while the frame was copied
+                bOk &= (clearCount != clearCountAtCopy);
+                framesDiscarded += 1;
+            }
+        }
+
+        bOk &= (Ros_Controller_IncQ_FrameCount(q) <= Q_SIZE);
+        for (groupIndex = 0; groupIndex < TEST_INCQ_STRESS_GROUPS; groupIndex += 1)
+            bOk &= (Ros_Controller_IncQ_Count(q, groupIndex) <= Q_SIZE);
+    }
+
+    //make sure the test went through all of the situations it is meant to cover
+    bOk &= (clearCount > 0) && (framesDiscarded > 0) && (fullCount > 0) && (emptyCount > 0);
+    bOk &= (framesRead > (TEST_INCQ_STRESS_STEPS / (4 * TEST_INCQ_STRESS_GROUPS)));
+
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - stress (%d frames read, %d discarded, %d clears): %s",
+        framesRead, framesDiscarded, clearCount, bOk ? "PASS" : "FAIL");
+
+    Ros_Controller_IncQ_Cleanup(q);
+    return bOk;
+}
+
+#define TEST_INCQ_BENCHMARK_FRAMES          20000
+#define TEST_INCQ_BENCHMARK_CALIBRATION_MS  200
+#define TEST_INCQ_BENCHMARK_TIMEOUT_MS      10000
+
+typedef struct
+{
+    Incremental_q* q;
+    int groupIndex;
+    volatile BOOL bDone;
+} IncQueueBenchmarkProducer;
+
+//-------------------------------------------------------------------
+// Producer task of Ros_Testing_ControllerStatusIO_IncQueueBenchmark.
+// Writes TEST_INCQ_BENCHMARK_FRAMES numbered increments of one group.
+//-------------------------------------------------------------------
+void Ros_Testing_ControllerStatusIO_IncQueueProducer(IncQueueBenchmarkProducer* producer)
+{
+    Incremental_data incData;
+    int i = 0;
+
+    bzero(&incData, sizeof(incData));
+    incData.inc[0] = producer->groupIndex;
+
+    while (i < TEST_INCQ_BENCHMARK_FRAMES)
+    {
+        incData.time = i;
+        if (Ros_Controller_IncQ_Push(producer->q, producer->groupIndex, &incData))
+            i += 1;
+        else
+            mpTaskDelay(0); //queue is full, let the consumer run
+    }
+
+    producer->bDone = TRUE;
+    mpDeleteSelf;
+}
+
+//-------------------------------------------------------------------
+// Run a producer task per group against a consumer (this task), like
+// the AddToIncQueue tasks and the IncMoveTask. Reports the throughput
+// and the longest time it took to read and release a frame.
+//-------------------------------------------------------------------
+BOOL Ros_Testing_ControllerStatusIO_IncQueueBenchmark(int numGroup)
+{
+    Incremental_q queue;
+    Incremental_q* q = &queue;
+    IncQueueBenchmarkProducer producers[MAX_CONTROLLABLE_GROUPS];
+    int tidProducers[MAX_CONTROLLABLE_GROUPS];
+    Incremental_data frame[MAX_CONTROLLABLE_GROUPS];
+    UINT64 tsStart, tsEnd, tsCalibration;
+    UINT64 worstDequeue = 0;
+    UINT32 ticksPerUs;
+    ULONG tickStart, tickCalibration;
+    int framesRead = 0;
+    BOOL bTimedOut = FALSE;
+    BOOL bOk = TRUE;
+    int groupIndex, elapsedMs;
+
+    if (!Ros_Controller_IncQ_Init(q, numGroup))
+    {
+        Ros_Debug_BroadcastMsg("Testing Controller IncQ - benchmark (%d groups): FAIL (init)", numGroup);
+        return FALSE;
+    }
+
+    //calibrate the timestamp counter against the system clock
+    tickCalibration = tickGet();
+    tsCalibration = Ros_IncMoveTiming_Now();
+    mpTaskDelay(TEST_INCQ_BENCHMARK_CALIBRATION_MS / mpGetRtc());
+    ticksPerUs = (UINT32)((Ros_IncMoveTiming_Now() - tsCalibration) / ((tickGet() - tickCalibration) * mpGetRtc() * 1000));
+    if (ticksPerUs == 0)
+        ticksPerUs = 1;
+
+    for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
+    {
+        producers[groupIndex].q = q;
+        producers[groupIndex].groupIndex = groupIndex;
+        producers[groupIndex].bDone = FALSE;
+    }
+
+    tickStart = tickGet();
+    for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
+    {
+        tidProducers[groupIndex] = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE,
+                                                (FUNCPTR)Ros_Testing_ControllerStatusIO_IncQueueProducer,
+                                                (int)&producers[groupIndex], 0, 0, 0, 0, 0, 0, 0, 0, 0);
+        bOk &= (tidProducers[groupIndex] != ERROR);
+    }
+
+    while (bOk && framesRead < TEST_INCQ_BENCHMARK_FRAMES && !bTimedOut)
+    {
+        tsStart = Ros_IncMoveTiming_Now();
+        if (Ros_Controller_IncQ_FrameCount(q) > 0)
+        {
+            UINT32 sequence = q->tail;
+
+            memcpy(frame, Ros_Controller_IncQ_Frame(q, sequence), sizeof(Incremental_data) * numGroup);
+            bOk &= Ros_Controller_IncQ_Release(q, sequence);
+            tsEnd = Ros_IncMoveTiming_Now();
+
+            if ((tsEnd - tsStart) > worstDequeue)
+                worstDequeue = tsEnd - tsStart;
+
+            for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
+                bOk &= (frame[groupIndex].time == (UINT64)framesRead) && (frame[groupIndex].inc[0] == groupIndex);
+            framesRead += 1;
+        }
+        else
+        {
+            mpTaskDelay(0); //queue is empty, let the producers run
+            bTimedOut = ((tickGet() - tickStart) * mpGetRtc()) > TEST_INCQ_BENCHMARK_TIMEOUT_MS;
+        }
+    }
+    elapsedMs = (int)((tickGet() - tickStart) * mpGetRtc());
+
+    //the producers are done once the consumer has all of the frames. Anything else is stuck.
+    for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
+    {
+        if (tidProducers[groupIndex] != ERROR && !producers[groupIndex].bDone)
+        {
+            mpDeleteTask(tidProducers[groupIndex]);
+            bOk = FALSE;
+        }
+    }
+    bOk &= !bTimedOut && (framesRead == TEST_INCQ_BENCHMARK_FRAMES) && (Ros_Controller_IncQ_FrameCount(q) == 0);
+
+    Ros_Debug_BroadcastMsg("Testing Controller IncQ - benchmark (%d groups, %d frames in %d ms, longest dequeue: %d us): %s",
+        numGroup, framesRead, elapsedMs, (int)(worstDequeue / ticksPerUs), bOk ? "PASS" : "FAIL");
+
+    Ros_Controller_IncQ_Cleanup(q);
+    return bOk;
+}
 
 BOOL Ros_Testing_ControllerStatusIO()
 {
@@ -355,6 +799,12 @@ BOOL Ros_Testing_ControllerStatusIO()
     bSuccess &= Ros_Testing_ControllerStatusIO_ShouldWarnNoCalibDataLoaded_R1S1S2();
     bSuccess &= Ros_Testing_ControllerStatusIO_ShouldWarnNoCalibDataLoaded_R1B1S1();
     bSuccess &= Ros_Testing_ControllerStatusIO_ShouldWarnNoCalibDataLoaded_R1B1R2B2();
+    bSuccess &= Ros_Testing_ControllerStatusIO_JointNameLookup();
+    bSuccess &= Ros_Testing_ControllerStatusIO_IncQueue();
+    bSuccess &= Ros_Testing_ControllerStatusIO_IncQueueStress();
+    bSuccess &= Ros_Testing_ControllerStatusIO_IncQueueBenchmark(1);
+    bSuccess &= Ros_Testing_ControllerStatusIO_IncQueueBenchmark(2);
+    bSuccess &= Ros_Testing_ControllerStatusIO_IncQueueBenchmark(MAX_CONTROLLABLE_GROUPS);
 
 
     return bSuccess;
@@ -34,6 +34,8 @@ void Ros_Testing_CtrlGroup_MakeFake6dofRobot(CtrlGroup* group)
     group->pulseToRad.PtoR[5] = 4;
     group->pulseToRad.PtoR[6] = 3;
     group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitJointTransform(group);
 }
 
 void Ros_Testing_CtrlGroup_MakeFakeDeltaRobot(CtrlGroup* group)
@@ -61,6 +63,8 @@ void Ros_Testing_CtrlGroup_MakeFakeDeltaRobot(CtrlGroup* group)
     group->pulseToRad.PtoR[5] = 4;
     group->pulseToRad.PtoR[6] = 3;
     group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitJointTransform(group);
 }
 
 void Ros_Testing_CtrlGroup_MakeFakeSiaRobot(CtrlGroup* group)
@@ -88,6 +92,63 @@ void Ros_Testing_CtrlGroup_MakeFakeSiaRobot(CtrlGroup* group)
     group->pulseToRad.PtoR[5] = 4;
     group->pulseToRad.PtoR[6] = 3;
     group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitJointTransform(group);
+}
+
+void Ros_Testing_CtrlGroup_MakeFakeHighSpeedPickingRobot(CtrlGroup* group)
+{
+    bzero(group, sizeof(CtrlGroup));
+
+    group->groupNo = 0;
+    group->numAxes = 5;
+    group->groupId = MP_R1_GID;
+
+    group->axisType.type[0] = AXIS_ROTATION; //s
+    group->axisType.type[1] = AXIS_ROTATION; //l
+    group->axisType.type[2] = AXIS_ROTATION; //u
+    group->axisType.type[3] = AXIS_INVALID;
+    group->axisType.type[4] = AXIS_ROTATION; //b
+    group->axisType.type[5] = AXIS_ROTATION; //t
+    group->axisType.type[6] = AXIS_INVALID;
+    group->axisType.type[7] = AXIS_INVALID;
+
+    group->pulseToRad.PtoR[0] = 9;
+    group->pulseToRad.PtoR[1] = 8;
+    group->pulseToRad.PtoR[2] = 7;
+    group->pulseToRad.PtoR[3] = 6;
+    group->pulseToRad.PtoR[4] = 5;
+    group->pulseToRad.PtoR[5] = 4;
+    group->pulseToRad.PtoR[6] = 3;
+    group->pulseToRad.PtoR[7] = 2;
+
+    Ros_CtrlGroup_InitJointTransform(group);
+}
+
+void Ros_Testing_CtrlGroup_MakeFakeScaraRobot(CtrlGroup* group)
+{
+    bzero(group, sizeof(CtrlGroup));
+
+    group->groupNo = 0;
+    group->numAxes = 4;
+    group->groupId = MP_R1_GID;
+
+    group->axisType.type[0] = AXIS_ROTATION; //s
+    group->axisType.type[1] = AXIS_ROTATION; //l
+    group->axisType.type[2] = AXIS_LINEAR;   //u
+    group->axisType.type[3] = AXIS_ROTATION; //r
+    group->axisType.type[4] = AXIS_INVALID;
+    group->axisType.type[5] = AXIS_INVALID;
+    group->axisType.type[6] = AXIS_INVALID;
+    group->axisType.type[7] = AXIS_INVALID;
+
+    group->pulseToRad.PtoR[0] = 9;
+    group->pulseToRad.PtoR[1] = 8;
+    group->pulseToRad.PtoR[2] = 7;
+    group->pulseToRad.PtoR[3] = 6;
+    group->pulseToMeter.PtoM[2] = 11;
+
+    Ros_CtrlGroup_InitJointTransform(group);
 }
 
 BOOL Ros_Testing_CtrlGroup_PosConverters()
@@ -267,12 +328,154 @@ BOOL Ros_Testing_CtrlGroup_HasBaseTrack()
     return bAllTestsPassed;
 }
 
+//-------------------------------------------------------------------
+// The conversions as they were before the JointTransform: the units of
+// each axis (in moto order) and the joint order are converted separately
+//-------------------------------------------------------------------
+static double Ros_Testing_CtrlGroup_ReferencePulsesPerUnit(CtrlGroup* group, int axis)
+{
+    if (group->axisType.type[axis] == AXIS_ROTATION)
+        return group->pulseToRad.PtoR[axis];
+    else if (group->axisType.type[axis] == AXIS_LINEAR)
+        return group->pulseToMeter.PtoM[axis];
+    else
+        return 1.0;
+}
+
+static void Ros_Testing_CtrlGroup_ReferenceToRosPos(CtrlGroup* group, long const pulsePos[MAX_PULSE_AXES], double rosPos[MAX_PULSE_AXES])
+{
+    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+
+    bzero(rosUnitsWithMotoOrder, sizeof(rosUnitsWithMotoOrder));
+    bzero(rosPos, sizeof(double) * MAX_PULSE_AXES);
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        if (!Ros_CtrlGroup_IsInvalidAxis(group, i))
+            rosUnitsWithMotoOrder[i] = pulsePos[i] / Ros_Testing_CtrlGroup_ReferencePulsesPerUnit(group, i);
+    }
+    Ros_CtrlGroup_ConvertMotoJointOrderToSequentialJointOrder(group, rosUnitsWithMotoOrder, rosPos);
+}
+
+static void Ros_Testing_CtrlGroup_ReferenceRosUnitsToMotoUnits(CtrlGroup* group, double const rosPos[MAX_PULSE_AXES], long pulsePos[MAX_PULSE_AXES])
+{
+    bzero(pulsePos, sizeof(long) * MAX_PULSE_AXES);
+    for (int i = 0; i < MAX_PULSE_AXES; i += 1)
+    {
+        if (!Ros_CtrlGroup_IsInvalidAxis(group, i))
+            pulsePos[i] = (int)(rosPos[i] * Ros_Testing_CtrlGroup_ReferencePulsesPerUnit(group, i));
+    }
+}
+
+static void Ros_Testing_CtrlGroup_ReferenceToMotoPos(CtrlGroup* group, double const rosPos[MAX_PULSE_AXES], long pulsePos[MAX_PULSE_AXES])
+{
+    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+
+    Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(group, rosPos, rosUnitsWithMotoOrder);
+    Ros_Testing_CtrlGroup_ReferenceRosUnitsToMotoUnits(group, rosUnitsWithMotoOrder, pulsePos);
+}
+
+#define TEST_JOINT_TRANSFORM_SAMPLES    1000
+#define TEST_JOINT_TRANSFORM_RANGE      2000000     // pulses
+
+static long Ros_Testing_CtrlGroup_RandomPulses(UINT32* random)
+{
+    *random = *random * 1103515245 + 12345;
+    return (long)((*random >> 8) % (2 * TEST_JOINT_TRANSFORM_RANGE + 1)) - TEST_JOINT_TRANSFORM_RANGE;
+}
+
+BOOL Ros_Testing_CtrlGroup_JointTransform()
+{
+    CtrlGroup* group = Ros_CtrlGroup_Ctor();
+    char const* styles[] = { "6 DOF", "Delta", "SLU-BT", "SCARA", "SIA" };
+    long pulsePos[MAX_PULSE_AXES];
+    long motoPos[MAX_PULSE_AXES];
+    long expectedMotoPos[MAX_PULSE_AXES];
+    double rosPos[MAX_PULSE_AXES];
+    double expectedRosPos[MAX_PULSE_AXES];
+    double rosUnitsWithMotoOrder[MAX_PULSE_AXES];
+    UINT32 random = 7;
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int style, sample, i;
+
+    //the transform must give exactly the same results as the separate conversions, in both directions,
+    //and a position must survive the round trip (up to the truncation to whole pulses)
+    for (style = 0; style < (int)(sizeof(styles) / sizeof(styles[0])); style += 1)
+    {
+        switch (style)
+        {
+        case 0: Ros_Testing_CtrlGroup_MakeFake6dofRobot(group); break;
+        case 1: Ros_Testing_CtrlGroup_MakeFakeDeltaRobot(group); break;
+        case 2: Ros_Testing_CtrlGroup_MakeFakeHighSpeedPickingRobot(group); break;
+        case 3: Ros_Testing_CtrlGroup_MakeFakeScaraRobot(group); break;
+        default: Ros_Testing_CtrlGroup_MakeFakeSiaRobot(group); break;
+        }
+
+        bOk = TRUE;
+        for (sample = 0; sample < TEST_JOINT_TRANSFORM_SAMPLES; sample += 1)
+        {
+            for (i = 0; i < MAX_PULSE_AXES; i += 1)
+                pulsePos[i] = Ros_CtrlGroup_IsInvalidAxis(group, i) ? 0 : Ros_Testing_CtrlGroup_RandomPulses(&random);
+
+            Ros_CtrlGroup_ConvertToRosPos(group, pulsePos, rosPos);
+            Ros_Testing_CtrlGroup_ReferenceToRosPos(group, pulsePos, expectedRosPos);
+            for (i = 0; i < MAX_PULSE_AXES; i += 1)
+                bOk &= (rosPos[i] == expectedRosPos[i]);
+
+            Ros_CtrlGroup_ConvertToMotoPos_FromSequentialOrdering(group, rosPos, motoPos);
+            Ros_Testing_CtrlGroup_ReferenceToMotoPos(group, rosPos, expectedMotoPos);
+            for (i = 0; i < MAX_PULSE_AXES; i += 1)
+                bOk &= (motoPos[i] == expectedMotoPos[i]) && (labs(motoPos[i] - pulsePos[i]) <= 1);
+
+            Ros_CtrlGroup_ConvertSequentialJointOrderToMotoJointOrder(group, rosPos, rosUnitsWithMotoOrder);
+            Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(group, rosUnitsWithMotoOrder, motoPos);
+            Ros_Testing_CtrlGroup_ReferenceRosUnitsToMotoUnits(group, rosUnitsWithMotoOrder, expectedMotoPos);
+            for (i = 0; i < MAX_PULSE_AXES; i += 1)
+                bOk &= (motoPos[i] == expectedMotoPos[i]);
+        }
+
+        Ros_Debug_BroadcastMsg("Testing CtrlGroup JointTransform - %s style: %s", styles[style], bOk ? "PASS" : "FAIL");
+        bAllTestsPassed &= bOk;
+    }
+
+    //the B axis compensation must change the B axis the same way as converting all axes to ROS and back,
+    //and leave the other axes as they are (instead of within a pulse)
+    Ros_Testing_CtrlGroup_MakeFakeHighSpeedPickingRobot(group);
+    group->bIsBaxisSlave = TRUE;
+    bOk = TRUE;
+    for (sample = 0; sample < TEST_JOINT_TRANSFORM_SAMPLES; sample += 1)
+    {
+        for (i = 0; i < MAX_PULSE_AXES; i += 1)
+            pulsePos[i] = Ros_CtrlGroup_IsInvalidAxis(group, i) ? 0 : Ros_Testing_CtrlGroup_RandomPulses(&random);
+
+        Ros_Testing_CtrlGroup_ReferenceToRosPos(group, pulsePos, rosPos);
+        rosPos[3] += -rosPos[1] + rosPos[2];
+        Ros_Testing_CtrlGroup_ReferenceToMotoPos(group, rosPos, expectedMotoPos);
+
+        memcpy(motoPos, pulsePos, sizeof(motoPos));
+        Ros_CtrlGroup_CompensateBaxisSlave(group, motoPos);
+
+        for (i = 0; i < MAX_PULSE_AXES; i += 1)
+        {
+            if (i == 4) //B
+                bOk &= (motoPos[i] == expectedMotoPos[i]);
+            else
+                bOk &= (motoPos[i] == pulsePos[i]) && (labs(expectedMotoPos[i] - pulsePos[i]) <= 1);
+        }
+    }
+    Ros_Debug_BroadcastMsg("Testing CtrlGroup JointTransform - B axis slave: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    Ros_CtrlGroup_Dtor(group);
+    return bAllTestsPassed;
+}
+
 BOOL Ros_Testing_CtrlGroup()
 {
     BOOL bSuccess = TRUE;
 
     bSuccess &= Ros_Testing_CtrlGroup_PosConverters();
     bSuccess &= Ros_Testing_CtrlGroup_HasBaseTrack();
+    bSuccess &= Ros_Testing_CtrlGroup_JointTransform();
 
     return bSuccess;
 }
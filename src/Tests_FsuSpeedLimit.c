@@ -0,0 +1,295 @@
+// Tests_FsuSpeedLimit.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef MOTOROS2_TESTING_ENABLE
+
+#include "MotoROS.h"
+
+#define TEST_FSU_NUM_INCREMENTS         200     // increments of each simulated motion
+#define TEST_FSU_MAX_EXTRA_CYCLES       2000    // cycles after the last increment before a simulation is abandoned
+#define TEST_FSU_LIMIT_START            50      // cycle at which the speed limit is applied
+
+//Simulated servo. The FSU speed limit makes the controller process only part of a commanded
+//increment: each axis moves at most 'limit' pulses per cycle, the rest of the increment is dropped.
+typedef struct
+{
+    LONG limit[MP_GRP_AXES_NUM];        // 0: no limit
+    LONG accepted[MP_GRP_AXES_NUM];     // pulses processed of the last increment
+    LONG position[MP_GRP_AXES_NUM];     // command position
+} SimulatedServo;
+
+typedef struct
+{
+    int cycles;                         // cycles until all pulses were processed
+    int recoveryCycles;                 // cycles after the limit was lifted until the commanded speed was reached again
+    LONG maxStep;                       // largest change of the processed pulses between two cycles, after the limit was lifted
+    BOOL bOverspeed;                    // more pulses than commanded were processed in a cycle
+    BOOL bPulsesConserved;              // the final position matches the sum of the commanded increments
+} FsuSimulationResult;
+
+static void Ros_Testing_FsuSpeedLimit_ServoProcess(SimulatedServo* servo, LONG const inc[MP_GRP_AXES_NUM], BOOL bLimited)
+{
+    for (int axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+    {
+        LONG accepted = inc[axis];
+
+        if (bLimited && servo->limit[axis] > 0)
+        {
+            if (accepted > servo->limit[axis])
+                accepted = servo->limit[axis];
+            else if (accepted < -servo->limit[axis])
+                accepted = -servo->limit[axis];
+        }
+
+        servo->accepted[axis] = accepted;
+        servo->position[axis] += accepted;
+    }
+}
+
+//-------------------------------------------------------------------
+// Run a motion at a constant speed through the reconciliation, the same way as
+// the IncMoveTask does, with the speed limit active for 'limitCycles' cycles.
+//-------------------------------------------------------------------
+static void Ros_Testing_FsuSpeedLimit_Simulate(LONG speed, LONG limit, int limitCycles, FsuSimulationResult* result)
+{
+    FsuSpeedLimitState state;
+    SimulatedServo servo;
+    UINT32 maxIncrement[MP_GRP_AXES_NUM];
+    LONG inc[MP_GRP_AXES_NUM];
+    LONG prevAccepted = 0;
+    int queued = 0;
+    int limitEnd = TEST_FSU_LIMIT_START + limitCycles;
+    int cycle, axis;
+
+    Ros_FsuSpeedLimit_Reset(&state);
+    bzero(&servo, sizeof(servo));
+    bzero(result, sizeof(FsuSimulationResult));
+    result->recoveryCycles = -1;
+
+    //the axes move at different speeds and directions, only the first one is limited
+    servo.limit[0] = limit;
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        maxIncrement[axis] = 10 * speed;
+
+    for (cycle = 0; cycle < TEST_FSU_NUM_INCREMENTS + TEST_FSU_MAX_EXTRA_CYCLES; cycle++)
+    {
+        BOOL bNewIncrement = FALSE;
+        BOOL bLimited = (cycle >= TEST_FSU_LIMIT_START && cycle < limitEnd);
+
+        bzero(inc, sizeof(inc));
+        if (!state.bSkipReadingQ && queued < TEST_FSU_NUM_INCREMENTS)
+        {
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+                inc[axis] = (axis % 2) ? -(speed + axis) : speed + axis;
+            bNewIncrement = TRUE;
+            queued++;
+        }
+
+        BOOL hasUnprocessedData = Ros_FsuSpeedLimit_Reconcile(&state, bNewIncrement, servo.accepted, maxIncrement, inc);
+        if (!hasUnprocessedData && queued == TEST_FSU_NUM_INCREMENTS)
+            break;
+
+        Ros_Testing_FsuSpeedLimit_ServoProcess(&servo, inc, bLimited);
+
+        if (labs(servo.accepted[0]) > speed)
+            result->bOverspeed = TRUE;
+
+        if (cycle >= limitEnd)
+        {
+            if (labs(servo.accepted[0] - prevAccepted) > result->maxStep)
+                result->maxStep = labs(servo.accepted[0] - prevAccepted);
+            if (result->recoveryCycles < 0 && servo.accepted[0] == speed)
+                result->recoveryCycles = cycle - limitEnd;
+        }
+        prevAccepted = servo.accepted[0];
+    }
+
+    result->cycles = cycle;
+    result->bPulsesConserved = TRUE;
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+    {
+        LONG expected = TEST_FSU_NUM_INCREMENTS * ((axis % 2) ? -(speed + axis) : speed + axis);
+        if (servo.position[axis] != expected)
+            result->bPulsesConserved = FALSE;
+    }
+}
+
+BOOL Ros_Testing_FsuSpeedLimit_Unlimited()
+{
+    FsuSimulationResult result;
+    BOOL bOk;
+
+    //without a speed limit, every increment is sent as it was read from the queue
+    Ros_Testing_FsuSpeedLimit_Simulate(100, 0, 0, &result);
+    bOk = result.bPulsesConserved && !result.bOverspeed && (result.cycles == TEST_FSU_NUM_INCREMENTS);
+    bOk &= (result.recoveryCycles == 0) && (result.maxStep == 0);
+    Ros_Debug_BroadcastMsg("Testing FsuSpeedLimit - unlimited: %s", bOk ? "PASS" : "FAIL");
+
+    return bOk;
+}
+
+BOOL Ros_Testing_FsuSpeedLimit_Limited()
+{
+    FsuSimulationResult result;
+    BOOL bOk;
+
+    //the pulses which were dropped by the servo are sent again, without exceeding the commanded speed
+    Ros_Testing_FsuSpeedLimit_Simulate(100, 30, 20, &result);
+    bOk = result.bPulsesConserved && !result.bOverspeed;
+    bOk &= (result.cycles > TEST_FSU_NUM_INCREMENTS) && (result.recoveryCycles == 0);
+    Ros_Debug_BroadcastMsg("Testing FsuSpeedLimit - limited: %s", bOk ? "PASS" : "FAIL");
+
+    return bOk;
+}
+
+//-------------------------------------------------------------------
+// Two groups read from the same frames of the increment queue. Only the
+// first one is limited, but the second one must wait for it.
+//-------------------------------------------------------------------
+BOOL Ros_Testing_FsuSpeedLimit_TwoGroups()
+{
+    static const LONG speed[2] = { 100, 60 };
+    FsuSpeedLimitState state[2];
+    SimulatedServo servo[2];
+    UINT32 maxIncrement[MP_GRP_AXES_NUM];
+    LONG inc[2][MP_GRP_AXES_NUM];
+    int limitEnd = TEST_FSU_LIMIT_START + 20;
+    int queued = 0, heldCycles = 0;
+    BOOL bInStep = TRUE, bOverspeed = FALSE, bConserved = TRUE;
+    BOOL bOk;
+    int cycle, axis, grp;
+
+    bzero(servo, sizeof(servo));
+    servo[0].limit[0] = 30;
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        maxIncrement[axis] = 10 * speed[0];
+
+    for (grp = 0; grp < 2; grp++)
+        Ros_FsuSpeedLimit_Reset(&state[grp]);
+
+    for (cycle = 0; cycle < TEST_FSU_NUM_INCREMENTS + TEST_FSU_MAX_EXTRA_CYCLES; cycle++)
+    {
+        BOOL bNewIncrement = FALSE;
+        BOOL bLimited = (cycle >= TEST_FSU_LIMIT_START && cycle < limitEnd);
+        BOOL hasUnprocessedData = FALSE;
+
+        //same decision as the IncMoveTask: a frame is read for both groups, or for none
+        bzero(inc, sizeof(inc));
+        if (Ros_FsuSpeedLimit_MustHoldFrame(state, 2))
+            heldCycles++;
+        else if (queued < TEST_FSU_NUM_INCREMENTS)
+        {
+            for (grp = 0; grp < 2; grp++)
+            {
+                for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+                    inc[grp][axis] = speed[grp];
+            }
+            bNewIncrement = TRUE;
+            queued++;
+        }
+
+        for (grp = 0; grp < 2; grp++)
+            hasUnprocessedData |= Ros_FsuSpeedLimit_Reconcile(&state[grp], bNewIncrement, servo[grp].accepted, maxIncrement, inc[grp]);
+        if (!hasUnprocessedData && queued == TEST_FSU_NUM_INCREMENTS)
+            break;
+
+        Ros_Testing_FsuSpeedLimit_ServoProcess(&servo[0], inc[0], bLimited);
+        Ros_Testing_FsuSpeedLimit_ServoProcess(&servo[1], inc[1], FALSE);
+
+        for (grp = 0; grp < 2; grp++)
+        {
+            if (labs(servo[grp].accepted[0]) > speed[grp])
+                bOverspeed = TRUE;
+        }
+
+        //the unlimited group only moves with the frames which were read, so it never gets ahead
+        if (servo[1].position[0] != queued * speed[1])
+            bInStep = FALSE;
+    }
+
+    for (grp = 0; grp < 2; grp++)
+    {
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        {
+            if (servo[grp].position[axis] != TEST_FSU_NUM_INCREMENTS * speed[grp])
+                bConserved = FALSE;
+        }
+    }
+
+    bOk = bConserved && bInStep && !bOverspeed && (heldCycles > 0);
+    Ros_Debug_BroadcastMsg("Testing FsuSpeedLimit - two groups (held %d cycles): %s", heldCycles, bOk ? "PASS" : "FAIL");
+
+    return bOk;
+}
+
+//-------------------------------------------------------------------
+// Recovery after the limit is lifted, for many combinations of speed, limit and duration
+//-------------------------------------------------------------------
+BOOL Ros_Testing_FsuSpeedLimit_Benchmark()
+{
+    static const LONG speeds[] = { 1, 7, 100, 1000 };
+    static const int limitPercentages[] = { 0, 10, 25, 50, 75, 90 };
+    static const int limitDurations[] = { 1, 5, 25, 100 };
+    FsuSimulationResult result;
+    ULONG tickBefore, tickAfter;
+    int worstRecovery = 0, worstExtraCycles = 0, profiles = 0;
+    LONG worstStepPercentage = 0;
+    BOOL bOk = TRUE;
+
+    tickBefore = tickGet();
+    for (int s = 0; s < sizeof(speeds) / sizeof(speeds[0]); s++)
+    {
+        for (int l = 0; l < sizeof(limitPercentages) / sizeof(limitPercentages[0]); l++)
+        {
+            for (int d = 0; d < sizeof(limitDurations) / sizeof(limitDurations[0]); d++)
+            {
+                //a limit of 0 pulses would stop the axis, the FSU always lets it move a little
+                LONG limit = (speeds[s] * limitPercentages[l]) / 100;
+                if (limit < 1)
+                    limit = 1;
+
+                Ros_Testing_FsuSpeedLimit_Simulate(speeds[s], limit, limitDurations[d], &result);
+                profiles++;
+
+                if (!result.bPulsesConserved || result.bOverspeed || result.recoveryCycles < 0)
+                {
+                    Ros_Debug_BroadcastMsg("FsuSpeedLimit benchmark failed: speed %d, limit %d, %d cycles", (int)speeds[s], (int)limit, limitDurations[d]);
+                    bOk = FALSE;
+                    continue;
+                }
+
+                if (result.recoveryCycles > worstRecovery)
+                    worstRecovery = result.recoveryCycles;
+                if (result.cycles - TEST_FSU_NUM_INCREMENTS > worstExtraCycles)
+                    worstExtraCycles = result.cycles - TEST_FSU_NUM_INCREMENTS;
+                if ((result.maxStep * 100) / speeds[s] > worstStepPercentage)
+                    worstStepPercentage = (result.maxStep * 100) / speeds[s];
+            }
+        }
+    }
+    tickAfter = tickGet();
+
+    Ros_Debug_BroadcastMsg("FsuSpeedLimit benchmark: %d profiles in %d ms. Worst recovery: %d cycles, worst delay: %d cycles, worst step: %d%% of the speed",
+        profiles, (int)((tickAfter - tickBefore) * mpGetRtc()), worstRecovery, worstExtraCycles, (int)worstStepPercentage);
+    Ros_Debug_BroadcastMsg("Testing FsuSpeedLimit - benchmark: %s", bOk ? "PASS" : "FAIL");
+
+    return bOk;
+}
+
+BOOL Ros_Testing_FsuSpeedLimit()
+{
+    BOOL bSuccess = TRUE;
+
+    bSuccess &= Ros_Testing_FsuSpeedLimit_Unlimited();
+    bSuccess &= Ros_Testing_FsuSpeedLimit_Limited();
+    bSuccess &= Ros_Testing_FsuSpeedLimit_TwoGroups();
+    bSuccess &= Ros_Testing_FsuSpeedLimit_Benchmark();
+
+    return bSuccess;
+}
+
+#endif //MOTOROS2_TESTING_ENABLE
@@ -0,0 +1,139 @@
+// Tests_IncPrecompile.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef MOTOROS2_TESTING_ENABLE
+
+#include "MotoROS.h"
+
+#define TEST_PRECOMPILE_BUFFER_SIZE     8192    // words
+#define TEST_PRECOMPILE_MOTION_CYCLES   1000    // cycles of the simulated motion
+#define TEST_PRECOMPILE_AXIS_MASK       0x3F    // six axes
+
+static INT16 Ros_Testing_IncPrecompile_Buffer[TEST_PRECOMPILE_BUFFER_SIZE];
+
+BOOL Ros_Testing_IncPrecompile_RoundTrip()
+{
+    //changes at the limits of the 16-bit encoding, and beyond
+    static const LONG increments[][MP_GRP_AXES_NUM] =
+    {
+        { 1, -1, 0, 0, 100, -100, 0, 0 },
+        { 32768, -32767, 0, 0, 32867, -32867, 0, 0 },
+        { 0, 0, 0, 0, -100000, 100000, 0, 0 },
+        { 2000000, -2000000, 0, 0, 7, 7, 0, 0 },
+        { -2000000, 2000000, 0, 0, 0, 0, 0, 0 },
+    };
+    const int numIncrements = sizeof(increments) / sizeof(increments[0]);
+    //axes 2 and 3 are not stored, as if they were invalid
+    const UINT32 axisMask = 0xF3;
+    IncStream stream;
+    LONG inc[MP_GRP_AXES_NUM];
+    int i;
+    BOOL bOk = TRUE;
+
+    Ros_IncPrecompile_InitStream(&stream, Ros_Testing_IncPrecompile_Buffer, TEST_PRECOMPILE_BUFFER_SIZE, axisMask);
+    for (i = 0; i < numIncrements; i++)
+        bOk &= Ros_IncPrecompile_Encode(&stream, increments[i]);
+    bOk &= (stream.numIncrements == numIncrements);
+
+    for (i = 0; i < numIncrements; i++)
+    {
+        bOk &= Ros_IncPrecompile_Decode(&stream, inc);
+        bOk &= (memcmp(inc, increments[i], sizeof(inc)) == 0);
+    }
+    bOk &= !Ros_IncPrecompile_Decode(&stream, inc);
+
+    Ros_Debug_BroadcastMsg("Testing IncPrecompile - round trip: %s", bOk ? "PASS" : "FAIL");
+    return bOk;
+}
+
+BOOL Ros_Testing_IncPrecompile_Capacity()
+{
+    static const LONG small[MP_GRP_AXES_NUM] = { 1, 1, 1, 0, 0, 0, 0, 0 };
+    static const LONG large[MP_GRP_AXES_NUM] = { 1, 1, 100000, 0, 0, 0, 0, 0 };
+    IncStream stream;
+    LONG inc[MP_GRP_AXES_NUM];
+    BOOL bOk = TRUE;
+
+    //three axes: the small increment takes 3 words, the large one 5 (one escaped change)
+    Ros_IncPrecompile_InitStream(&stream, Ros_Testing_IncPrecompile_Buffer, 10, 0x07);
+    bOk &= Ros_IncPrecompile_Encode(&stream, small);
+    bOk &= Ros_IncPrecompile_Encode(&stream, small);
+    bOk &= !Ros_IncPrecompile_Encode(&stream, large);
+    bOk &= (stream.length == 6) && (stream.numIncrements == 2);
+
+    //a rejected increment leaves the stream unchanged
+    bOk &= Ros_IncPrecompile_Encode(&stream, small);
+    bOk &= (stream.length == 9);
+
+    bOk &= Ros_IncPrecompile_Decode(&stream, inc) && Ros_IncPrecompile_Decode(&stream, inc) && Ros_IncPrecompile_Decode(&stream, inc);
+    bOk &= (memcmp(inc, small, sizeof(inc)) == 0);
+    bOk &= !Ros_IncPrecompile_Decode(&stream, inc);
+
+    Ros_Debug_BroadcastMsg("Testing IncPrecompile - capacity: %s", bOk ? "PASS" : "FAIL");
+    return bOk;
+}
+
+//-------------------------------------------------------------------
+// Size of the stream of a smooth motion (accelerate, cruise, decelerate)
+//-------------------------------------------------------------------
+BOOL Ros_Testing_IncPrecompile_Compression()
+{
+    IncStream stream;
+    LONG inc[MP_GRP_AXES_NUM];
+    LONG decoded[MP_GRP_AXES_NUM];
+    LONG position[MP_GRP_AXES_NUM];
+    int cycle, axis, uncompressed;
+    BOOL bOk = TRUE;
+
+    bzero(inc, sizeof(inc));
+    bzero(position, sizeof(position));
+    Ros_IncPrecompile_InitStream(&stream, Ros_Testing_IncPrecompile_Buffer, TEST_PRECOMPILE_BUFFER_SIZE, TEST_PRECOMPILE_AXIS_MASK);
+
+    for (cycle = 0; cycle < TEST_PRECOMPILE_MOTION_CYCLES && bOk; cycle++)
+    {
+        for (axis = 0; axis < 6; axis++)
+        {
+            LONG accel = (axis + 1) * 3;
+            if (cycle < TEST_PRECOMPILE_MOTION_CYCLES / 4)
+                inc[axis] += accel;
+            else if (cycle >= (TEST_PRECOMPILE_MOTION_CYCLES * 3) / 4)
+                inc[axis] -= accel;
+        }
+        bOk &= Ros_IncPrecompile_Encode(&stream, inc);
+    }
+
+    //the decoded increments add up to the same motion
+    while (Ros_IncPrecompile_Decode(&stream, decoded))
+    {
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+            position[axis] += decoded[axis];
+    }
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis++)
+        bOk &= (position[axis] == ((axis < 6) ? (LONG)((axis + 1) * 3) * (TEST_PRECOMPILE_MOTION_CYCLES / 4) * (TEST_PRECOMPILE_MOTION_CYCLES * 3 / 4) : 0));
+
+    //one word per axis and cycle, instead of a LONG for each of the MP_GRP_AXES_NUM axes of Incremental_data
+    uncompressed = TEST_PRECOMPILE_MOTION_CYCLES * MP_GRP_AXES_NUM * (sizeof(LONG) / sizeof(INT16));
+    bOk &= (stream.length == TEST_PRECOMPILE_MOTION_CYCLES * 6);
+
+    Ros_Debug_BroadcastMsg("IncPrecompile compression: %d cycles in %d words (%d%% of uncompressed)",
+        stream.numIncrements, stream.length, (stream.length * 100) / uncompressed);
+    Ros_Debug_BroadcastMsg("Testing IncPrecompile - compression: %s", bOk ? "PASS" : "FAIL");
+    return bOk;
+}
+
+BOOL Ros_Testing_IncPrecompile()
+{
+    BOOL bSuccess = TRUE;
+
+    bSuccess &= Ros_Testing_IncPrecompile_RoundTrip();
+    bSuccess &= Ros_Testing_IncPrecompile_Capacity();
+    bSuccess &= Ros_Testing_IncPrecompile_Compression();
+
+    return bSuccess;
+}
+
+#endif //MOTOROS2_TESTING_ENABLE
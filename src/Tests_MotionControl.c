@@ -0,0 +1,1434 @@
+// Tests_MotionControl.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef MOTOROS2_TESTING_ENABLE
+
+#include "MotoROS.h"
+
+BOOL Ros_Testing_MotionControl_Segment()
+{
+    JointMotionData start, end;
+    TrajectorySegment segment;
+    double pos[MP_GRP_AXES_NUM];
+    double vel[MP_GRP_AXES_NUM];
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int numAxes = 6;
+    int i;
+
+    bzero(&start, sizeof(start));
+    bzero(&end, sizeof(end));
+
+    start.time = 1000;
+    end.time = 1500;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        start.pos[i] = 0.1 * i;
+        start.vel[i] = 0.2 - (0.1 * i);
+        end.pos[i] = 1.0 - (0.3 * i);
+        end.vel[i] = 0.05 * i;
+    }
+
+    Ros_MotionControl_ComputeSegment(&start, &end, numAxes, FALSE, &segment);
+
+    //the segment must start at the start point
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, 0.0, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        bOk &= Ros_Testing_CompareDouble(pos[i], start.pos[i]);
+        bOk &= Ros_Testing_CompareDouble(vel[i], start.vel[i]);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl Segment - start: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the segment must end at the end point
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, 0.5, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        bOk &= Ros_Testing_CompareDouble(pos[i], end.pos[i]);
+        bOk &= Ros_Testing_CompareDouble(vel[i], end.vel[i]);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl Segment - end: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //in between, it must match the cubic in its expanded form
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, 0.2, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        double interval = 0.5;
+        double t = 0.2;
+        double accCoef1 = (6 * (end.pos[i] - start.pos[i]) / (interval * interval)) - (2 * (end.vel[i] + 2 * start.vel[i]) / interval);
+        double accCoef2 = (-12 * (end.pos[i] - start.pos[i]) / (interval * interval * interval)) + (6 * (end.vel[i] + start.vel[i]) / (interval * interval));
+
+        bOk &= Ros_Testing_CompareDouble(pos[i], start.pos[i] + start.vel[i] * t + accCoef1 * t * t / 2 + accCoef2 * t * t * t / 6);
+        bOk &= Ros_Testing_CompareDouble(vel[i], start.vel[i] + accCoef1 * t + accCoef2 * t * t / 2);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl Segment - intermediate: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a segment without duration holds the start position
+    end.time = start.time;
+    Ros_MotionControl_ComputeSegment(&start, &end, numAxes, FALSE, &segment);
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, 0.0, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+        bOk &= Ros_Testing_CompareDouble(pos[i], start.pos[i]);
+    Ros_Debug_BroadcastMsg("Testing MotionControl Segment - zero duration: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_QuinticSegment()
+{
+    JointMotionData start, end;
+    TrajectorySegment segment;
+    double pos[MP_GRP_AXES_NUM];
+    double vel[MP_GRP_AXES_NUM];
+    double posBefore[MP_GRP_AXES_NUM], posAfter[MP_GRP_AXES_NUM];
+    double velBefore[MP_GRP_AXES_NUM], velAfter[MP_GRP_AXES_NUM];
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int numAxes = 6;
+    double interval = 0.5;
+    double dt = 0.0001;
+    int i;
+
+    bzero(&start, sizeof(start));
+    bzero(&end, sizeof(end));
+
+    start.time = 1000;
+    end.time = 1500;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        start.pos[i] = 0.1 * i;
+        start.vel[i] = 0.2 - (0.1 * i);
+        start.acc[i] = 0.5 * i;
+        end.pos[i] = 1.0 - (0.3 * i);
+        end.vel[i] = 0.05 * i;
+        end.acc[i] = 1.0 - (0.4 * i);
+    }
+
+    Ros_MotionControl_ComputeSegment(&start, &end, numAxes, TRUE, &segment);
+
+    //the segment must start at the start point
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, 0.0, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        bOk &= Ros_Testing_CompareDouble(pos[i], start.pos[i]);
+        bOk &= Ros_Testing_CompareDouble(vel[i], start.vel[i]);
+        bOk &= Ros_Testing_CompareDouble(2 * segment.c2[i], start.acc[i]);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl QuinticSegment - start: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the segment must end at the end point
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, interval, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        bOk &= Ros_Testing_CompareDouble(pos[i], end.pos[i]);
+        bOk &= Ros_Testing_CompareDouble(vel[i], end.vel[i]);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl QuinticSegment - end: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the acceleration at the end (numerical derivative of the velocity) must match the end point
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, interval - dt, posBefore, velBefore);
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, interval + dt, posAfter, velAfter);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        double acc = (velAfter[i] - velBefore[i]) / (2 * dt);
+        bOk &= (fabs(acc - end.acc[i]) < 0.001);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl QuinticSegment - end acceleration: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //with zero accelerations, it must still match position and velocity at the end
+    bzero(start.acc, sizeof(start.acc));
+    bzero(end.acc, sizeof(end.acc));
+    Ros_MotionControl_ComputeSegment(&start, &end, numAxes, TRUE, &segment);
+    Ros_MotionControl_EvaluateSegment(&segment, numAxes, interval, pos, vel);
+    bOk = TRUE;
+    for (i = 0; i < numAxes; i += 1)
+    {
+        bOk &= Ros_Testing_CompareDouble(pos[i], end.pos[i]);
+        bOk &= Ros_Testing_CompareDouble(vel[i], end.vel[i]);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl QuinticSegment - zero acceleration: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+#define TEST_LIMITS_INTERPOL_PERIOD     4           //ms
+#define TEST_LIMITS_PULSE_PER_RAD       100000.0
+#define TEST_LIMITS_MAX_INC             1000        //pulses per cycle (= 2.5 rad/s)
+#define TEST_LIMITS_NUM_POINTS          11
+#define TEST_LIMITS_BENCHMARK_POINTS    10000
+
+void Ros_Testing_MotionControl_MakeFakeLimitedGroup(CtrlGroup* group)
+{
+    bzero(group, sizeof(CtrlGroup));
+
+    group->numAxes = 6;
+    for (int axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+    {
+        if (axis < group->numAxes)
+        {
+            group->axisType.type[axis] = AXIS_ROTATION;
+            group->pulseToRad.PtoR[axis] = TEST_LIMITS_PULSE_PER_RAD;
+            group->maxInc.maxIncrement[axis] = TEST_LIMITS_MAX_INC;
+            group->maxSpeed[axis] = TEST_LIMITS_MAX_INC * 1000.0 / TEST_LIMITS_INTERPOL_PERIOD / TEST_LIMITS_PULSE_PER_RAD;
+            group->trajJointIndex[axis] = axis;
+        }
+        else
+            group->axisType.type[axis] = AXIS_INVALID;
+    }
+
+    Ros_CtrlGroup_InitJointTransform(group);
+}
+
+void Ros_Testing_MotionControl_SetPoint(trajectory_msgs__msg__JointTrajectoryPoint* point, double* pos, double* vel, double* acc, int timeMs)
+{
+    bzero(point, sizeof(trajectory_msgs__msg__JointTrajectoryPoint));
+    point->positions.data = pos;
+    point->positions.size = point->positions.capacity = 6;
+    point->velocities.data = vel;
+    point->velocities.size = point->velocities.capacity = 6;
+
+    //the controller isn't initialized yet (totalAxesCount is 0), so the conversion expects an
+    //'empty' acceleration array. It must still be readable.
+    point->accelerations.data = acc;
+    point->time_from_start.sec = timeMs / 1000;
+    point->time_from_start.nanosec = (timeMs % 1000) * 1000000;
+}
+
+BOOL Ros_Testing_MotionControl_TrajectoryLimits()
+{
+    CtrlGroup group;
+    trajectory_msgs__msg__JointTrajectoryPoint points[TEST_LIMITS_NUM_POINTS];
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence sequence;
+    TrajectoryLimitViolation violation;
+    Init_Trajectory_Status status;
+    double pos[TEST_LIMITS_NUM_POINTS][MP_GRP_AXES_NUM];
+    double vel[TEST_LIMITS_NUM_POINTS][MP_GRP_AXES_NUM];
+    double acc[MP_GRP_AXES_NUM];
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int i, axis;
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+
+    //1 rad/s on all axes, one point every 100 ms
+    bzero(acc, sizeof(acc));
+    for (i = 0; i < TEST_LIMITS_NUM_POINTS; i += 1)
+    {
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+        {
+            pos[i][axis] = 0.1 * i;
+            vel[i][axis] = 1.0;
+        }
+        Ros_Testing_MotionControl_SetPoint(&points[i], pos[i], vel[i], acc, i * 100);
+    }
+    sequence.data = points;
+    sequence.size = sequence.capacity = TEST_LIMITS_NUM_POINTS;
+
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_OK) && (violation.pointIndex == -1);
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, TRUE, &violation);
+    bOk &= (status == INIT_TRAJ_OK) && (violation.pointIndex == -1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - valid: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //commanded velocity of a single point exceeds the limit
+    vel[5][2] = 3.0;
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_INVALID_VELOCITY) && (violation.pointIndex == 5) && (violation.axis == 2) && (violation.limitType == TRAJ_LIMIT_VELOCITY);
+    Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - velocity: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+    vel[5][2] = 1.0;
+
+    //all velocities are within limits, but the segment in between needs a larger increment
+    //(0.5 rad in 100 ms peaks at 7.5 rad/s)
+    for (i = 7; i < TEST_LIMITS_NUM_POINTS; i += 1)
+        pos[i][1] += 0.4;
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_INVALID_VELOCITY) && (violation.pointIndex == 7) && (violation.axis == 1) && (violation.limitType == TRAJ_LIMIT_INCREMENT);
+    bOk &= (violation.value > TEST_LIMITS_MAX_INC) && Ros_Testing_CompareDouble(violation.limit, TEST_LIMITS_MAX_INC);
+    Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - increment: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+    for (i = 7; i < TEST_LIMITS_NUM_POINTS; i += 1)
+        pos[i][1] -= 0.4;
+
+    //the velocities and increments are within limits, but reversing from 1 to -2 rad/s in 100 ms
+    //needs 120 rad/s^2 at the end of the segment (the limit is 2.5 rad/s / 25 ms)
+    vel[5][0] = -2.0;
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_INVALID_VELOCITY) && (violation.pointIndex == 5) && (violation.axis == 0) && (violation.limitType == TRAJ_LIMIT_ACCELERATION);
+    bOk &= Ros_Testing_CompareDouble(violation.value, 120.0) && Ros_Testing_CompareDouble(violation.limit, 100.0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - acceleration: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+    vel[5][0] = 1.0;
+
+    //4-axis palletizing robot (SLU--T-): the T-axis is moto axis 5, but its speed limit is the one of ROS joint 3
+    group.groupId = MP_R1_GID;
+    group.numAxes = 4;
+    group.axisType.type[3] = AXIS_INVALID;
+    group.axisType.type[4] = AXIS_INVALID;
+    group.maxSpeed[4] = 0.0;
+    group.maxSpeed[5] = 0.0;
+    group.trajJointIndex[5] = 3;
+    Ros_CtrlGroup_InitJointTransform(&group);
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_OK) && (violation.pointIndex == -1);
+    vel[5][3] = 3.0;
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk &= (status == INIT_TRAJ_INVALID_VELOCITY) && (violation.pointIndex == 5) && (violation.axis == 5) && (violation.limitType == TRAJ_LIMIT_VELOCITY);
+    Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - joint order: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+    vel[5][3] = 1.0;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_BaxisSlave()
+{
+    CtrlGroup group;
+    trajectory_msgs__msg__JointTrajectoryPoint points[TEST_LIMITS_NUM_POINTS];
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence sequence;
+    TrajectoryLimitViolation violation;
+    Init_Trajectory_Status status;
+    double pos[TEST_LIMITS_NUM_POINTS][MP_GRP_AXES_NUM];
+    double vel[MP_GRP_AXES_NUM];
+    double acc[MP_GRP_AXES_NUM];
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int i, axis;
+
+    //MPL80/100 (SLU-BT): the B-axis (moto axis 4) is compensated for the motion of L and U
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+    group.bIsBaxisSlave = TRUE;
+
+    //L and U move at -1 and 1 rad/s, so the compensation adds 2 rad/s to the B-axis
+    bzero(vel, sizeof(vel));
+    bzero(acc, sizeof(acc));
+    vel[1] = -1.0;
+    vel[2] = 1.0;
+    vel[4] = 0.4;
+    for (i = 0; i < TEST_LIMITS_NUM_POINTS; i += 1)
+    {
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            pos[i][axis] = vel[axis] * 0.1 * i;
+        Ros_Testing_MotionControl_SetPoint(&points[i], pos[i], vel, acc, i * 100);
+    }
+    sequence.data = points;
+    sequence.size = sequence.capacity = TEST_LIMITS_NUM_POINTS;
+
+    //compensated once, the B-axis moves at 2.4 rad/s (within the limit of 2.5 rad/s). Compensated
+    //twice, it would move at 4.4 rad/s.
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_OK) && (violation.pointIndex == -1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl BaxisSlave - compensated once: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //0.6 rad/s is within the limit by itself, but not after the compensation
+    vel[4] = 0.6;
+    for (i = 0; i < TEST_LIMITS_NUM_POINTS; i += 1)
+        pos[i][4] = vel[4] * 0.1 * i;
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_INVALID_VELOCITY) && (violation.pointIndex == 0) && (violation.axis == 4);
+    bOk &= Ros_Testing_CompareDouble(violation.value, 2.6);
+    Ros_Debug_BroadcastMsg("Testing MotionControl BaxisSlave - compensated limit: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //without the slave, the same trajectory is within the limits
+    group.bIsBaxisSlave = FALSE;
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    bOk = (status == INIT_TRAJ_OK) && (violation.pointIndex == -1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl BaxisSlave - no slave: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_TrajectoryLimitsBenchmark()
+{
+    CtrlGroup group;
+    trajectory_msgs__msg__JointTrajectoryPoint* points;
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence sequence;
+    TrajectoryLimitViolation violation;
+    Init_Trajectory_Status status;
+    double posA[MP_GRP_AXES_NUM], posB[MP_GRP_AXES_NUM];
+    double zero[MP_GRP_AXES_NUM];
+    ULONG tickBefore, tickAfter;
+    BOOL bOk;
+    int i;
+
+    points = (trajectory_msgs__msg__JointTrajectoryPoint*)mpMalloc(sizeof(trajectory_msgs__msg__JointTrajectoryPoint) * TEST_LIMITS_BENCHMARK_POINTS);
+    if (points == NULL)
+    {
+        Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - benchmark: SKIPPED (out of memory)");
+        return TRUE;
+    }
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+
+    //move back and forth between two positions (peaks at 1.5 rad/s), so the points can share their arrays
+    bzero(zero, sizeof(zero));
+    for (i = 0; i < MP_GRP_AXES_NUM; i += 1)
+    {
+        posA[i] = 0.0;
+        posB[i] = 0.1;
+    }
+    for (i = 0; i < TEST_LIMITS_BENCHMARK_POINTS; i += 1)
+        Ros_Testing_MotionControl_SetPoint(&points[i], (i % 2) ? posB : posA, zero, zero, i * 100);
+    sequence.data = points;
+    sequence.size = sequence.capacity = TEST_LIMITS_BENCHMARK_POINTS;
+
+    tickBefore = tickGet();
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, FALSE, &violation);
+    tickAfter = tickGet();
+
+    bOk = (status == INIT_TRAJ_OK);
+    Ros_Debug_BroadcastMsg("Testing MotionControl TrajectoryLimits - benchmark (%d points in %d ms): %s",
+        TEST_LIMITS_BENCHMARK_POINTS, (int)((tickAfter - tickBefore) * mpGetRtc()), bOk ? "PASS" : "FAIL");
+
+    mpFree(points);
+
+    return bOk;
+}
+
+#define TEST_SPARSE_NUM_POINTS          5
+
+#define TEST_SEGMENT_BENCHMARK_POINTS       16
+#define TEST_SEGMENT_BENCHMARK_SEGMENTS     4000    // per group
+#define TEST_SEGMENT_BENCHMARK_CYCLES       25      // per segment (100 ms)
+
+typedef enum
+{
+    TEST_SEGMENT_BENCHMARK_EXPANDED,    //cubic in its expanded form, with the acceleration coefficients (before TrajectorySegment)
+    TEST_SEGMENT_BENCHMARK_HORNER,      //Ros_MotionControl_ComputeSegment + Ros_MotionControl_EvaluateSegment
+    TEST_SEGMENT_BENCHMARK_FIXED_POINT, //Ros_MotionControl_ComputePulseSegment + Ros_MotionControl_EvaluatePulseSegment
+    TEST_SEGMENT_BENCHMARK_NUM_METHODS
+} SegmentBenchmarkMethod;
+
+//-------------------------------------------------------------------
+// Generate the pulse positions of all cycles of all segments of numGroup
+// groups with one of the methods. Returns the sum of all pulse positions.
+//-------------------------------------------------------------------
+INT64 Ros_Testing_MotionControl_RunSegmentBenchmark(CtrlGroup* group, JointMotionData const points[TEST_SEGMENT_BENCHMARK_POINTS], int numGroup, SegmentBenchmarkMethod method)
+{
+    JointMotionData start, end;
+    TrajectorySegment segment;
+    PulseSegment pulseSegment;
+    double accCoef1[MP_GRP_AXES_NUM];
+    double accCoef2[MP_GRP_AXES_NUM];
+    double pos[MP_GRP_AXES_NUM];
+    double vel[MP_GRP_AXES_NUM];
+    long pulsePos[MP_GRP_AXES_NUM];
+    double interval = (TEST_SEGMENT_BENCHMARK_CYCLES * TEST_LIMITS_INTERPOL_PERIOD) / 1000.0;
+    INT64 checksum = 0;
+    int groupIndex, segmentIndex, cycle, axis;
+
+    for (groupIndex = 0; groupIndex < numGroup; groupIndex += 1)
+    {
+        for (segmentIndex = 0; segmentIndex < TEST_SEGMENT_BENCHMARK_SEGMENTS; segmentIndex += 1)
+        {
+            start = points[(groupIndex + segmentIndex) % TEST_SEGMENT_BENCHMARK_POINTS];
+            end = points[(groupIndex + segmentIndex + 1) % TEST_SEGMENT_BENCHMARK_POINTS];
+            start.time = 0;
+            end.time = TEST_SEGMENT_BENCHMARK_CYCLES * TEST_LIMITS_INTERPOL_PERIOD;
+
+            if (method == TEST_SEGMENT_BENCHMARK_EXPANDED)
+            {
+                for (axis = 0; axis < group->numAxes; axis += 1)
+                {
+                    accCoef1[axis] = (6 * (end.pos[axis] - start.pos[axis]) / (interval * interval))
+                        - (2 * (end.vel[axis] + 2 * start.vel[axis]) / interval);
+                    accCoef2[axis] = (-12 * (end.pos[axis] - start.pos[axis]) / (interval * interval * interval))
+                        + (6 * (end.vel[axis] + start.vel[axis]) / (interval * interval));
+                }
+            }
+            else
+            {
+                Ros_MotionControl_ComputeSegment(&start, &end, group->numAxes, FALSE, &segment);
+                if (method == TEST_SEGMENT_BENCHMARK_FIXED_POINT)
+                    Ros_MotionControl_ComputePulseSegment(group, &segment, interval, &pulseSegment);
+            }
+
+            for (cycle = 1; cycle <= TEST_SEGMENT_BENCHMARK_CYCLES; cycle += 1)
+            {
+                double t = (cycle * TEST_LIMITS_INTERPOL_PERIOD) / 1000.0;
+
+                if (method == TEST_SEGMENT_BENCHMARK_EXPANDED)
+                {
+                    bzero(pos, sizeof(pos));
+                    for (axis = 0; axis < group->numAxes; axis += 1)
+                    {
+                        pos[axis] = start.pos[axis] + start.vel[axis] * t + accCoef1[axis] * t * t / 2 + accCoef2[axis] * t * t * t / 6;
+                        vel[axis] = start.vel[axis] + accCoef1[axis] * t + accCoef2[axis] * t * t / 2;
+                    }
+                    Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(group, pos, pulsePos);
+                }
+                else if (method == TEST_SEGMENT_BENCHMARK_HORNER)
+                {
+                    Ros_MotionControl_EvaluateSegment(&segment, group->numAxes, t, pos, vel);
+                    Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(group, pos, pulsePos);
+                }
+                else
+                    Ros_MotionControl_EvaluatePulseSegment(&pulseSegment, t, pulsePos);
+
+                for (axis = 0; axis < group->numAxes; axis += 1)
+                    checksum += pulsePos[axis];
+            }
+        }
+    }
+
+    return checksum;
+}
+
+//-------------------------------------------------------------------
+// Compare the increments per second of the ways the AddToIncQueue task
+// can evaluate the cubic segments, for numGroup groups
+//-------------------------------------------------------------------
+BOOL Ros_Testing_MotionControl_SegmentBenchmark(int numGroup)
+{
+    const char* methodNames[TEST_SEGMENT_BENCHMARK_NUM_METHODS] = { "expanded", "horner", "fixed-point" };
+    CtrlGroup group;
+    JointMotionData points[TEST_SEGMENT_BENCHMARK_POINTS];
+    INT64 checksum[TEST_SEGMENT_BENCHMARK_NUM_METHODS];
+    INT64 numIncrements = (INT64)numGroup * TEST_SEGMENT_BENCHMARK_SEGMENTS * TEST_SEGMENT_BENCHMARK_CYCLES;
+    INT64 maxChecksumDifference;
+    ULONG tickBefore, tickAfter;
+    BOOL bOk;
+    int method, i, axis;
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+    maxChecksumDifference = numIncrements * group.numAxes; //at most a pulse per axis and cycle
+
+    //a wave on each axis, at up to 1 rad/s
+    bzero(points, sizeof(points));
+    for (i = 0; i < TEST_SEGMENT_BENCHMARK_POINTS; i += 1)
+    {
+        for (axis = 0; axis < group.numAxes; axis += 1)
+        {
+            double angle = (0.1 * i) + axis;
+
+            points[i].pos[axis] = sin(angle);
+            points[i].vel[axis] = cos(angle);
+        }
+    }
+
+    for (method = 0; method < TEST_SEGMENT_BENCHMARK_NUM_METHODS; method += 1)
+    {
+        int elapsedMs;
+
+        tickBefore = tickGet();
+        checksum[method] = Ros_Testing_MotionControl_RunSegmentBenchmark(&group, points, numGroup, (SegmentBenchmarkMethod)method);
+        tickAfter = tickGet();
+
+        elapsedMs = (int)((tickAfter - tickBefore) * mpGetRtc());
+        Ros_Debug_BroadcastMsg("Testing MotionControl Segment - benchmark %d groups, %s: %lld increments in %d ms (%lld per second)",
+            numGroup, methodNames[method], numIncrements, elapsedMs, (numIncrements * 1000) / ((elapsedMs > 0) ? elapsedMs : 1));
+    }
+
+    //all methods must generate the same pulses, up to the rounding
+    bOk = TRUE;
+    for (method = 1; method < TEST_SEGMENT_BENCHMARK_NUM_METHODS; method += 1)
+    {
+        INT64 difference = checksum[method] - checksum[method - 1];
+        bOk &= (difference <= maxChecksumDifference) && (-difference <= maxChecksumDifference);
+    }
+    Ros_Debug_BroadcastMsg("Testing MotionControl Segment - benchmark %d groups: %s", numGroup, bOk ? "PASS" : "FAIL");
+
+    return bOk;
+}
+
+BOOL Ros_Testing_MotionControl_SparseTrajectory()
+{
+    CtrlGroup group;
+    CtrlGroup* groups[1] = { &group };
+    trajectory_msgs__msg__JointTrajectoryPoint points[TEST_SPARSE_NUM_POINTS];
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence sequence;
+    TrajectoryLimitViolation violation;
+    Init_Trajectory_Status status;
+    double pos[TEST_SPARSE_NUM_POINTS][MP_GRP_AXES_NUM];
+    double vel[TEST_SPARSE_NUM_POINTS][MP_GRP_AXES_NUM];
+    double acc[TEST_SPARSE_NUM_POINTS][MP_GRP_AXES_NUM];
+    static const double waypoints[TEST_SPARSE_NUM_POINTS] = { 0.0, 0.5, 1.0, 0.2, 0.2 };
+    double speedLimit = TEST_LIMITS_MAX_INC * 1000.0 / TEST_LIMITS_INTERPOL_PERIOD / TEST_LIMITS_PULSE_PER_RAD;
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int i, axis;
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+
+    //the first axis moves between the waypoints, the others move less
+    bzero(vel, sizeof(vel));
+    bzero(acc, sizeof(acc));
+    for (i = 0; i < TEST_SPARSE_NUM_POINTS; i += 1)
+    {
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            pos[i][axis] = waypoints[i] / (axis + 1);
+
+        //position-only, but the memory is allocated for all axes (same as the FJT goal)
+        Ros_Testing_MotionControl_SetPoint(&points[i], pos[i], vel[i], acc[i], 0);
+        points[i].velocities.size = 0;
+        points[i].accelerations.capacity = 6;
+    }
+    sequence.data = points;
+    sequence.size = sequence.capacity = TEST_SPARSE_NUM_POINTS;
+
+    //the timing of the client is left untouched, if it specified one for some of the waypoints
+    Ros_Millis_To_Duration_Msg(500, &points[2].time_from_start);
+    status = Ros_MotionControl_TimeParameterizeTrajectory(groups, 1, 6, &sequence, TEST_LIMITS_INTERPOL_PERIOD, TRUE);
+    bOk = (status == INIT_TRAJ_INVALID_TIME) && Ros_MotionControl_IsSparseTrajectory(&sequence);
+    bOk &= (Ros_Duration_Msg_To_Millis(&points[1].time_from_start) == 0) && (Ros_Duration_Msg_To_Millis(&points[2].time_from_start) == 500);
+    Ros_Millis_To_Duration_Msg(0, &points[2].time_from_start);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SparseTrajectory - mixed timing: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //there must be room for the computed velocities
+    points[3].velocities.capacity = 0;
+    status = Ros_MotionControl_TimeParameterizeTrajectory(groups, 1, 6, &sequence, TEST_LIMITS_INTERPOL_PERIOD, TRUE);
+    bOk = (status == INIT_TRAJ_INSUFFICIENT_WAYPOINT_MEMORY) && Ros_MotionControl_IsSparseTrajectory(&sequence);
+    points[3].velocities.capacity = 6;
+    Ros_Debug_BroadcastMsg("Testing MotionControl SparseTrajectory - memory: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    bOk = Ros_MotionControl_IsSparseTrajectory(&sequence);
+    status = Ros_MotionControl_TimeParameterizeTrajectory(groups, 1, 6, &sequence, TEST_LIMITS_INTERPOL_PERIOD, TRUE);
+    bOk &= (status == INIT_TRAJ_OK) && !Ros_MotionControl_IsSparseTrajectory(&sequence);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SparseTrajectory - accepted: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the first segment can't be faster than a minimum-jerk motion at the speed limit
+    bOk = (Ros_Duration_Msg_To_Millis(&points[0].time_from_start) == 0);
+    bOk &= (Ros_Duration_Msg_To_Millis(&points[1].time_from_start) >= (INT64)(1000.0 * 1.875 * 0.5 / (speedLimit * SPARSE_TRAJECTORY_SPEED_RATIO)));
+    for (i = 1; i < TEST_SPARSE_NUM_POINTS; i += 1)
+        bOk &= (Ros_Duration_Msg_To_Millis(&points[i].time_from_start) > Ros_Duration_Msg_To_Millis(&points[i - 1].time_from_start));
+    Ros_Debug_BroadcastMsg("Testing MotionControl SparseTrajectory - timing: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the robot doesn't stop at the first waypoint in between, but it does where the axes reverse, and at the end
+    bOk = (vel[1][0] > 0.0) && (vel[1][0] <= speedLimit) && (vel[1][5] > 0.0);
+    bOk &= (vel[0][0] == 0.0) && (vel[2][0] == 0.0) && (vel[3][0] == 0.0) && (vel[4][0] == 0.0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SparseTrajectory - velocities: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    status = Ros_MotionControl_ValidateTrajectoryLimits(&group, &sequence, TEST_LIMITS_INTERPOL_PERIOD, TRUE, &violation);
+    bOk = (status == INIT_TRAJ_OK);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SparseTrajectory - limits: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_SpeedScaleRamp()
+{
+    SpeedScaleRamp ramp;
+    double stepPerCycle = 0.01;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    //slowing down from full speed to half speed, starting at cycle 100
+    ramp.startScale = 1.0;
+    ramp.targetScale = 0.5;
+    ramp.startCycle = 100;
+
+    bOk = Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 0, stepPerCycle), 1.0);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 100, stepPerCycle), 1.0);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 125, stepPerCycle), 0.75);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 150, stepPerCycle), 0.5);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 1000, stepPerCycle), 0.5);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SpeedScaleRamp - down: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //speeding up from a hold
+    ramp.startScale = 0.0;
+    ramp.targetScale = 1.0;
+    ramp.startCycle = 0;
+
+    bOk = Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 0, stepPerCycle), 0.0);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 30, stepPerCycle), 0.3);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 100, stepPerCycle), 1.0);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 200, stepPerCycle), 1.0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SpeedScaleRamp - up: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the cycle counter wraps around
+    ramp.startScale = 1.0;
+    ramp.targetScale = 0.0;
+    ramp.startCycle = 0xFFFFFFF0;
+
+    bOk = Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 0xFFFFFFE0, stepPerCycle), 1.0);
+    bOk &= Ros_Testing_CompareDouble(Ros_MotionControl_EvaluateSpeedScaleRamp(&ramp, 0x00000010, stepPerCycle), 0.68);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SpeedScaleRamp - wrap around: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_SpeedScalePublish()
+{
+    SpeedScaleRamp written = { 0.25, 0.75, 1234 };
+    SpeedScaleRamp read;
+    UINT32 sequence;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    Ros_MotionControl_InitSpeedScale();
+
+    //an update leaves the sequence even, and readers see the complete ramp
+    sequence = Ros_MotionControl_SpeedScaleSequence;
+    mpSemTake(Ros_MotionControl_SpeedScaleLock, WAIT_FOREVER);
+    Ros_MotionControl_WriteSpeedScaleRamp(&written);
+    mpSemGive(Ros_MotionControl_SpeedScaleLock);
+    Ros_MotionControl_ReadSpeedScaleRamp(&read);
+    bOk = (Ros_MotionControl_SpeedScaleSequence == sequence + 2) && !(Ros_MotionControl_SpeedScaleSequence & 1);
+    bOk &= Ros_Testing_CompareDouble(read.startScale, 0.25) && Ros_Testing_CompareDouble(read.targetScale, 0.75) && (read.startCycle == 1234);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SpeedScalePublish - read: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //an update which never completes (odd sequence) makes the reader fall back to the lock, instead of spinning
+    Ros_MotionControl_SpeedScaleSequence += 1;
+    bzero(&read, sizeof(read));
+    Ros_MotionControl_ReadSpeedScaleRamp(&read);
+    Ros_MotionControl_SpeedScaleSequence += 1;
+    bOk = Ros_Testing_CompareDouble(read.targetScale, 0.75) && (read.startCycle == 1234);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SpeedScalePublish - interrupted update: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    Ros_MotionControl_CleanupSpeedScale();
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_SampleTrajectory()
+{
+    CtrlGroup group;
+    trajectory_msgs__msg__JointTrajectoryPoint points[3];
+    trajectory_msgs__msg__JointTrajectoryPoint__Sequence sequence;
+    JointMotionData sample;
+    double pos[3][MP_GRP_AXES_NUM];
+    double vel[3][MP_GRP_AXES_NUM];
+    double acc[MP_GRP_AXES_NUM];
+    BOOL bOk, bAllTestsPassed = TRUE;
+    int i, axis;
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+
+    //start and end at rest, passing through the middle point at 1 rad/s
+    bzero(acc, sizeof(acc));
+    for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+    {
+        pos[0][axis] = 0.0;
+        vel[0][axis] = 0.0;
+        pos[1][axis] = 0.1;
+        vel[1][axis] = 1.0;
+        pos[2][axis] = 0.3;
+        vel[2][axis] = 0.0;
+    }
+    for (i = 0; i < 3; i += 1)
+        Ros_Testing_MotionControl_SetPoint(&points[i], pos[i], vel[i], acc, i * 100);
+    sequence.data = points;
+    sequence.size = sequence.capacity = 3;
+
+    //at a point, the sample is the point itself
+    bOk = Ros_MotionControl_SampleTrajectory(&group, &sequence, 100, FALSE, &sample);
+    bOk &= (sample.time == 100);
+    for (axis = 0; axis < group.numAxes; axis += 1)
+        bOk &= Ros_Testing_CompareDouble(sample.pos[axis], 0.1) && Ros_Testing_CompareDouble(sample.vel[axis], 1.0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SampleTrajectory - point: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //halfway through the first segment (p = 20t^2 - 100t^3)
+    bOk = Ros_MotionControl_SampleTrajectory(&group, &sequence, 50, FALSE, &sample);
+    for (axis = 0; axis < group.numAxes; axis += 1)
+        bOk &= Ros_Testing_CompareDouble(sample.pos[axis], 0.0375) && Ros_Testing_CompareDouble(sample.vel[axis], 1.25);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SampleTrajectory - segment: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //outside of the trajectory
+    bOk = !Ros_MotionControl_SampleTrajectory(&group, &sequence, -1, FALSE, &sample);
+    bOk &= !Ros_MotionControl_SampleTrajectory(&group, &sequence, 201, FALSE, &sample);
+    bOk &= Ros_MotionControl_SampleTrajectory(&group, &sequence, 200, FALSE, &sample) && Ros_Testing_CompareDouble(sample.pos[0], 0.3);
+    Ros_Debug_BroadcastMsg("Testing MotionControl SampleTrajectory - range: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+#define TEST_PULSE_SEGMENT_COUNT        2000
+#define TEST_PULSE_SEGMENT_MAX_CYCLES   250     // up to 1 s per segment
+
+BOOL Ros_Testing_MotionControl_PulseSegment()
+{
+    CtrlGroup group;
+    JointMotionData start, end;
+    TrajectorySegment segment;
+    PulseSegment pulseSegment;
+    double pos[MP_GRP_AXES_NUM];
+    double vel[MP_GRP_AXES_NUM];
+    long expectedPulsePos[MP_GRP_AXES_NUM];
+    long pulsePos[MP_GRP_AXES_NUM];
+    BOOL bOk, bAllTestsPassed = TRUE;
+    double interval = 0.5;
+    double t;
+    int axis, quintic;
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&group);
+    group.axisType.type[5] = AXIS_LINEAR;
+    group.pulseToMeter.PtoM[5] = 1000000.0;
+    Ros_CtrlGroup_InitJointTransform(&group);
+
+    bzero(&start, sizeof(start));
+    bzero(&end, sizeof(end));
+
+    start.time = 1000;
+    end.time = 1500;
+    for (axis = 0; axis < group.numAxes; axis += 1)
+    {
+        start.pos[axis] = 0.3 * axis - 0.7;
+        start.vel[axis] = 0.2 - (0.1 * axis);
+        start.acc[axis] = 1.5 - (0.6 * axis);
+        end.pos[axis] = 0.4 - (0.25 * axis);
+        end.vel[axis] = 0.1 * axis - 0.3;
+        end.acc[axis] = 0.5 * axis - 1.0;
+    }
+
+    //the fixed-point evaluation must match the floating point evaluation (and conversion) to within one pulse,
+    //also at times which are not a multiple of the interpolation period (speed scaling)
+    for (quintic = 0; quintic <= 1; quintic += 1)
+    {
+        Ros_MotionControl_ComputeSegment(&start, &end, group.numAxes, quintic, &segment);
+        bOk = Ros_MotionControl_ComputePulseSegment(&group, &segment, interval, &pulseSegment);
+
+        for (t = 0.0; bOk && t <= interval; t += 0.0013)
+        {
+            Ros_MotionControl_EvaluateSegment(&segment, group.numAxes, t, pos, vel);
+            Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(&group, pos, expectedPulsePos);
+            Ros_MotionControl_EvaluatePulseSegment(&pulseSegment, t, pulsePos);
+
+            for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+                bOk &= (labs(pulsePos[axis] - expectedPulsePos[axis]) <= 1);
+        }
+
+        //end of the segment
+        Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(&group, end.pos, expectedPulsePos);
+        Ros_MotionControl_EvaluatePulseSegment(&pulseSegment, interval, pulsePos);
+        for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+            bOk &= (labs(pulsePos[axis] - expectedPulsePos[axis]) <= 1);
+
+        Ros_Debug_BroadcastMsg("Testing MotionControl PulseSegment - %s: %s", quintic ? "quintic" : "cubic", bOk ? "PASS" : "FAIL");
+        bAllTestsPassed &= bOk;
+    }
+
+    //a long chain of pseudo-random segments, evaluated every interpolation cycle like the AddToIncQueue
+    //task does: the fixed-point positions never deviate by more than one pulse
+    for (quintic = 0; quintic <= 1; quintic += 1)
+    {
+        UINT32 random = 2024;
+        long maxDeviation = 0;
+        int segmentIndex, cycle, cycles;
+
+        bzero(&end, sizeof(end));
+        bOk = TRUE;
+        for (segmentIndex = 0; bOk && segmentIndex < TEST_PULSE_SEGMENT_COUNT; segmentIndex += 1)
+        {
+            start = end;
+            random = random * 1103515245 + 12345;
+            cycles = 1 + ((random >> 8) % TEST_PULSE_SEGMENT_MAX_CYCLES);
+            end.time = start.time + (cycles * TEST_LIMITS_INTERPOL_PERIOD);
+            for (axis = 0; axis < group.numAxes; axis += 1)
+            {
+                double maxSpeed = group.maxSpeed[axis] > 0.0 ? group.maxSpeed[axis] : 1.0;
+                double fraction;
+
+                random = random * 1103515245 + 12345;
+                fraction = (double)((random >> 8) % 20001) / 10000.0 - 1.0;   //-1.0 to 1.0
+                end.vel[axis] = fraction * maxSpeed;
+                end.pos[axis] = start.pos[axis] + ((start.vel[axis] + end.vel[axis]) / 2.0) * (end.time - start.time) / 1000.0;
+                end.acc[axis] = fraction * 10.0;
+            }
+
+            interval = (end.time - start.time) / 1000.0;
+            Ros_MotionControl_ComputeSegment(&start, &end, group.numAxes, quintic, &segment);
+            bOk = Ros_MotionControl_ComputePulseSegment(&group, &segment, interval, &pulseSegment);
+
+            for (cycle = 1; bOk && cycle <= cycles; cycle += 1)
+            {
+                t = (cycle * TEST_LIMITS_INTERPOL_PERIOD) / 1000.0;
+                Ros_MotionControl_EvaluateSegment(&segment, group.numAxes, t, pos, vel);
+                Ros_CtrlGroup_ConvertRosUnitsToMotoUnits(&group, pos, expectedPulsePos);
+                Ros_MotionControl_EvaluatePulseSegment(&pulseSegment, t, pulsePos);
+
+                for (axis = 0; axis < MP_GRP_AXES_NUM; axis += 1)
+                {
+                    if (labs(pulsePos[axis] - expectedPulsePos[axis]) > maxDeviation)
+                        maxDeviation = labs(pulsePos[axis] - expectedPulsePos[axis]);
+                }
+            }
+        }
+        bOk &= (maxDeviation <= 1);
+
+        Ros_Debug_BroadcastMsg("Testing MotionControl PulseSegment - %d %s segments (max deviation: %ld pulses): %s",
+            TEST_PULSE_SEGMENT_COUNT, quintic ? "quintic" : "cubic", maxDeviation, bOk ? "PASS" : "FAIL");
+        bAllTestsPassed &= bOk;
+    }
+
+    //segments which can't be represented are left to the floating point evaluation
+    interval = 0.5;
+    start.time = 1000;
+    end.time = 1500;
+    for (axis = 0; axis < group.numAxes; axis += 1)
+    {
+        start.pos[axis] = 0.3 * axis - 0.7;
+        end.pos[axis] = 0.4 - (0.25 * axis);
+    }
+    Ros_MotionControl_ComputeSegment(&start, &end, group.numAxes, FALSE, &segment);
+    bOk = !Ros_MotionControl_ComputePulseSegment(&group, &segment, 0.0, &pulseSegment);
+    end.pos[0] = start.pos[0] + (2.0 * PULSE_SEGMENT_MAX_RANGE / TEST_LIMITS_PULSE_PER_RAD);
+    Ros_MotionControl_ComputeSegment(&start, &end, group.numAxes, FALSE, &segment);
+    bOk &= !Ros_MotionControl_ComputePulseSegment(&group, &segment, interval, &pulseSegment);
+    Ros_Debug_BroadcastMsg("Testing MotionControl PulseSegment - fallback: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_RawIncrements()
+{
+    CtrlGroup groupA, groupB;
+    CtrlGroup* groups[2] = { &groupA, &groupB };
+    int32_t data[RAW_STREAMING_MAX_CYCLES_PER_MSG * 2 * MP_GRP_AXES_NUM];
+    int sizePerCycle = 2 * MP_GRP_AXES_NUM;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&groupA);
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&groupB);
+
+    //increments at the limit of each (existing) axis, alternating in direction
+    for (int index = 0; index < (int)(sizeof(data) / sizeof(data[0])); index += 1)
+    {
+        int axis = index % MP_GRP_AXES_NUM;
+        data[index] = (axis < groupA.numAxes) ? ((index % 2) ? TEST_LIMITS_MAX_INC : -TEST_LIMITS_MAX_INC) : 0;
+    }
+
+    bOk = (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, sizePerCycle) == RAW_INCREMENTS_OK);
+    bOk &= (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, sizeof(data) / sizeof(data[0])) == RAW_INCREMENTS_OK);
+    Ros_Debug_BroadcastMsg("Testing MotionControl RawIncrements - valid: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //partial cycles, no cycles and too many cycles
+    bOk = (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, sizePerCycle - 1) == RAW_INCREMENTS_INVALID_SIZE);
+    bOk &= (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, 0) == RAW_INCREMENTS_INVALID_SIZE);
+    bOk &= (Ros_MotionControl_ValidateRawIncrements(groups, 1, data, (RAW_STREAMING_MAX_CYCLES_PER_MSG + 1) * MP_GRP_AXES_NUM) == RAW_INCREMENTS_INVALID_SIZE);
+    Ros_Debug_BroadcastMsg("Testing MotionControl RawIncrements - size: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //exceeding maxInc of an axis of the second group in the last cycle, and moving an axis which doesn't exist
+    data[sizeof(data) / sizeof(data[0]) - MP_GRP_AXES_NUM + 2] = -(TEST_LIMITS_MAX_INC + 1);
+    bOk = (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, sizeof(data) / sizeof(data[0])) == RAW_INCREMENTS_EXCEEDS_MAX_INC);
+    bOk &= (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, sizePerCycle) == RAW_INCREMENTS_OK);
+    data[MP_GRP_AXES_NUM - 1] = 1;
+    bOk &= (Ros_MotionControl_ValidateRawIncrements(groups, 2, data, sizePerCycle) == RAW_INCREMENTS_EXCEEDS_MAX_INC);
+    Ros_Debug_BroadcastMsg("Testing MotionControl RawIncrements - maxInc: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+#define TEST_INC_QUEUE_REFILL_LATENCY   12      //cycles the producer takes to refill the queue after it was woken up
+#define TEST_INC_QUEUE_SIM_CYCLES       2000
+
+typedef struct
+{
+    CtrlGroup group;
+    int count;                  //increments in the queue of the group
+    int refillLatency;          //cycles
+    int refillCountdown;        //cycles until the producer has refilled the queue (0 while it waits for a signal)
+    int emptyCycles;            //cycles in which the queue was empty when it was read
+} IncQueueSimulation;
+
+void Ros_Testing_MotionControl_InitIncQueueSimulation(IncQueueSimulation* sim, int depth, int refillLatency)
+{
+    bzero(sim, sizeof(IncQueueSimulation));
+    Ros_Testing_MotionControl_MakeFakeLimitedGroup(&sim->group);
+
+    sim->group.incQueueDepth = depth;
+    sim->group.incQueueRefillWait = -1;
+    sim->group.incQueueStats.minFill = -1;
+    sim->group.hasDataToProcess = TRUE;
+
+    //the producer has filled the queue before the trajectory is started
+    sim->count = depth;
+    sim->refillLatency = refillLatency;
+}
+
+//-------------------------------------------------------------------
+// Reads the increment queue of a group for a number of cycles, like the
+// IncMoveTask does: one increment per cycle, and the producer is woken up
+// when the queue is drained down to the low watermark (or when the adaptive
+// depth asks for it). The producer then takes 'refillLatency' cycles to
+// fill the queue up to the high watermark.
+//-------------------------------------------------------------------
+void Ros_Testing_MotionControl_SimulateIncQueue(IncQueueSimulation* sim, int numCycles)
+{
+    for (int cycle = 0; cycle < numCycles; cycle += 1)
+    {
+        BOOL bSignaled;
+
+        if (sim->refillCountdown > 0)
+        {
+            sim->refillCountdown -= 1;
+            if (sim->refillCountdown == 0 && sim->group.hasDataToProcess && sim->count < Q_HIGH_WATERMARK(&sim->group))
+                sim->count = Q_HIGH_WATERMARK(&sim->group);
+        }
+
+        Ros_MotionControl_UpdateIncQueueStats(&sim->group.incQueueStats, sim->count, sim->group.hasDataToProcess);
+
+        if (sim->count > 0)
+        {
+            sim->count -= 1;
+            bSignaled = (sim->count == Q_LOW_WATERMARK(&sim->group));
+            if (Ros_MotionControl_TrackIncQueueRefill(&sim->group, sim->count + 1, sim->count, bSignaled))
+                bSignaled = TRUE;
+        }
+        else
+        {
+            sim->emptyCycles += 1;
+            bSignaled = Ros_MotionControl_TrackIncQueueRefill(&sim->group, 0, 0, FALSE);
+        }
+
+        if (bSignaled && sim->refillCountdown == 0)
+            sim->refillCountdown = sim->refillLatency;
+    }
+}
+
+BOOL Ros_Testing_MotionControl_AdaptiveIncQueueDepth()
+{
+    BOOL bAllTestsPassed = TRUE;
+    BOOL bOk;
+    int latencyPeak = 0;
+    Ros_Configuration_Settings savedSettings;
+    IncQueueSimulation sim;
+    int underrunCount, emptyCycles;
+
+    //fast refills keep the queue at the minimum depth
+    bOk = (Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&latencyPeak, 1, Q_SIZE) == MIN_INCREMENT_QUEUE_DEPTH);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - minimum: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a slow refill is followed immediately
+    bOk = (Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&latencyPeak, 32, Q_SIZE) == 32 * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR);
+    bOk &= (latencyPeak == 32);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - rise: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //faster refills only let the peak decay slowly
+    bOk = (Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&latencyPeak, 1, Q_SIZE) == 30 * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR);
+    bOk &= (Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&latencyPeak, 1, Q_SIZE) == 29 * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - decay: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the depth never exceeds the configured depth
+    bOk = (Ros_MotionControl_ComputeAdaptiveIncQueueDepth(&latencyPeak, Q_SIZE, 200) == 200);
+    bOk &= (latencyPeak == Q_SIZE);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - maximum: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the depth is only adapted while adaptive_increment_queue_depth is enabled
+    savedSettings = g_nodeConfigSettings;
+    g_nodeConfigSettings.increment_queue_depth_trajectory = DEFAULT_INCREMENT_QUEUE_DEPTH;
+
+    //a producer which takes longer to refill the queue than it takes to drain it from the low watermark lets the
+    //queue run empty. A fixed depth keeps running into underruns.
+    g_nodeConfigSettings.adaptive_increment_queue_depth = FALSE;
+    Ros_Testing_MotionControl_InitIncQueueSimulation(&sim, MIN_INCREMENT_QUEUE_DEPTH, TEST_INC_QUEUE_REFILL_LATENCY);
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES);
+    bOk = (sim.group.incQueueDepth == MIN_INCREMENT_QUEUE_DEPTH);
+    bOk &= (sim.group.incQueueStats.underrunCount > TEST_INC_QUEUE_SIM_CYCLES / (2 * TEST_INC_QUEUE_REFILL_LATENCY));
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - fixed depth: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the adaptive depth is raised after the first underruns, until the producer refills the queue in time
+    g_nodeConfigSettings.adaptive_increment_queue_depth = TRUE;
+    Ros_Testing_MotionControl_InitIncQueueSimulation(&sim, MIN_INCREMENT_QUEUE_DEPTH, TEST_INC_QUEUE_REFILL_LATENCY);
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES / 10);
+    bOk = (sim.group.incQueueStats.underrunCount > 0);
+    bOk &= (sim.group.incQueueDepth == TEST_INC_QUEUE_REFILL_LATENCY * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR);
+    underrunCount = sim.group.incQueueStats.underrunCount;
+    emptyCycles = sim.emptyCycles;
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES);
+    bOk &= (sim.emptyCycles == emptyCycles) && (sim.group.incQueueStats.underrunCount == underrunCount);
+    bOk &= (sim.group.incQueueDepth == TEST_INC_QUEUE_REFILL_LATENCY * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - underrun: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the queue draining at the end of the trajectory is not taken as a slow refill
+    sim.group.hasDataToProcess = FALSE;
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES / 10);
+    bOk = (sim.count == 0) && (sim.group.incQueueStats.underrunCount == underrunCount);
+    bOk &= (sim.group.incQueueDepth == TEST_INC_QUEUE_REFILL_LATENCY * ADAPTIVE_INC_QUEUE_DEPTH_FACTOR);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - drain: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the depth is limited to the configured depth, even if the queue keeps running empty
+    g_nodeConfigSettings.increment_queue_depth_trajectory = MIN_INCREMENT_QUEUE_DEPTH + 2;
+    Ros_Testing_MotionControl_InitIncQueueSimulation(&sim, MIN_INCREMENT_QUEUE_DEPTH, TEST_INC_QUEUE_REFILL_LATENCY);
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES);
+    bOk = (sim.group.incQueueDepth == MIN_INCREMENT_QUEUE_DEPTH + 2);
+    bOk &= (sim.group.incQueueStats.underrunCount > TEST_INC_QUEUE_SIM_CYCLES / (2 * TEST_INC_QUEUE_REFILL_LATENCY));
+    Ros_Debug_BroadcastMsg("Testing MotionControl AdaptiveIncQueueDepth - configured depth: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    g_nodeConfigSettings = savedSettings;
+
+    return bAllTestsPassed;
+}
+
+#define TEST_TIMING_TICKS_PER_US        50
+
+BOOL Ros_Testing_MotionControl_IncMoveTiming()
+{
+    BOOL bAllTestsPassed = TRUE;
+    BOOL bOk;
+    IncMoveTimingHistogram histogram;
+    IncMoveTimingHistogram const* wakeJitter = Ros_IncMoveTiming_GetHistogram(INC_MOVE_TIMING_WAKE_JITTER);
+    IncMoveTimingHistogram const* readQueue = Ros_IncMoveTiming_GetHistogram(INC_MOVE_TIMING_READ_QUEUE);
+    const int wakeDeviationUs[] = { 0, 3, -3, 100 };
+    UINT16 savedInterpolPeriod;
+    UINT64 periodTicks, ts;
+
+    //power-of-two buckets, the last one is open-ended
+    bOk = (Ros_IncMoveTiming_BucketIndex(0) == 0);
+    bOk &= (Ros_IncMoveTiming_BucketIndex(1) == 1);
+    bOk &= (Ros_IncMoveTiming_BucketIndex(2) == 2) && (Ros_IncMoveTiming_BucketIndex(3) == 2);
+    bOk &= (Ros_IncMoveTiming_BucketIndex(4000) == 12);
+    bOk &= (Ros_IncMoveTiming_BucketIndex(0xFFFFFFFF) == INC_MOVE_TIMING_NUM_BUCKETS - 1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - buckets: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    bzero(&histogram, sizeof(histogram));
+    Ros_IncMoveTiming_AddSample(&histogram, 5);
+    Ros_IncMoveTiming_AddSample(&histogram, 7);
+    Ros_IncMoveTiming_AddSample(&histogram, 100000);
+    bOk = (histogram.count == 3) && (histogram.max_us == 100000);
+    bOk &= (histogram.buckets[3] == 2) && (histogram.buckets[INC_MOVE_TIMING_NUM_BUCKETS - 1] == 1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - samples: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the cycles of the increment-move task are timed with synthetic timestamps (the calibration is discarded
+    //afterwards, so the task calibrates against the real timestamp counter)
+    savedInterpolPeriod = g_Ros_Controller.interpolPeriod;
+    g_Ros_Controller.interpolPeriod = TEST_LIMITS_INTERPOL_PERIOD;
+    periodTicks = TEST_LIMITS_INTERPOL_PERIOD * 1000 * TEST_TIMING_TICKS_PER_US;
+    Ros_IncMoveTiming_ResetCalibration();
+    Ros_IncMoveTiming_TaskStart();
+
+    //nothing is recorded until the timestamp counter has been calibrated against the interpolation clock
+    ts = periodTicks;
+    for (int cycle = 0; cycle < INC_MOVE_TIMING_CALIBRATION_CYCLES; cycle += 1)
+    {
+        Ros_IncMoveTiming_StartCycle(ts);
+        Ros_IncMoveTiming_Record(INC_MOVE_TIMING_READ_QUEUE, ts, ts + 10 * TEST_TIMING_TICKS_PER_US);
+        ts += periodTicks;
+    }
+    bOk = (wakeJitter->count == 0) && (readQueue->count == 0);
+    Ros_IncMoveTiming_StartCycle(ts);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - calibration: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the wake jitter is the deviation of the time between two wake-ups from the interpolation period
+    for (int i = 0; i < (int)(sizeof(wakeDeviationUs) / sizeof(wakeDeviationUs[0])); i += 1)
+    {
+        ts += periodTicks + wakeDeviationUs[i] * TEST_TIMING_TICKS_PER_US;
+        Ros_IncMoveTiming_StartCycle(ts);
+    }
+    bOk = (wakeJitter->count == 4) && (wakeJitter->max_us == 100);
+    bOk &= (wakeJitter->buckets[0] == 1) && (wakeJitter->buckets[2] == 2) && (wakeJitter->buckets[7] == 1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - wake jitter: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a negative duration is recorded as 0 us
+    Ros_IncMoveTiming_Record(INC_MOVE_TIMING_READ_QUEUE, ts, ts + 250 * TEST_TIMING_TICKS_PER_US);
+    Ros_IncMoveTiming_Record(INC_MOVE_TIMING_READ_QUEUE, ts, ts - 1);
+    bOk = (readQueue->count == 2) && (readQueue->max_us == 250);
+    bOk &= (readQueue->buckets[0] == 1) && (readQueue->buckets[8] == 1);
+    bOk &= (Ros_IncMoveTiming_GetHistogram(INC_MOVE_TIMING_INC_MOVE)->count == 0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - phases: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a reset is carried out at the start of the next cycle
+    Ros_IncMoveTiming_RequestReset();
+    bOk = (wakeJitter->count == 4) && (readQueue->count == 2);
+    ts += periodTicks;
+    Ros_IncMoveTiming_StartCycle(ts);
+    bOk &= (wakeJitter->count == 1) && (wakeJitter->buckets[0] == 1) && (wakeJitter->max_us == 0);
+    bOk &= (readQueue->count == 0) && (readQueue->buckets[8] == 0) && (readQueue->max_us == 0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - reset: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the calibration is kept when the task is restarted, but the time it was stopped isn't taken as jitter
+    Ros_IncMoveTiming_TaskStart();
+    ts += 100 * periodTicks;
+    Ros_IncMoveTiming_StartCycle(ts);
+    Ros_IncMoveTiming_Record(INC_MOVE_TIMING_READ_QUEUE, ts, ts + 10 * TEST_TIMING_TICKS_PER_US);
+    bOk = (wakeJitter->count == 0) && (readQueue->count == 1) && (readQueue->buckets[4] == 1);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncMoveTiming - restart: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    Ros_IncMoveTiming_ResetCalibration();
+    Ros_IncMoveTiming_TaskStart();
+    g_Ros_Controller.interpolPeriod = savedInterpolPeriod;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_IncQueueStats()
+{
+    BOOL bAllTestsPassed = TRUE;
+    BOOL bOk;
+    IncQueueStats stats;
+    BOOL savedAdaptive;
+    IncQueueSimulation sim;
+    int lateCycles, underrunCount;
+
+    bzero(&stats, sizeof(stats));
+    stats.minFill = -1;
+
+    //an empty queue before the first increments were added is not an underrun
+    bOk = !Ros_MotionControl_UpdateIncQueueStats(&stats, 0, TRUE);
+    bOk &= !Ros_MotionControl_UpdateIncQueueStats(&stats, 20, TRUE);
+    bOk &= !Ros_MotionControl_UpdateIncQueueStats(&stats, 8, TRUE);
+    bOk &= (stats.minFill == 8) && (stats.underrunCount == 0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncQueueStats - fill: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //an underrun is counted once, and its length in cycles
+    bOk = Ros_MotionControl_UpdateIncQueueStats(&stats, 0, TRUE);
+    bOk &= !Ros_MotionControl_UpdateIncQueueStats(&stats, 0, TRUE);
+    bOk &= !Ros_MotionControl_UpdateIncQueueStats(&stats, 0, TRUE);
+    bOk &= !Ros_MotionControl_UpdateIncQueueStats(&stats, 5, TRUE);
+    bOk &= Ros_MotionControl_UpdateIncQueueStats(&stats, 0, TRUE);
+    bOk &= (stats.minFill == 0) && (stats.underrunCount == 2) && (stats.longestUnderrun == 3);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncQueueStats - underrun: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //draining at the end of the trajectory is not an underrun
+    bOk = !Ros_MotionControl_UpdateIncQueueStats(&stats, 0, FALSE);
+    bOk &= !Ros_MotionControl_UpdateIncQueueStats(&stats, 0, FALSE);
+    bOk &= (stats.underrunCount == 2) && (stats.longestUnderrun == 3) && (stats.currentUnderrun == 0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncQueueStats - drain: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    savedAdaptive = g_nodeConfigSettings.adaptive_increment_queue_depth;
+    g_nodeConfigSettings.adaptive_increment_queue_depth = FALSE;
+
+    //a producer which refills the queue in time doesn't cause underruns
+    Ros_Testing_MotionControl_InitIncQueueSimulation(&sim, MIN_INCREMENT_QUEUE_DEPTH, MIN_INCREMENT_QUEUE_DEPTH / 2 - 2);
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES);
+    bOk = (sim.emptyCycles == 0) && (sim.group.incQueueStats.underrunCount == 0) && (sim.group.incQueueStats.longestUnderrun == 0);
+    bOk &= (sim.group.incQueueStats.minFill > 0) && (sim.group.incQueueStats.minFill < MIN_INCREMENT_QUEUE_DEPTH / 2);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncQueueStats - in time: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a producer which is too slow lets the queue run empty after each refill, for the cycles it is late
+    Ros_Testing_MotionControl_InitIncQueueSimulation(&sim, MIN_INCREMENT_QUEUE_DEPTH, TEST_INC_QUEUE_REFILL_LATENCY);
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES);
+    lateCycles = TEST_INC_QUEUE_REFILL_LATENCY - MIN_INCREMENT_QUEUE_DEPTH / 2 - 1;
+    bOk = (sim.group.incQueueStats.minFill == 0) && (sim.group.incQueueStats.longestUnderrun == lateCycles);
+    bOk &= (sim.group.incQueueStats.underrunCount > 0) && (sim.emptyCycles >= sim.group.incQueueStats.underrunCount * lateCycles);
+    bOk &= (sim.emptyCycles < (sim.group.incQueueStats.underrunCount + 1) * lateCycles);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncQueueStats - late: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //once the producer has no more increments to add, the queue running empty is not counted
+    underrunCount = sim.group.incQueueStats.underrunCount;
+    sim.group.hasDataToProcess = FALSE;
+    Ros_Testing_MotionControl_SimulateIncQueue(&sim, TEST_INC_QUEUE_SIM_CYCLES / 10);
+    bOk = (sim.count == 0) && (sim.group.incQueueStats.underrunCount == underrunCount);
+    bOk &= (sim.group.incQueueStats.longestUnderrun == lateCycles) && (sim.group.incQueueStats.currentUnderrun == 0);
+    Ros_Debug_BroadcastMsg("Testing MotionControl IncQueueStats - end of trajectory: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    g_nodeConfigSettings.adaptive_increment_queue_depth = savedAdaptive;
+
+    return bAllTestsPassed;
+}
+
+typedef struct
+{
+    CtrlGroup* group;
+    volatile BOOL bWaiting;
+    volatile BOOL bDone;
+    volatile ULONG tickWoken;
+} AddToIncQueueWaiter;
+
+//-------------------------------------------------------------------
+// Task which waits for a signal like the AddToIncQueue task of a group
+//-------------------------------------------------------------------
+void Ros_Testing_MotionControl_AddToIncQueueWaiter(AddToIncQueueWaiter* waiter)
+{
+    waiter->bWaiting = TRUE;
+    Ros_MotionControl_WaitForSignal(waiter->group);
+    waiter->tickWoken = tickGet();
+    waiter->bDone = TRUE;
+    mpDeleteSelf;
+}
+
+BOOL Ros_Testing_MotionControl_AddToIncQueueSignal()
+{
+    CtrlGroup group;
+    AddToIncQueueWaiter waiter;
+    int timeoutTicks = ADD_TO_INC_Q_WAIT_TIMEOUT / mpGetRtc();
+    int elapsedTicks, tid;
+    ULONG tickStart;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    if (timeoutTicks < 1)
+        timeoutTicks = 1;
+
+    bzero(&group, sizeof(group));
+    group.semAddToIncQueue = mpSemBCreate(SEM_Q_FIFO, SEM_EMPTY);
+    if (group.semAddToIncQueue == NULL)
+    {
+        Ros_Debug_BroadcastMsg("Testing MotionControl AddToIncQueueSignal: FAIL (semaphore)");
+        return FALSE;
+    }
+
+    //a signal which is given while the task is busy isn't lost. Several signals are merged into one.
+    Ros_MotionControl_SignalAddToIncQueue(&group);
+    Ros_MotionControl_SignalAddToIncQueue(&group);
+    tickStart = tickGet();
+    Ros_MotionControl_WaitForSignal(&group);
+    bOk = ((int)(tickGet() - tickStart) < timeoutTicks);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AddToIncQueueSignal - pending: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //without a signal, the wait times out (so a HOLD or E-stop is noticed)
+    tickStart = tickGet();
+    Ros_MotionControl_WaitForSignal(&group);
+    elapsedTicks = (int)(tickGet() - tickStart);
+    bOk = (elapsedTicks >= timeoutTicks) && (elapsedTicks < 2 * timeoutTicks);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AddToIncQueueSignal - timeout: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a waiting task is woken up by the signal, not by the timeout
+    bzero(&waiter, sizeof(waiter));
+    waiter.group = &group;
+    tid = mpCreateTask(MP_PRI_TIME_NORMAL, MP_STACK_SIZE, (FUNCPTR)Ros_Testing_MotionControl_AddToIncQueueWaiter,
+                       (int)&waiter, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    bOk = (tid != ERROR);
+    while (bOk && !waiter.bWaiting)
+        mpTaskDelay(1);
+    mpTaskDelay(timeoutTicks / 4);
+    tickStart = tickGet();
+    Ros_MotionControl_SignalAddToIncQueue(&group);
+    for (elapsedTicks = 0; bOk && !waiter.bDone && elapsedTicks < 2 * timeoutTicks; elapsedTicks += 1)
+        mpTaskDelay(1);
+    if (bOk && !waiter.bDone)
+    {
+        mpDeleteTask(tid);
+        bOk = FALSE;
+    }
+    bOk &= ((int)(waiter.tickWoken - tickStart) < timeoutTicks / 2);
+    Ros_Debug_BroadcastMsg("Testing MotionControl AddToIncQueueSignal - wake up: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    mpSemDelete(group.semAddToIncQueue);
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl_JointNamesHash()
+{
+    rosidl_runtime_c__String__Sequence jnames;
+    const size_t NUM_JOINTS = 3;
+    char longName[MAX_JOINT_NAME_LENGTH + 8];
+    UINT64 hash;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    rosidl_runtime_c__String__Sequence__init(&jnames, NUM_JOINTS);
+    rosidl_runtime_c__String__assign(&jnames.data[0], "joint_1");
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_2");
+    rosidl_runtime_c__String__assign(&jnames.data[2], "joint_3");
+    hash = Ros_MotionControl_HashJointNames(&jnames);
+
+    //the mapping of the previous request is reused if the hash is the same, so it must only depend on the names
+    bOk = (Ros_MotionControl_HashJointNames(&jnames) == hash);
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_2");
+    bOk &= (Ros_MotionControl_HashJointNames(&jnames) == hash);
+    Ros_Debug_BroadcastMsg("Testing MotionControl JointNamesHash - same names: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_3");
+    rosidl_runtime_c__String__assign(&jnames.data[2], "joint_2");
+    bOk = (Ros_MotionControl_HashJointNames(&jnames) != hash);
+    Ros_Debug_BroadcastMsg("Testing MotionControl JointNamesHash - reordered: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the boundaries between the names are part of the hash
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_2joint_3");
+    rosidl_runtime_c__String__assign(&jnames.data[2], "");
+    bOk = (Ros_MotionControl_HashJointNames(&jnames) != hash);
+    Ros_Debug_BroadcastMsg("Testing MotionControl JointNamesHash - regrouped: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    rosidl_runtime_c__String__assign(&jnames.data[1], "joint_2");
+    rosidl_runtime_c__String__assign(&jnames.data[2], "joint_3");
+    jnames.size = 2;
+    bOk = (Ros_MotionControl_HashJointNames(&jnames) != hash);
+    jnames.size = NUM_JOINTS;
+    Ros_Debug_BroadcastMsg("Testing MotionControl JointNamesHash - subset: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //like the lookup, the characters past MAX_JOINT_NAME_LENGTH are not significant
+    memset(longName, 'a', sizeof(longName) - 1);
+    longName[sizeof(longName) - 1] = '\0';
+    rosidl_runtime_c__String__assign(&jnames.data[0], longName);
+    hash = Ros_MotionControl_HashJointNames(&jnames);
+    longName[MAX_JOINT_NAME_LENGTH] = 'b';
+    rosidl_runtime_c__String__assign(&jnames.data[0], longName);
+    bOk = (Ros_MotionControl_HashJointNames(&jnames) == hash);
+    longName[MAX_JOINT_NAME_LENGTH - 1] = 'b';
+    rosidl_runtime_c__String__assign(&jnames.data[0], longName);
+    bOk &= (Ros_MotionControl_HashJointNames(&jnames) != hash);
+    Ros_Debug_BroadcastMsg("Testing MotionControl JointNamesHash - long names: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    rosidl_runtime_c__String__Sequence__fini(&jnames);
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_MotionControl()
+{
+    BOOL bSuccess = TRUE;
+
+    bSuccess &= Ros_Testing_MotionControl_Segment();
+    bSuccess &= Ros_Testing_MotionControl_QuinticSegment();
+    bSuccess &= Ros_Testing_MotionControl_TrajectoryLimits();
+    bSuccess &= Ros_Testing_MotionControl_BaxisSlave();
+    bSuccess &= Ros_Testing_MotionControl_TrajectoryLimitsBenchmark();
+    bSuccess &= Ros_Testing_MotionControl_SegmentBenchmark(1);
+    bSuccess &= Ros_Testing_MotionControl_SegmentBenchmark(2);
+    bSuccess &= Ros_Testing_MotionControl_SegmentBenchmark(MAX_CONTROLLABLE_GROUPS);
+    bSuccess &= Ros_Testing_MotionControl_SparseTrajectory();
+    bSuccess &= Ros_Testing_MotionControl_SpeedScaleRamp();
+    bSuccess &= Ros_Testing_MotionControl_SpeedScalePublish();
+    bSuccess &= Ros_Testing_MotionControl_SampleTrajectory();
+    bSuccess &= Ros_Testing_MotionControl_PulseSegment();
+    bSuccess &= Ros_Testing_MotionControl_RawIncrements();
+    bSuccess &= Ros_Testing_MotionControl_AdaptiveIncQueueDepth();
+    bSuccess &= Ros_Testing_MotionControl_IncMoveTiming();
+    bSuccess &= Ros_Testing_MotionControl_IncQueueStats();
+    bSuccess &= Ros_Testing_MotionControl_AddToIncQueueSignal();
+    bSuccess &= Ros_Testing_MotionControl_JointNamesHash();
+
+    return bSuccess;
+}
+
+#endif //MOTOROS2_TESTING_ENABLE
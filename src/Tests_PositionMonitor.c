@@ -0,0 +1,324 @@
+// Tests_PositionMonitor.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(MOTOROS2_TESTING_ENABLE) && defined(MOTOROS2_INCLUDE_TESTS_POSITION_MONITOR_C)
+
+#include "MotoROS.h"
+
+static BOOL Ros_Testing_PositionMonitor_TransformInputs()
+{
+    CtrlGroup group;
+    CtrlGroup* savedGroup = g_Ros_Controller.ctrlGroups[0];
+    PositionMonitor_TransformInputs savedInputs = transformInputs[0];
+    long pulsePos[MAX_PULSE_AXES] = { 0 };
+    long pulsePosTrack[MAX_PULSE_AXES] = { 0 };
+    MP_COORD toolData;
+    UINT32 changed;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    bzero(&group, sizeof(CtrlGroup));
+    group.groupId = MP_R1_GID;
+    group.baseTrackGroupIndex = -1;
+    group.tool = 0;
+    g_Ros_Controller.ctrlGroups[0] = &group;
+
+    bzero(&transformInputs[0], sizeof(PositionMonitor_TransformInputs));
+    bzero(&toolData, sizeof(MP_COORD));
+    toolData.z = 100000;
+
+    //nothing was calculated yet
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == (TF_INPUTS_CHANGED_POSITION | TF_INPUTS_CHANGED_TOOL | TF_INPUTS_CHANGED_CALIBRATION));
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - first: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //standing still. The track position is not read for a group without a base track, so it's ignored.
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == 0);
+    pulsePosTrack[0] = 1234;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk &= (changed == 0);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - unchanged: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a single pulse on any axis is a different position
+    pulsePos[MAX_PULSE_AXES - 1] = 1;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == TF_INPUTS_CHANGED_POSITION);
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk &= (changed == 0);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - position: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //select_motion_tool
+    group.tool = 3;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == TF_INPUTS_CHANGED_TOOL);
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk &= (changed == 0);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - tool number: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the tool file was edited on the pendant
+    toolData.rz = 900000;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == TF_INPUTS_CHANGED_TOOL);
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk &= (changed == 0);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - tool definition: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    pulsePos[0] = -1;
+    toolData.x = 5000;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == (TF_INPUTS_CHANGED_POSITION | TF_INPUTS_CHANGED_TOOL));
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - position and tool: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //on a base track, moving the track moves the robot
+    group.baseTrackGroupIndex = 1;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk = (changed == TF_INPUTS_CHANGED_POSITION);
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk &= (changed == 0);
+    pulsePosTrack[0] += 1;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    bOk &= (changed == TF_INPUTS_CHANGED_POSITION);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TransformInputs - base track: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    transformInputs[0] = savedInputs;
+    g_Ros_Controller.ctrlGroups[0] = savedGroup;
+    return bAllTestsPassed;
+}
+
+//R1, R2 on a base track (B1) and the base track itself
+#define TEST_TF_NUM_GROUPS  3
+
+typedef struct
+{
+    int numGroup;
+    CtrlGroup* ctrlGroups[TEST_TF_NUM_GROUPS];
+    PositionMonitor_TransformInputs transformInputs[TEST_TF_NUM_GROUPS];
+    geometry_msgs__msg__TransformStamped* tfLinks[MAX_CONTROLLABLE_GROUPS][NUMBER_TRANSFORM_LINKS_PER_ROBOT];
+    BOOL bTfStaticChanged;
+} TfTestingState;
+
+static void Ros_Testing_PositionMonitor_MakeFakeGroups(CtrlGroup* groups, TfTestingState* savedState)
+{
+    savedState->numGroup = g_Ros_Controller.numGroup;
+    memcpy(savedState->ctrlGroups, g_Ros_Controller.ctrlGroups, sizeof(savedState->ctrlGroups));
+    memcpy(savedState->transformInputs, transformInputs, sizeof(savedState->transformInputs));
+    memcpy(savedState->tfLinks, tfLinks, sizeof(savedState->tfLinks));
+    savedState->bTfStaticChanged = bTfStaticChanged;
+
+    bzero(groups, sizeof(CtrlGroup) * TEST_TF_NUM_GROUPS);
+    groups[0].groupId = MP_R1_GID;
+    groups[0].baseTrackGroupIndex = -1;
+    groups[1].groupId = MP_R2_GID;
+    groups[1].baseTrackGroupIndex = 2;
+    groups[2].groupId = MP_B1_GID;
+    groups[2].baseTrackGroupIndex = -1;
+
+    g_Ros_Controller.numGroup = TEST_TF_NUM_GROUPS;
+    for (int i = 0; i < TEST_TF_NUM_GROUPS; i += 1)
+        g_Ros_Controller.ctrlGroups[i] = &groups[i];
+
+    bzero(transformInputs, sizeof(savedState->transformInputs));
+}
+
+static void Ros_Testing_PositionMonitor_RestoreGroups(TfTestingState const* savedState)
+{
+    g_Ros_Controller.numGroup = savedState->numGroup;
+    memcpy(g_Ros_Controller.ctrlGroups, savedState->ctrlGroups, sizeof(savedState->ctrlGroups));
+    memcpy(transformInputs, savedState->transformInputs, sizeof(savedState->transformInputs));
+    memcpy(tfLinks, savedState->tfLinks, sizeof(savedState->tfLinks));
+    bTfStaticChanged = savedState->bTfStaticChanged;
+}
+
+static BOOL Ros_Testing_PositionMonitor_IsLinkIn(tf2_msgs__msg__TFMessage const* msg, geometry_msgs__msg__TransformStamped const* link)
+{
+    return (link >= msg->transforms.data) && (link < msg->transforms.data + msg->transforms.size);
+}
+
+static BOOL Ros_Testing_PositionMonitor_TfLinks()
+{
+    CtrlGroup groups[TEST_TF_NUM_GROUPS];
+    TfTestingState savedState;
+    tf2_msgs__msg__TFMessage* transform;
+    tf2_msgs__msg__TFMessage* transformStatic;
+    char expected[MAX_TF_FRAME_NAME_LENGTH];
+    int numLinks, numStaticLinks;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    Ros_Testing_PositionMonitor_MakeFakeGroups(groups, &savedState);
+    groups[1].tool = 5;
+
+    Ros_PositionMonitor_CountTfLinks(&numLinks, &numStaticLinks);
+    bOk = (numLinks == 3) && (numStaticLinks == 5);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfLinks - count: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    transform = tf2_msgs__msg__TFMessage__create();
+    transformStatic = tf2_msgs__msg__TFMessage__create();
+    geometry_msgs__msg__TransformStamped__Sequence__init(&transform->transforms, numLinks);
+    geometry_msgs__msg__TransformStamped__Sequence__init(&transformStatic->transforms, numStaticLinks);
+    Ros_PositionMonitor_Initialize_TfLinks(transform, transformStatic);
+
+    //only the links which move with the robot are on /tf
+    bOk = Ros_Testing_PositionMonitor_IsLinkIn(transformStatic, tfLinks[0][tfLink_WorldToBase]);
+    bOk &= Ros_Testing_PositionMonitor_IsLinkIn(transform, tfLinks[0][tfLink_BaseToFlange]);
+    bOk &= Ros_Testing_PositionMonitor_IsLinkIn(transformStatic, tfLinks[0][tfLink_FlangeToTool0]);
+    bOk &= Ros_Testing_PositionMonitor_IsLinkIn(transformStatic, tfLinks[0][tfLink_FlangeToTcp]);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfLinks - robot: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    bOk = Ros_Testing_PositionMonitor_IsLinkIn(transform, tfLinks[1][tfLink_WorldToBase]);
+    bOk &= Ros_Testing_PositionMonitor_IsLinkIn(transform, tfLinks[1][tfLink_BaseToFlange]);
+    bOk &= Ros_Testing_PositionMonitor_IsLinkIn(transformStatic, tfLinks[1][tfLink_FlangeToTool0]);
+    bOk &= Ros_Testing_PositionMonitor_IsLinkIn(transformStatic, tfLinks[1][tfLink_FlangeToTcp]);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfLinks - robot on base track: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    bOk = TRUE;
+    for (int link = 0; link < NUMBER_TRANSFORM_LINKS_PER_ROBOT; link += 1)
+        bOk &= (tfLinks[2][link] == NULL);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfLinks - base track: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //every transform in the messages belongs to exactly one link
+    bOk = TRUE;
+    for (int a = 0; a < 2 * NUMBER_TRANSFORM_LINKS_PER_ROBOT; a += 1)
+    {
+        for (int b = a + 1; b < 2 * NUMBER_TRANSFORM_LINKS_PER_ROBOT; b += 1)
+            bOk &= (tfLinks[a / NUMBER_TRANSFORM_LINKS_PER_ROBOT][a % NUMBER_TRANSFORM_LINKS_PER_ROBOT] !=
+                tfLinks[b / NUMBER_TRANSFORM_LINKS_PER_ROBOT][b % NUMBER_TRANSFORM_LINKS_PER_ROBOT]);
+    }
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfLinks - unique: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    snprintf(expected, MAX_TF_FRAME_NAME_LENGTH, "%sr2/base", g_nodeConfigSettings.tf_frame_prefix);
+    bOk = (strcmp(tfLinks[1][tfLink_WorldToBase]->child_frame_id.data, expected) == 0);
+    bOk &= (strcmp(tfLinks[1][tfLink_BaseToFlange]->header.frame_id.data, expected) == 0);
+    snprintf(expected, MAX_TF_FRAME_NAME_LENGTH, "%sr2/tcp_5", g_nodeConfigSettings.tf_frame_prefix);
+    bOk &= (strcmp(tfLinks[1][tfLink_FlangeToTcp]->child_frame_id.data, expected) == 0);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfLinks - frame names: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    tf2_msgs__msg__TFMessage__destroy(transform);
+    tf2_msgs__msg__TFMessage__destroy(transformStatic);
+    Ros_Testing_PositionMonitor_RestoreGroups(&savedState);
+    return bAllTestsPassed;
+}
+
+static BOOL Ros_Testing_PositionMonitor_TfStatic()
+{
+    CtrlGroup groups[TEST_TF_NUM_GROUPS];
+    TfTestingState savedState;
+    tf2_msgs__msg__TFMessage* transform;
+    tf2_msgs__msg__TFMessage* transformStatic;
+    long pulsePos[MAX_PULSE_AXES] = { 0 };
+    long pulsePosTrack[MAX_PULSE_AXES] = { 0 };
+    MP_COORD toolData;
+    geometry_msgs__msg__Vector3 const* translation;
+    char expected[MAX_TF_FRAME_NAME_LENGTH];
+    int numLinks, numStaticLinks;
+    UINT32 changed;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    Ros_Testing_PositionMonitor_MakeFakeGroups(groups, &savedState);
+    groups[0].robotCalibrationToBaseFrame.x = 250000;
+    groups[1].robotCalibrationToBaseFrame.x = 750000;
+
+    Ros_PositionMonitor_CountTfLinks(&numLinks, &numStaticLinks);
+    transform = tf2_msgs__msg__TFMessage__create();
+    transformStatic = tf2_msgs__msg__TFMessage__create();
+    geometry_msgs__msg__TransformStamped__Sequence__init(&transform->transforms, numLinks);
+    geometry_msgs__msg__TransformStamped__Sequence__init(&transformStatic->transforms, numStaticLinks);
+    Ros_PositionMonitor_Initialize_TfLinks(transform, transformStatic);
+
+    bzero(&toolData, sizeof(MP_COORD));
+    toolData.z = 100000;
+
+    //the first position publishes the calibration and the tool
+    bTfStaticChanged = FALSE;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(0, changed);
+    bOk = bTfStaticChanged;
+    bOk &= (fabs(tfLinks[0][tfLink_WorldToBase]->transform.translation.x - 0.25) < 1e-9);
+    translation = &tfLinks[0][tfLink_FlangeToTcp]->transform.translation;
+    bOk &= (fabs(sqrt(translation->x * translation->x + translation->y * translation->y + translation->z * translation->z) - 0.1) < 1e-6);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfStatic - first: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //standing still or moving doesn't change any of the static links
+    bTfStaticChanged = FALSE;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(0, changed);
+    bOk = !bTfStaticChanged;
+    pulsePos[0] = 1000;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(0, changed);
+    bOk &= !bTfStaticChanged;
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfStatic - position: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //select_motion_tool republishes it, with the tcp frame of the new tool
+    groups[0].tool = 2;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(0, changed);
+    bOk = bTfStaticChanged;
+    snprintf(expected, MAX_TF_FRAME_NAME_LENGTH, "%sr1/tcp_2", g_nodeConfigSettings.tf_frame_prefix);
+    bOk &= (strcmp(tfLinks[0][tfLink_FlangeToTcp]->child_frame_id.data, expected) == 0);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfStatic - tool number: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //so does an edit of the tool file
+    bTfStaticChanged = FALSE;
+    toolData.x = 30000;
+    toolData.y = 40000;
+    toolData.z = 0;
+    changed = Ros_PositionMonitor_TransformInputsChanged(0, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(0, changed);
+    bOk = bTfStaticChanged;
+    translation = &tfLinks[0][tfLink_FlangeToTcp]->transform.translation;
+    bOk &= (fabs(sqrt(translation->x * translation->x + translation->y * translation->y + translation->z * translation->z) - 0.05) < 1e-6);
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfStatic - tool definition: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the base of a robot on a track is on /tf, so it's left to the calculation of the position
+    bTfStaticChanged = FALSE;
+    changed = Ros_PositionMonitor_TransformInputsChanged(1, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(1, changed);
+    bOk = bTfStaticChanged;
+    bOk &= (tfLinks[1][tfLink_WorldToBase]->transform.translation.x == 0.0);
+    bTfStaticChanged = FALSE;
+    pulsePosTrack[0] = 1000;
+    changed = Ros_PositionMonitor_TransformInputsChanged(1, pulsePos, pulsePosTrack, &toolData);
+    Ros_PositionMonitor_UpdateStaticLinks(1, changed);
+    bOk &= !bTfStaticChanged;
+    Ros_Debug_BroadcastMsg("Testing PositionMonitor TfStatic - base track: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    tf2_msgs__msg__TFMessage__destroy(transform);
+    tf2_msgs__msg__TFMessage__destroy(transformStatic);
+    Ros_Testing_PositionMonitor_RestoreGroups(&savedState);
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_PositionMonitor()
+{
+    BOOL bSuccess = TRUE;
+
+    bSuccess &= Ros_Testing_PositionMonitor_TransformInputs();
+    bSuccess &= Ros_Testing_PositionMonitor_TfLinks();
+    bSuccess &= Ros_Testing_PositionMonitor_TfStatic();
+
+    return bSuccess;
+}
+
+#endif //MOTOROS2_TESTING_ENABLE
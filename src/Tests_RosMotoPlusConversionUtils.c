@@ -82,12 +82,45 @@ BOOL Ros_Testing_Ros_MpCoord_To_GeomMsgsTransform()
     return bSuccess;
 }
 
+BOOL Ros_Testing_Ros_GeomMsgsTransform_To_MpCoord()
+{
+    BOOL bSuccess = TRUE;
+    MP_COORD mp_coord_ = { 0 };
+    MP_COORD mp_coord_out_ = { 0 };
+    geometry_msgs__msg__Transform ros_tf_ = { { 0 } };
+
+    mp_coord_.x  =  412345;
+    mp_coord_.y  = -150001;
+    mp_coord_.z  =  987654;
+    mp_coord_.rx = 1200000;
+    mp_coord_.ry =  -45000;
+    mp_coord_.rz =  900000;
+
+    // convert to ROS and back, the result should be the original
+    Ros_MpCoord_To_GeomMsgsTransform(&mp_coord_, &ros_tf_);
+    Ros_GeomMsgsTransform_To_MpCoord(&ros_tf_, &mp_coord_out_);
+
+    // positions are rounded to the nearest micro-meter, so this is exact
+    bSuccess &= (mp_coord_.x == mp_coord_out_.x);
+    bSuccess &= (mp_coord_.y == mp_coord_out_.y);
+    bSuccess &= (mp_coord_.z == mp_coord_out_.z);
+
+    // NOTE: this is not a strict equals test right now (uses non-zero epsilon)
+    bSuccess &= Ros_Testing_CompareLong(mp_coord_.rx, mp_coord_out_.rx);
+    bSuccess &= Ros_Testing_CompareLong(mp_coord_.ry, mp_coord_out_.ry);
+    bSuccess &= Ros_Testing_CompareLong(mp_coord_.rz, mp_coord_out_.rz);
+
+    Ros_Debug_BroadcastMsg("Testing Ros_GeomMsgsTransform_To_MpCoord: %s", bSuccess ? "PASS" : "FAIL");
+    return bSuccess;
+}
+
 BOOL Ros_Testing_RosMotoPlusConversionUtils()
 {
     BOOL bSuccess = TRUE;
 
     bSuccess &= Ros_Testing_Ros_MpCoord_To_GeomMsgsPose();
     bSuccess &= Ros_Testing_Ros_MpCoord_To_GeomMsgsTransform();
+    bSuccess &= Ros_Testing_Ros_GeomMsgsTransform_To_MpCoord();
 
     return bSuccess;
 }
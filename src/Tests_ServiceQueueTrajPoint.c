@@ -0,0 +1,68 @@
+// Tests_ServiceQueueTrajPoint.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifdef MOTOROS2_TESTING_ENABLE
+
+#include "MotoROS.h"
+
+BOOL Ros_Testing_ServiceQueueTrajPoint_FormatStatus()
+{
+    BOOL bAllTestsPassed = TRUE;
+    BOOL bOk;
+    char statusMsg[QUEUE_STATUS_MSG_LEN + 1];
+    char longResult[2 * QUEUE_STATUS_MSG_LEN];
+    const char* queueStatus = " (queued: 3/15, underruns: 2)";
+    const char* largestQueueStatus = " (queued: -2147483648/-2147483648, underruns: -2147483648)";
+    size_t resultLen;
+
+    //the buffer is one longer than QUEUE_STATUS_MSG_LEN, to detect writes past the limit
+    memset(statusMsg, 'x', sizeof(statusMsg));
+    memset(longResult, 'a', sizeof(longResult) - 1);
+    longResult[sizeof(longResult) - 1] = '\0';
+
+    Ros_ServiceQueueTrajPoint_FormatStatus(statusMsg, "Success", 3, 15, 2);
+    bOk = (strcmp(statusMsg, "Success (queued: 3/15, underruns: 2)") == 0);
+    Ros_Debug_BroadcastMsg("Testing ServiceQueueTrajPoint FormatStatus - format: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a result string which doesn't fit is shortened, the state of the queue is kept
+    Ros_ServiceQueueTrajPoint_FormatStatus(statusMsg, longResult, 3, 15, 2);
+    resultLen = QUEUE_STATUS_MSG_LEN - 1 - strlen(queueStatus);
+    bOk = (strlen(statusMsg) == QUEUE_STATUS_MSG_LEN - 1) && (statusMsg[QUEUE_STATUS_MSG_LEN] == 'x');
+    bOk &= (strncmp(statusMsg, longResult, resultLen) == 0) && (strcmp(statusMsg + resultLen, queueStatus) == 0);
+    Ros_Debug_BroadcastMsg("Testing ServiceQueueTrajPoint FormatStatus - truncated: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a result string which just fits is not shortened
+    longResult[resultLen] = '\0';
+    Ros_ServiceQueueTrajPoint_FormatStatus(statusMsg, longResult, 3, 15, 2);
+    bOk = (strlen(statusMsg) == QUEUE_STATUS_MSG_LEN - 1) && (strncmp(statusMsg, longResult, resultLen) == 0);
+    longResult[resultLen] = 'a';
+    Ros_Debug_BroadcastMsg("Testing ServiceQueueTrajPoint FormatStatus - fits: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the largest state of the queue still leaves room for part of the result string
+    Ros_ServiceQueueTrajPoint_FormatStatus(statusMsg, longResult, (int)0x80000000, (int)0x80000000, (int)0x80000000);
+    resultLen = QUEUE_STATUS_MSG_LEN - 1 - strlen(largestQueueStatus);
+    bOk = (resultLen > 0) && (strlen(statusMsg) == QUEUE_STATUS_MSG_LEN - 1) && (statusMsg[QUEUE_STATUS_MSG_LEN] == 'x');
+    bOk &= (strncmp(statusMsg, longResult, resultLen) == 0) && (strcmp(statusMsg + resultLen, largestQueueStatus) == 0);
+    Ros_Debug_BroadcastMsg("Testing ServiceQueueTrajPoint FormatStatus - largest: %s", bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_ServiceQueueTrajPoint()
+{
+    BOOL bSuccess = TRUE;
+
+    bSuccess &= Ros_Testing_ServiceQueueTrajPoint_FormatStatus();
+
+    return bSuccess;
+}
+
+#endif //MOTOROS2_TESTING_ENABLE
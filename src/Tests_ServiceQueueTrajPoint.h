@@ -0,0 +1,17 @@
+// Tests_ServiceQueueTrajPoint.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_TESTS_SERVICE_QUEUE_TRAJ_POINT_H
+#define MOTOROS2_TESTS_SERVICE_QUEUE_TRAJ_POINT_H
+
+#ifdef MOTOROS2_TESTING_ENABLE
+
+extern BOOL Ros_Testing_ServiceQueueTrajPoint();
+
+#endif //MOTOROS2_TESTING_ENABLE
+
+#endif  // MOTOROS2_TESTS_SERVICE_QUEUE_TRAJ_POINT_H
@@ -0,0 +1,106 @@
+// Tests_SubscriberQueueTrajPoints.c
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#if defined(MOTOROS2_TESTING_ENABLE) && defined(MOTOROS2_INCLUDE_TESTS_QUEUE_TRAJ_POINTS_C)
+
+#include "MotoROS.h"
+
+static void Ros_Testing_SubscriberQueueTrajPoints_SetDuration(builtin_interfaces__msg__Duration* duration, int32_t sec, uint32_t nanosec)
+{
+    duration->sec = sec;
+    duration->nanosec = nanosec;
+}
+
+static BOOL Ros_Testing_SubscriberQueueTrajPoints_IsAfter()
+{
+    builtin_interfaces__msg__Duration a, b;
+    BOOL bOk;
+
+    //the seconds take precedence over the nanoseconds
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&a, 2, 0);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&b, 1, 999999999);
+    bOk = Ros_SubscriberQueueTrajPoints_IsAfter(&a, &b) && !Ros_SubscriberQueueTrajPoints_IsAfter(&b, &a);
+
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&a, 1, 500000001);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&b, 1, 500000000);
+    bOk &= Ros_SubscriberQueueTrajPoints_IsAfter(&a, &b) && !Ros_SubscriberQueueTrajPoints_IsAfter(&b, &a);
+
+    //a point at the same time is not after it
+    bOk &= !Ros_SubscriberQueueTrajPoints_IsAfter(&b, &b);
+
+    Ros_Debug_BroadcastMsg("Testing %s: %s", __func__, bOk ? "PASS" : "FAIL");
+    return bOk;
+}
+
+static BOOL Ros_Testing_SubscriberQueueTrajPoints_Sequence()
+{
+    BOOL bSavedMustInitialize = Ros_MotionControl_MustInitializePointQueue;
+    PointStreamState savedStream = Ros_PointStream;
+    builtin_interfaces__msg__Duration timeFromStart;
+    builtin_interfaces__msg__Time stamp;
+    BOOL bOk, bAllTestsPassed = TRUE;
+
+    //the first point of a stream initializes the point queue, nothing of a previous stream is skipped
+    Ros_MotionControl_MustInitializePointQueue = TRUE;
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&Ros_PointStream.lastPointTime, 10, 0);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&timeFromStart, 0, 0);
+    bOk = !Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&timeFromStart, 5, 0);
+    bOk &= !Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Debug_BroadcastMsg("Testing %s: new stream: %s", __func__, bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //points up to the time_from_start of the last queued point are skipped when they are published again
+    Ros_MotionControl_MustInitializePointQueue = FALSE;
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&Ros_PointStream.lastPointTime, 1, 500000000);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&timeFromStart, 0, 999999999);
+    bOk = Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&timeFromStart, 1, 500000000);
+    bOk &= Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&timeFromStart, 1, 500000001);
+    bOk &= !Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Testing_SubscriberQueueTrajPoints_SetDuration(&timeFromStart, 2, 0);
+    bOk &= !Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Debug_BroadcastMsg("Testing %s: skip queued: %s", __func__, bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //a rejected point is reported, but doesn't advance the stream. It is queued when it is published again.
+    Ros_SubscriberQueueTrajPoints_RejectPoint(motoros2_interfaces__msg__QueueResultEnum__BUSY);
+    bOk = (Ros_PointStream.resultCode == motoros2_interfaces__msg__QueueResultEnum__BUSY);
+    bOk &= (Ros_PointStream.lastPointTime.sec == 1) && (Ros_PointStream.lastPointTime.nanosec == 500000000);
+    bOk &= !Ros_SubscriberQueueTrajPoints_IsQueued(&timeFromStart);
+    Ros_Debug_BroadcastMsg("Testing %s: rejected: %s", __func__, bOk ? "PASS" : "FAIL");
+    bAllTestsPassed &= bOk;
+
+    //the stamp of a message is reported even if it's rejected (not in point-queue mode)
+    if (!Ros_MotionControl_IsMotionMode_PointQueue())
+    {
+        stamp.sec = 1234;
+        stamp.nanosec = 5678;
+        bOk = !Ros_SubscriberQueueTrajPoints_StartMessage(&stamp);
+        bOk &= (Ros_PointStream.lastStamp.sec == 1234) && (Ros_PointStream.lastStamp.nanosec == 5678);
+        bOk &= (Ros_PointStream.resultCode == motoros2_interfaces__msg__QueueResultEnum__WRONG_MODE);
+        Ros_Debug_BroadcastMsg("Testing %s: wrong mode: %s", __func__, bOk ? "PASS" : "FAIL");
+        bAllTestsPassed &= bOk;
+    }
+
+    Ros_PointStream = savedStream;
+    Ros_MotionControl_MustInitializePointQueue = bSavedMustInitialize;
+    return bAllTestsPassed;
+}
+
+BOOL Ros_Testing_SubscriberQueueTrajPoints()
+{
+    BOOL bSuccess = TRUE;
+
+    bSuccess &= Ros_Testing_SubscriberQueueTrajPoints_IsAfter();
+    bSuccess &= Ros_Testing_SubscriberQueueTrajPoints_Sequence();
+
+    return bSuccess;
+}
+
+#endif //MOTOROS2_TESTING_ENABLE
@@ -0,0 +1,17 @@
+// Tests_SubscriberQueueTrajPoints.h
+
+// SPDX-FileCopyrightText: 2025, Yaskawa America, Inc.
+// SPDX-FileCopyrightText: 2025, Delft University of Technology
+//
+// SPDX-License-Identifier: Apache-2.0
+
+#ifndef MOTOROS2_TESTS_SUBSCRIBER_QUEUE_TRAJ_POINTS_H
+#define MOTOROS2_TESTS_SUBSCRIBER_QUEUE_TRAJ_POINTS_H
+
+#ifdef MOTOROS2_TESTING_ENABLE
+
+extern BOOL Ros_Testing_SubscriberQueueTrajPoints();
+
+#endif //MOTOROS2_TESTING_ENABLE
+
+#endif  // MOTOROS2_TESTS_SUBSCRIBER_QUEUE_TRAJ_POINTS_H
@@ -78,6 +78,12 @@ void RosInitTask()
     bTestResult &= Ros_Testing_ControllerStatusIO();
     bTestResult &= Ros_Testing_ActionServer_FJT();
     bTestResult &= Ros_Testing_TimeConversionUtils();
+    bTestResult &= Ros_Testing_MotionControl();
+    bTestResult &= Ros_Testing_FsuSpeedLimit();
+    bTestResult &= Ros_Testing_IncPrecompile();
+    bTestResult &= Ros_Testing_ServiceQueueTrajPoint();
+    bTestResult &= Ros_Testing_SubscriberQueueTrajPoints();
+    bTestResult &= Ros_Testing_PositionMonitor();
     bTestResult ? Ros_Debug_BroadcastMsg("Testing SUCCESSFUL") : Ros_Debug_BroadcastMsg("!!! Testing FAILED !!!");
     MOTOROS2_MEM_TRACE_REPORT(testing)
     Ros_Debug_BroadcastMsg("===");
@@ -134,8 +140,17 @@ void RosInitTask()
         Ros_ServiceResetError_Initialize();
         Ros_ServiceStartTrajMode_Initialize();
         Ros_ServiceStartPointQueueMode_Initialize();
+        Ros_ServiceStartRawStreamingMode_Initialize();
         Ros_ServiceStopTrajMode_Initialize();
         Ros_ServiceSelectMotionTool_Initialize();
+        Ros_ServiceResetIncMoveTiming_Initialize();
+        Ros_SubscriberSpeedScale_Initialize();
+        Ros_SubscriberRawIncrements_Initialize();
+        Ros_SubscriberQueueTrajPoints_Initialize();
+        Ros_SubscriberQueueCartesianPoints_Initialize();
+        Ros_IncMoveTiming_Initialize();
+        Ros_IncQueueStatus_Initialize();
+        Ros_IncPrecompile_Initialize();
 
         // Start executor that performs all communication
         // (This task deletes itself when the agent disconnects.)
@@ -184,6 +199,9 @@ void RosInitTask()
                 motoRosAssert(FALSE, SUBCODE_FAIL_IO_STATUS_UPDATE);
             }
 
+            //The raw-streaming watchdog of the IncMoveTask only latches an underrun. The robot is held from here.
+            Ros_MotionControl_HandleRawStreamingUnderrun();
+
             //Update robot's feedback position and publish the topics
             Ros_PositionMonitor_UpdateLocation();
         }
@@ -207,10 +225,19 @@ void RosInitTask()
         mpSemTake(semCommunicationExecutorStatus, WAIT_FOREVER);
         mpSemDelete(semCommunicationExecutorStatus);
 
+        Ros_IncPrecompile_Cleanup();
+        Ros_IncQueueStatus_Cleanup();
+        Ros_IncMoveTiming_Cleanup();
+        Ros_SubscriberQueueCartesianPoints_Cleanup();
+        Ros_SubscriberQueueTrajPoints_Cleanup();
+        Ros_SubscriberRawIncrements_Cleanup();
+        Ros_SubscriberSpeedScale_Cleanup();
+        Ros_ServiceResetIncMoveTiming_Cleanup();
         Ros_ServiceSelectMotionTool_Cleanup();
         Ros_ServiceStopTrajMode_Cleanup();
         Ros_ServiceStartTrajMode_Cleanup();
         Ros_ServiceStartPointQueueMode_Cleanup();
+        Ros_ServiceStartRawStreamingMode_Cleanup();
         Ros_ServiceResetError_Cleanup();
         Ros_ServiceReadWriteIO_Cleanup();
         Ros_ServiceQueueTrajPoint_Cleanup();